@@ -159,6 +159,7 @@ idAASSettings::idAASSettings()
 	writeBrushMap = false;
 	playerFlood = false;
 	noOptimize = false;
+	writeRouteTable = false;
 	allowSwimReachabilities = false;
 	allowFlyReachabilities = false;
 	fileExtension = "aas48";
@@ -1334,6 +1335,8 @@ bool idAASFileLocal::Load( const idStr& fileName, unsigned int mapFileCRC )
 		common->Warning( "AAS file '%s' is out of date", name.c_str() );
 		return false;
 	}
+	// tools load without a map, keep the CRC the file was compiled for
+	crc = c;
 	
 	// clear the file in memory
 	Clear();
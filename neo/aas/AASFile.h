@@ -239,6 +239,7 @@ public:
 	bool						writeBrushMap;
 	bool						playerFlood;
 	bool						noOptimize;
+	bool						writeRouteTable;
 	bool						allowSwimReachabilities;
 	bool						allowFlyReachabilities;
 	idStr						fileExtension;
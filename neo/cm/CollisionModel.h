@@ -83,6 +83,30 @@ typedef struct trace_s
 
 typedef int cmHandle_t;
 
+// trace request for batched collision detection
+typedef enum
+{
+	CM_TRACE_TRANSLATION,					// translation from start to end
+	CM_TRACE_ROTATION,						// rotation about the rotation axis
+	CM_TRACE_CONTENTS						// contents at start
+} cmTraceType_t;
+
+typedef struct cmTraceRequest_s
+{
+	cmTraceType_t			type;			// kind of trace
+	idVec3					start;			// start of trace
+	idVec3					end;			// end of translation
+	idRotation				rotation;		// rotation
+	const idTraceModel* 	trm;			// trace model, NULL for a point trace
+	idMat3					trmAxis;		// trace model axis
+	int						contentMask;	// contents to collide with
+	cmHandle_t				model;			// model to trace against
+	idVec3					modelOrigin;	// model origin
+	idMat3					modelAxis;		// model axis
+	trace_t					results;		// result of translation or rotation
+	int						contents;		// result of contents test
+} cmTraceRequest_t;
+
 #define CM_CLIP_EPSILON		0.25f			// always stay this distance away from any model
 #define CM_BOX_EPSILON		1.0f			// should always be larger than clip epsilon
 #define CM_MAX_TRACE_DIST	4096.0f			// maximum distance a trace model may be traced, point traces are unlimited
@@ -135,6 +159,9 @@ public:
 	virtual int				Contacts( contactInfo_t* contacts, const int maxContacts, const idVec3& start, const idVec6& dir, const float depth,
 									  const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 									  cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis ) = 0;
+	// Runs a batch of independent traces, spread over the job system when there are enough of them.
+	// Must be called from the thread that runs the other traces, models may not change until it returns.
+	virtual void			TraceBatch( cmTraceRequest_t* requests, const int numRequests ) = 0;
 									  
 	// Tests collision detection.
 	virtual void			DebugOutput( const idVec3& origin ) = 0;
@@ -61,11 +61,11 @@ bool idCollisionModelManagerLocal::TestTrmVertsInBrush( cm_traceWork_t* tw, cm_b
 	float d, bestd;
 	idVec3* p;
 	
-	if( b->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( b->checkcount[tw->contextNum] == tw->checkCount )
 	{
 		return false;
 	}
-	b->checkcount = idCollisionModelManagerLocal::checkCount;
+	b->checkcount[tw->contextNum] = tw->checkCount;
 	
 	if( !( b->contents & tw->contents ) )
 	{
@@ -129,12 +129,12 @@ bool idCollisionModelManagerLocal::TestTrmVertsInBrush( cm_traceWork_t* tw, cm_b
 CM_SetTrmEdgeSidedness
 ================
 */
-#define CM_SetTrmEdgeSidedness( edge, bpl, epl, bitNum ) {						\
+#define CM_SetTrmEdgeSidedness( cache, bpl, epl, bitNum ) {						\
 	const int mask = 1 << bitNum;												\
-	if ( ( edge->sideSet & mask ) == 0 ) {										\
+	if ( ( (cache)->sideSet & mask ) == 0 ) {									\
 		const float fl = (bpl).PermutedInnerProduct( epl );						\
-		edge->side = ( edge->side & ~mask ) | ( ( fl < 0.0f ) ? mask : 0 );		\
-		edge->sideSet |= mask;													\
+		(cache)->side = ( (cache)->side & ~mask ) | ( ( fl < 0.0f ) ? mask : 0 );	\
+		(cache)->sideSet |= mask;												\
 	}																			\
 }
 
@@ -143,12 +143,12 @@ CM_SetTrmEdgeSidedness
 CM_SetTrmPolygonSidedness
 ================
 */
-#define CM_SetTrmPolygonSidedness( v, plane, bitNum ) {						\
+#define CM_SetTrmPolygonSidedness( cache, p, plane, bitNum ) {				\
 	const int mask = 1 << bitNum;											\
-	if ( ( (v)->sideSet & mask ) == 0 ) {									\
-		const float fl = plane.Distance( (v)->p );							\
-		(v)->side = ( (v)->side & ~mask ) | ( ( fl < 0.0f ) ? mask : 0 );		\
-		(v)->sideSet |= mask;												\
+	if ( ( (cache)->sideSet & mask ) == 0 ) {								\
+		const float fl = plane.Distance( p );								\
+		(cache)->side = ( (cache)->side & ~mask ) | ( ( fl < 0.0f ) ? mask : 0 );	\
+		(cache)->sideSet |= mask;											\
 	}																		\
 }
 
@@ -169,11 +169,11 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 	cm_vertex_t* v, *v1, *v2;
 	
 	// if already checked this polygon
-	if( p->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( p->checkcount[tw->contextNum] == tw->checkCount )
 	{
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	p->checkcount[tw->contextNum] = tw->checkCount;
 	
 	// if this polygon does not have the right contents behind it
 	if( !( p->contents & tw->contents ) )
@@ -211,7 +211,7 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 			edgeNum = p->edges[i];
 			edge = tw->model->edges + abs( edgeNum );
 			// if this edge is already tested
-			if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+			if( edge->cache[tw->contextNum].checkcount == tw->checkCount )
 			{
 				continue;
 			}
@@ -220,7 +220,7 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 			{
 				v = &tw->model->vertices[edge->vertexNum[j]];
 				// if this vertex is already tested
-				if( v->checkcount == idCollisionModelManagerLocal::checkCount )
+				if( v->cache[tw->contextNum].checkcount == tw->checkCount )
 				{
 					continue;
 				}
@@ -262,20 +262,20 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs( edgeNum );
 		// reset sidedness cache if this is the first time we encounter this edge
-		if( edge->checkcount != idCollisionModelManagerLocal::checkCount )
+		if( edge->cache[tw->contextNum].checkcount != tw->checkCount )
 		{
-			edge->sideSet = 0;
+			edge->cache[tw->contextNum].sideSet = 0;
 		}
 		// pluecker coordinate for edge
 		tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[edge->vertexNum[0]].p,
 				tw->model->vertices[edge->vertexNum[1]].p );
 		v = &tw->model->vertices[edge->vertexNum[INT32_SIGNBITSET( edgeNum )]];
 		// reset sidedness cache if this is the first time we encounter this vertex
-		if( v->checkcount != idCollisionModelManagerLocal::checkCount )
+		if( v->cache[tw->contextNum].checkcount != tw->checkCount )
 		{
-			v->sideSet = 0;
+			v->cache[tw->contextNum].sideSet = 0;
 		}
-		v->checkcount = idCollisionModelManagerLocal::checkCount;
+		v->cache[tw->contextNum].checkcount = tw->checkCount;
 	}
 	
 	// get side of polygon for each trm vertex
@@ -301,8 +301,8 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 			edgeNum = p->edges[j];
 			edge = tw->model->edges + abs( edgeNum );
 #if 1
-			CM_SetTrmEdgeSidedness( edge, tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
-			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( edge->side >> i ) & 1 ) ^ flip )
+			CM_SetTrmEdgeSidedness( &edge->cache[tw->contextNum], tw->edges[i].pl, tw->polygonEdgePlueckerCache[j], i );
+			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( edge->cache[tw->contextNum].side >> i ) & 1 ) ^ flip )
 			{
 				break;
 			}
@@ -348,25 +348,25 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 	{
 		edgeNum = p->edges[i];
 		edge = tw->model->edges + abs( edgeNum );
-		if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+		if( edge->cache[tw->contextNum].checkcount == tw->checkCount )
 		{
 			continue;
 		}
-		edge->checkcount = idCollisionModelManagerLocal::checkCount;
+		edge->cache[tw->contextNum].checkcount = tw->checkCount;
 		
 		for( j = 0; j < tw->numPolys; j++ )
 		{
 #if 1
 			v1 = tw->model->vertices + edge->vertexNum[0];
-			CM_SetTrmPolygonSidedness( v1, tw->polys[j].plane, j );
+			CM_SetTrmPolygonSidedness( &v1->cache[tw->contextNum], v1->p, tw->polys[j].plane, j );
 			v2 = tw->model->vertices + edge->vertexNum[1];
-			CM_SetTrmPolygonSidedness( v2, tw->polys[j].plane, j );
+			CM_SetTrmPolygonSidedness( &v2->cache[tw->contextNum], v2->p, tw->polys[j].plane, j );
 			// if the polygon edge does not cross the trm polygon plane
-			if( !( ( ( v1->side ^ v2->side ) >> j ) & 1 ) )
+			if( !( ( ( v1->cache[tw->contextNum].side ^ v2->cache[tw->contextNum].side ) >> j ) & 1 ) )
 			{
 				continue;
 			}
-			flip = ( v1->side >> j ) & 1;
+			flip = ( v1->cache[tw->contextNum].side >> j ) & 1;
 #else
 			float d1, d2;
 			
@@ -392,8 +392,8 @@ bool idCollisionModelManagerLocal::TestTrmInPolygon( cm_traceWork_t* tw, cm_poly
 				trmEdge = tw->edges + abs( trmEdgeNum );
 #if 1
 				bitNum = abs( trmEdgeNum );
-				CM_SetTrmEdgeSidedness( edge, trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
-				if( INT32_SIGNBITSET( trmEdgeNum ) ^ ( ( edge->side >> bitNum ) & 1 ) ^ flip )
+				CM_SetTrmEdgeSidedness( &edge->cache[tw->contextNum], trmEdge->pl, tw->polygonEdgePlueckerCache[i], bitNum );
+				if( INT32_SIGNBITSET( trmEdgeNum ) ^ ( ( edge->cache[tw->contextNum].side >> bitNum ) & 1 ) ^ flip )
 				{
 					break;
 				}
@@ -539,7 +539,7 @@ int	idCollisionModelManagerLocal::TransformedPointContents( const idVec3& p, cmH
 idCollisionModelManagerLocal::ContentsTrm
 ==================
 */
-int idCollisionModelManagerLocal::ContentsTrm( trace_t* results, const idVec3& start,
+int idCollisionModelManagerLocal::ContentsTrm( cm_traceContext_t* context, trace_t* results, const idVec3& start,
 		const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 		cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis )
 {
@@ -563,7 +563,8 @@ int idCollisionModelManagerLocal::ContentsTrm( trace_t* results, const idVec3& s
 		return results->c.contents;
 	}
 	
-	idCollisionModelManagerLocal::checkCount++;
+	tw.contextNum = context->contextNum;
+	tw.checkCount = ++context->checkCount;
 	
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -720,6 +721,18 @@ idCollisionModelManagerLocal::Contents
 int idCollisionModelManagerLocal::Contents( const idVec3& start,
 		const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 		cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis )
+{
+	return Contents( &traceContexts[0], start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+}
+
+/*
+==================
+idCollisionModelManagerLocal::Contents
+==================
+*/
+int idCollisionModelManagerLocal::Contents( cm_traceContext_t* context, const idVec3& start,
+		const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
+		cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis )
 {
 	trace_t results;
 	
@@ -734,5 +747,5 @@ int idCollisionModelManagerLocal::Contents( const idVec3& start,
 		return 0;
 	}
 	
-	return ContentsTrm( &results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+	return ContentsTrm( context, &results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
 }
@@ -279,11 +279,11 @@ void idCollisionModelManagerLocal::DrawPolygon( cm_model_t* model, cm_polygon_t*
 		{
 			edgeNum = p->edges[i];
 			edge = model->edges + abs( edgeNum );
-			if( edge->checkcount == checkCount )
+			if( edge->cache[0].checkcount == traceContexts[0].checkCount )
 			{
 				continue;
 			}
-			edge->checkcount = checkCount;
+			edge->cache[0].checkcount = traceContexts[0].checkCount;
 			DrawEdge( model, edgeNum, origin, axis );
 		}
 	}
@@ -326,7 +326,7 @@ void idCollisionModelManagerLocal::DrawNodePolygons( cm_model_t* model, cm_node_
 					continue;
 				}
 			}
-			if( p->checkcount == checkCount )
+			if( p->checkcount[0] == traceContexts[0].checkCount )
 			{
 				continue;
 			}
@@ -336,7 +336,7 @@ void idCollisionModelManagerLocal::DrawNodePolygons( cm_model_t* model, cm_node_
 			}
 			
 			DrawPolygon( model, p, origin, axis, viewOrigin );
-			p->checkcount = checkCount;
+			p->checkcount[0] = traceContexts[0].checkCount;
 		}
 		if( node->planeType == -1 )
 		{
@@ -383,7 +383,7 @@ void idCollisionModelManagerLocal::DrawModel( cmHandle_t handle, const idVec3& m
 	
 	model = models[ handle ];
 	viewPos = ( viewOrigin - modelOrigin ) * modelAxis.Transpose();
-	checkCount++;
+	traceContexts[0].checkCount++;
 	DrawNodePolygons( model, model->node, modelOrigin, modelAxis, viewPos, radius );
 }
 
@@ -400,6 +400,7 @@ static idCVar cm_testRotation(	"cm_testRotation",		"1",					CVAR_GAME | CVAR_BOO
 static idCVar cm_testModel(	"cm_testModel",			"0",					CVAR_GAME | CVAR_INTEGER,	"" );
 static idCVar cm_testTimes(	"cm_testTimes",			"1000",					CVAR_GAME | CVAR_INTEGER,	"" );
 static idCVar cm_testRandomMany(	"cm_testRandomMany",	"0",					CVAR_GAME | CVAR_BOOL,		"" );
+static idCVar cm_testBatch(	"cm_testBatch",			"0",					CVAR_GAME | CVAR_BOOL,		"run the test translations as one trace batch" );
 static idCVar cm_testOrigin(	"cm_testOrigin",		"0 0 0",				CVAR_GAME,					"" );
 static idCVar cm_testReset(	"cm_testReset",			"0",					CVAR_GAME | CVAR_BOOL,		"" );
 static idCVar cm_testBox(	"cm_testBox",			"-16 -16 0 16 16 64",	CVAR_GAME,					"" );
@@ -493,13 +494,37 @@ void idCollisionModelManagerLocal::DebugOutput( const idVec3& origin )
 	}
 	
 	// translational collision detection
-	timer.Clear();
-	timer.Start();
-	for( i = 0; i < cm_testTimes.GetInteger(); i++ )
+	if( cm_testBatch.GetBool() )
 	{
-		Translation( &trace, start, testend[i], &itm, boxAxis, CONTENTS_SOLID | CONTENTS_PLAYERCLIP, cm_testModel.GetInteger(), vec3_origin, modelAxis );
+		idList<cmTraceRequest_t> requests;
+		requests.SetNum( cm_testTimes.GetInteger() );
+		for( i = 0; i < requests.Num(); i++ )
+		{
+			requests[i].type = CM_TRACE_TRANSLATION;
+			requests[i].start = start;
+			requests[i].end = testend[i];
+			requests[i].trm = &itm;
+			requests[i].trmAxis = boxAxis;
+			requests[i].contentMask = CONTENTS_SOLID | CONTENTS_PLAYERCLIP;
+			requests[i].model = cm_testModel.GetInteger();
+			requests[i].modelOrigin = vec3_origin;
+			requests[i].modelAxis = modelAxis;
+		}
+		timer.Clear();
+		timer.Start();
+		TraceBatch( requests.Ptr(), requests.Num() );
+		timer.Stop();
+	}
+	else
+	{
+		timer.Clear();
+		timer.Start();
+		for( i = 0; i < cm_testTimes.GetInteger(); i++ )
+		{
+			Translation( &trace, start, testend[i], &itm, boxAxis, CONTENTS_SOLID | CONTENTS_PLAYERCLIP, cm_testModel.GetInteger(), vec3_origin, modelAxis );
+		}
+		timer.Stop();
 	}
-	timer.Stop();
 	t = timer.Milliseconds();
 	if( t < min_translation ) min_translation = t;
 	if( t > max_translation ) max_translation = t;
@@ -88,11 +88,11 @@ int idCollisionModelManagerLocal::CountPolygonMemory( cm_node_t* node ) const
 	for( pref = node->polygons; pref; pref = pref->next )
 	{
 		p = pref->p;
-		if( p->checkcount == checkCount )
+		if( p->checkcount[0] == traceContexts[0].checkCount )
 		{
 			continue;
 		}
-		p->checkcount = checkCount;
+		p->checkcount[0] = traceContexts[0].checkCount;
 		
 		memory += sizeof( cm_polygon_t ) + ( p->numEdges - 1 ) * sizeof( p->edges[0] );
 	}
@@ -118,11 +118,11 @@ void idCollisionModelManagerLocal::WritePolygons( idFile* fp, cm_node_t* node )
 	for( pref = node->polygons; pref; pref = pref->next )
 	{
 		p = pref->p;
-		if( p->checkcount == checkCount )
+		if( p->checkcount[0] == traceContexts[0].checkCount )
 		{
 			continue;
 		}
-		p->checkcount = checkCount;
+		p->checkcount[0] = traceContexts[0].checkCount;
 		fp->WriteFloatString( "\t%d (", p->numEdges );
 		for( i = 0; i < p->numEdges; i++ )
 		{
@@ -155,11 +155,11 @@ int idCollisionModelManagerLocal::CountBrushMemory( cm_node_t* node ) const
 	for( bref = node->brushes; bref; bref = bref->next )
 	{
 		b = bref->b;
-		if( b->checkcount == checkCount )
+		if( b->checkcount[0] == traceContexts[0].checkCount )
 		{
 			continue;
 		}
-		b->checkcount = checkCount;
+		b->checkcount[0] = traceContexts[0].checkCount;
 		
 		memory += sizeof( cm_brush_t ) + ( b->numPlanes - 1 ) * sizeof( b->planes[0] );
 	}
@@ -185,11 +185,11 @@ void idCollisionModelManagerLocal::WriteBrushes( idFile* fp, cm_node_t* node )
 	for( bref = node->brushes; bref; bref = bref->next )
 	{
 		b = bref->b;
-		if( b->checkcount == checkCount )
+		if( b->checkcount[0] == traceContexts[0].checkCount )
 		{
 			continue;
 		}
-		b->checkcount = checkCount;
+		b->checkcount[0] = traceContexts[0].checkCount;
 		fp->WriteFloatString( "\t%d {\n", b->numPlanes );
 		for( i = 0; i < b->numPlanes; i++ )
 		{
@@ -234,17 +234,17 @@ void idCollisionModelManagerLocal::WriteCollisionModel( idFile* fp, cm_model_t*
 	WriteNodes( fp, model->node );
 	fp->WriteFloatString( "\t}\n" );
 	// polygons
-	checkCount++;
+	traceContexts[0].checkCount++;
 	polygonMemory = CountPolygonMemory( model->node );
 	fp->WriteFloatString( "\tpolygons /* polygonMemory = */ %d {\n", polygonMemory );
-	checkCount++;
+	traceContexts[0].checkCount++;
 	WritePolygons( fp, model->node );
 	fp->WriteFloatString( "\t}\n" );
 	// brushes
-	checkCount++;
+	traceContexts[0].checkCount++;
 	brushMemory = CountBrushMemory( model->node );
 	fp->WriteFloatString( "\tbrushes /* brushMemory = */ %d {\n", brushMemory );
-	checkCount++;
+	traceContexts[0].checkCount++;
 	WriteBrushes( fp, model->node );
 	fp->WriteFloatString( "\t}\n" );
 	// closing brace
@@ -360,9 +360,7 @@ void idCollisionModelManagerLocal::ParseVertices( idLexer* src, cm_model_t* mode
 	for( i = 0; i < model->numVertices; i++ )
 	{
 		src->Parse1DMatrix( 3, model->vertices[i].p.ToFloatPtr() );
-		model->vertices[i].side = 0;
-		model->vertices[i].sideSet = 0;
-		model->vertices[i].checkcount = 0;
+		memset( model->vertices[i].cache, 0, sizeof( model->vertices[i].cache ) );
 	}
 	src->ExpectTokenString( "}" );
 }
@@ -386,12 +384,10 @@ void idCollisionModelManagerLocal::ParseEdges( idLexer* src, cm_model_t* model )
 		model->edges[i].vertexNum[0] = src->ParseInt();
 		model->edges[i].vertexNum[1] = src->ParseInt();
 		src->ExpectTokenString( ")" );
-		model->edges[i].side = 0;
-		model->edges[i].sideSet = 0;
+		memset( model->edges[i].cache, 0, sizeof( model->edges[i].cache ) );
 		model->edges[i].internal = src->ParseInt();
 		model->edges[i].numUsers = src->ParseInt();
 		model->edges[i].normal = vec3_origin;
-		model->edges[i].checkcount = 0;
 		model->numInternalEdges += model->edges[i].internal;
 	}
 	src->ExpectTokenString( "}" );
@@ -464,7 +460,7 @@ void idCollisionModelManagerLocal::ParsePolygons( idLexer* src, cm_model_t* mode
 		// get material
 		p->material = declManager->FindMaterial( token );
 		p->contents = p->material->GetContentFlags();
-		p->checkcount = 0;
+		memset( p->checkcount, 0, sizeof( p->checkcount ) );
 		// filter polygon into tree
 		R_FilterPolygonIntoTree( model, model->node, NULL, p );
 	}
@@ -515,7 +511,7 @@ void idCollisionModelManagerLocal::ParseBrushes( idLexer* src, cm_model_t* model
 		{
 			b->contents = ContentsFromString( token );
 		}
-		b->checkcount = 0;
+		memset( b->checkcount, 0, sizeof( b->checkcount ) );
 		b->primitiveNum = 0;
 		b->material = NULL;
 		// filter brush into tree
@@ -586,7 +582,7 @@ cm_model_t* idCollisionModelManagerLocal::ParseCollisionModel( idLexer* src )
 		src->Error( "ParseCollisionModel: bad token \"%s\"", token.c_str() );
 	}
 	// calculate edge normals
-	checkCount++;
+	traceContexts[0].checkCount++;
 	CalculateEdgeNormals( model, model->node );
 	// get model bounds from brush and polygon bounds
 	CM_GetNodeBounds( &model->bounds, model->node );
@@ -196,7 +196,15 @@ void idCollisionModelManagerLocal::Clear()
 	mapName.Clear();
 	mapFileTime = 0;
 	loaded = 0;
-	checkCount = 0;
+	for( int i = 0; i < CM_MAX_TRACE_CONTEXTS; i++ )
+	{
+		traceContexts[i].contextNum = i;
+		traceContexts[i].checkCount = 0;
+		traceContexts[i].getContacts = false;
+		traceContexts[i].contacts = NULL;
+		traceContexts[i].maxContacts = 0;
+		traceContexts[i].numContacts = 0;
+	}
 	maxModels = 0;
 	numModels = 0;
 	models = NULL;
@@ -205,10 +213,6 @@ void idCollisionModelManagerLocal::Clear()
 	trmMaterial = NULL;
 	numProcNodes = 0;
 	procNodes = NULL;
-	getContacts = false;
-	contacts = NULL;
-	maxContacts = 0;
-	numContacts = 0;
 }
 
 /*
@@ -459,6 +463,12 @@ void idCollisionModelManagerLocal::FreeMap()
 {
 	int i;
 	
+	if( traceJobList != NULL )
+	{
+		parallelJobManager->FreeJobList( traceJobList );
+		traceJobList = NULL;
+	}
+	
 	if( !loaded )
 	{
 		Clear();
@@ -540,11 +550,11 @@ void idCollisionModelManagerLocal::CalculateEdgeNormals( cm_model_t* model, cm_n
 		{
 			p = pref->p;
 			// if we checked this polygon already
-			if( p->checkcount == checkCount )
+			if( p->checkcount[0] == traceContexts[0].checkCount )
 			{
 				continue;
 			}
-			p->checkcount = checkCount;
+			p->checkcount[0] = traceContexts[0].checkCount;
 			
 			for( i = 0; i < p->numEdges; i++ )
 			{
@@ -859,7 +869,7 @@ void idCollisionModelManagerLocal::SetupTrmModelStructure()
 		trmPolygons[i]->p = AllocPolygon( model, MAX_TRACEMODEL_POLYEDGES );
 		trmPolygons[i]->p->bounds.Clear();
 		trmPolygons[i]->p->plane.Zero();
-		trmPolygons[i]->p->checkcount = 0;
+		memset( trmPolygons[i]->p->checkcount, 0, sizeof( trmPolygons[i]->p->checkcount ) );
 		trmPolygons[i]->p->contents = -1;		// all contents
 		trmPolygons[i]->p->material = trmMaterial;
 		trmPolygons[i]->p->numEdges = 0;
@@ -869,7 +879,7 @@ void idCollisionModelManagerLocal::SetupTrmModelStructure()
 	trmBrushes[0]->b = AllocBrush( model, MAX_TRACEMODEL_POLYS );
 	trmBrushes[0]->b->primitiveNum = 0;
 	trmBrushes[0]->b->bounds.Clear();
-	trmBrushes[0]->b->checkcount = 0;
+	memset( trmBrushes[0]->b->checkcount, 0, sizeof( trmBrushes[0]->b->checkcount ) );
 	trmBrushes[0]->b->contents = -1;		// all contents
 	trmBrushes[ 0 ]->b->material = trmMaterial;
 	trmBrushes[0]->b->numPlanes = 0;
@@ -916,7 +926,7 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel& trm,
 	for( i = 0; i < trm.numVerts; i++, vertex++, trmVert++ )
 	{
 		vertex->p = *trmVert;
-		vertex->sideSet = 0;
+		memset( vertex->cache, 0, sizeof( vertex->cache ) );
 	}
 	// edges
 	model->numEdges = trm.numEdges;
@@ -928,7 +938,7 @@ cmHandle_t idCollisionModelManagerLocal::SetupTrmModel( const idTraceModel& trm,
 		edge->vertexNum[1] = trmEdge->v[1];
 		edge->normal = trmEdge->normal;
 		edge->internal = false;
-		edge->sideSet = 0;
+		memset( edge->cache, 0, sizeof( edge->cache ) );
 	}
 	// polygons
 	model->numPolygons = trm.numPolys;
@@ -1266,11 +1276,11 @@ void idCollisionModelManagerLocal::R_ChopWindingListWithTreeBrushes( cm_windingL
 		{
 			b = bref->b;
 			// if we checked this brush already
-			if( b->checkcount == checkCount )
+			if( b->checkcount[0] == traceContexts[0].checkCount )
 			{
 				continue;
 			}
-			b->checkcount = checkCount;
+			b->checkcount[0] = traceContexts[0].checkCount;
 			// if the windings in the list originate from this brush
 			if( b->primitiveNum == list->primitiveNum )
 			{
@@ -1362,7 +1372,7 @@ idFixedWinding* idCollisionModelManagerLocal::WindingOutsideBrushes( idFixedWind
 	cm_windingList->contents = contents;
 	cm_windingList->primitiveNum = primitiveNum;
 	//
-	checkCount++;
+	traceContexts[0].checkCount++;
 	R_ChopWindingListWithTreeBrushes( cm_windingList, headNode );
 	//
 	if( !cm_windingList->numWindings )
@@ -1675,7 +1685,7 @@ cm_polygon_t* idCollisionModelManagerLocal::TryMergePolygons( cm_model_t* model,
 	memcpy( newp, p1, sizeof( cm_polygon_t ) );
 	memcpy( newp->edges, newEdges, newNumEdges * sizeof( int ) );
 	newp->numEdges = newNumEdges;
-	newp->checkcount = 0;
+	memset( newp->checkcount, 0, sizeof( newp->checkcount ) );
 	// increase usage count for the edges of this polygon
 	for( i = 0; i < newp->numEdges; i++ )
 	{
@@ -1787,11 +1797,11 @@ void idCollisionModelManagerLocal::MergeTreePolygons( cm_model_t* model, cm_node
 			{
 				p = pref->p;
 				// if we checked this polygon already
-				if( p->checkcount == checkCount )
+				if( p->checkcount[0] == traceContexts[0].checkCount )
 				{
 					continue;
 				}
-				p->checkcount = checkCount;
+				p->checkcount[0] = traceContexts[0].checkCount;
 				// try to merge this polygon with other polygons in the tree
 				if( MergePolygonWithTreePolygons( model, model->node, p ) )
 				{
@@ -2087,11 +2097,11 @@ void idCollisionModelManagerLocal::FindInternalEdges( cm_model_t* model, cm_node
 		{
 			p = pref->p;
 			// if we checked this polygon already
-			if( p->checkcount == checkCount )
+			if( p->checkcount[0] == traceContexts[0].checkCount )
 			{
 				continue;
 			}
-			p->checkcount = checkCount;
+			p->checkcount[0] = traceContexts[0].checkCount;
 			
 			FindInternalPolygonEdges( model, model->node, p );
 			
@@ -2677,7 +2687,7 @@ int idCollisionModelManagerLocal::GetVertex( cm_model_t* model, const idVec3& v,
 		cm_vertexHash->ResizeIndex( model->maxVertices );
 	}
 	model->vertices[model->numVertices].p = vert;
-	model->vertices[model->numVertices].checkcount = 0;
+	memset( model->vertices[model->numVertices].cache, 0, sizeof( model->vertices[model->numVertices].cache ) );
 	*vertexNum = model->numVertices;
 	// add vertice to hash
 	cm_vertexHash->Add( hashKey, model->numVertices );
@@ -2772,7 +2782,7 @@ int idCollisionModelManagerLocal::GetEdge( cm_model_t* model, const idVec3& v1,
 	model->edges[model->numEdges].vertexNum[0] = v1num;
 	model->edges[model->numEdges].vertexNum[1] = v2num;
 	model->edges[model->numEdges].internal = false;
-	model->edges[model->numEdges].checkcount = 0;
+	memset( model->edges[model->numEdges].cache, 0, sizeof( model->edges[model->numEdges].cache ) );
 	model->edges[model->numEdges].numUsers = 1; // used by one polygon atm
 	model->edges[model->numEdges].normal.Zero();
 	//
@@ -2844,7 +2854,7 @@ void idCollisionModelManagerLocal::CreatePolygon( cm_model_t* model, idFixedWind
 	p->numEdges = numPolyEdges;
 	p->contents = material->GetContentFlags();
 	p->material = material;
-	p->checkcount = 0;
+	memset( p->checkcount, 0, sizeof( p->checkcount ) );
 	p->plane = plane;
 	p->bounds = bounds;
 	for( i = 0; i < numPolyEdges; i++ )
@@ -3146,7 +3156,7 @@ void idCollisionModelManagerLocal::ConvertBrush( cm_model_t* model, const idMapB
 	}
 	// create brush for position test
 	brush = AllocBrush( model, mapBrush->GetNumSides() );
-	brush->checkcount = 0;
+	memset( brush->checkcount, 0, sizeof( brush->checkcount ) );
 	brush->contents = contents;
 	brush->material = material;
 	brush->primitiveNum = primitiveNum;
@@ -3272,11 +3282,11 @@ void idCollisionModelManagerLocal::RemapEdges( cm_node_t* node, int* edgeRemap )
 		{
 			p = pref->p;
 			// if we checked this polygon already
-			if( p->checkcount == checkCount )
+			if( p->checkcount[0] == traceContexts[0].checkCount )
 			{
 				continue;
 			}
-			p->checkcount = checkCount;
+			p->checkcount[0] = traceContexts[0].checkCount;
 			for( i = 0; i < p->numEdges; i++ )
 			{
 				if( p->edges[i] < 0 )
@@ -3354,7 +3364,7 @@ void idCollisionModelManagerLocal::OptimizeArrays( cm_model_t* model )
 		}
 	}
 	// change polygon edge indexes
-	checkCount++;
+	traceContexts[0].checkCount++;
 	RemapEdges( model->node, remap );
 	model->numEdges = newNumEdges;
 	
@@ -3389,13 +3399,13 @@ idCollisionModelManagerLocal::FinishModel
 void idCollisionModelManagerLocal::FinishModel( cm_model_t* model )
 {
 	// try to merge polygons
-	checkCount++;
+	traceContexts[0].checkCount++;
 	MergeTreePolygons( model, model->node );
 	// find internal edges (no mesh can ever collide with internal edges)
-	checkCount++;
+	traceContexts[0].checkCount++;
 	FindInternalEdges( model, model->node );
 	// calculate edge normals
-	checkCount++;
+	traceContexts[0].checkCount++;
 	CalculateEdgeNormals( model, model->node );
 	
 	//common->Printf( "%s vertex hash spread is %d\n", model->name.c_str(), cm_vertexHash->GetSpread() );
@@ -3417,7 +3427,7 @@ void idCollisionModelManagerLocal::FinishModel( cm_model_t* model )
 						model->numBrushRefs * sizeof( cm_brushRef_t );
 }
 
-static const byte BCM_VERSION = 100;
+static const byte BCM_VERSION = 101;
 static const unsigned int BCM_MAGIC = ( 'B' << 24 ) | ( 'C' << 16 ) | ( 'M' << 16 ) | BCM_VERSION;
 
 /*
@@ -3466,20 +3476,20 @@ cm_model_t* idCollisionModelManagerLocal::LoadBinaryModelFromFile( idFile* file,
 	for( int i = 0; i < model->numVertices; i++ )
 	{
 		file->ReadBig( model->vertices[i].p );
-		file->ReadBig( model->vertices[i].checkcount );
-		file->ReadBig( model->vertices[i].side );
-		file->ReadBig( model->vertices[i].sideSet );
+		file->ReadBig( model->vertices[i].cache[0].checkcount );
+		file->ReadBig( model->vertices[i].cache[0].side );
+		file->ReadBig( model->vertices[i].cache[0].sideSet );
 	}
 	
 	model->maxEdges = model->numEdges;
 	model->edges = ( cm_edge_t* ) Mem_ClearedAlloc( model->maxEdges * sizeof( cm_edge_t ), TAG_COLLISION );
 	for( int i = 0; i < model->numEdges; i++ )
 	{
-		file->ReadBig( model->edges[i].checkcount );
+		file->ReadBig( model->edges[i].cache[0].checkcount );
 		file->ReadBig( model->edges[i].internal );
 		file->ReadBig( model->edges[i].numUsers );
-		file->ReadBig( model->edges[i].side );
-		file->ReadBig( model->edges[i].sideSet );
+		file->ReadBig( model->edges[i].cache[0].side );
+		file->ReadBig( model->edges[i].cache[0].sideSet );
 		file->ReadBig( model->edges[i].vertexNum[0] );
 		file->ReadBig( model->edges[i].vertexNum[1] );
 		file->ReadBig( model->edges[i].normal );
@@ -3527,7 +3537,7 @@ cm_model_t* idCollisionModelManagerLocal::LoadBinaryModelFromFile( idFile* file,
 		polys[i]->numEdges = numEdges;
 		polys[i]->material = materials[materialIndex];
 		file->ReadBig( polys[i]->bounds );
-		file->ReadBig( polys[i]->checkcount );
+		file->ReadBig( polys[i]->checkcount[0] );
 		file->ReadBig( polys[i]->contents );
 		file->ReadBig( polys[i]->plane );
 		file->ReadBigArray( polys[i]->edges, polys[i]->numEdges );
@@ -3541,7 +3551,7 @@ cm_model_t* idCollisionModelManagerLocal::LoadBinaryModelFromFile( idFile* file,
 		brushes[i] = AllocBrush( model, numPlanes );
 		brushes[i]->numPlanes = numPlanes;
 		brushes[i]->material = materials[materialIndex];
-		file->ReadBig( brushes[i]->checkcount );
+		file->ReadBig( brushes[i]->checkcount[0] );
 		file->ReadBig( brushes[i]->bounds );
 		file->ReadBig( brushes[i]->contents );
 		file->ReadBig( brushes[i]->primitiveNum );
@@ -3647,17 +3657,17 @@ void idCollisionModelManagerLocal::WriteBinaryModelToFile( cm_model_t* model, id
 	for( int i = 0; i < model->numVertices; i++ )
 	{
 		file->WriteBig( model->vertices[i].p );
-		file->WriteBig( model->vertices[i].checkcount );
-		file->WriteBig( model->vertices[i].side );
-		file->WriteBig( model->vertices[i].sideSet );
+		file->WriteBig( model->vertices[i].cache[0].checkcount );
+		file->WriteBig( model->vertices[i].cache[0].side );
+		file->WriteBig( model->vertices[i].cache[0].sideSet );
 	}
 	for( int i = 0; i < model->numEdges; i++ )
 	{
-		file->WriteBig( model->edges[i].checkcount );
+		file->WriteBig( model->edges[i].cache[0].checkcount );
 		file->WriteBig( model->edges[i].internal );
 		file->WriteBig( model->edges[i].numUsers );
-		file->WriteBig( model->edges[i].side );
-		file->WriteBig( model->edges[i].sideSet );
+		file->WriteBig( model->edges[i].cache[0].side );
+		file->WriteBig( model->edges[i].cache[0].sideSet );
 		file->WriteBig( model->edges[i].vertexNum[0] );
 		file->WriteBig( model->edges[i].vertexNum[1] );
 		file->WriteBig( model->edges[i].normal );
@@ -3735,7 +3745,7 @@ void idCollisionModelManagerLocal::WriteBinaryModelToFile( cm_model_t* model, id
 		file->WriteBig( ( int )materials.FindIndex( polys[i]->material ) );
 		file->WriteBig( polys[i]->numEdges );
 		file->WriteBig( polys[i]->bounds );
-		file->WriteBig( polys[i]->checkcount );
+		file->WriteBig( polys[i]->checkcount[0] );
 		file->WriteBig( polys[i]->contents );
 		file->WriteBig( polys[i]->plane );
 		file->WriteBigArray( polys[i]->edges, polys[i]->numEdges );
@@ -3744,7 +3754,7 @@ void idCollisionModelManagerLocal::WriteBinaryModelToFile( cm_model_t* model, id
 	{
 		file->WriteBig( ( int )materials.FindIndex( brushes[i]->material ) );
 		file->WriteBig( brushes[i]->numPlanes );
-		file->WriteBig( brushes[i]->checkcount );
+		file->WriteBig( brushes[i]->checkcount[0] );
 		file->WriteBig( brushes[i]->bounds );
 		file->WriteBig( brushes[i]->contents );
 		file->WriteBig( brushes[i]->primitiveNum );
@@ -4521,12 +4531,12 @@ bool idCollisionModelManagerLocal::TrmFromModel_r( idTraceModel& trm, cm_node_t*
 		{
 			p = pref->p;
 			
-			if( p->checkcount == checkCount )
+			if( p->checkcount[0] == traceContexts[0].checkCount )
 			{
 				continue;
 			}
 			
-			p->checkcount = checkCount;
+			p->checkcount[0] = traceContexts[0].checkCount;
 			
 			if( trm.numPolys >= MAX_TRACEMODEL_POLYS )
 			{
@@ -4591,7 +4601,7 @@ bool idCollisionModelManagerLocal::TrmFromModel( const cm_model_t* model, idTrac
 	trm.bounds.Clear();
 	
 	// copy polygons
-	checkCount++;
+	traceContexts[0].checkCount++;
 	if( !TrmFromModel_r( trm, model->node ) )
 	{
 		common->Printf( "idCollisionModelManagerLocal::TrmFromModel: model %s has too many polygons.\n", model->name.c_str() );
@@ -79,25 +79,29 @@ Collision model
 ===============================================================================
 */
 
-typedef struct cm_vertex_s
+#define CM_MAX_TRACE_CONTEXTS		4			// number of traces that can run concurrently, context 0 belongs to the main thread
+
+// per trace context state stored with model vertices and edges
+typedef struct cm_traceCache_s
 {
-	idVec3					p;					// vertex point
 	int						checkcount;			// for multi-check avoidance
 	// DG: use int instead of long for 64bit compatibility
-	unsigned int			side;				// each bit tells at which side this vertex passes one of the trace model edges
-	unsigned int			sideSet;			// each bit tells if sidedness for the trace model edge has been calculated yet
+	unsigned int			side;				// each bit tells at which side the feature passes one of the trace model features
+	unsigned int			sideSet;			// each bit tells if sidedness for the trace model feature has been calculated yet
 	// DG end
+} cm_traceCache_t;
+
+typedef struct cm_vertex_s
+{
+	idVec3					p;					// vertex point
+	cm_traceCache_t			cache[CM_MAX_TRACE_CONTEXTS];	// side tells at which side this vertex passes one of the trace model edges
 } cm_vertex_t;
 
 typedef struct cm_edge_s
 {
-	int						checkcount;			// for multi-check avoidance
 	unsigned short			internal;			// a trace model can never collide with internal edges
 	unsigned short			numUsers;			// number of polygons using this edge
-	// DG: use int instead of long for 64bit compatibility
-	unsigned int			side;				// each bit tells at which side of this edge one of the trace model vertices passes
-	unsigned int			sideSet;			// each bit tells if sidedness for the trace model vertex has been calculated yet
-	// DG end
+	cm_traceCache_t			cache[CM_MAX_TRACE_CONTEXTS];	// side tells at which side of this edge one of the trace model vertices passes
 	int						vertexNum[2];		// start and end point of edge
 	idVec3					normal;				// edge normal
 } cm_edge_t;
@@ -111,7 +115,7 @@ typedef struct cm_polygonBlock_s
 typedef struct cm_polygon_s
 {
 	idBounds				bounds;				// polygon bounds
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount[CM_MAX_TRACE_CONTEXTS];	// for multi-check avoidance
 	int						contents;			// contents behind polygon
 	const idMaterial* 		material;			// material
 	idPlane					plane;				// polygon plane
@@ -141,13 +145,13 @@ typedef struct cm_brush_s
 {
 	cm_brush_s()
 	{
-		checkcount = 0;
+		memset( checkcount, 0, sizeof( checkcount ) );
 		contents = 0;
 		material = NULL;
 		primitiveNum = 0;
 		numPlanes = 0;
 	}
-	int						checkcount;			// for multi-check avoidance
+	int						checkcount[CM_MAX_TRACE_CONTEXTS];	// for multi-check avoidance
 	idBounds				bounds;				// brush bounds
 	int						contents;			// contents of brush
 	const idMaterial* 		material;			// material
@@ -298,6 +302,9 @@ typedef struct cm_traceWork_s
 	int maxContacts;								// max size of contact array
 	int numContacts;								// number of contacts found
 	
+	int contextNum;									// trace context, selects the vertex, edge, polygon and brush check counts
+	int checkCount;									// for multi-check avoidance
+	
 	idPlane heartPlane1;							// polygons should be near anough the trace heart planes
 	float maxDistFromHeartPlane1;
 	idPlane heartPlane2;
@@ -307,6 +314,18 @@ typedef struct cm_traceWork_s
 	idVec3 polygonRotationOriginCache[CM_MAX_POLYGON_EDGES];
 } cm_traceWork_t;
 
+typedef struct cm_traceContext_s
+{
+	int contextNum;									// index into the per context check counts
+	int checkCount;									// for multi-check avoidance
+	ALIGN16( cm_traceWork_t tw );					// trace work for translations and rotations
+	// for retrieving contact points
+	bool getContacts;
+	contactInfo_t* contacts;
+	int maxContacts;
+	int numContacts;
+} cm_traceContext_t;
+
 /*
 ===============================================================================
 
@@ -366,6 +385,10 @@ public:
 	int				Contacts( contactInfo_t* contacts, const int maxContacts, const idVec3& start, const idVec6& dir, const float depth,
 							  const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 							  cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis );
+	// runs a batch of independent trace requests spread over the job system
+	void			TraceBatch( cmTraceRequest_t* requests, const int numRequests );
+	// runs trace requests with the given trace context, used by the batch jobs
+	void			TraceRequests( cm_traceContext_t* context, cmTraceRequest_t* requests, const int numRequests );
 	// test collision detection
 	void			DebugOutput( const idVec3& origin );
 	// draw a model
@@ -379,6 +402,9 @@ public:
 	bool			WriteCollisionModelForMapEntity( const idMapEntity* mapEnt, const char* filename, const bool testTraceModel = true );
 	
 private:			// CollisionMap_translate.cpp
+	void			Translation( cm_traceContext_t* context, trace_t* results, const idVec3& start, const idVec3& end,
+								 const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
+								 cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis );
 	int				TranslateEdgeThroughEdge( idVec3& cross, idPluecker& l1, idPluecker& l2, float* fraction );
 	void			TranslateTrmEdgeThroughPolygon( cm_traceWork_t* tw, cm_polygon_t* poly, cm_trmEdge_t* trmEdge );
 	void			TranslateTrmVertexThroughPolygon( cm_traceWork_t* tw, cm_polygon_t* poly, cm_trmVertex_t* v, int bitNum );
@@ -411,7 +437,10 @@ private:			// CollisionMap_rotate.cpp
 			cm_vertex_t* v, idVec3& rotationOrigin );
 	bool			RotateTrmThroughPolygon( cm_traceWork_t* tw, cm_polygon_t* p );
 	void			BoundsForRotation( const idVec3& origin, const idVec3& axis, const idVec3& start, const idVec3& end, idBounds& bounds );
-	void			Rotation180( trace_t* results, const idVec3& rorg, const idVec3& axis,
+	void			Rotation( cm_traceContext_t* context, trace_t* results, const idVec3& start, const idRotation& rotation,
+							  const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
+							  cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis );
+	void			Rotation180( cm_traceContext_t* context, trace_t* results, const idVec3& rorg, const idVec3& axis,
 								 const float startAngle, const float endAngle, const idVec3& start,
 								 const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 								 cmHandle_t model, const idVec3& origin, const idMat3& modelAxis );
@@ -422,7 +451,10 @@ private:			// CollisionMap_contents.cpp
 	cm_node_t* 		PointNode( const idVec3& p, cm_model_t* model );
 	int				PointContents( const idVec3 p, cmHandle_t model );
 	int				TransformedPointContents( const idVec3& p, cmHandle_t model, const idVec3& origin, const idMat3& modelAxis );
-	int				ContentsTrm( trace_t* results, const idVec3& start,
+	int				Contents( cm_traceContext_t* context, const idVec3& start,
+							  const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
+							  cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis );
+	int				ContentsTrm( cm_traceContext_t* context, trace_t* results, const idVec3& start,
 								 const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 								 cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis );
 								 
@@ -540,8 +572,8 @@ private:			// collision map data
 	idStr			mapName;
 	ID_TIME_T			mapFileTime;
 	int				loaded;
-	// for multi-check avoidance
-	int				checkCount;
+	// one trace context per concurrently running trace
+	cm_traceContext_t traceContexts[CM_MAX_TRACE_CONTEXTS];
 	// models
 	int				maxModels;
 	int				numModels;
@@ -553,12 +585,11 @@ private:			// collision map data
 	// for data pruning
 	int				numProcNodes;
 	cm_procNode_t* 	procNodes;
-	// for retrieving contact points
-	bool			getContacts;
-	contactInfo_t* 	contacts;
-	int				maxContacts;
-	int				numContacts;
+	// for batched traces
+	idParallelJobList* traceJobList;
 };
 
 // for debugging
 extern idCVar cm_debugCollision;
+
+extern idCollisionModelManagerLocal collisionModelManagerLocal;
@@ -555,7 +555,7 @@ void idCollisionModelManagerLocal::RotateTrmEdgeThroughPolygon( cm_traceWork_t*
 		edge = tw->model->edges + abs( edgeNum );
 		
 		// if this edge is already checked
-		if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+		if( edge->cache[tw->contextNum].checkcount == tw->checkCount )
 		{
 			continue;
 		}
@@ -1194,11 +1194,11 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t* tw,
 	idVec3* rotationOrigin;
 	
 	// if already checked this polygon
-	if( p->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( p->checkcount[tw->contextNum] == tw->checkCount )
 	{
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	p->checkcount[tw->contextNum] = tw->checkCount;
 	
 	// if this polygon does not have the right contents behind it
 	if( !( p->contents & tw->contents ) )
@@ -1312,12 +1312,12 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t* tw,
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs( edgeNum );
 			
-			if( e->checkcount == idCollisionModelManagerLocal::checkCount )
+			if( e->cache[tw->contextNum].checkcount == tw->checkCount )
 			{
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			e->cache[tw->contextNum].checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if( e->internal )
 			{
@@ -1330,12 +1330,12 @@ bool idCollisionModelManagerLocal::RotateTrmThroughPolygon( cm_traceWork_t* tw,
 				v = tw->model->vertices + e->vertexNum[k ^ INT32_SIGNBITSET( edgeNum )];
 				
 				// if this vertex is already checked
-				if( v->checkcount == idCollisionModelManagerLocal::checkCount )
+				if( v->cache[tw->contextNum].checkcount == tw->checkCount )
 				{
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				v->cache[tw->contextNum].checkcount = tw->checkCount;
 				
 				// if the vertex is outside the trm rotation bounds
 				if( !tw->bounds.ContainsPoint( v->p ) )
@@ -1414,7 +1414,7 @@ void idCollisionModelManagerLocal::BoundsForRotation( const idVec3& origin, cons
 idCollisionModelManagerLocal::Rotation180
 ================
 */
-void idCollisionModelManagerLocal::Rotation180( trace_t* results, const idVec3& rorg, const idVec3& axis,
+void idCollisionModelManagerLocal::Rotation180( cm_traceContext_t* context, trace_t* results, const idVec3& rorg, const idVec3& axis,
 		const float startAngle, const float endAngle, const idVec3& start,
 		const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 		cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis )
@@ -1429,7 +1429,7 @@ void idCollisionModelManagerLocal::Rotation180( trace_t* results, const idVec3&
 	cm_trmPolygon_t* poly;
 	cm_trmEdge_t* edge;
 	cm_trmVertex_t* vert;
-	ALIGN16( static cm_traceWork_t tw );
+	cm_traceWork_t& tw = context->tw;
 	
 	if( model < 0 || model > MAX_SUBMODELS || model > idCollisionModelManagerLocal::maxModels )
 	{
@@ -1442,7 +1442,8 @@ void idCollisionModelManagerLocal::Rotation180( trace_t* results, const idVec3&
 		return;
 	}
 	
-	idCollisionModelManagerLocal::checkCount++;
+	tw.contextNum = context->contextNum;
+	tw.checkCount = ++context->checkCount;
 	
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -1834,6 +1835,18 @@ void idCollisionModelManagerLocal::Rotation180( trace_t* results, const idVec3&
 	}
 }
 
+/*
+================
+idCollisionModelManagerLocal::Rotation
+================
+*/
+void idCollisionModelManagerLocal::Rotation( trace_t* results, const idVec3& start, const idRotation& rotation,
+		const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
+		cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis )
+{
+	Rotation( &traceContexts[0], results, start, rotation, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+}
+
 /*
 ================
 idCollisionModelManagerLocal::Rotation
@@ -1843,7 +1856,7 @@ idCollisionModelManagerLocal::Rotation
 static int entered = 0;
 #endif
 
-void idCollisionModelManagerLocal::Rotation( trace_t* results, const idVec3& start, const idRotation& rotation,
+void idCollisionModelManagerLocal::Rotation( cm_traceContext_t* context, trace_t* results, const idVec3& start, const idRotation& rotation,
 		const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 		cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis )
 {
@@ -1858,7 +1871,7 @@ void idCollisionModelManagerLocal::Rotation( trace_t* results, const idVec3& sta
 	// if special position test
 	if( rotation.GetAngle() == 0.0f )
 	{
-		idCollisionModelManagerLocal::ContentsTrm( results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+		idCollisionModelManagerLocal::ContentsTrm( context, results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
 		return;
 	}
 	
@@ -1871,7 +1884,7 @@ void idCollisionModelManagerLocal::Rotation( trace_t* results, const idVec3& sta
 		{
 			entered = 1;
 			// if already messed up to begin with
-			if( idCollisionModelManagerLocal::Contents( start, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask )
+			if( idCollisionModelManagerLocal::Contents( context, start, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask )
 			{
 				startsolid = true;
 			}
@@ -1900,7 +1913,7 @@ void idCollisionModelManagerLocal::Rotation( trace_t* results, const idVec3& sta
 		for( lasta = 0.0f, a = stepa; fabs( a ) < fabs( maxa ) + 1.0f; lasta = a, a += stepa )
 		{
 			// partial rotation
-			idCollisionModelManagerLocal::Rotation180( results, rotation.GetOrigin(), rotation.GetVec(), lasta, a, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+			idCollisionModelManagerLocal::Rotation180( context, results, rotation.GetOrigin(), rotation.GetVec(), lasta, a, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
 			// if there is a collision
 			if( results->fraction < 1.0f )
 			{
@@ -1913,7 +1926,7 @@ void idCollisionModelManagerLocal::Rotation( trace_t* results, const idVec3& sta
 		return;
 	}
 	
-	idCollisionModelManagerLocal::Rotation180( results, rotation.GetOrigin(), rotation.GetVec(), 0.0f, rotation.GetAngle(), start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+	idCollisionModelManagerLocal::Rotation180( context, results, rotation.GetOrigin(), rotation.GetVec(), 0.0f, rotation.GetAngle(), start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
 	
 #ifdef _DEBUG
 	// test for missed collisions
@@ -1923,14 +1936,14 @@ void idCollisionModelManagerLocal::Rotation( trace_t* results, const idVec3& sta
 		{
 			entered = 1;
 			// if the trm is stuck in the model
-			if( idCollisionModelManagerLocal::Contents( results->endpos, trm, results->endAxis, -1, model, modelOrigin, modelAxis ) & contentMask )
+			if( idCollisionModelManagerLocal::Contents( context, results->endpos, trm, results->endAxis, -1, model, modelOrigin, modelAxis ) & contentMask )
 			{
 				trace_t tr;
 				
 				// test where the trm is stuck in the model
-				idCollisionModelManagerLocal::Contents( results->endpos, trm, results->endAxis, -1, model, modelOrigin, modelAxis );
+				idCollisionModelManagerLocal::Contents( context, results->endpos, trm, results->endAxis, -1, model, modelOrigin, modelAxis );
 				// re-run collision detection to find out where it failed
-				idCollisionModelManagerLocal::Rotation( &tr, start, rotation, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+				idCollisionModelManagerLocal::Rotation( context, &tr, start, rotation, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
 			}
 			entered = 0;
 		}
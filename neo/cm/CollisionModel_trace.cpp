@@ -294,3 +294,103 @@ void idCollisionModelManagerLocal::TraceThroughModel( cm_traceWork_t* tw )
 		idCollisionModelManagerLocal::TraceThroughAxialBSPTree_r( tw, tw->model->node, 0, 1, start, tw->end );
 	}
 }
+
+/*
+===============================================================================
+
+Batched traces
+
+===============================================================================
+*/
+
+#define CM_MIN_TRACES_PER_JOB		8			// smaller batches are not worth the job overhead
+
+typedef struct cm_traceJob_s
+{
+	cm_traceContext_t* 		context;
+	cmTraceRequest_t* 		requests;
+	int						numRequests;
+} cm_traceJob_t;
+
+/*
+================
+CM_TraceJob
+================
+*/
+static void CM_TraceJob( cm_traceJob_t* job )
+{
+	collisionModelManagerLocal.TraceRequests( job->context, job->requests, job->numRequests );
+}
+
+REGISTER_PARALLEL_JOB( CM_TraceJob, "CM_TraceJob" );
+
+/*
+================
+idCollisionModelManagerLocal::TraceRequests
+================
+*/
+void idCollisionModelManagerLocal::TraceRequests( cm_traceContext_t* context, cmTraceRequest_t* requests, const int numRequests )
+{
+	for( int i = 0; i < numRequests; i++ )
+	{
+		cmTraceRequest_t& r = requests[i];
+		switch( r.type )
+		{
+			case CM_TRACE_TRANSLATION:
+				Translation( context, &r.results, r.start, r.end, r.trm, r.trmAxis, r.contentMask, r.model, r.modelOrigin, r.modelAxis );
+				r.contents = r.results.c.contents;
+				break;
+			case CM_TRACE_ROTATION:
+				Rotation( context, &r.results, r.start, r.rotation, r.trm, r.trmAxis, r.contentMask, r.model, r.modelOrigin, r.modelAxis );
+				r.contents = r.results.c.contents;
+				break;
+			case CM_TRACE_CONTENTS:
+				r.contents = Contents( context, r.start, r.trm, r.trmAxis, r.contentMask, r.model, r.modelOrigin, r.modelAxis );
+				break;
+		}
+	}
+}
+
+/*
+================
+idCollisionModelManagerLocal::TraceBatch
+
+  Each job gets a contiguous slice of the requests and a trace context of its own,
+  so the check counts and sidedness caches stored with the model geometry never
+  get shared between threads. The caller waits for the jobs, so the context of
+  the calling thread can be handed to one of them. The job list is allocated
+  with the first batch that needs it and kept until the map is freed.
+================
+*/
+void idCollisionModelManagerLocal::TraceBatch( cmTraceRequest_t* requests, const int numRequests )
+{
+	int numJobs = Min( numRequests / CM_MIN_TRACES_PER_JOB, CM_MAX_TRACE_CONTEXTS );
+	numJobs = Min( numJobs, parallelJobManager->GetNumProcessingUnits() + 1 );
+	
+	if( numJobs <= 1 )
+	{
+		TraceRequests( &traceContexts[0], requests, numRequests );
+		return;
+	}
+	
+	if( traceJobList == NULL )
+	{
+		traceJobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, CM_MAX_TRACE_CONTEXTS, 0, NULL );
+	}
+	
+	cm_traceJob_t jobs[CM_MAX_TRACE_CONTEXTS];
+	
+	int first = 0;
+	for( int i = 0; i < numJobs; i++ )
+	{
+		const int last = ( numRequests * ( i + 1 ) ) / numJobs;
+		jobs[i].context = &traceContexts[i];
+		jobs[i].requests = requests + first;
+		jobs[i].numRequests = last - first;
+		traceJobList->AddJob( ( jobRun_t )CM_TraceJob, &jobs[i] );
+		first = last;
+	}
+	
+	traceJobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+	traceJobList->Wait();
+}
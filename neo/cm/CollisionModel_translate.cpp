@@ -206,7 +206,7 @@ CM_SetVertexSidedness
   stores for the given model vertex at which side of one of the trm edges it passes
 ================
 */
-ID_INLINE void CM_SetVertexSidedness( cm_vertex_t* v, const idPluecker& vpl, const idPluecker& epl, const int bitNum )
+ID_INLINE void CM_SetVertexSidedness( cm_traceCache_t* v, const idPluecker& vpl, const idPluecker& epl, const int bitNum )
 {
 	const int mask = 1 << bitNum;
 	if( ( v->sideSet & mask ) == 0 )
@@ -224,7 +224,7 @@ CM_SetEdgeSidedness
   stores for the given model edge at which side one of the trm vertices
 ================
 */
-ID_INLINE void CM_SetEdgeSidedness( cm_edge_t* edge, const idPluecker& vpl, const idPluecker& epl, const int bitNum )
+ID_INLINE void CM_SetEdgeSidedness( cm_traceCache_t* edge, const idPluecker& vpl, const idPluecker& epl, const int bitNum )
 {
 	const int mask = 1 << bitNum;
 	if( ( edge->sideSet & mask ) == 0 )
@@ -255,7 +255,7 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 		edgeNum = poly->edges[i];
 		edge = tw->model->edges + abs( edgeNum );
 		// if this edge is already checked
-		if( edge->checkcount == idCollisionModelManagerLocal::checkCount )
+		if( edge->cache[tw->contextNum].checkcount == tw->checkCount )
 		{
 			continue;
 		}
@@ -266,20 +266,20 @@ void idCollisionModelManagerLocal::TranslateTrmEdgeThroughPolygon( cm_traceWork_
 		}
 		pl = &tw->polygonEdgePlueckerCache[i];
 		// get the sides at which the trm edge vertices pass the polygon edge
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
-		CM_SetEdgeSidedness( edge, *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
+		CM_SetEdgeSidedness( &edge->cache[tw->contextNum], *pl, tw->vertices[trmEdge->vertexNum[0]].pl, trmEdge->vertexNum[0] );
+		CM_SetEdgeSidedness( &edge->cache[tw->contextNum], *pl, tw->vertices[trmEdge->vertexNum[1]].pl, trmEdge->vertexNum[1] );
 		// if the trm edge start and end vertex do not pass the polygon edge at different sides
-		if( !( ( ( edge->side >> trmEdge->vertexNum[0] ) ^ ( edge->side >> trmEdge->vertexNum[1] ) ) & 1 ) )
+		if( !( ( ( edge->cache[tw->contextNum].side >> trmEdge->vertexNum[0] ) ^ ( edge->cache[tw->contextNum].side >> trmEdge->vertexNum[1] ) ) & 1 ) )
 		{
 			continue;
 		}
 		// get the sides at which the polygon edge vertices pass the trm edge
 		v1 = tw->model->vertices + edge->vertexNum[INT32_SIGNBITSET( edgeNum )];
-		CM_SetVertexSidedness( v1, tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum );
+		CM_SetVertexSidedness( &v1->cache[tw->contextNum], tw->polygonVertexPlueckerCache[i], trmEdge->pl, trmEdge->bitNum );
 		v2 = tw->model->vertices + edge->vertexNum[INT32_SIGNBITNOTSET( edgeNum )];
-		CM_SetVertexSidedness( v2, tw->polygonVertexPlueckerCache[i + 1], trmEdge->pl, trmEdge->bitNum );
+		CM_SetVertexSidedness( &v2->cache[tw->contextNum], tw->polygonVertexPlueckerCache[i + 1], trmEdge->pl, trmEdge->bitNum );
 		// if the polygon edge start and end vertex do not pass the trm edge at different sides
-		if( !( ( v1->side ^ v2->side ) & ( 1 << trmEdge->bitNum ) ) )
+		if( !( ( v1->cache[tw->contextNum].side ^ v2->cache[tw->contextNum].side ) & ( 1 << trmEdge->bitNum ) ) )
 		{
 			continue;
 		}
@@ -400,8 +400,8 @@ void idCollisionModelManagerLocal::TranslateTrmVertexThroughPolygon( cm_traceWor
 		{
 			edgeNum = poly->edges[i];
 			edge = tw->model->edges + abs( edgeNum );
-			CM_SetEdgeSidedness( edge, tw->polygonEdgePlueckerCache[i], v->pl, bitNum );
-			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( edge->side >> bitNum ) & 1 ) )
+			CM_SetEdgeSidedness( &edge->cache[tw->contextNum], tw->polygonEdgePlueckerCache[i], v->pl, bitNum );
+			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( edge->cache[tw->contextNum].side >> bitNum ) & 1 ) )
 			{
 				return;
 			}
@@ -451,17 +451,17 @@ void idCollisionModelManagerLocal::TranslatePointThroughPolygon( cm_traceWork_t*
 			edgeNum = poly->edges[i];
 			edge = tw->model->edges + abs( edgeNum );
 			// if we didn't yet calculate the sidedness for this edge
-			if( edge->checkcount != idCollisionModelManagerLocal::checkCount )
+			if( edge->cache[tw->contextNum].checkcount != tw->checkCount )
 			{
 				float fl;
-				edge->checkcount = idCollisionModelManagerLocal::checkCount;
+				edge->cache[tw->contextNum].checkcount = tw->checkCount;
 				pl.FromLine( tw->model->vertices[edge->vertexNum[0]].p, tw->model->vertices[edge->vertexNum[1]].p );
 				fl = v->pl.PermutedInnerProduct( pl );
-				edge->side = ( fl < 0.0f );
+				edge->cache[tw->contextNum].side = ( fl < 0.0f );
 			}
 			// if the point passes the edge at the wrong side
-			//if ( (edgeNum > 0) == edge->side ) {
-			if( INT32_SIGNBITSET( edgeNum ) ^ edge->side )
+			//if ( (edgeNum > 0) == edge->cache[tw->contextNum].side ) {
+			if( INT32_SIGNBITSET( edgeNum ) ^ edge->cache[tw->contextNum].side )
 			{
 				return;
 			}
@@ -510,8 +510,8 @@ void idCollisionModelManagerLocal::TranslateVertexThroughTrmPolygon( cm_traceWor
 			edgeNum = trmpoly->edges[i];
 			edge = tw->edges + abs( edgeNum );
 			
-			CM_SetVertexSidedness( v, pl, edge->pl, edge->bitNum );
-			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( v->side >> edge->bitNum ) & 1 ) )
+			CM_SetVertexSidedness( &v->cache[tw->contextNum], pl, edge->pl, edge->bitNum );
+			if( INT32_SIGNBITSET( edgeNum ) ^ ( ( v->cache[tw->contextNum].side >> edge->bitNum ) & 1 ) )
 			{
 				return;
 			}
@@ -558,11 +558,11 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 	cm_edge_t* e;
 	
 	// if already checked this polygon
-	if( p->checkcount == idCollisionModelManagerLocal::checkCount )
+	if( p->checkcount[tw->contextNum] == tw->checkCount )
 	{
 		return false;
 	}
-	p->checkcount = idCollisionModelManagerLocal::checkCount;
+	p->checkcount[tw->contextNum] = tw->checkCount;
 	
 	// if this polygon does not have the right contents behind it
 	if( !( p->contents & tw->contents ) )
@@ -626,9 +626,9 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs( edgeNum );
 			// reset sidedness cache if this is the first time we encounter this edge during this trace
-			if( e->checkcount != idCollisionModelManagerLocal::checkCount )
+			if( e->cache[tw->contextNum].checkcount != tw->checkCount )
 			{
-				e->sideSet = 0;
+				e->cache[tw->contextNum].sideSet = 0;
 			}
 			// pluecker coordinate for edge
 			tw->polygonEdgePlueckerCache[i].FromLine( tw->model->vertices[e->vertexNum[0]].p,
@@ -636,9 +636,9 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 					
 			v = &tw->model->vertices[e->vertexNum[INT32_SIGNBITSET( edgeNum )]];
 			// reset sidedness cache if this is the first time we encounter this vertex during this trace
-			if( v->checkcount != idCollisionModelManagerLocal::checkCount )
+			if( v->cache[tw->contextNum].checkcount != tw->checkCount )
 			{
-				v->sideSet = 0;
+				v->cache[tw->contextNum].sideSet = 0;
 			}
 			// pluecker coordinate for vertex movement vector
 			tw->polygonVertexPlueckerCache[i].FromRay( v->p, -tw->dir );
@@ -672,12 +672,12 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 			edgeNum = p->edges[i];
 			e = tw->model->edges + abs( edgeNum );
 			
-			if( e->checkcount == idCollisionModelManagerLocal::checkCount )
+			if( e->cache[tw->contextNum].checkcount == tw->checkCount )
 			{
 				continue;
 			}
 			// set edge check count
-			e->checkcount = idCollisionModelManagerLocal::checkCount;
+			e->cache[tw->contextNum].checkcount = tw->checkCount;
 			// can never collide with internal edges
 			if( e->internal )
 			{
@@ -689,12 +689,12 @@ bool idCollisionModelManagerLocal::TranslateTrmThroughPolygon( cm_traceWork_t* t
 			
 				v = tw->model->vertices + e->vertexNum[k ^ INT32_SIGNBITSET( edgeNum )];
 				// if this vertex is already checked
-				if( v->checkcount == idCollisionModelManagerLocal::checkCount )
+				if( v->cache[tw->contextNum].checkcount == tw->checkCount )
 				{
 					continue;
 				}
 				// set vertex check count
-				v->checkcount = idCollisionModelManagerLocal::checkCount;
+				v->cache[tw->contextNum].checkcount = tw->checkCount;
 				
 				// if the vertex is outside the trace bounds
 				if( !tw->bounds.ContainsPoint( v->p ) )
@@ -802,6 +802,18 @@ void idCollisionModelManagerLocal::SetupTranslationHeartPlanes( cm_traceWork_t*
 	tw->heartPlane2.FitThroughPoint( tw->start );
 }
 
+/*
+================
+idCollisionModelManagerLocal::Translation
+================
+*/
+void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3& start, const idVec3& end,
+		const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
+		cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis )
+{
+	Translation( &traceContexts[0], results, start, end, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+}
+
 /*
 ================
 idCollisionModelManagerLocal::Translation
@@ -811,7 +823,7 @@ idCollisionModelManagerLocal::Translation
 static int entered = 0;
 #endif
 
-void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3& start, const idVec3& end,
+void idCollisionModelManagerLocal::Translation( cm_traceContext_t* context, trace_t* results, const idVec3& start, const idVec3& end,
 		const idTraceModel* trm, const idMat3& trmAxis, int contentMask,
 		cmHandle_t model, const idVec3& modelOrigin, const idMat3& modelAxis )
 {
@@ -824,7 +836,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	cm_trmPolygon_t* poly;
 	cm_trmEdge_t* edge;
 	cm_trmVertex_t* vert;
-	ALIGN16( static cm_traceWork_t tw );
+	cm_traceWork_t& tw = context->tw;
 	
 	assert( ( ( byte* )&start ) < ( ( byte* )results ) || ( ( byte* )&start ) >= ( ( ( byte* )results ) + sizeof( trace_t ) ) );
 	assert( ( ( byte* )&end ) < ( ( byte* )results ) || ( ( byte* )&end ) >= ( ( ( byte* )results ) + sizeof( trace_t ) ) );
@@ -846,7 +858,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	// if case special position test
 	if( start[0] == end[0] && start[1] == end[1] && start[2] == end[2] )
 	{
-		idCollisionModelManagerLocal::ContentsTrm( results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+		idCollisionModelManagerLocal::ContentsTrm( context, results, start, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
 		return;
 	}
 	
@@ -855,11 +867,11 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	// test whether or not stuck to begin with
 	if( cm_debugCollision.GetBool() )
 	{
-		if( !entered && !idCollisionModelManagerLocal::getContacts )
+		if( !entered && !context->getContacts )
 		{
 			entered = 1;
 			// if already messed up to begin with
-			if( idCollisionModelManagerLocal::Contents( start, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask )
+			if( idCollisionModelManagerLocal::Contents( context, start, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask )
 			{
 				startsolid = true;
 			}
@@ -868,7 +880,8 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	}
 #endif
 	
-	idCollisionModelManagerLocal::checkCount++;
+	tw.contextNum = context->contextNum;
+	tw.checkCount = ++context->checkCount;
 	
 	tw.trace.fraction = 1.0f;
 	tw.trace.c.contents = 0;
@@ -878,9 +891,9 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	tw.rotation = false;
 	tw.positionTest = false;
 	tw.quickExit = false;
-	tw.getContacts = idCollisionModelManagerLocal::getContacts;
-	tw.contacts = idCollisionModelManagerLocal::contacts;
-	tw.maxContacts = idCollisionModelManagerLocal::maxContacts;
+	tw.getContacts = context->getContacts;
+	tw.contacts = context->contacts;
+	tw.maxContacts = context->maxContacts;
 	tw.numContacts = 0;
 	tw.model = idCollisionModelManagerLocal::models[model];
 	tw.start = start - modelOrigin;
@@ -953,7 +966,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 			results->c.point += modelOrigin;
 			results->c.dist += modelOrigin * results->c.normal;
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		context->numContacts = tw.numContacts;
 		return;
 	}
 	
@@ -1184,7 +1197,7 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 				tw.contacts[i].dist += modelOrigin * tw.contacts[i].normal;
 			}
 		}
-		idCollisionModelManagerLocal::numContacts = tw.numContacts;
+		context->numContacts = tw.numContacts;
 	}
 	else
 	{
@@ -1215,18 +1228,18 @@ void idCollisionModelManagerLocal::Translation( trace_t* results, const idVec3&
 	// test for missed collisions
 	if( cm_debugCollision.GetBool() )
 	{
-		if( !entered && !idCollisionModelManagerLocal::getContacts )
+		if( !entered && !context->getContacts )
 		{
 			entered = 1;
 			// if the trm is stuck in the model
-			if( idCollisionModelManagerLocal::Contents( results->endpos, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask )
+			if( idCollisionModelManagerLocal::Contents( context, results->endpos, trm, trmAxis, -1, model, modelOrigin, modelAxis ) & contentMask )
 			{
 				trace_t tr;
 				
 				// test where the trm is stuck in the model
-				idCollisionModelManagerLocal::Contents( results->endpos, trm, trmAxis, -1, model, modelOrigin, modelAxis );
+				idCollisionModelManagerLocal::Contents( context, results->endpos, trm, trmAxis, -1, model, modelOrigin, modelAxis );
 				// re-run collision detection to find out where it failed
-				idCollisionModelManagerLocal::Translation( &tr, start, end, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
+				idCollisionModelManagerLocal::Translation( context, &tr, start, end, trm, trmAxis, contentMask, model, modelOrigin, modelAxis );
 			}
 			entered = 0;
 		}
@@ -446,6 +446,7 @@ idEntity::idEntity():
 	snapshotNode.SetOwner( this );
 	snapshotChanged = -1;
 	snapshotStale = false;
+	saveStateDirty = true;
 	snapshotBits = 0;
 	
 	thinkFlags		= 0;
@@ -1083,6 +1084,8 @@ void idEntity::BecomeActive( int flags )
 		}
 	}
 	
+	saveStateDirty = true;
+	
 	int oldFlags = thinkFlags;
 	thinkFlags |= flags;
 	if( thinkFlags )
@@ -1122,6 +1125,8 @@ void idEntity::BecomeInactive( int flags )
 		}
 	}
 	
+	saveStateDirty = true;
+	
 	if( thinkFlags )
 	{
 		thinkFlags &= ~flags;
@@ -1716,7 +1721,10 @@ bool idEntity::UpdateRenderEntity( renderEntity_s* renderEntity, const renderVie
 		{
 			currentTime = gameLocal.GetTimeGroupTime( renderEntity->timeGroup );
 		}
-		return animator->CreateFrame( currentTime, false );
+		const bool created = animator->CreateFrame( currentTime, false );
+		
+		// the frame may already have been created by idGameLocal::CreateAnimatorFrames
+		return animator->TakeBatchedFrame() || created;
 	}
 	
 	return false;
@@ -192,6 +192,8 @@ public:
 	int						snapshotBits;			// number of bits this entity occupied in the last snapshot
 	bool					snapshotStale;			// Set to true if this entity is considered stale in the snapshot
 	
+	bool					saveStateDirty;			// the entity processed events or thought since the last save (see idSaveGameCache)
+	
 	idStr					name;					// name of entity
 	idDict					spawnArgs;				// key/value pairs used to spawn and initialize entity
 	idScriptObject			scriptObject;			// contains all script defined data for this entity
@@ -260,6 +260,9 @@ public:
 	virtual void				AF_UndoChanges();
 	virtual idRenderModel* 		AF_CreateMesh( const idDict& args, idVec3& meshOrigin, idMat3& meshAxis, bool& poseIsSet );
 	
+	// AAS compiler support.
+	virtual bool				AAS_WriteRouteTable( const char* fileName );
+	
 	
 	// Entity selection.
 	virtual void				ClearEntitySelection();
@@ -321,7 +324,7 @@ extern idGameEdit* 				gameEdit;
 ===============================================================================
 */
 
-const int GAME_API_VERSION		= 8;
+const int GAME_API_VERSION		= 9;
 
 typedef struct
 {
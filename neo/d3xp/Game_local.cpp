@@ -490,7 +490,12 @@ void idGameLocal::SaveGame( idFile* f, idFile* strings )
 		}
 	}
 	
-	idSaveGame savegame( f, strings, BUILD_NUMBER );
+	if( !g_incrementalSaves.GetBool() )
+	{
+		saveGameCache.Clear();
+	}
+	
+	idSaveGame savegame( f, strings, BUILD_NUMBER, g_incrementalSaves.GetBool() ? &saveGameCache : NULL );
 	
 	if( g_flushSave.GetBool( ) == true )
 	{
@@ -682,8 +687,21 @@ void idGameLocal::SaveGame( idFile* f, idFile* strings )
 	
 	savegame.Close();
 	
+	// everything written from here on can be reused by the next save, unless it changes
+	for( ent = spawnedEntities.Next(); ent != NULL; ent = ent->spawnNode.Next() )
+	{
+		ent->saveStateDirty = false;
+	}
+	
 	int endTimeMs = Sys_Milliseconds();
-	idLib::Printf( "Save time: %dms\n", ( endTimeMs - startTimeMs ) );
+	if( g_incrementalSaves.GetBool() )
+	{
+		idLib::Printf( "Save time: %dms (%d entities reused)\n", ( endTimeMs - startTimeMs ), saveGameCache.NumReused() );
+	}
+	else
+	{
+		idLib::Printf( "Save time: %dms\n", ( endTimeMs - startTimeMs ) );
+	}
 	
 	if( g_recordSaveGameTrace.GetBool() )
 	{
@@ -1675,6 +1693,7 @@ void idGameLocal::MapShutdown()
 	
 	clip.Shutdown();
 	idClipModel::ClearTraceModelCache();
+	saveGameCache.Clear();
 	
 	common->UpdateLevelLoadPacifier();
 	
@@ -2526,6 +2545,114 @@ void idGameLocal::RunEntityThink( idEntity& ent, idUserCmdMgr& userCmdMgr )
 
 idCVar g_recordTrace( "g_recordTrace", "0", CVAR_BOOL, "" );
 
+/*
+===============================================================================
+
+	Batched animator frames
+
+===============================================================================
+*/
+
+#define MIN_ANIMATORS_PER_JOB		2			// a single animator is not worth the job overhead
+
+typedef struct animatorFrameJob_s
+{
+	idAnimator** 			animators;
+	const int* 				times;
+	int						numAnimators;
+} animatorFrameJob_t;
+
+/*
+================
+Anim_CreateFrameJob
+================
+*/
+static void Anim_CreateFrameJob( animatorFrameJob_t* job )
+{
+	for( int i = 0; i < job->numAnimators; i++ )
+	{
+		job->animators[i]->CreateBatchedFrame( job->times[i] );
+	}
+}
+
+REGISTER_PARALLEL_JOB( Anim_CreateFrameJob, "Anim_CreateFrameJob" );
+
+/*
+================
+idGameLocal::CreateAnimatorFrames
+
+  Creates the frames the render callbacks would otherwise create one by one on
+  the game thread. Each job only writes the joint buffers of its own animators,
+  the model defs and anims are shared read only. Entities that are hidden,
+  outside the player PVS or being debugged are left to the render callback.
+================
+*/
+void idGameLocal::CreateAnimatorFrames()
+{
+	idStaticList<idAnimator*, MAX_GENTITIES> animators;
+	idStaticList<int, MAX_GENTITIES> times;
+	idEntity* ent;
+	
+	if( !g_animatorJobs.GetBool() || g_debugAnim.GetInteger() == -2 )
+	{
+		return;
+	}
+	
+	if( inCinematic && skipCinematic )
+	{
+		return;
+	}
+	
+	for( ent = activeEntities.Next(); ent != NULL; ent = ent->activeNode.Next() )
+	{
+		if( ent->GetRenderEntity()->callback != idEntity::ModelCallback || ent->GetModelDefHandle() == -1 )
+		{
+			continue;
+		}
+		if( ent->IsHidden() || ent->entityNumber == g_debugAnim.GetInteger() || !InPlayerPVS( ent ) )
+		{
+			continue;
+		}
+		idAnimator* animator = ent->GetAnimator();
+		if( animator == NULL )
+		{
+			continue;
+		}
+		const int currentTime = GetTimeGroupTime( ent->GetRenderEntity()->timeGroup );
+		if( !animator->NeedsFrame( currentTime ) )
+		{
+			continue;
+		}
+		animators.Append( animator );
+		times.Append( currentTime );
+	}
+	
+	int numJobs = Min( animators.Num() / MIN_ANIMATORS_PER_JOB, parallelJobManager->GetNumProcessingUnits() + 1 );
+	if( numJobs <= 1 )
+	{
+		// the render callbacks will create the frames
+		return;
+	}
+	
+	animatorFrameJob_t* jobs = ( animatorFrameJob_t* )_alloca( numJobs * sizeof( jobs[0] ) );
+	idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, numJobs, 0, NULL );
+	
+	int first = 0;
+	for( int i = 0; i < numJobs; i++ )
+	{
+		const int last = ( animators.Num() * ( i + 1 ) ) / numJobs;
+		jobs[i].animators = animators.Ptr() + first;
+		jobs[i].times = times.Ptr() + first;
+		jobs[i].numAnimators = last - first;
+		jobList->AddJob( ( jobRun_t )Anim_CreateFrameJob, &jobs[i] );
+		first = last;
+	}
+	
+	jobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+	jobList->Wait();
+	parallelJobManager->FreeJobList( jobList );
+}
+
 /*
 ================
 idGameLocal::RunFrame
@@ -2743,6 +2870,9 @@ void idGameLocal::RunFrame( idUserCmdMgr& cmdMgr, gameReturn_t& ret )
 			
 			timer_events.Stop();
 			
+			// build the joints of the visible animated entities before the renderer asks for them
+			CreateAnimatorFrames();
+			
 			// free the player pvs
 			FreePlayerPVS();
 			
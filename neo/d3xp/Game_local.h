@@ -306,6 +306,7 @@ public:
 	bool					sortPushers;			// true if active lists needs to be reordered to place pushers at the front
 	bool					sortTeamMasters;		// true if active lists needs to be reordered to place physics team masters before their slaves
 	idDict					persistentLevelInfo;	// contains args that are kept around between levels
+	idSaveGameCache			saveGameCache;			// saved state of the objects from the previous save of this level
 	
 	// can be used to automatically effect every material in the world that references globalParms
 	float					globalShaderParms[ MAX_GLOBAL_SHADER_PARMS ];
@@ -704,6 +705,7 @@ private:
 	pvsHandle_t				GetClientPVS( idPlayer* player, pvsType_t type );
 	void					SetupPlayerPVS();
 	void					FreePlayerPVS();
+	void					CreateAnimatorFrames();
 	void					UpdateGravity();
 	void					SortActiveEntityList();
 	void					ShowTargets();
@@ -59,6 +59,19 @@ idAASLocal::idAASLocal
 idAASLocal::idAASLocal()
 {
 	file = NULL;
+	for( int i = 0; i < AAS_MAX_ROUTING_CONTEXTS; i++ )
+	{
+		routingContexts[i].areaUpdate = NULL;
+		routingContexts[i].portalUpdate = NULL;
+		routingContexts[i].goalAreaTravelTimes = NULL;
+	}
+	routeTableData = NULL;
+	routeTableLength = 0;
+	routeTableMapped = false;
+	routeTableNumFlagSets = 0;
+	routeTableCaches = NULL;
+	routeTableClusterChanges = NULL;
+	routeTableNumChanges = 0;
 }
 
 /*
@@ -310,3 +323,16 @@ void idAASLocal::GetEdge( int edgeNum, idVec3& start, idVec3& end ) const
 	start = file->GetVertex( v[INT32_SIGNBITSET( edgeNum )] );
 	end = file->GetVertex( v[INT32_SIGNBITNOTSET( edgeNum )] );
 }
+
+/*
+============
+idGameEdit::AAS_WriteRouteTable
+============
+*/
+bool idGameEdit::AAS_WriteRouteTable( const char* fileName )
+{
+	idAAS* aas = idAAS::Alloc();
+	bool result = aas->Init( fileName, 0 ) && aas->WriteRouteTable();
+	delete aas;
+	return result;
+}
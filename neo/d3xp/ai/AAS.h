@@ -68,6 +68,18 @@ typedef struct aasObstacle_s
 	idBounds					expAbsBounds;	// expanded absolute bounds of obstacle
 } aasObstacle_t;
 
+
+typedef struct aasRouteRequest_s
+{
+	int							areaNum;		// area to route from
+	idVec3						origin;			// position in the start area
+	int							goalAreaNum;	// area to route to
+	int							travelFlags;	// allowed travel types
+	bool						reachable;		// set if a route to the goal area exists
+	int							travelTime;		// travel time to the goal area
+	idReachability* 			reach;			// first reachability along the route
+} aasRouteRequest_t;
+
 class idAASCallback
 {
 public:
@@ -128,6 +140,8 @@ public:
 	virtual int					TravelTimeToGoalArea( int areaNum, const idVec3& origin, int goalAreaNum, int travelFlags ) const = 0;
 	// Get the travel time and first reachability to be used towards the goal, returns true if there is a path.
 	virtual bool				RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int& travelTime, idReachability** reach ) const = 0;
+	// Route a batch of requests, large batches are spread over the job threads.
+	virtual void				RouteToGoalAreas( aasRouteRequest_t* requests, const int numRequests ) const = 0;
 	// Creates a walk path towards the goal.
 	virtual bool				WalkPathToGoal( aasPath_t& path, int areaNum, const idVec3& origin, int goalAreaNum, const idVec3& goalOrigin, int travelFlags ) const = 0;
 	// Returns true if one can walk along a straight line from the origin to the goal origin.
@@ -142,6 +156,8 @@ public:
 	virtual void				ShowFlyPath( const idVec3& origin, int goalAreaNum, const idVec3& goalOrigin ) const = 0;
 	// Find the nearest goal which satisfies the callback.
 	virtual bool				FindNearestGoal( aasGoal_t& goal, int areaNum, const idVec3 origin, const idVec3& target, int travelFlags, aasObstacle_t* obstacles, int numObstacles, idAASCallback& callback ) const = 0;
+	// Precompute the travel times between cluster portals and store them next to the AAS file.
+	virtual bool				WriteRouteTable() = 0;
 };
 
 #endif /* !__AAS_H__ */
@@ -38,6 +38,7 @@ class idRoutingCache
 	friend class idAASLocal;
 	
 public:
+	idRoutingCache();
 	idRoutingCache( int size );
 	~idRoutingCache();
 	
@@ -75,6 +76,21 @@ private:
 };
 
 
+#define AAS_MAX_ROUTING_CONTEXTS	8				// threads that can route at the same time
+#define AAS_ROUTETABLE_MAX_FLAGSETS	4				// travel flag combinations stored in a route table
+
+class idRoutingContext
+{
+	friend class idAASLocal;
+	
+private:
+	idSysInterlockedInteger		inUse;					// set while a thread routes with this context
+	idRoutingUpdate* 			areaUpdate;				// memory used to update the area routing cache
+	idRoutingUpdate* 			portalUpdate;			// memory used to update the portal routing cache
+	unsigned short* 			goalAreaTravelTimes;	// travel times to goal areas
+};
+
+
 class idRoutingObstacle
 {
 	friend class idAASLocal;
@@ -115,6 +131,7 @@ public:
 	virtual void				RemoveAllObstacles();
 	virtual int					TravelTimeToGoalArea( int areaNum, const idVec3& origin, int goalAreaNum, int travelFlags ) const;
 	virtual bool				RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int& travelTime, idReachability** reach ) const;
+	virtual void				RouteToGoalAreas( aasRouteRequest_t* requests, const int numRequests ) const;
 	virtual bool				WalkPathToGoal( aasPath_t& path, int areaNum, const idVec3& origin, int goalAreaNum, const idVec3& goalOrigin, int travelFlags ) const;
 	virtual bool				WalkPathValid( int areaNum, const idVec3& origin, int goalAreaNum, const idVec3& goalOrigin, int travelFlags, idVec3& endPos, int& endAreaNum ) const;
 	virtual bool				FlyPathToGoal( aasPath_t& path, int areaNum, const idVec3& origin, int goalAreaNum, const idVec3& goalOrigin, int travelFlags ) const;
@@ -122,6 +139,9 @@ public:
 	virtual void				ShowWalkPath( const idVec3& origin, int goalAreaNum, const idVec3& goalOrigin ) const;
 	virtual void				ShowFlyPath( const idVec3& origin, int goalAreaNum, const idVec3& goalOrigin ) const;
 	virtual bool				FindNearestGoal( aasGoal_t& goal, int areaNum, const idVec3 origin, const idVec3& target, int travelFlags, aasObstacle_t* obstacles, int numObstacles, idAASCallback& callback ) const;
+	virtual bool				WriteRouteTable();
+	
+	void						RouteRequests( aasRouteRequest_t* requests, const int numRequests ) const;
 	
 private:
 	idAASFile* 					file;
@@ -132,16 +152,26 @@ private:	// routing data
 	int							areaCacheIndexSize;		// number of area cache entries
 	idRoutingCache** 			portalCacheIndex;		// for each area in the world the travel times from each portal
 	int							portalCacheIndexSize;	// number of portal cache entries
-	idRoutingUpdate* 			areaUpdate;				// memory used to update the area routing cache
-	idRoutingUpdate* 			portalUpdate;			// memory used to update the portal routing cache
-	unsigned short* 			goalAreaTravelTimes;	// travel times to goal areas
+	mutable idRoutingContext	routingContexts[AAS_MAX_ROUTING_CONTEXTS];	// per thread scratch memory for routing
+	mutable idSysInterlockedInteger	numActiveContexts;	// number of contexts currently in use
 	unsigned short* 			areaTravelTimes;		// travel times through the areas
 	int							numAreaTravelTimes;		// number of area travel times
+	mutable idSysMutex			cacheLock;				// guards the cache indexes and the time sorted cache list
 	mutable idRoutingCache* 	cacheListStart;			// start of list with cache sorted from oldest to newest
 	mutable idRoutingCache* 	cacheListEnd;			// end of list with cache sorted from oldest to newest
 	mutable int					totalCacheMemory;		// total cache memory used
 	idList<idRoutingObstacle*, TAG_AAS>	obstacleList;			// list with obstacles
 	
+private:	// precomputed route table
+	byte* 						routeTableData;			// contents of the route table file
+	int							routeTableLength;		// length of the route table file
+	bool						routeTableMapped;		// true if the route table file is memory mapped
+	int							routeTableNumFlagSets;	// number of travel flag combinations in the table
+	int							routeTableFlags[AAS_ROUTETABLE_MAX_FLAGSETS];	// travel flags of each combination
+	idRoutingCache* 			routeTableCaches;		// caches pointing into the table data
+	int* 						routeTableClusterChanges;	// per cluster number of areas and reachabilities that changed since the table was built
+	int							routeTableNumChanges;	// total number of changes
+	
 private:	// routing
 	bool						SetupRouting();
 	void						ShutdownRouting();
@@ -153,15 +183,21 @@ private:	// routing
 	void						DeletePortalCache();
 	void						ShutdownRoutingCache();
 	void						RoutingStats() const;
+	idRoutingContext* 			AllocRoutingContext() const;
+	void						FreeRoutingContext( idRoutingContext* context ) const;
 	void						LinkCache( idRoutingCache* cache ) const;
 	void						UnlinkCache( idRoutingCache* cache ) const;
 	void						DeleteOldestCache() const;
+	void						DeleteOldCaches( int numOwnContexts ) const;
 	idReachability* 			GetAreaReachability( int areaNum, int reachabilityNum ) const;
 	int							ClusterAreaNum( int clusterNum, int areaNum ) const;
-	void						UpdateAreaRoutingCache( idRoutingCache* areaCache ) const;
-	idRoutingCache* 			GetAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
-	void						UpdatePortalRoutingCache( idRoutingCache* portalCache ) const;
-	idRoutingCache* 			GetPortalRoutingCache( int clusterNum, int areaNum, int travelFlags ) const;
+	void						UpdateAreaRoutingCache( idRoutingContext* context, idRoutingCache* areaCache ) const;
+	idRoutingCache* 			GetAreaRoutingCache( idRoutingContext* context, int clusterNum, int areaNum, int travelFlags ) const;
+	void						UpdatePortalRoutingCache( idRoutingContext* context, idRoutingCache* portalCache ) const;
+	idRoutingCache* 			GetPortalRoutingCache( idRoutingContext* context, int clusterNum, int areaNum, int travelFlags ) const;
+	idRoutingCache* 			InsertRoutingCache( idRoutingCache** cacheList, idRoutingCache* cache ) const;
+	bool						RouteToGoalArea( idRoutingContext* context, int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int& travelTime, idReachability** reach ) const;
+	bool						FindNearestGoal( idRoutingContext* context, aasGoal_t& goal, int areaNum, const idVec3 origin, const idVec3& target, int travelFlags, aasObstacle_t* obstacles, int numObstacles, idAASCallback& callback ) const;
 	void						RemoveRoutingCacheUsingArea( int areaNum );
 	void						DisableArea( int areaNum );
 	void						EnableArea( int areaNum );
@@ -169,6 +205,15 @@ private:	// routing
 	void						GetBoundsAreas_r( int nodeNum, const idBounds& bounds, idList<int>& areas ) const;
 	void						SetObstacleState( const idRoutingObstacle* obstacle, bool enable );
 	
+private:	// route table
+	idStr						RouteTableName() const;
+	bool						LoadRouteTable();
+	void						FreeRouteTable();
+	int							RouteTableFlagSet( int travelFlags ) const;
+	idRoutingCache* 			RouteTableAreaCache( int clusterNum, int areaNum, int travelFlags ) const;
+	idRoutingCache* 			RouteTablePortalCache( int clusterNum, int areaNum, int travelFlags ) const;
+	void						ChangeRouteTableState( int areaNum, int change );
+	
 private:	// pathing
 	bool						EdgeSplitPoint( idVec3& split, int edgeNum, const idPlane& plane ) const;
 	bool						FloorEdgeSplitPoint( idVec3& split, int areaNum, const idPlane& splitPlane, const idPlane& frontPlane, bool closest ) const;
@@ -0,0 +1,493 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+
+#pragma hdrstop
+#include "precompiled.h"
+
+
+#include "AAS_local.h"
+#include "../Game_local.h"		// for print and error
+
+/*
+===============================================================================
+
+	Precomputed route table
+
+	The table holds, for every travel flag combination, the area routing cache
+	towards each portal area inside both clusters next to the portal, followed
+	by the portal routing cache towards each portal area. These are the caches
+	the portal floods keep asking for, so with the table in place a route only
+	needs a flood inside the cluster of the goal area.
+
+	The data is stored in native byte order so the file can be mapped and used
+	in place. Each cache is stored as its travel times followed by its
+	reachabilities, padded to four bytes.
+
+	The table describes the AAS file as it was compiled. Caches of clusters with
+	disabled areas or obstacles are computed at run time as before, and the portal
+	caches are only used as long as nothing at all changed.
+
+===============================================================================
+*/
+
+#define AAS_ROUTETABLE_IDENT		( ( 'T' << 24 ) | ( 'R' << 16 ) | ( 'S' << 8 ) | 'A' )
+#define AAS_ROUTETABLE_VERSION		1
+#define AAS_ROUTETABLE_EXTENSION	".routes"
+
+// the travel flags the AI routes with
+static const int routeTableTravelFlags[] =
+{
+	TFL_WALK | TFL_AIR,
+	TFL_WALK | TFL_AIR | TFL_FLY
+};
+
+typedef struct aasRouteTableHeader_s
+{
+	int							ident;
+	int							version;
+	unsigned int				mapFileCRC;
+	int							numAreas;
+	int							numPortals;
+	int							numClusters;
+	int							numFlagSets;
+	int							travelFlags[AAS_ROUTETABLE_MAX_FLAGSETS];
+} aasRouteTableHeader_t;
+
+/*
+============
+RouteTableCacheSize
+============
+*/
+static ID_INLINE int RouteTableCacheSize( int size )
+{
+	return ( size * ( sizeof( unsigned short ) + sizeof( byte ) ) + 3 ) & ~3;
+}
+
+/*
+============
+idAASLocal::RouteTableName
+============
+*/
+idStr idAASLocal::RouteTableName() const
+{
+	idStr name = file->GetName();
+	name += AAS_ROUTETABLE_EXTENSION;
+	return name;
+}
+
+/*
+============
+idAASLocal::LoadRouteTable
+============
+*/
+bool idAASLocal::LoadRouteTable()
+{
+	int i, flagSet, portalNum, side, size, offset, mappedLength;
+	ID_TIME_T aasTimeStamp;
+	idRoutingCache* cache;
+	
+	FreeRouteTable();
+	
+	if( !aas_useRouteTable.GetBool() )
+	{
+		return false;
+	}
+	
+	const idStr name = RouteTableName();
+	idFile* f = fileSystem->OpenFileRead( name );
+	if( f == NULL )
+	{
+		return false;
+	}
+	
+	fileSystem->ReadFile( file->GetName(), NULL, &aasTimeStamp );
+	if( f->Timestamp() < aasTimeStamp )
+	{
+		gameLocal.Warning( "route table '%s' is older than the AAS file", name.c_str() );
+		delete f;
+		return false;
+	}
+	
+	// map the file when it is a plain file on disk, otherwise read it
+	routeTableLength = f->Length();
+	routeTableData = ( byte* )Sys_MapFile( f->GetFullPath(), mappedLength );
+	if( routeTableData != NULL && mappedLength == routeTableLength )
+	{
+		routeTableMapped = true;
+	}
+	else
+	{
+		Sys_UnmapFile( routeTableData, mappedLength );
+		routeTableData = ( byte* )Mem_Alloc( routeTableLength, TAG_AAS );
+		if( f->Read( routeTableData, routeTableLength ) != routeTableLength )
+		{
+			gameLocal.Warning( "couldn't read route table '%s'", name.c_str() );
+			delete f;
+			FreeRouteTable();
+			return false;
+		}
+	}
+	delete f;
+	
+	const aasRouteTableHeader_t* header = ( const aasRouteTableHeader_t* )routeTableData;
+	if( routeTableLength < ( int )sizeof( aasRouteTableHeader_t ) ||
+			header->ident != AAS_ROUTETABLE_IDENT || header->version != AAS_ROUTETABLE_VERSION ||
+			header->mapFileCRC != file->GetCRC() || header->numAreas != file->GetNumAreas() ||
+			header->numPortals != file->GetNumPortals() || header->numClusters != file->GetNumClusters() ||
+			header->numFlagSets <= 0 || header->numFlagSets > AAS_ROUTETABLE_MAX_FLAGSETS )
+	{
+		gameLocal.Warning( "route table '%s' does not match the AAS file", name.c_str() );
+		FreeRouteTable();
+		return false;
+	}
+	
+	routeTableNumFlagSets = header->numFlagSets;
+	for( i = 0; i < routeTableNumFlagSets; i++ )
+	{
+		routeTableFlags[i] = header->travelFlags[i];
+	}
+	
+	const int numPortals = file->GetNumPortals();
+	routeTableCaches = new( TAG_AAS ) idRoutingCache[ routeTableNumFlagSets * numPortals * 3 ];
+	
+	// point the caches into the table, in the order the table was written
+	offset = sizeof( aasRouteTableHeader_t );
+	for( flagSet = 0; flagSet < routeTableNumFlagSets; flagSet++ )
+	{
+		idRoutingCache* flagSetCaches = &routeTableCaches[ flagSet * numPortals * 3 ];
+		
+		for( i = 0; i < numPortals * 3; i++ )
+		{
+			if( i < numPortals * 2 )
+			{
+				portalNum = i >> 1;
+				side = i & 1;
+			}
+			else
+			{
+				portalNum = i - numPortals * 2;
+				side = 0;
+			}
+			if( portalNum == 0 )
+			{
+				continue;
+			}
+			
+			const aasPortal_t& portal = file->GetPortal( portalNum );
+			if( portal.clusters[side] <= 0 )
+			{
+				continue;
+			}
+			size = ( i < numPortals * 2 ) ? file->GetCluster( portal.clusters[side] ).numReachableAreas : numPortals;
+			if( offset + RouteTableCacheSize( size ) > routeTableLength )
+			{
+				gameLocal.Warning( "route table '%s' is truncated", name.c_str() );
+				FreeRouteTable();
+				return false;
+			}
+			
+			cache = &flagSetCaches[i];
+			cache->cluster = portal.clusters[side];
+			cache->areaNum = portal.areaNum;
+			cache->travelFlags = routeTableFlags[flagSet];
+			cache->size = size;
+			cache->travelTimes = ( unsigned short* )( routeTableData + offset );
+			cache->reachabilities = routeTableData + offset + size * sizeof( unsigned short );
+			offset += RouteTableCacheSize( size );
+		}
+	}
+	
+	if( offset != routeTableLength )
+	{
+		gameLocal.Warning( "route table '%s' does not match the AAS file", name.c_str() );
+		FreeRouteTable();
+		return false;
+	}
+	
+	routeTableClusterChanges = ( int* )Mem_ClearedAlloc( file->GetNumClusters() * sizeof( int ), TAG_AAS );
+	routeTableNumChanges = 0;
+	
+	gameLocal.Printf( "loaded %s (%d KB%s)\n", name.c_str(), routeTableLength >> 10, routeTableMapped ? ", mapped" : "" );
+	return true;
+}
+
+/*
+============
+idAASLocal::FreeRouteTable
+============
+*/
+void idAASLocal::FreeRouteTable()
+{
+	delete[] routeTableCaches;
+	routeTableCaches = NULL;
+	
+	if( routeTableMapped )
+	{
+		Sys_UnmapFile( routeTableData, routeTableLength );
+	}
+	else
+	{
+		Mem_Free( routeTableData );
+	}
+	routeTableData = NULL;
+	routeTableLength = 0;
+	routeTableMapped = false;
+	routeTableNumFlagSets = 0;
+	
+	Mem_Free( routeTableClusterChanges );
+	routeTableClusterChanges = NULL;
+	routeTableNumChanges = 0;
+}
+
+/*
+============
+idAASLocal::WriteRouteTable
+============
+*/
+bool idAASLocal::WriteRouteTable()
+{
+	int i, flagSet, portalNum, side, size;
+	idRoutingCache* cache;
+	aasRouteTableHeader_t header;
+	static const byte padding[4] = { 0, 0, 0, 0 };
+	
+	if( file == NULL )
+	{
+		return false;
+	}
+	
+	// the table is always built by the routing code, never from an older table
+	FreeRouteTable();
+	
+	// the table has to describe the AAS file as it was compiled
+	if( obstacleList.Num() > 0 )
+	{
+		gameLocal.Warning( "can't write a route table while there are routing obstacles" );
+		return false;
+	}
+	for( i = 1; i < file->GetNumAreas(); i++ )
+	{
+		if( file->GetArea( i ).travelFlags & TFL_INVALID )
+		{
+			gameLocal.Warning( "can't write a route table while areas are disabled" );
+			return false;
+		}
+	}
+	
+	const idStr name = RouteTableName();
+	idFile* f = fileSystem->OpenFileWrite( name, "fs_basepath" );
+	if( f == NULL )
+	{
+		gameLocal.Warning( "couldn't open %s for writing", name.c_str() );
+		return false;
+	}
+	
+	const int numPortals = file->GetNumPortals();
+	
+	memset( &header, 0, sizeof( header ) );
+	header.ident = AAS_ROUTETABLE_IDENT;
+	header.version = AAS_ROUTETABLE_VERSION;
+	header.mapFileCRC = file->GetCRC();
+	header.numAreas = file->GetNumAreas();
+	header.numPortals = numPortals;
+	header.numClusters = file->GetNumClusters();
+	header.numFlagSets = sizeof( routeTableTravelFlags ) / sizeof( routeTableTravelFlags[0] );
+	for( i = 0; i < header.numFlagSets; i++ )
+	{
+		header.travelFlags[i] = routeTableTravelFlags[i];
+	}
+	f->Write( &header, sizeof( header ) );
+	
+	idRoutingContext* context = AllocRoutingContext();
+	
+	for( flagSet = 0; flagSet < header.numFlagSets; flagSet++ )
+	{
+		for( i = 0; i < numPortals * 3; i++ )
+		{
+			if( i < numPortals * 2 )
+			{
+				portalNum = i >> 1;
+				side = i & 1;
+			}
+			else
+			{
+				portalNum = i - numPortals * 2;
+				side = 0;
+			}
+			if( portalNum == 0 )
+			{
+				continue;
+			}
+			
+			const aasPortal_t& portal = file->GetPortal( portalNum );
+			if( portal.clusters[side] <= 0 )
+			{
+				continue;
+			}
+			if( i < numPortals * 2 )
+			{
+				cache = GetAreaRoutingCache( context, portal.clusters[side], portal.areaNum, header.travelFlags[flagSet] );
+			}
+			else
+			{
+				cache = GetPortalRoutingCache( context, portal.clusters[side], portal.areaNum, header.travelFlags[flagSet] );
+			}
+			
+			size = cache->size;
+			f->Write( cache->travelTimes, size * sizeof( unsigned short ) );
+			f->Write( cache->reachabilities, size * sizeof( byte ) );
+			f->Write( padding, RouteTableCacheSize( size ) - size * ( sizeof( unsigned short ) + sizeof( byte ) ) );
+			
+			// nothing holds on to the caches between portals
+			DeleteOldCaches( 1 );
+		}
+	}
+	
+	FreeRoutingContext( context );
+	
+	gameLocal.Printf( "wrote %s (%d KB)\n", name.c_str(), f->Tell() >> 10 );
+	delete f;
+	
+	return true;
+}
+
+/*
+============
+idAASLocal::RouteTableFlagSet
+============
+*/
+int idAASLocal::RouteTableFlagSet( int travelFlags ) const
+{
+	for( int i = 0; i < routeTableNumFlagSets; i++ )
+	{
+		if( routeTableFlags[i] == travelFlags )
+		{
+			return i;
+		}
+	}
+	return -1;
+}
+
+/*
+============
+idAASLocal::RouteTableAreaCache
+
+  returns the area cache towards a portal area inside one of the clusters
+  next to the portal, or NULL when the cluster changed since the table was built
+============
+*/
+idRoutingCache* idAASLocal::RouteTableAreaCache( int clusterNum, int areaNum, int travelFlags ) const
+{
+	if( routeTableCaches == NULL || clusterNum <= 0 )
+	{
+		return NULL;
+	}
+	
+	const int areaCluster = file->GetArea( areaNum ).cluster;
+	if( areaCluster >= 0 || routeTableClusterChanges[clusterNum] != 0 )
+	{
+		return NULL;
+	}
+	
+	const int flagSet = RouteTableFlagSet( travelFlags );
+	if( flagSet < 0 )
+	{
+		return NULL;
+	}
+	
+	const int portalNum = -areaCluster;
+	const int side = file->GetPortal( portalNum ).clusters[0] != clusterNum;
+	return &routeTableCaches[ flagSet * file->GetNumPortals() * 3 + portalNum * 2 + side ];
+}
+
+/*
+============
+idAASLocal::RouteTablePortalCache
+
+  returns the portal cache towards a portal area, or NULL when anything
+  changed since the table was built
+============
+*/
+idRoutingCache* idAASLocal::RouteTablePortalCache( int clusterNum, int areaNum, int travelFlags ) const
+{
+	if( routeTableCaches == NULL || routeTableNumChanges != 0 )
+	{
+		return NULL;
+	}
+	
+	const int areaCluster = file->GetArea( areaNum ).cluster;
+	if( areaCluster >= 0 )
+	{
+		return NULL;
+	}
+	
+	// the table floods from the front cluster of the portal
+	const int portalNum = -areaCluster;
+	if( file->GetPortal( portalNum ).clusters[0] != clusterNum )
+	{
+		return NULL;
+	}
+	
+	const int flagSet = RouteTableFlagSet( travelFlags );
+	if( flagSet < 0 )
+	{
+		return NULL;
+	}
+	
+	return &routeTableCaches[ flagSet * file->GetNumPortals() * 3 + file->GetNumPortals() * 2 + portalNum ];
+}
+
+/*
+============
+idAASLocal::ChangeRouteTableState
+
+  keeps count of the areas and reachabilities that changed in each cluster,
+  a portal area counts for the clusters on both sides
+============
+*/
+void idAASLocal::ChangeRouteTableState( int areaNum, int change )
+{
+	if( routeTableClusterChanges == NULL )
+	{
+		return;
+	}
+	
+	const int clusterNum = file->GetArea( areaNum ).cluster;
+	if( clusterNum > 0 )
+	{
+		routeTableClusterChanges[clusterNum] += change;
+	}
+	else if( clusterNum < 0 )
+	{
+		const aasPortal_t& portal = file->GetPortal( -clusterNum );
+		routeTableClusterChanges[portal.clusters[0]] += change;
+		routeTableClusterChanges[portal.clusters[1]] += change;
+	}
+	routeTableNumChanges += change;
+}
@@ -35,11 +35,33 @@ If you have questions concerning this license or the applicable additional terms
 
 #define CACHETYPE_AREA				1
 #define CACHETYPE_PORTAL			2
+#define CACHETYPE_TABLE				3
 
 #define MAX_ROUTING_CACHE_MEMORY	(2*1024*1024)
 
 #define LEDGE_TRAVELTIME_PANALTY	250
 
+/*
+============
+idRoutingCache::idRoutingCache
+
+  cache that points into the precomputed route table
+============
+*/
+idRoutingCache::idRoutingCache()
+{
+	areaNum = 0;
+	cluster = 0;
+	next = prev = NULL;
+	time_next = time_prev = NULL;
+	travelFlags = 0;
+	startTravelTime = 0;
+	type = CACHETYPE_TABLE;
+	size = 0;
+	reachabilities = NULL;
+	travelTimes = NULL;
+}
+
 /*
 ============
 idRoutingCache::idRoutingCache
@@ -68,6 +90,10 @@ idRoutingCache::~idRoutingCache
 */
 idRoutingCache::~idRoutingCache()
 {
+	if( type == CACHETYPE_TABLE )
+	{
+		return;		// the data belongs to the route table
+	}
 	delete [] reachabilities;
 	delete [] travelTimes;
 }
@@ -235,10 +261,15 @@ void idAASLocal::SetupRoutingCache()
 	portalCacheIndexSize = file->GetNumAreas();
 	portalCacheIndex = ( idRoutingCache** ) Mem_ClearedAlloc( portalCacheIndexSize * sizeof( idRoutingCache* ), TAG_AAS );
 	
-	areaUpdate = ( idRoutingUpdate* ) Mem_ClearedAlloc( file->GetNumAreas() * sizeof( idRoutingUpdate ), TAG_AAS );
-	portalUpdate = ( idRoutingUpdate* ) Mem_ClearedAlloc( ( file->GetNumPortals() + 1 ) * sizeof( idRoutingUpdate ), TAG_AAS );
-	
-	goalAreaTravelTimes = ( unsigned short* ) Mem_ClearedAlloc( file->GetNumAreas() * sizeof( unsigned short ), TAG_AAS );
+	// the first context is used by the game thread, the others are allocated once a job thread needs them
+	routingContexts[0].areaUpdate = ( idRoutingUpdate* ) Mem_ClearedAlloc( file->GetNumAreas() * sizeof( idRoutingUpdate ), TAG_AAS );
+	routingContexts[0].portalUpdate = ( idRoutingUpdate* ) Mem_ClearedAlloc( ( file->GetNumPortals() + 1 ) * sizeof( idRoutingUpdate ), TAG_AAS );
+	routingContexts[0].goalAreaTravelTimes = ( unsigned short* ) Mem_ClearedAlloc( file->GetNumAreas() * sizeof( unsigned short ), TAG_AAS );
+	for( i = 0; i < AAS_MAX_ROUTING_CONTEXTS; i++ )
+	{
+		routingContexts[i].inUse.SetValue( 0 );
+	}
+	numActiveContexts.SetValue( 0 );
 	
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
@@ -308,12 +339,16 @@ void idAASLocal::ShutdownRoutingCache()
 	Mem_Free( portalCacheIndex );
 	portalCacheIndex = NULL;
 	portalCacheIndexSize = 0;
-	Mem_Free( areaUpdate );
-	areaUpdate = NULL;
-	Mem_Free( portalUpdate );
-	portalUpdate = NULL;
-	Mem_Free( goalAreaTravelTimes );
-	goalAreaTravelTimes = NULL;
+	for( i = 0; i < AAS_MAX_ROUTING_CONTEXTS; i++ )
+	{
+		assert( routingContexts[i].inUse.GetValue() == 0 );
+		Mem_Free( routingContexts[i].areaUpdate );
+		routingContexts[i].areaUpdate = NULL;
+		Mem_Free( routingContexts[i].portalUpdate );
+		routingContexts[i].portalUpdate = NULL;
+		Mem_Free( routingContexts[i].goalAreaTravelTimes );
+		routingContexts[i].goalAreaTravelTimes = NULL;
+	}
 	
 	cacheListStart = cacheListEnd = NULL;
 	totalCacheMemory = 0;
@@ -328,6 +363,7 @@ bool idAASLocal::SetupRouting()
 {
 	CalculateAreaTravelTimes();
 	SetupRoutingCache();
+	LoadRouteTable();
 	return true;
 }
 
@@ -340,6 +376,7 @@ void idAASLocal::ShutdownRouting()
 {
 	DeleteAreaTravelTimes();
 	ShutdownRoutingCache();
+	FreeRouteTable();
 }
 
 /*
@@ -416,6 +453,7 @@ void idAASLocal::DisableArea( int areaNum )
 	}
 	
 	file->SetAreaTravelFlag( areaNum, TFL_INVALID );
+	ChangeRouteTableState( areaNum, 1 );
 	
 	RemoveRoutingCacheUsingArea( areaNum );
 }
@@ -435,6 +473,7 @@ void idAASLocal::EnableArea( int areaNum )
 	}
 	
 	file->RemoveAreaTravelFlag( areaNum, TFL_INVALID );
+	ChangeRouteTableState( areaNum, -1 );
 	
 	RemoveRoutingCacheUsingArea( areaNum );
 }
@@ -552,7 +591,7 @@ idAASLocal::SetObstacleState
 */
 void idAASLocal::SetObstacleState( const idRoutingObstacle* obstacle, bool enable )
 {
-	int i;
+	int i, oldTravelType;
 	const aasArea_t* area;
 	idReachability* reach, *rev_reach;
 	bool inside;
@@ -592,6 +631,7 @@ void idAASLocal::SetObstacleState( const idRoutingObstacle* obstacle, bool enabl
 			
 			if( inside )
 			{
+				oldTravelType = rev_reach->travelType;
 				if( enable )
 				{
 					rev_reach->disableCount--;
@@ -606,6 +646,12 @@ void idAASLocal::SetObstacleState( const idRoutingObstacle* obstacle, bool enabl
 					rev_reach->travelType |= TFL_INVALID;
 					rev_reach->disableCount++;
 				}
+				if( ( oldTravelType ^ rev_reach->travelType ) & TFL_INVALID )
+				{
+					const int change = ( rev_reach->travelType & TFL_INVALID ) ? 1 : -1;
+					ChangeRouteTableState( rev_reach->fromAreaNum, change );
+					ChangeRouteTableState( rev_reach->toAreaNum, change );
+				}
 			}
 		}
 	}
@@ -677,11 +723,59 @@ void idAASLocal::RemoveAllObstacles()
 	obstacleList.Clear();
 }
 
+/*
+============
+idAASLocal::AllocRoutingContext
+
+  grab scratch memory for a single thread, the routing caches themselves are shared
+============
+*/
+idRoutingContext* idAASLocal::AllocRoutingContext() const
+{
+	// count the context as active before any cache is looked up so
+	// DeleteOldCaches never frees a cache this thread is about to read
+	numActiveContexts.Increment();
+	
+	while( 1 )
+	{
+		for( int i = 0; i < AAS_MAX_ROUTING_CONTEXTS; i++ )
+		{
+			idRoutingContext* context = &routingContexts[i];
+			if( context->inUse.CompareExchange( 0, 1 ) != 0 )
+			{
+				continue;
+			}
+			if( !context->areaUpdate )
+			{
+				context->areaUpdate = ( idRoutingUpdate* ) Mem_ClearedAlloc( file->GetNumAreas() * sizeof( idRoutingUpdate ), TAG_AAS );
+				context->portalUpdate = ( idRoutingUpdate* ) Mem_ClearedAlloc( ( file->GetNumPortals() + 1 ) * sizeof( idRoutingUpdate ), TAG_AAS );
+				context->goalAreaTravelTimes = ( unsigned short* ) Mem_ClearedAlloc( file->GetNumAreas() * sizeof( unsigned short ), TAG_AAS );
+			}
+			return context;
+		}
+		// more threads are routing than there are contexts
+		Sys_Yield();
+	}
+	return NULL;
+}
+
+/*
+============
+idAASLocal::FreeRoutingContext
+============
+*/
+void idAASLocal::FreeRoutingContext( idRoutingContext* context ) const
+{
+	context->inUse.Decrement();
+	numActiveContexts.Decrement();
+}
+
 /*
 ============
 idAASLocal::LinkCache
 
   link the cache in the cache list sorted from oldest to newest cache
+  the cache lock must be held
 ============
 */
 void idAASLocal::LinkCache( idRoutingCache* cache ) const
@@ -775,6 +869,35 @@ void idAASLocal::DeleteOldestCache() const
 	delete cache;
 }
 
+/*
+============
+idAASLocal::DeleteOldCaches
+
+  Caches are handed out without holding the lock, so they can only be freed
+  while no other thread is routing. Threads that start routing after the
+  check block on the cache lock until the old caches are gone. When other
+  threads are busy the cache is allowed to grow until the next call.
+============
+*/
+void idAASLocal::DeleteOldCaches( int numOwnContexts ) const
+{
+	if( totalCacheMemory <= MAX_ROUTING_CACHE_MEMORY )
+	{
+		return;
+	}
+	
+	idScopedCriticalSection lock( cacheLock );
+	
+	if( numActiveContexts.GetValue() > numOwnContexts )
+	{
+		return;
+	}
+	while( totalCacheMemory > MAX_ROUTING_CACHE_MEMORY )
+	{
+		DeleteOldestCache();
+	}
+}
+
 /*
 ============
 idAASLocal::GetAreaReachability
@@ -820,7 +943,7 @@ ID_INLINE int idAASLocal::ClusterAreaNum( int clusterNum, int areaNum ) const
 idAASLocal::UpdateAreaRoutingCache
 ============
 */
-void idAASLocal::UpdateAreaRoutingCache( idRoutingCache* areaCache ) const
+void idAASLocal::UpdateAreaRoutingCache( idRoutingContext* context, idRoutingCache* areaCache ) const
 {
 	int i, nextAreaNum, cluster, badTravelFlags, clusterAreaNum, numReachableAreas;
 	unsigned short t, startAreaTravelTimes[MAX_REACH_PER_AREA];
@@ -843,7 +966,7 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache* areaCache ) const
 	memset( startAreaTravelTimes, 0, sizeof( startAreaTravelTimes ) );
 	
 	// initialize first update
-	curUpdate = &areaUpdate[clusterAreaNum];
+	curUpdate = &context->areaUpdate[clusterAreaNum];
 	curUpdate->areaNum = areaCache->areaNum;
 	curUpdate->areaTravelTimes = startAreaTravelTimes;
 	curUpdate->tmpTravelTime = areaCache->startTravelTime;
@@ -914,7 +1037,7 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache* areaCache ) const
 			
 				areaCache->travelTimes[clusterAreaNum] = t;
 				areaCache->reachabilities[clusterAreaNum] = reach->number; // reversed reachability used to get into this area
-				nextUpdate = &areaUpdate[clusterAreaNum];
+				nextUpdate = &context->areaUpdate[clusterAreaNum];
 				nextUpdate->areaNum = nextAreaNum;
 				nextUpdate->tmpTravelTime = t;
 				nextUpdate->areaTravelTimes = reach->areaTravelTimes;
@@ -954,41 +1077,81 @@ void idAASLocal::UpdateAreaRoutingCache( idRoutingCache* areaCache ) const
 idAASLocal::GetAreaRoutingCache
 ============
 */
-idRoutingCache* idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, int travelFlags ) const
+idRoutingCache* idAASLocal::GetAreaRoutingCache( idRoutingContext* context, int clusterNum, int areaNum, int travelFlags ) const
 {
 	int clusterAreaNum;
-	idRoutingCache* cache, *clusterCache;
+	idRoutingCache* cache;
+	
+	// portal areas of unchanged clusters are read from the route table
+	cache = RouteTableAreaCache( clusterNum, areaNum, travelFlags );
+	if( cache )
+	{
+		return cache;
+	}
 	
 	// number of the area in the cluster
 	clusterAreaNum = ClusterAreaNum( clusterNum, areaNum );
-	// pointer to the cache for the area in the cluster
-	clusterCache = areaCacheIndex[clusterNum][clusterAreaNum];
+	
+	cacheLock.Lock();
 	// check if cache without undesired travel flags already exists
-	for( cache = clusterCache; cache; cache = cache->next )
+	for( cache = areaCacheIndex[clusterNum][clusterAreaNum]; cache; cache = cache->next )
 	{
 		if( cache->travelFlags == travelFlags )
 		{
 			break;
 		}
 	}
-	// if no cache found
-	if( !cache )
-	{
-		cache = new( TAG_AAS ) idRoutingCache( file->GetCluster( clusterNum ).numReachableAreas );
-		cache->type = CACHETYPE_AREA;
-		cache->cluster = clusterNum;
-		cache->areaNum = areaNum;
-		cache->startTravelTime = 1;
-		cache->travelFlags = travelFlags;
-		cache->prev = NULL;
-		cache->next = clusterCache;
-		if( clusterCache )
+	if( cache )
+	{
+		LinkCache( cache );
+		cacheLock.Unlock();
+		return cache;
+	}
+	cacheLock.Unlock();
+	
+	// build the cache outside the lock so other threads keep routing meanwhile
+	cache = new( TAG_AAS ) idRoutingCache( file->GetCluster( clusterNum ).numReachableAreas );
+	cache->type = CACHETYPE_AREA;
+	cache->cluster = clusterNum;
+	cache->areaNum = areaNum;
+	cache->startTravelTime = 1;
+	cache->travelFlags = travelFlags;
+	UpdateAreaRoutingCache( context, cache );
+	
+	idScopedCriticalSection lock( cacheLock );
+	return InsertRoutingCache( &areaCacheIndex[clusterNum][clusterAreaNum], cache );
+}
+
+/*
+============
+idAASLocal::InsertRoutingCache
+
+  add a newly built cache to an area or portal cache index, when another thread
+  built the same cache in the meantime the existing one is kept
+  the cache lock must be held
+============
+*/
+idRoutingCache* idAASLocal::InsertRoutingCache( idRoutingCache** cacheList, idRoutingCache* cache ) const
+{
+	idRoutingCache* existing;
+	
+	for( existing = *cacheList; existing; existing = existing->next )
+	{
+		if( existing->travelFlags == cache->travelFlags )
 		{
-			clusterCache->prev = cache;
+			delete cache;
+			LinkCache( existing );
+			return existing;
 		}
-		areaCacheIndex[clusterNum][clusterAreaNum] = cache;
-		UpdateAreaRoutingCache( cache );
 	}
+	
+	cache->prev = NULL;
+	cache->next = *cacheList;
+	if( *cacheList )
+	{
+		( *cacheList )->prev = cache;
+	}
+	*cacheList = cache;
 	LinkCache( cache );
 	return cache;
 }
@@ -998,7 +1161,7 @@ idRoutingCache* idAASLocal::GetAreaRoutingCache( int clusterNum, int areaNum, in
 idAASLocal::UpdatePortalRoutingCache
 ============
 */
-void idAASLocal::UpdatePortalRoutingCache( idRoutingCache* portalCache ) const
+void idAASLocal::UpdatePortalRoutingCache( idRoutingContext* context, idRoutingCache* portalCache ) const
 {
 	int i, portalNum, clusterAreaNum;
 	unsigned short t;
@@ -1007,7 +1170,7 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache* portalCache ) const
 	idRoutingCache* cache;
 	idRoutingUpdate* updateListStart, *updateListEnd, *curUpdate, *nextUpdate;
 	
-	curUpdate = &portalUpdate[ file->GetNumPortals() ];
+	curUpdate = &context->portalUpdate[ file->GetNumPortals() ];
 	curUpdate->cluster = portalCache->cluster;
 	curUpdate->areaNum = portalCache->areaNum;
 	curUpdate->tmpTravelTime = portalCache->startTravelTime;
@@ -1037,7 +1200,7 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache* portalCache ) const
 		curUpdate->isInList = false;
 		
 		cluster = &file->GetCluster( curUpdate->cluster );
-		cache = GetAreaRoutingCache( curUpdate->cluster, curUpdate->areaNum, portalCache->travelFlags );
+		cache = GetAreaRoutingCache( context, curUpdate->cluster, curUpdate->areaNum, portalCache->travelFlags );
 		
 		// take all portals of the cluster
 		for( i = 0; i < cluster->numPortals; i++ )
@@ -1064,7 +1227,7 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache* portalCache ) const
 			
 				portalCache->travelTimes[portalNum] = t;
 				portalCache->reachabilities[portalNum] = cache->reachabilities[clusterAreaNum];
-				nextUpdate = &portalUpdate[portalNum];
+				nextUpdate = &context->portalUpdate[portalNum];
 				if( portal->clusters[0] == curUpdate->cluster )
 				{
 					nextUpdate->cluster = portal->clusters[1];
@@ -1103,10 +1266,18 @@ void idAASLocal::UpdatePortalRoutingCache( idRoutingCache* portalCache ) const
 idAASLocal::GetPortalRoutingCache
 ============
 */
-idRoutingCache* idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum, int travelFlags ) const
+idRoutingCache* idAASLocal::GetPortalRoutingCache( idRoutingContext* context, int clusterNum, int areaNum, int travelFlags ) const
 {
 	idRoutingCache* cache;
 	
+	// portal areas are read from the route table as long as nothing changed since it was built
+	cache = RouteTablePortalCache( clusterNum, areaNum, travelFlags );
+	if( cache )
+	{
+		return cache;
+	}
+	
+	cacheLock.Lock();
 	// check if cache without undesired travel flags already exists
 	for( cache = portalCacheIndex[areaNum]; cache; cache = cache->next )
 	{
@@ -1115,26 +1286,25 @@ idRoutingCache* idAASLocal::GetPortalRoutingCache( int clusterNum, int areaNum,
 			break;
 		}
 	}
-	// if no cache found
-	if( !cache )
-	{
-		cache = new( TAG_AAS ) idRoutingCache( file->GetNumPortals() );
-		cache->type = CACHETYPE_PORTAL;
-		cache->cluster = clusterNum;
-		cache->areaNum = areaNum;
-		cache->startTravelTime = 1;
-		cache->travelFlags = travelFlags;
-		cache->prev = NULL;
-		cache->next = portalCacheIndex[areaNum];
-		if( portalCacheIndex[areaNum] )
-		{
-			portalCacheIndex[areaNum]->prev = cache;
-		}
-		portalCacheIndex[areaNum] = cache;
-		UpdatePortalRoutingCache( cache );
+	if( cache )
+	{
+		LinkCache( cache );
+		cacheLock.Unlock();
+		return cache;
 	}
-	LinkCache( cache );
-	return cache;
+	cacheLock.Unlock();
+	
+	// build the cache outside the lock so other threads keep routing meanwhile
+	cache = new( TAG_AAS ) idRoutingCache( file->GetNumPortals() );
+	cache->type = CACHETYPE_PORTAL;
+	cache->cluster = clusterNum;
+	cache->areaNum = areaNum;
+	cache->startTravelTime = 1;
+	cache->travelFlags = travelFlags;
+	UpdatePortalRoutingCache( context, cache );
+	
+	idScopedCriticalSection lock( cacheLock );
+	return InsertRoutingCache( &portalCacheIndex[areaNum], cache );
 }
 
 /*
@@ -1143,6 +1313,30 @@ idAASLocal::RouteToGoalArea
 ============
 */
 bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int& travelTime, idReachability** reach ) const
+{
+	idRoutingContext* context;
+	bool result;
+	
+	travelTime = 0;
+	*reach = NULL;
+	
+	if( !file )
+	{
+		return false;
+	}
+	
+	context = AllocRoutingContext();
+	result = RouteToGoalArea( context, areaNum, origin, goalAreaNum, travelFlags, travelTime, reach );
+	FreeRoutingContext( context );
+	return result;
+}
+
+/*
+============
+idAASLocal::RouteToGoalArea
+============
+*/
+bool idAASLocal::RouteToGoalArea( idRoutingContext* context, int areaNum, const idVec3 origin, int goalAreaNum, int travelFlags, int& travelTime, idReachability** reach ) const
 {
 	int clusterNum, goalClusterNum, portalNum, i, clusterAreaNum;
 	unsigned short int t, bestTime;
@@ -1175,10 +1369,7 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		return false;
 	}
 	
-	while( totalCacheMemory > MAX_ROUTING_CACHE_MEMORY )
-	{
-		DeleteOldestCache();
-	}
+	DeleteOldCaches( 1 );
 	
 	clusterNum = file->GetArea( areaNum ).cluster;
 	goalClusterNum = file->GetArea( goalAreaNum ).cluster;
@@ -1194,7 +1385,7 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 			goalClusterNum = portal->clusters[0];
 		}
 		// get the portal routing cache
-		portalCache = GetPortalRoutingCache( goalClusterNum, goalAreaNum, travelFlags );
+		portalCache = GetPortalRoutingCache( context, goalClusterNum, goalAreaNum, travelFlags );
 		*reach = GetAreaReachability( areaNum, portalCache->reachabilities[-clusterNum] );
 		travelTime = portalCache->travelTimes[-clusterNum] + AreaTravelTime( areaNum, origin, ( *reach )->start );
 		return true;
@@ -1216,7 +1407,7 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 	// if both areas are in the same cluster
 	if( clusterNum > 0 && goalClusterNum > 0 && clusterNum == goalClusterNum )
 	{
-		clusterCache = GetAreaRoutingCache( clusterNum, goalAreaNum, travelFlags );
+		clusterCache = GetAreaRoutingCache( context, clusterNum, goalAreaNum, travelFlags );
 		clusterAreaNum = ClusterAreaNum( clusterNum, areaNum );
 		if( clusterCache->travelTimes[clusterAreaNum] )
 		{
@@ -1244,7 +1435,7 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		goalClusterNum = portal->clusters[0];
 	}
 	// get the portal routing cache
-	portalCache = GetPortalRoutingCache( goalClusterNum, goalAreaNum, travelFlags );
+	portalCache = GetPortalRoutingCache( context, goalClusterNum, goalAreaNum, travelFlags );
 	
 	// the cluster the area is in
 	cluster = &file->GetCluster( clusterNum );
@@ -1269,7 +1460,7 @@ bool idAASLocal::RouteToGoalArea( int areaNum, const idVec3 origin, int goalArea
 		
 		portal = &file->GetPortal( portalNum );
 		// get the cache of the portal area
-		areaCache = GetAreaRoutingCache( clusterNum, portal->areaNum, travelFlags );
+		areaCache = GetAreaRoutingCache( context, clusterNum, portal->areaNum, travelFlags );
 		// if the portal is not reachable from this area
 		if( !areaCache->travelTimes[clusterAreaNum] )
 		{
@@ -1338,12 +1529,136 @@ int idAASLocal::TravelTimeToGoalArea( int areaNum, const idVec3& origin, int goa
 	return travelTime;
 }
 
+/*
+===============================================================================
+
+	Batched routing
+
+===============================================================================
+*/
+
+#define AAS_MIN_ROUTES_PER_JOB		16			// smaller batches are not worth the job overhead
+
+typedef struct aasRouteJob_s
+{
+	const idAASLocal* 		aas;
+	aasRouteRequest_t* 		requests;
+	int						numRequests;
+} aasRouteJob_t;
+
+/*
+============
+AAS_RouteJob
+============
+*/
+static void AAS_RouteJob( aasRouteJob_t* job )
+{
+	job->aas->RouteRequests( job->requests, job->numRequests );
+}
+
+REGISTER_PARALLEL_JOB( AAS_RouteJob, "AAS_RouteJob" );
+
+/*
+============
+idAASLocal::RouteRequests
+============
+*/
+void idAASLocal::RouteRequests( aasRouteRequest_t* requests, const int numRequests ) const
+{
+	idRoutingContext* context = AllocRoutingContext();
+	for( int i = 0; i < numRequests; i++ )
+	{
+		aasRouteRequest_t& r = requests[i];
+		r.reachable = RouteToGoalArea( context, r.areaNum, r.origin, r.goalAreaNum, r.travelFlags, r.travelTime, &r.reach );
+	}
+	FreeRoutingContext( context );
+}
+
+/*
+============
+idAASLocal::RouteToGoalAreas
+
+  Each job routes a contiguous slice of the requests with a routing context of
+  its own. The cluster and portal caches are shared between the jobs, a cache
+  built by one job is immediately used by the others. Old caches are only
+  deleted once the jobs are done.
+============
+*/
+void idAASLocal::RouteToGoalAreas( aasRouteRequest_t* requests, const int numRequests ) const
+{
+	int i, numJobs;
+	
+	if( !file )
+	{
+		for( i = 0; i < numRequests; i++ )
+		{
+			requests[i].reachable = false;
+			requests[i].travelTime = 0;
+			requests[i].reach = NULL;
+		}
+		return;
+	}
+	
+	numJobs = Min( numRequests / AAS_MIN_ROUTES_PER_JOB, AAS_MAX_ROUTING_CONTEXTS );
+	numJobs = Min( numJobs, parallelJobManager->GetNumProcessingUnits() + 1 );
+	
+	if( numJobs <= 1 )
+	{
+		RouteRequests( requests, numRequests );
+		return;
+	}
+	
+	aasRouteJob_t jobs[AAS_MAX_ROUTING_CONTEXTS];
+	idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, numJobs, 0, NULL );
+	
+	int first = 0;
+	for( i = 0; i < numJobs; i++ )
+	{
+		const int last = ( numRequests * ( i + 1 ) ) / numJobs;
+		jobs[i].aas = this;
+		jobs[i].requests = requests + first;
+		jobs[i].numRequests = last - first;
+		jobList->AddJob( ( jobRun_t )AAS_RouteJob, &jobs[i] );
+		first = last;
+	}
+	
+	jobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+	jobList->Wait();
+	parallelJobManager->FreeJobList( jobList );
+	
+	// the jobs may have grown the cache past the limit while they were sharing it
+	DeleteOldCaches( 0 );
+}
+
 /*
 ============
 idAASLocal::FindNearestGoal
 ============
 */
 bool idAASLocal::FindNearestGoal( aasGoal_t& goal, int areaNum, const idVec3 origin, const idVec3& target, int travelFlags, aasObstacle_t* obstacles, int numObstacles, idAASCallback& callback ) const
+{
+	idRoutingContext* context;
+	bool result;
+	
+	if( file == NULL || areaNum <= 0 )
+	{
+		goal.areaNum = areaNum;
+		goal.origin = origin;
+		return false;
+	}
+	
+	context = AllocRoutingContext();
+	result = FindNearestGoal( context, goal, areaNum, origin, target, travelFlags, obstacles, numObstacles, callback );
+	FreeRoutingContext( context );
+	return result;
+}
+
+/*
+============
+idAASLocal::FindNearestGoal
+============
+*/
+bool idAASLocal::FindNearestGoal( idRoutingContext* context, aasGoal_t& goal, int areaNum, const idVec3 origin, const idVec3& target, int travelFlags, aasObstacle_t* obstacles, int numObstacles, idAASCallback& callback ) const
 {
 	int i, j, k, badTravelFlags, nextAreaNum, bestAreaNum;
 	unsigned short t, bestTravelTime;
@@ -1376,12 +1691,12 @@ bool idAASLocal::FindNearestGoal( aasGoal_t& goal, int areaNum, const idVec3 ori
 	}
 	
 	badTravelFlags = ~travelFlags;
-	SIMDProcessor->Memset( goalAreaTravelTimes, 0, file->GetNumAreas() * sizeof( unsigned short ) );
+	SIMDProcessor->Memset( context->goalAreaTravelTimes, 0, file->GetNumAreas() * sizeof( unsigned short ) );
 	
 	targetDist = ( target - origin ).Length();
 	
 	// initialize first update
-	curUpdate = &areaUpdate[areaNum];
+	curUpdate = &context->areaUpdate[areaNum];
 	curUpdate->areaNum = areaNum;
 	curUpdate->tmpTravelTime = 0;
 	curUpdate->start = origin;
@@ -1476,7 +1791,7 @@ bool idAASLocal::FindNearestGoal( aasGoal_t& goal, int areaNum, const idVec3 ori
 			}
 			
 			// if this is not the best path towards the next area
-			if( goalAreaTravelTimes[nextAreaNum] && t >= goalAreaTravelTimes[nextAreaNum] )
+			if( context->goalAreaTravelTimes[nextAreaNum] && t >= context->goalAreaTravelTimes[nextAreaNum] )
 			{
 				continue;
 			}
@@ -1495,8 +1810,8 @@ bool idAASLocal::FindNearestGoal( aasGoal_t& goal, int areaNum, const idVec3 ori
 				continue;
 			}
 			
-			goalAreaTravelTimes[nextAreaNum] = t;
-			nextUpdate = &areaUpdate[nextAreaNum];
+			context->goalAreaTravelTimes[nextAreaNum] = t;
+			nextUpdate = &context->areaUpdate[nextAreaNum];
 			nextUpdate->areaNum = nextAreaNum;
 			nextUpdate->tmpTravelTime = t;
 			nextUpdate->start = reach->end;
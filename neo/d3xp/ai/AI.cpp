@@ -1721,6 +1721,67 @@ float idAI::TravelDistance( const idVec3& start, const idVec3& end ) const
 	return travelTime;
 }
 
+/*
+=====================
+idAI::TravelDistances
+
+Same as TravelDistance for several goals, the routes are computed as one batch.
+=====================
+*/
+void idAI::TravelDistances( const idVec3& start, const idVec3* ends, float* distances, const int numEnds ) const
+{
+	int			i;
+	int			fromArea;
+	int			toArea;
+	idVec2		delta;
+	
+	if( !aas || ai_debugMove.GetBool() )
+	{
+		for( i = 0; i < numEnds; i++ )
+		{
+			distances[i] = TravelDistance( start, ends[i] );
+		}
+		return;
+	}
+	
+	idList<aasRouteRequest_t> requests;
+	idList<int> requestEnds;
+	
+	fromArea = PointReachableAreaNum( start );
+	for( i = 0; i < numEnds; i++ )
+	{
+		toArea = PointReachableAreaNum( ends[i] );
+		
+		if( !fromArea || !toArea )
+		{
+			// can't seem to get there
+			distances[i] = -1;
+		}
+		else if( fromArea == toArea )
+		{
+			// same area, so just take the straight line distance
+			delta = ends[i].ToVec2() - start.ToVec2();
+			distances[i] = delta.LengthFast();
+		}
+		else
+		{
+			aasRouteRequest_t& request = requests.Alloc();
+			request.areaNum = fromArea;
+			request.origin = start;
+			request.goalAreaNum = toArea;
+			request.travelFlags = travelFlags;
+			requestEnds.Append( i );
+		}
+	}
+	
+	aas->RouteToGoalAreas( requests.Ptr(), requests.Num() );
+	
+	for( i = 0; i < requests.Num(); i++ )
+	{
+		distances[requestEnds[i]] = requests[i].reachable ? requests[i].travelTime : -1;
+	}
+}
+
 /*
 =====================
 idAI::StopMove
@@ -499,6 +499,7 @@ protected:
 	void					KickObstacles( const idVec3& dir, float force, idEntity* alwaysKick );
 	bool					ReachedPos( const idVec3& pos, const moveCommand_t moveCommand ) const;
 	float					TravelDistance( const idVec3& start, const idVec3& end ) const;
+	void					TravelDistances( const idVec3& start, const idVec3* ends, float* distances, const int numEnds ) const;
 	int						PointReachableAreaNum( const idVec3& pos, const float boundsScale = 2.0f ) const;
 	bool					PathToGoal( aasPath_t& path, int areaNum, const idVec3& origin, int goalAreaNum, const idVec3& goalOrigin ) const;
 	void					DrawRoute() const;
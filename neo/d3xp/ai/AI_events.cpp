@@ -2563,22 +2563,33 @@ void idAI::Event_GetClosestHiddenTarget( const char* type )
 		return;
 	}
 	
-	bestEnt = NULL;
-	bestTime = idMath::INFINITY;
+	// route to all targets of the type at once
+	idList<idEntity*> ents;
+	idList<idVec3> destOrgs;
+	idList<float> times;
 	for( i = 0; i < targets.Num(); i++ )
 	{
 		ent = targets[ i ].GetEntity();
 		if( ent != NULL && idStr::Cmp( ent->GetEntityDefName(), type ) == 0 )
 		{
-			const idVec3& destOrg = ent->GetPhysics()->GetOrigin();
-			time = TravelDistance( org, destOrg );
-			if( ( time >= 0.0f ) && ( time < bestTime ) )
+			ents.Append( ent );
+			destOrgs.Append( ent->GetPhysics()->GetOrigin() );
+		}
+	}
+	times.SetNum( ents.Num() );
+	TravelDistances( org, destOrgs.Ptr(), times.Ptr(), ents.Num() );
+	
+	bestEnt = NULL;
+	bestTime = idMath::INFINITY;
+	for( i = 0; i < ents.Num(); i++ )
+	{
+		time = times[ i ];
+		if( ( time >= 0.0f ) && ( time < bestTime ) )
+		{
+			if( !EntityCanSeePos( enemyEnt, lastVisibleEnemyPos, destOrgs[ i ] ) )
 			{
-				if( !EntityCanSeePos( enemyEnt, lastVisibleEnemyPos, destOrg ) )
-				{
-					bestEnt = ent;
-					bestTime = time;
-				}
+				bestEnt = ents[ i ];
+				bestTime = time;
 			}
 		}
 	}
@@ -33,14 +33,51 @@ If you have questions concerning this license or the applicable additional terms
 #include "../Game_local.h"
 
 idCVar binaryLoadAnim( "binaryLoadAnim", "1", 0, "enable binary load/write of idMD5Anim" ); // koz fixme does this need to be archived?
+idCVar binaryCompressAnim( "binaryCompressAnim", "0", CVAR_BOOL, "write quantized frames to the idMD5Anim binary files" );
+idCVar binaryCompressAnimTranslationError( "binaryCompressAnimTranslationError", "0.01", CVAR_FLOAT, "max error in units of a compressed joint translation component" );
+idCVar binaryCompressAnimRotationError( "binaryCompressAnimRotationError", "0.0005", CVAR_FLOAT, "max error of a compressed joint quaternion component" );
 
 static const byte B_ANIM_MD5_VERSION = 101;
 static const unsigned int B_ANIM_MD5_MAGIC = ( 'B' << 24 ) | ( 'M' << 16 ) | ( 'D' << 8 ) | B_ANIM_MD5_VERSION;
 
+static const byte B_ANIM_MD5_COMPRESSED_VERSION = 1;
+static const unsigned int B_ANIM_MD5_COMPRESSED_MAGIC = ( 'B' << 24 ) | ( 'M' << 16 ) | ( 'C' << 8 ) | B_ANIM_MD5_COMPRESSED_VERSION;
+
 static const int JOINT_FRAME_PAD	= 1;	// one extra to be able to read one more float than is necessary
 
 bool idAnimManager::forceExport = false;
 
+/*
+====================
+NumJointComponents
+====================
+*/
+static int NumJointComponents( int animBits )
+{
+	int num = 0;
+	for( int i = ANIM_BIT_TX; i <= ANIM_BIT_QZ; i++ )
+	{
+		if( animBits & BIT( i ) )
+		{
+			num++;
+		}
+	}
+	return num;
+}
+
+/*
+====================
+GeneratedAnimFileName
+====================
+*/
+static idStr GeneratedAnimFileName( const char* filename )
+{
+	idStr generatedFileName = "generated/anim/";
+	generatedFileName.AppendPath( filename );
+	generatedFileName.SetFileExtension( ".bMD5anim" );
+	return generatedFileName;
+}
+
 /***********************************************************************
 
 	idMD5Anim
@@ -60,6 +97,7 @@ idMD5Anim::idMD5Anim()
 	frameRate	= 24;
 	animLength	= 0;
 	numAnimatedComponents = 0;
+	numComponents16 = 0;
 	totaldelta.Zero();
 }
 
@@ -92,6 +130,13 @@ void idMD5Anim::Free()
 	jointInfo.Clear();
 	bounds.Clear();
 	componentFrames.Clear();
+	
+	numComponents16 = 0;
+	compressedBaseFrame.Clear();
+	quantizedFrames16.Clear();
+	quantizedFrames8.Clear();
+	componentScale.Clear();
+	componentBias.Clear();
 }
 
 /*
@@ -199,6 +244,7 @@ idMD5Anim::Allocated
 size_t idMD5Anim::Allocated() const
 {
 	size_t	size = bounds.Allocated() + jointInfo.Allocated() + componentFrames.Allocated() + name.Allocated();
+	size += compressedBaseFrame.Allocated() + quantizedFrames16.Allocated() + quantizedFrames8.Allocated() + componentScale.Allocated() + componentBias.Allocated();
 	return size;
 }
 
@@ -209,13 +255,7 @@ idMD5Anim::LoadAnim
 */
 bool idMD5Anim::LoadAnim( const char* filename )
 {
-
-	idLexer	parser( LEXFL_ALLOWPATHNAMES | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT );
-	idToken	token;
-	
-	idStr generatedFileName = "generated/anim/";
-	generatedFileName.AppendPath( filename );
-	generatedFileName.SetFileExtension( ".bMD5anim" );
+	idStr generatedFileName = GeneratedAnimFileName( filename );
 	
 	// Get the timestamp on the original file, if it's newer than what is stored in binary model, regenerate it
 	ID_TIME_T sourceTimeStamp = fileSystem->GetTimestamp( filename );
@@ -232,6 +272,40 @@ bool idMD5Anim::LoadAnim( const char* filename )
 		return true;
 	}
 	
+	if( !ParseAnim( filename ) )
+	{
+		return false;
+	}
+	
+	if( binaryCompressAnim.GetBool() )
+	{
+		animCompressionStats_t stats;
+		Compress( binaryCompressAnimTranslationError.GetFloat(), binaryCompressAnimRotationError.GetFloat(), stats );
+	}
+	
+	if( binaryLoadAnim.GetBool() )
+	{
+		idLib::Printf( "Writing %s\n", generatedFileName.c_str() );
+		idFileLocal outputFile( fileSystem->OpenFileWrite( generatedFileName, "fs_basepath" ) );
+		WriteBinary( outputFile, sourceTimeStamp );
+	}
+	
+	// done
+	return true;
+}
+
+/*
+====================
+idMD5Anim::ParseAnim
+
+Parses the text .md5anim file, doesn't look at the binary file.
+====================
+*/
+bool idMD5Anim::ParseAnim( const char* filename )
+{
+	idLexer	parser( LEXFL_ALLOWPATHNAMES | LEXFL_NOSTRINGESCAPECHARS | LEXFL_NOSTRINGCONCAT );
+	idToken	token;
+	
 	if( !parser.LoadFile( filename ) )
 	{
 		return false;
@@ -426,14 +500,6 @@ bool idMD5Anim::LoadAnim( const char* filename )
 	// we don't count last frame because it would cause a 1 frame pause at the end
 	animLength = ( ( numFrames - 1 ) * 1000 + frameRate - 1 ) / frameRate;
 	
-	if( binaryLoadAnim.GetBool() )
-	{
-		idLib::Printf( "Writing %s\n", generatedFileName.c_str() );
-		idFileLocal outputFile( fileSystem->OpenFileWrite( generatedFileName, "fs_basepath" ) );
-		WriteBinary( outputFile, sourceTimeStamp );
-	}
-	
-	// done
 	return true;
 }
 
@@ -452,10 +518,11 @@ bool idMD5Anim::LoadBinary( idFile* file, ID_TIME_T sourceTimeStamp )
 	
 	unsigned int magic = 0;
 	file->ReadBig( magic );
-	if( magic != B_ANIM_MD5_MAGIC )
+	if( magic != B_ANIM_MD5_MAGIC && magic != B_ANIM_MD5_COMPRESSED_MAGIC )
 	{
 		return false;
 	}
+	const bool compressed = ( magic == B_ANIM_MD5_COMPRESSED_MAGIC );
 	
 	ID_TIME_T loadedTimeStamp;
 	file->ReadBig( loadedTimeStamp );
@@ -466,6 +533,12 @@ bool idMD5Anim::LoadBinary( idFile* file, ID_TIME_T sourceTimeStamp )
 		return false;
 	}
 	// RB end
+	
+	// regenerate from the source when binaryCompressAnim was changed
+	if( !fileSystem->InProductionMode() && ( sourceTimeStamp != FILE_NOT_FOUND_TIMESTAMP ) && ( sourceTimeStamp != 0 ) && ( compressed != binaryCompressAnim.GetBool() ) )
+	{
+		return false;
+	}
 
 	file->ReadBig( numFrames );
 	file->ReadBig( frameRate );
@@ -518,11 +591,52 @@ bool idMD5Anim::LoadBinary( idFile* file, ID_TIME_T sourceTimeStamp )
 		j.w = 0.0f;
 	}
 	
-	file->ReadBig( num );
-	componentFrames.SetNum( num + JOINT_FRAME_PAD );
-	for( int i = 0; i < componentFrames.Num(); i++ )
+	if( compressed )
 	{
-		file->ReadFloat( componentFrames[i] );
+		componentFrames.Clear();
+		
+		file->ReadBig( numComponents16 );
+		
+		compressedBaseFrame.SetNum( baseFrame.Num() );
+		for( int i = 0; i < compressedBaseFrame.Num(); i++ )
+		{
+			idJointQuat& j = compressedBaseFrame[i];
+			file->ReadBig( j.q.x );
+			file->ReadBig( j.q.y );
+			file->ReadBig( j.q.z );
+			file->ReadBig( j.q.w );
+			file->ReadVec3( j.t );
+			j.w = 0.0f;
+		}
+		
+		componentScale.SetNum( numAnimatedComponents );
+		file->ReadBigArray( componentScale.Ptr(), componentScale.Num() );
+		componentBias.SetNum( numAnimatedComponents );
+		file->ReadBigArray( componentBias.Ptr(), componentBias.Num() );
+		
+		file->ReadBig( num );
+		quantizedFrames16.SetNum( num );
+		file->ReadBigArray( quantizedFrames16.Ptr(), quantizedFrames16.Num() );
+		
+		file->ReadBig( num );
+		quantizedFrames8.SetNum( num );
+		file->Read( quantizedFrames8.Ptr(), quantizedFrames8.Num() );
+	}
+	else
+	{
+		numComponents16 = 0;
+		compressedBaseFrame.Clear();
+		quantizedFrames16.Clear();
+		quantizedFrames8.Clear();
+		componentScale.Clear();
+		componentBias.Clear();
+		
+		file->ReadBig( num );
+		componentFrames.SetNum( num + JOINT_FRAME_PAD );
+		for( int i = 0; i < componentFrames.Num(); i++ )
+		{
+			file->ReadFloat( componentFrames[i] );
+		}
 	}
 	
 	//file->ReadString( name );
@@ -545,7 +659,7 @@ void idMD5Anim::WriteBinary( idFile* file, ID_TIME_T sourceTimeStamp )
 		return;
 	}
 	
-	file->WriteBig( B_ANIM_MD5_MAGIC );
+	file->WriteBig( IsCompressed() ? B_ANIM_MD5_COMPRESSED_MAGIC : B_ANIM_MD5_MAGIC );
 	file->WriteBig( sourceTimeStamp );
 	
 	file->WriteBig( numFrames );
@@ -584,10 +698,36 @@ void idMD5Anim::WriteBinary( idFile* file, ID_TIME_T sourceTimeStamp )
 		file->WriteVec3( j.t );
 	}
 	
-	file->WriteBig( componentFrames.Num() - JOINT_FRAME_PAD );
-	for( int i = 0; i < componentFrames.Num(); i++ )
+	if( IsCompressed() )
+	{
+		file->WriteBig( numComponents16 );
+		
+		for( int i = 0; i < compressedBaseFrame.Num(); i++ )
+		{
+			idJointQuat& j = compressedBaseFrame[i];
+			file->WriteBig( j.q.x );
+			file->WriteBig( j.q.y );
+			file->WriteBig( j.q.z );
+			file->WriteBig( j.q.w );
+			file->WriteVec3( j.t );
+		}
+		
+		file->WriteBigArray( componentScale.Ptr(), componentScale.Num() );
+		file->WriteBigArray( componentBias.Ptr(), componentBias.Num() );
+		
+		file->WriteBig( quantizedFrames16.Num() );
+		file->WriteBigArray( quantizedFrames16.Ptr(), quantizedFrames16.Num() );
+		
+		file->WriteBig( quantizedFrames8.Num() );
+		file->Write( quantizedFrames8.Ptr(), quantizedFrames8.Num() );
+	}
+	else
 	{
-		file->WriteFloat( componentFrames[i] );
+		file->WriteBig( componentFrames.Num() - JOINT_FRAME_PAD );
+		for( int i = 0; i < componentFrames.Num(); i++ )
+		{
+			file->WriteFloat( componentFrames[i] );
+		}
 	}
 	
 	//file->WriteString( name );
@@ -713,7 +853,7 @@ idMD5Anim::GetOrigin
 */
 void idMD5Anim::GetOrigin( idVec3& offset, int time, int cyclecount ) const
 {
-	offset = baseFrame[ 0 ].t;
+	offset = AnimatedBaseFrame()[ 0 ].t;
 	if( !( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) ) )
 	{
 		// just use the baseframe
@@ -723,8 +863,10 @@ void idMD5Anim::GetOrigin( idVec3& offset, int time, int cyclecount ) const
 	frameBlend_t frame;
 	ConvertTimeToFrame( time, cyclecount, frame );
 	
-	const float* componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float* componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float buffer1[6], buffer2[6];
+	const int numComponents = NumJointComponents( jointInfo[ 0 ].animBits );
+	const float* componentPtr1 = GetFrameComponents( frame.frame1, jointInfo[ 0 ].firstComponent, numComponents, buffer1 );
+	const float* componentPtr2 = GetFrameComponents( frame.frame2, jointInfo[ 0 ].firstComponent, numComponents, buffer2 );
 	
 	if( jointInfo[ 0 ].animBits & ANIM_TX )
 	{
@@ -758,19 +900,22 @@ idMD5Anim::GetOriginRotation
 */
 void idMD5Anim::GetOriginRotation( idQuat& rotation, int time, int cyclecount ) const
 {
+	const idJointQuat& base = AnimatedBaseFrame()[ 0 ];
 	int animBits = jointInfo[ 0 ].animBits;
 	if( !( animBits & ( ANIM_QX | ANIM_QY | ANIM_QZ ) ) )
 	{
 		// just use the baseframe
-		rotation = baseFrame[ 0 ].q;
+		rotation = base.q;
 		return;
 	}
 	
 	frameBlend_t frame;
 	ConvertTimeToFrame( time, cyclecount, frame );
 	
-	const float*	jointframe1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-	const float*	jointframe2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+	float			buffer1[6], buffer2[6];
+	const int		numComponents = NumJointComponents( animBits );
+	const float*	jointframe1 = GetFrameComponents( frame.frame1, jointInfo[ 0 ].firstComponent, numComponents, buffer1 );
+	const float*	jointframe2 = GetFrameComponents( frame.frame2, jointInfo[ 0 ].firstComponent, numComponents, buffer2 );
 	
 	if( animBits & ANIM_TX )
 	{
@@ -798,9 +943,9 @@ void idMD5Anim::GetOriginRotation( idQuat& rotation, int time, int cyclecount )
 		case ANIM_QX:
 			q1.x = jointframe1[0];
 			q2.x = jointframe2[0];
-			q1.y = baseFrame[ 0 ].q.y;
+			q1.y = base.q.y;
 			q2.y = q1.y;
-			q1.z = baseFrame[ 0 ].q.z;
+			q1.z = base.q.z;
 			q2.z = q1.z;
 			q1.w = q1.CalcW();
 			q2.w = q2.CalcW();
@@ -808,9 +953,9 @@ void idMD5Anim::GetOriginRotation( idQuat& rotation, int time, int cyclecount )
 		case ANIM_QY:
 			q1.y = jointframe1[0];
 			q2.y = jointframe2[0];
-			q1.x = baseFrame[ 0 ].q.x;
+			q1.x = base.q.x;
 			q2.x = q1.x;
-			q1.z = baseFrame[ 0 ].q.z;
+			q1.z = base.q.z;
 			q2.z = q1.z;
 			q1.w = q1.CalcW();
 			q2.w = q2.CalcW();
@@ -818,9 +963,9 @@ void idMD5Anim::GetOriginRotation( idQuat& rotation, int time, int cyclecount )
 		case ANIM_QZ:
 			q1.z = jointframe1[0];
 			q2.z = jointframe2[0];
-			q1.x = baseFrame[ 0 ].q.x;
+			q1.x = base.q.x;
 			q2.x = q1.x;
-			q1.y = baseFrame[ 0 ].q.y;
+			q1.y = base.q.y;
 			q2.y = q1.y;
 			q1.w = q1.CalcW();
 			q2.w = q2.CalcW();
@@ -830,7 +975,7 @@ void idMD5Anim::GetOriginRotation( idQuat& rotation, int time, int cyclecount )
 			q1.y = jointframe1[1];
 			q2.x = jointframe2[0];
 			q2.y = jointframe2[1];
-			q1.z = baseFrame[ 0 ].q.z;
+			q1.z = base.q.z;
 			q2.z = q1.z;
 			q1.w = q1.CalcW();
 			q2.w = q2.CalcW();
@@ -840,7 +985,7 @@ void idMD5Anim::GetOriginRotation( idQuat& rotation, int time, int cyclecount )
 			q1.z = jointframe1[1];
 			q2.x = jointframe2[0];
 			q2.z = jointframe2[1];
-			q1.y = baseFrame[ 0 ].q.y;
+			q1.y = base.q.y;
 			q2.y = q1.y;
 			q1.w = q1.CalcW();
 			q2.w = q2.CalcW();
@@ -850,7 +995,7 @@ void idMD5Anim::GetOriginRotation( idQuat& rotation, int time, int cyclecount )
 			q1.z = jointframe1[1];
 			q2.y = jointframe2[0];
 			q2.z = jointframe2[1];
-			q1.x = baseFrame[ 0 ].q.x;
+			q1.x = base.q.x;
 			q2.x = q1.x;
 			q1.w = q1.CalcW();
 			q2.w = q2.CalcW();
@@ -884,11 +1029,13 @@ void idMD5Anim::GetBounds( idBounds& bnds, int time, int cyclecount ) const
 	bnds.AddBounds( bounds[ frame.frame2 ] );
 	
 	// origin position
-	idVec3 offset = baseFrame[ 0 ].t;
+	idVec3 offset = AnimatedBaseFrame()[ 0 ].t;
 	if( jointInfo[ 0 ].animBits & ( ANIM_TX | ANIM_TY | ANIM_TZ ) )
 	{
-		const float* componentPtr1 = &componentFrames[ numAnimatedComponents * frame.frame1 + jointInfo[ 0 ].firstComponent ];
-		const float* componentPtr2 = &componentFrames[ numAnimatedComponents * frame.frame2 + jointInfo[ 0 ].firstComponent ];
+		float buffer1[6], buffer2[6];
+		const int numComponents = NumJointComponents( jointInfo[ 0 ].animBits );
+		const float* componentPtr1 = GetFrameComponents( frame.frame1, jointInfo[ 0 ].firstComponent, numComponents, buffer1 );
+		const float* componentPtr2 = GetFrameComponents( frame.frame2, jointInfo[ 0 ].firstComponent, numComponents, buffer2 );
 		
 		if( jointInfo[ 0 ].animBits & ANIM_TX )
 		{
@@ -995,7 +1142,7 @@ idMD5Anim::GetInterpolatedFrame
 void idMD5Anim::GetInterpolatedFrame( frameBlend_t& frame, idJointQuat* joints, const int* index, int numIndexes ) const
 {
 	// copy the baseframe
-	SIMDProcessor->Memcpy( joints, baseFrame.Ptr(), baseFrame.Num() * sizeof( baseFrame[ 0 ] ) );
+	SIMDProcessor->Memcpy( joints, AnimatedBaseFrame(), baseFrame.Num() * sizeof( baseFrame[ 0 ] ) );
 	
 	if( numAnimatedComponents == 0 )
 	{
@@ -1006,8 +1153,27 @@ void idMD5Anim::GetInterpolatedFrame( frameBlend_t& frame, idJointQuat* joints,
 	idJointQuat* blendJoints = ( idJointQuat* )_alloca16( baseFrame.Num() * sizeof( blendJoints[ 0 ] ) );
 	int* lerpIndex = ( int* )_alloca16( baseFrame.Num() * sizeof( lerpIndex[ 0 ] ) );
 	
-	const float* frame1 = &componentFrames[frame.frame1 * numAnimatedComponents];
-	const float* frame2 = &componentFrames[frame.frame2 * numAnimatedComponents];
+	const float* frame1;
+	const float* frame2;
+	if( IsCompressed() )
+	{
+		// decode the quantized frames, the joints are decoded from the floats as usual
+		float* components = ( float* )_alloca16( 2 * numAnimatedComponents * sizeof( components[ 0 ] ) );
+		frame1 = GetJointFrameComponents( frame.frame1, index, numIndexes, components );
+		if( frame.frame2 != frame.frame1 )
+		{
+			frame2 = GetJointFrameComponents( frame.frame2, index, numIndexes, components + numAnimatedComponents );
+		}
+		else
+		{
+			frame2 = frame1;
+		}
+	}
+	else
+	{
+		frame1 = &componentFrames[frame.frame1 * numAnimatedComponents];
+		frame2 = &componentFrames[frame.frame2 * numAnimatedComponents];
+	}
 	
 	int numLerpJoints = DecodeInterpolatedFrames( joints, blendJoints, lerpIndex, frame1, frame2, jointInfo.Ptr(), index, numIndexes );
 	
@@ -1084,20 +1250,319 @@ idMD5Anim::GetSingleFrame
 */
 void idMD5Anim::GetSingleFrame( int framenum, idJointQuat* joints, const int* index, int numIndexes ) const
 {
-	// copy the baseframe
-	SIMDProcessor->Memcpy( joints, baseFrame.Ptr(), baseFrame.Num() * sizeof( baseFrame[ 0 ] ) );
-	
 	if( framenum == 0 || numAnimatedComponents == 0 )
 	{
 		// just use the base frame
+		SIMDProcessor->Memcpy( joints, baseFrame.Ptr(), baseFrame.Num() * sizeof( baseFrame[ 0 ] ) );
 		return;
 	}
 	
-	const float* frame = &componentFrames[framenum * numAnimatedComponents];
+	// copy the baseframe
+	SIMDProcessor->Memcpy( joints, AnimatedBaseFrame(), baseFrame.Num() * sizeof( baseFrame[ 0 ] ) );
+	
+	float* components = IsCompressed() ? ( float* )_alloca16( numAnimatedComponents * sizeof( components[ 0 ] ) ) : NULL;
+	const float* frame = GetJointFrameComponents( framenum, index, numIndexes, components );
 	
 	DecodeSingleFrame( joints, frame, jointInfo.Ptr(), index, numIndexes );
 }
 
+/*
+====================
+idMD5Anim::IsCompressed
+====================
+*/
+bool idMD5Anim::IsCompressed() const
+{
+	// the raw frames always have the padding
+	return ( componentFrames.Num() == 0 );
+}
+
+/*
+====================
+idMD5Anim::AnimatedBaseFrame
+
+The base frame the animated components are decoded on top of.
+====================
+*/
+const idJointQuat* idMD5Anim::AnimatedBaseFrame() const
+{
+	return IsCompressed() ? compressedBaseFrame.Ptr() : baseFrame.Ptr();
+}
+
+/*
+====================
+idMD5Anim::GetFrameComponents
+
+Returns the animated components [firstComponent, firstComponent + numComponents) of the
+frame. Compressed frames are decoded into buffer, which must hold numComponents floats.
+====================
+*/
+const float* idMD5Anim::GetFrameComponents( int framenum, int firstComponent, int numComponents, float* buffer ) const
+{
+	if( !IsCompressed() )
+	{
+		return componentFrames.Ptr() + framenum * numAnimatedComponents + firstComponent;
+	}
+	
+	const int lastComponent = firstComponent + numComponents;
+	
+	if( firstComponent < numComponents16 )
+	{
+		const int num = Min( lastComponent, numComponents16 ) - firstComponent;
+		const unsigned short* src = quantizedFrames16.Ptr() + framenum * numComponents16 + firstComponent;
+		SIMDProcessor->DequantizeComponents( buffer, src, componentScale.Ptr() + firstComponent, componentBias.Ptr() + firstComponent, num );
+	}
+	
+	if( lastComponent > numComponents16 )
+	{
+		const int first = Max( firstComponent, numComponents16 );
+		const int numComponents8 = numAnimatedComponents - numComponents16;
+		const byte* src = quantizedFrames8.Ptr() + framenum * numComponents8 + ( first - numComponents16 );
+		SIMDProcessor->DequantizeComponents( buffer + ( first - firstComponent ), src, componentScale.Ptr() + first, componentBias.Ptr() + first, lastComponent - first );
+	}
+	
+	return buffer;
+}
+
+/*
+====================
+idMD5Anim::GetJointFrameComponents
+
+Returns all animated components of the frame, but compressed frames only get the components
+of the indexed joints decoded into buffer, which must hold numAnimatedComponents floats. The
+components of a joint are contiguous and stored with the same bits, so each joint is a single
+run. When most of the joints are asked for the whole frame is decoded in one pass.
+====================
+*/
+const float* idMD5Anim::GetJointFrameComponents( int framenum, const int* index, int numIndexes, float* buffer ) const
+{
+	if( !IsCompressed() || numIndexes * 2 >= numJoints )
+	{
+		return GetFrameComponents( framenum, 0, numAnimatedComponents, buffer );
+	}
+	
+	for( int i = 0; i < numIndexes; i++ )
+	{
+		const jointAnimInfo_t& info = jointInfo[ index[ i ] ];
+		if( info.animBits == 0 )
+		{
+			continue;
+		}
+		GetFrameComponents( framenum, info.firstComponent, idMath::BitCount( info.animBits ), buffer + info.firstComponent );
+	}
+	
+	return buffer;
+}
+
+/*
+====================
+idMD5Anim::Compress
+
+Replaces the raw frames with quantized frames. Components that stay within the error
+bound for the whole anim are folded into a copy of the base frame. The components of a joint are
+stored with 8 bits when that keeps all of them within the error bound, otherwise with 16
+bits. The 16 bit joints come first in the frame so both parts decode in a single pass.
+The error is measured on the decoded joint quaternions and translations of every frame.
+====================
+*/
+void idMD5Anim::Compress( float maxTranslationError, float maxRotationError, animCompressionStats_t& stats )
+{
+	memset( &stats, 0, sizeof( stats ) );
+	stats.sizeBefore = Allocated();
+	
+	if( IsCompressed() || numAnimatedComponents == 0 )
+	{
+		stats.sizeAfter = stats.sizeBefore;
+		return;
+	}
+	
+	// keep the raw anim around to measure the error
+	const idList<jointAnimInfo_t, TAG_MD5_ANIM> rawJointInfo = jointInfo;
+	const int rawNumComponents = numAnimatedComponents;
+	const idList<float, TAG_MD5_ANIM> rawFrames = componentFrames;
+	componentFrames.Clear();
+	
+	idList<float, TAG_MD5_ANIM> componentMin;
+	idList<float, TAG_MD5_ANIM> componentMax;
+	componentMin.SetNum( rawNumComponents );
+	componentMax.SetNum( rawNumComponents );
+	for( int c = 0; c < rawNumComponents; c++ )
+	{
+		componentMin[c] = componentMax[c] = rawFrames[c];
+		for( int f = 1; f < numFrames; f++ )
+		{
+			const float value = rawFrames[f * rawNumComponents + c];
+			componentMin[c] = Min( componentMin[c], value );
+			componentMax[c] = Max( componentMax[c], value );
+		}
+	}
+	
+	// remove the constant components and pick the bits per joint
+	compressedBaseFrame = baseFrame;
+	idList<int, TAG_MD5_ANIM> jointBits;
+	jointBits.SetNum( numJoints );
+	for( int j = 0; j < numJoints; j++ )
+	{
+		jointAnimInfo_t& info = jointInfo[j];
+		int component = info.firstComponent;
+		bool foldedRotation = false;
+		bool fits8 = ( j != 0 );	// the origin joint moves the entity, so it always gets 16 bits
+		
+		for( int b = ANIM_BIT_TX; b <= ANIM_BIT_QZ; b++ )
+		{
+			if( !( info.animBits & BIT( b ) ) )
+			{
+				continue;
+			}
+			
+			const float tolerance = ( b <= ANIM_BIT_TZ ) ? maxTranslationError : maxRotationError;
+			const float range = componentMax[component] - componentMin[component];
+			if( range * 0.5f <= tolerance )
+			{
+				const float value = ( componentMin[component] + componentMax[component] ) * 0.5f;
+				if( b <= ANIM_BIT_TZ )
+				{
+					compressedBaseFrame[j].t[b - ANIM_BIT_TX] = value;
+				}
+				else
+				{
+					compressedBaseFrame[j].q[b - ANIM_BIT_QX] = value;
+					foldedRotation = true;
+				}
+				info.animBits &= ~BIT( b );
+				stats.numConstantComponents++;
+			}
+			else if( range * ( 0.5f / 255.0f ) > tolerance )
+			{
+				fits8 = false;
+			}
+			component++;
+		}
+		
+		// the decoder only calculates w for animated rotations
+		if( foldedRotation && !( info.animBits & ( ANIM_QX | ANIM_QY | ANIM_QZ ) ) )
+		{
+			compressedBaseFrame[j].q.w = compressedBaseFrame[j].q.CalcW();
+		}
+		
+		if( info.animBits == 0 )
+		{
+			info.firstComponent = 0;
+			jointBits[j] = 0;
+		}
+		else
+		{
+			jointBits[j] = fits8 ? 8 : 16;
+		}
+	}
+	
+	// lay out the 16 bit joints followed by the 8 bit joints
+	idList<int, TAG_MD5_ANIM> rawComponent;
+	for( int bits = 16; bits >= 8; bits -= 8 )
+	{
+		if( bits == 8 )
+		{
+			numComponents16 = rawComponent.Num();
+		}
+		for( int j = 0; j < numJoints; j++ )
+		{
+			if( jointBits[j] != bits )
+			{
+				continue;
+			}
+			jointAnimInfo_t& info = jointInfo[j];
+			int component = rawJointInfo[j].firstComponent;
+			info.firstComponent = rawComponent.Num();
+			for( int b = ANIM_BIT_TX; b <= ANIM_BIT_QZ; b++ )
+			{
+				if( !( rawJointInfo[j].animBits & BIT( b ) ) )
+				{
+					continue;
+				}
+				if( info.animBits & BIT( b ) )
+				{
+					rawComponent.Append( component );
+				}
+				component++;
+			}
+			if( bits == 16 )
+			{
+				stats.numJoints16++;
+			}
+			else
+			{
+				stats.numJoints8++;
+			}
+		}
+	}
+	numAnimatedComponents = rawComponent.Num();
+	const int numComponents8 = numAnimatedComponents - numComponents16;
+	
+	// quantize
+	componentScale.SetNum( numAnimatedComponents );
+	componentBias.SetNum( numAnimatedComponents );
+	for( int c = 0; c < numAnimatedComponents; c++ )
+	{
+		const int raw = rawComponent[c];
+		componentBias[c] = componentMin[raw];
+		componentScale[c] = ( componentMax[raw] - componentMin[raw] ) / ( ( c < numComponents16 ) ? 65535.0f : 255.0f );
+	}
+	
+	quantizedFrames16.SetNum( numFrames * numComponents16 );
+	quantizedFrames8.SetNum( numFrames * numComponents8 );
+	for( int f = 0; f < numFrames; f++ )
+	{
+		const float* rawFrame = &rawFrames[f * rawNumComponents];
+		for( int c = 0; c < numAnimatedComponents; c++ )
+		{
+			const float value = rawFrame[rawComponent[c]] - componentBias[c];
+			const int q = ( componentScale[c] > 0.0f ) ? idMath::Ftoi( value / componentScale[c] + 0.5f ) : 0;
+			if( c < numComponents16 )
+			{
+				quantizedFrames16[f * numComponents16 + c] = idMath::ClampInt( 0, 65535, q );
+			}
+			else
+			{
+				quantizedFrames8[f * numComponents8 + c - numComponents16] = idMath::ClampInt( 0, 255, q );
+			}
+		}
+	}
+	
+	stats.sizeAfter = Allocated();
+	
+	// measure the error
+	idList<int, TAG_MD5_ANIM> index;
+	index.SetNum( numJoints );
+	for( int j = 0; j < numJoints; j++ )
+	{
+		index[j] = j;
+	}
+	
+	idJointQuat* rawJoints = ( idJointQuat* )_alloca16( numJoints * sizeof( rawJoints[0] ) );
+	idJointQuat* joints = ( idJointQuat* )_alloca16( numJoints * sizeof( joints[0] ) );
+	float* components = ( float* )_alloca16( Max( numAnimatedComponents, 1 ) * sizeof( components[0] ) );
+	
+	for( int f = 0; f < numFrames; f++ )
+	{
+		SIMDProcessor->Memcpy( rawJoints, baseFrame.Ptr(), numJoints * sizeof( rawJoints[0] ) );
+		DecodeSingleFrame( rawJoints, &rawFrames[f * rawNumComponents], rawJointInfo.Ptr(), index.Ptr(), numJoints );
+		
+		SIMDProcessor->Memcpy( joints, compressedBaseFrame.Ptr(), numJoints * sizeof( joints[0] ) );
+		DecodeSingleFrame( joints, GetFrameComponents( f, 0, numAnimatedComponents, components ), jointInfo.Ptr(), index.Ptr(), numJoints );
+		
+		for( int j = 0; j < numJoints; j++ )
+		{
+			const idQuat& q1 = joints[j].q;
+			const idQuat& q2 = rawJoints[j].q;
+			const float cosHalfAngle = idMath::Fabs( q1.x * q2.x + q1.y * q2.y + q1.z * q2.z + q1.w * q2.w );
+			const float translationError = ( joints[j].t - rawJoints[j].t ).Length();
+			const float rotationError = RAD2DEG( 2.0f * idMath::ACos( cosHalfAngle ) );
+			stats.maxTranslationError = Max( stats.maxTranslationError, translationError );
+			stats.maxRotationError = Max( stats.maxRotationError, rotationError );
+		}
+	}
+}
+
 /*
 ====================
 idMD5Anim::CheckModelHierarchy
@@ -1339,6 +1804,63 @@ void idAnimManager::ListAnims() const
 	gameLocal.Printf( "%d memory used in %d joint names\n", namesize, jointnames.Num() );
 }
 
+/*
+================
+idAnimManager::CompressAnims
+
+Offline conversion of the .md5anim files under the path to compressed binary files.
+================
+*/
+void idAnimManager::CompressAnims( const char* path )
+{
+	const float maxTranslationError = binaryCompressAnimTranslationError.GetFloat();
+	const float maxRotationError = binaryCompressAnimRotationError.GetFloat();
+	
+	idFileList* files = fileSystem->ListFilesTree( path, ".md5anim", true );
+	
+	size_t totalBefore = 0;
+	size_t totalAfter = 0;
+	float worstTranslationError = 0.0f;
+	float worstRotationError = 0.0f;
+	int num = 0;
+	
+	for( int i = 0; i < files->GetNumFiles(); i++ )
+	{
+		const char* filename = files->GetFile( i );
+		
+		idMD5Anim anim;
+		if( !anim.ParseAnim( filename ) )
+		{
+			gameLocal.Warning( "Couldn't load anim: '%s'", filename );
+			continue;
+		}
+		
+		animCompressionStats_t stats;
+		anim.Compress( maxTranslationError, maxRotationError, stats );
+		
+		idFileLocal outputFile( fileSystem->OpenFileWrite( GeneratedAnimFileName( filename ), "fs_basepath" ) );
+		anim.WriteBinary( outputFile, fileSystem->GetTimestamp( filename ) );
+		
+		gameLocal.Printf( "%8d -> %8d bytes : %3d/%3d joints 16/8 bit : %3d constant : %.4f units %.4f degrees : %s\n",
+						  ( int )stats.sizeBefore, ( int )stats.sizeAfter, stats.numJoints16, stats.numJoints8, stats.numConstantComponents,
+						  stats.maxTranslationError, stats.maxRotationError, filename );
+						  
+		totalBefore += stats.sizeBefore;
+		totalAfter += stats.sizeAfter;
+		worstTranslationError = Max( worstTranslationError, stats.maxTranslationError );
+		worstRotationError = Max( worstRotationError, stats.maxRotationError );
+		num++;
+	}
+	
+	fileSystem->FreeFileList( files );
+	
+	gameLocal.Printf( "\n%d anims compressed from %d to %d bytes, max error %.4f units %.4f degrees\n", num, ( int )totalBefore, ( int )totalAfter, worstTranslationError, worstRotationError );
+	if( !binaryCompressAnim.GetBool() )
+	{
+		gameLocal.Printf( "set binaryCompressAnim 1 to load the compressed anims\n" );
+	}
+}
+
 /*
 ================
 idAnimManager::FlushUnusedAnims
@@ -79,6 +79,17 @@ typedef struct
 	int						firstComponent;
 } jointAnimInfo_t;
 
+typedef struct
+{
+	size_t					sizeBefore;
+	size_t					sizeAfter;
+	int						numConstantComponents;	// components that were folded into the base frame
+	int						numJoints16;			// animated joints stored with 16 bits per component
+	int						numJoints8;				// animated joints stored with 8 bits per component
+	float					maxTranslationError;	// in units
+	float					maxRotationError;		// in degrees
+} animCompressionStats_t;
+
 typedef struct
 {
 	jointHandle_t			num;
@@ -218,6 +229,15 @@ private:
 	idList<jointAnimInfo_t, TAG_MD5_ANIM>	jointInfo;
 	idList<idJointQuat, TAG_MD5_ANIM>		baseFrame;
 	idList<float, TAG_MD5_ANIM>			componentFrames;
+	
+	// compressed frames, componentFrames is empty when these are used
+	int						numComponents16;		// components [0, numComponents16) are stored with 16 bits, the rest with 8 bits
+	idList<idJointQuat, TAG_MD5_ANIM>		compressedBaseFrame;	// base frame with the constant components folded in
+	idList<unsigned short, TAG_MD5_ANIM>	quantizedFrames16;
+	idList<byte, TAG_MD5_ANIM>			quantizedFrames8;
+	idList<float, TAG_MD5_ANIM>			componentScale;
+	idList<float, TAG_MD5_ANIM>			componentBias;
+	
 	idStr					name;
 	idVec3					totaldelta;
 	mutable int				ref_count;
@@ -234,9 +254,13 @@ public:
 		return sizeof( *this ) + Allocated();
 	};
 	bool					LoadAnim( const char* filename );
+	bool					ParseAnim( const char* filename );
 	bool					LoadBinary( idFile* file, ID_TIME_T sourceTimeStamp );
 	void					WriteBinary( idFile* file, ID_TIME_T sourceTimeStamp );
 	
+	bool					IsCompressed() const;
+	void					Compress( float maxTranslationError, float maxRotationError, animCompressionStats_t& stats );
+	
 	void					IncreaseRefs() const;
 	void					DecreaseRefs() const;
 	int						NumRefs() const;
@@ -256,6 +280,11 @@ public:
 	void					GetOrigin( idVec3& offset, int currentTime, int cyclecount ) const;
 	void					GetOriginRotation( idQuat& rotation, int time, int cyclecount ) const;
 	void					GetBounds( idBounds& bounds, int currentTime, int cyclecount ) const;
+	
+private:
+	const idJointQuat*		AnimatedBaseFrame() const;
+	const float*			GetFrameComponents( int framenum, int firstComponent, int numComponents, float* buffer ) const;
+	const float*			GetJointFrameComponents( int framenum, const int* index, int numIndexes, float* buffer ) const;
 };
 
 /*
@@ -517,6 +546,9 @@ public:
 	void						ForceUpdate();
 	void						ClearForceUpdate();
 	bool						CreateFrame( int animtime, bool force );
+	bool						NeedsFrame( int animtime ) const;
+	void						CreateBatchedFrame( int animtime );
+	bool						TakeBatchedFrame();
 	bool						FrameHasChanged( int animtime ) const;
 	void						GetDelta( int fromtime, int totime, idVec3& delta ) const;
 	bool						GetDeltaRotation( int fromtime, int totime, idMat3& delta ) const;
@@ -578,6 +610,7 @@ private:
 	mutable bool				stoppedAnimatingUpdate;
 	bool						removeOriginOffset;
 	bool						forceUpdate;
+	bool						batchedFrame;			// frame was created by the animator jobs and not yet picked up by the render callback
 	
 	idBounds					frameBounds;
 	
@@ -610,6 +643,7 @@ public:
 	void						Preload( const idPreloadManifest& manifest );
 	void						ReloadAnims();
 	void						ListAnims() const;
+	void						CompressAnims( const char* path );
 	int							JointIndex( const char* name );
 	const char* 				JointName( int index ) const;
 	
@@ -3805,6 +3805,7 @@ idAnimator::idAnimator()
 	stoppedAnimatingUpdate	= false;
 	removeOriginOffset		= false;
 	forceUpdate				= false;
+	batchedFrame			= false;
 	
 	frameBounds.Clear();
 	
@@ -4047,6 +4048,7 @@ void idAnimator::FreeData()
 	numJoints = 0;
 	
 	modelDef = NULL;
+	batchedFrame = false;
 	
 	ForceUpdate();
 }
@@ -5431,6 +5433,56 @@ bool idAnimator::CreateFrame( int currentTime, bool force )
 	return true;
 }
 
+/*
+=====================
+idAnimator::NeedsFrame
+
+Returns true if CreateFrame would build a new frame for the given time.
+=====================
+*/
+bool idAnimator::NeedsFrame( int currentTime ) const
+{
+	if( !modelDef || !modelDef->ModelHandle() )
+	{
+		return false;
+	}
+	
+	if( lastTransformTime == currentTime )
+	{
+		return false;
+	}
+	
+	return ( lastTransformTime == -1 || stoppedAnimatingUpdate || IsAnimating( currentTime ) );
+}
+
+/*
+=====================
+idAnimator::CreateBatchedFrame
+
+Called from the animator jobs. Only touches the state of this animator, the
+render callback picks the frame up with TakeBatchedFrame.
+=====================
+*/
+void idAnimator::CreateBatchedFrame( int currentTime )
+{
+	if( CreateFrame( currentTime, false ) )
+	{
+		batchedFrame = true;
+	}
+}
+
+/*
+=====================
+idAnimator::TakeBatchedFrame
+=====================
+*/
+bool idAnimator::TakeBatchedFrame()
+{
+	const bool created = batchedFrame;
+	batchedFrame = false;
+	return created;
+}
+
 /*
 =====================
 idAnimator::ForceUpdate
@@ -1017,6 +1017,7 @@ bool idClass::ProcessEventArgPtr( const idEventDef* ev, intptr_t* data )
 	{
 		idEntity* ent = ( idEntity* )this;
 		ts.PushState( ent->timeGroup );
+		ent->saveStateDirty = true;
 	}
 	
 	if( g_debugTriggers.GetBool() && ( ev == &EV_Activate ) && IsType( idEntity::Type ) )
@@ -59,12 +59,163 @@ At the head of the save game is enough information to restore the player to the
 file be unloadable in some way (for example, due to script changes).
 */
 
+/*
+================
+ObjectKey
+================
+*/
+static ID_INLINE int ObjectKey( const idHashIndex& hash, const idClass* obj )
+{
+	return hash.GenerateKey( ( int )( ( intptr_t )obj >> 4 ) );
+}
+
+/*
+================
+AppendBytes
+================
+*/
+static void AppendBytes( idList< byte, TAG_SAVEGAMES >& list, const void* data, int length )
+{
+	const int num = list.Num();
+	if( num + length > list.NumAllocated() )
+	{
+		list.Resize( Max( num + length, list.NumAllocated() * 2 ) );
+	}
+	list.SetNum( num + length );
+	memcpy( list.Ptr() + num, data, length );
+}
+
+/***********************************************************************
+
+	idSaveGameCache
+
+***********************************************************************/
+
+/*
+================
+idSaveGameCache::idSaveGameCache
+================
+*/
+idSaveGameCache::idSaveGameCache()
+{
+	numReused = 0;
+}
+
+/*
+================
+idSaveGameCache::Clear
+================
+*/
+void idSaveGameCache::Clear()
+{
+	objects.Clear();
+	objectHash.Free();
+	relocs.Clear();
+	data.Clear();
+	strings.Clear();
+	numReused = 0;
+}
+
+/*
+================
+idSaveGameCache::FindObject
+================
+*/
+const idSaveGameCache::cachedObject_t* idSaveGameCache::FindObject( const idClass* obj ) const
+{
+	for( int i = objectHash.First( ObjectKey( objectHash, obj ) ); i != -1; i = objectHash.Next( i ) )
+	{
+		if( objects[i].obj == obj )
+		{
+			return &objects[i];
+		}
+	}
+	return NULL;
+}
+
+/*
+================
+idSaveGameCache::StateChecksum
+
+Checksum of the entity state that changes without going through events or thinking.
+================
+*/
+unsigned int idSaveGameCache::StateChecksum( const idClass* obj )
+{
+	if( !obj->IsType( idEntity::Type ) )
+	{
+		return 0;
+	}
+	
+	const idEntity* ent = static_cast< const idEntity* >( obj );
+	const renderEntity_t* renderEntity = const_cast< idEntity* >( ent )->GetRenderEntity();
+	const idPhysics* physics = ent->GetPhysics();
+	
+	unsigned int crc;
+	CRC32_InitChecksum( crc );
+	CRC32_UpdateChecksum( crc, &ent->health, sizeof( ent->health ) );
+	CRC32_UpdateChecksum( crc, &ent->fl, sizeof( ent->fl ) );
+	CRC32_UpdateChecksum( crc, &ent->thinkFlags, sizeof( ent->thinkFlags ) );
+	CRC32_UpdateChecksum( crc, physics->GetOrigin().ToFloatPtr(), sizeof( idVec3 ) );
+	CRC32_UpdateChecksum( crc, physics->GetAxis().ToFloatPtr(), sizeof( idMat3 ) );
+	CRC32_UpdateChecksum( crc, &renderEntity->hModel, sizeof( renderEntity->hModel ) );
+	CRC32_UpdateChecksum( crc, &renderEntity->customSkin, sizeof( renderEntity->customSkin ) );
+	CRC32_UpdateChecksum( crc, &renderEntity->customShader, sizeof( renderEntity->customShader ) );
+	CRC32_UpdateChecksum( crc, renderEntity->shaderParms, sizeof( renderEntity->shaderParms ) );
+	CRC32_UpdateChecksum( crc, renderEntity->origin.ToFloatPtr(), sizeof( idVec3 ) );
+	if( ent->scriptObject.HasObject() )
+	{
+		CRC32_UpdateChecksum( crc, ent->scriptObject.data, ent->scriptObject.GetTypeDef()->Size() );
+	}
+	CRC32_FinishChecksum( crc );
+	
+	return crc;
+}
+
+/*
+================
+idSaveGameCache::CanReuse
+================
+*/
+bool idSaveGameCache::CanReuse( const idClass* obj, unsigned int checksum )
+{
+	// threads and the other non entity objects always get saved again
+	if( !obj->IsType( idEntity::Type ) )
+	{
+		return false;
+	}
+	
+	const idEntity* ent = static_cast< const idEntity* >( obj );
+	if( ent->saveStateDirty || ent->thinkFlags != 0 )
+	{
+		return false;
+	}
+	
+	// guis change their state when they are drawn
+	const renderEntity_t* renderEntity = const_cast< idEntity* >( ent )->GetRenderEntity();
+	for( int i = 0; i < MAX_RENDERENTITY_GUI; i++ )
+	{
+		if( renderEntity->gui[i] != NULL )
+		{
+			return false;
+		}
+	}
+	
+	return checksum == StateChecksum( obj );
+}
+
+/***********************************************************************
+
+	idSaveGame
+
+***********************************************************************/
+
 /*
 ================
 idSaveGame::idSaveGame()
 ================
 */
-idSaveGame::idSaveGame( idFile* savefile, idFile* stringTableFile, int saveVersion )
+idSaveGame::idSaveGame( idFile* savefile, idFile* stringTableFile, int saveVersion, idSaveGameCache* saveCache )
 {
 	//compressor = idCompressor::AllocLZW();
 	//compressor->Init( savefile, true, 8 );
@@ -72,12 +223,27 @@ idSaveGame::idSaveGame( idFile* savefile, idFile* stringTableFile, int saveVersi
 	file = savefile;
 	stringFile = stringTableFile;
 	version = saveVersion;
+	cache = saveCache;
+	relocs = NULL;
 	
 	// Put NULL at the start of the list so we can skip over it.
 	objects.Clear();
 	objects.Append( NULL );
+	objectHash.Add( ObjectKey( objectHash, NULL ), 0 );
 	
-	curStringTableOffset = 0;
+	if( cache != NULL )
+	{
+		// the string table only grows while the cache is kept, start over before it gets too large
+		if( cache->strings.curOffset > MAX_SAVEGAME_STRING_TABLE_SIZE / 2 )
+		{
+			cache->Clear();
+		}
+		strings = &cache->strings;
+	}
+	else
+	{
+		strings = &localStrings;
+	}
 }
 
 /*
@@ -108,21 +274,31 @@ void idSaveGame::Close()
 	// read trace models
 	idClipModel::SaveTraceModels( this );
 	
-	for( int i = 1; i < objects.Num(); i++ )
+	if( cache != NULL )
+	{
+		SaveObjectsCached();
+	}
+	else
 	{
-		CallSave_r( objects[ i ]->GetType(), objects[ i ] );
+		for( int i = 1; i < objects.Num(); i++ )
+		{
+			CallSave_r( objects[ i ]->GetType(), objects[ i ] );
+		}
 	}
 	
 	objects.Clear();
+	objectHash.Free();
 	
 	// Save out the string table at the end of the file
-	for( int i = 0; i < stringTable.Num(); ++i )
+	for( int i = 0; i < strings->table.Num(); ++i )
 	{
-		stringFile->WriteString( stringTable[i].string );
+		stringFile->WriteString( strings->table[i].string );
 	}
 	
-	stringHash.Free();
-	stringTable.Clear();
+	if( strings == &localStrings )
+	{
+		localStrings.Clear();
+	}
 	
 	if( file->Length() > MIN_SAVEGAME_SIZE_BYTES || stringFile->Length() > MAX_SAVEGAME_STRING_TABLE_SIZE )
 	{
@@ -198,6 +374,117 @@ void idSaveGame::CallSave_r( const idTypeInfo* cls, const idClass* obj )
 	( obj->*cls->Save )( this );
 }
 
+/*
+================
+idSaveGame::SaveObjectsCached
+
+Writes the objects like Close does, but copies the state of the unchanged entities from the cache.
+Every object that is saved again goes to a blob of its own first, so it can be reused next time.
+================
+*/
+void idSaveGame::SaveObjectsCached()
+{
+	idList< idSaveGameCache::cachedObject_t, TAG_SAVEGAMES >	newObjects;
+	idList< idSaveGameCache::relocation_t, TAG_SAVEGAMES >		newRelocs;
+	idList< byte, TAG_SAVEGAMES >								newData;
+	
+	newObjects.SetNum( objects.Num() - 1 );
+	newRelocs.SetGranularity( 1024 );
+	newData.Resize( Max( cache->data.Num(), 256 * 1024 ) );
+	
+	idFile_Memory blobFile( "saveGameBlob" );
+	idFile* saveFile = file;
+	
+	cache->numReused = 0;
+	
+	for( int i = 1; i < objects.Num(); i++ )
+	{
+		const idClass* obj = objects[i];
+		const unsigned int checksum = idSaveGameCache::StateChecksum( obj );
+		
+		idSaveGameCache::cachedObject_t& newObj = newObjects[i - 1];
+		newObj.obj = obj;
+		newObj.checksum = checksum;
+		newObj.offset = newData.Num();
+		newObj.firstReloc = newRelocs.Num();
+		
+		const idSaveGameCache::cachedObject_t* cached = cache->FindObject( obj );
+		bool reuse = ( cached != NULL ) && idSaveGameCache::CanReuse( obj, cached->checksum );
+		
+		// all the objects the blob points to must still be around
+		for( int r = 0; reuse && r < cached->numRelocs; r++ )
+		{
+			const idSaveGameCache::relocation_t& reloc = cache->relocs[cached->firstReloc + r];
+			int index = -1;
+			for( int j = objectHash.First( ObjectKey( objectHash, reloc.obj ) ); j != -1; j = objectHash.Next( j ) )
+			{
+				if( objects[j] == reloc.obj )
+				{
+					index = j;
+					break;
+				}
+			}
+			if( index < 0 )
+			{
+				newRelocs.SetNum( newObj.firstReloc );
+				reuse = false;
+				break;
+			}
+			newRelocs.Append( reloc );
+			idSwap::Big( index );
+			memcpy( cache->data.Ptr() + cached->offset + reloc.offset, &index, sizeof( index ) );
+		}
+		
+		if( reuse && g_incrementalSavesVerify.GetBool() )
+		{
+			blobFile.Clear( false );
+			file = &blobFile;
+			CallSave_r( obj->GetType(), obj );
+			file = saveFile;
+			
+			if( blobFile.Length() != cached->length || memcmp( blobFile.GetDataPtr(), cache->data.Ptr() + cached->offset, cached->length ) != 0 )
+			{
+				const char* name = obj->IsType( idEntity::Type ) ? static_cast< const idEntity* >( obj )->GetName() : "";
+				gameLocal.Warning( "idSaveGame: cached state of %s '%s' is out of date", obj->GetClassname(), name );
+				newRelocs.SetNum( newObj.firstReloc );
+				reuse = false;
+			}
+		}
+		
+		if( reuse )
+		{
+			newObj.length = cached->length;
+			AppendBytes( newData, cache->data.Ptr() + cached->offset, cached->length );
+			cache->numReused++;
+		}
+		else
+		{
+			blobFile.Clear( false );
+			file = &blobFile;
+			relocs = &newRelocs;
+			CallSave_r( obj->GetType(), obj );
+			relocs = NULL;
+			file = saveFile;
+			
+			newObj.length = blobFile.Length();
+			AppendBytes( newData, blobFile.GetDataPtr(), blobFile.Length() );
+		}
+		newObj.numRelocs = newRelocs.Num() - newObj.firstReloc;
+		
+		file->Write( newData.Ptr() + newObj.offset, newObj.length );
+	}
+	
+	cache->objects.Swap( newObjects );
+	cache->relocs.Swap( newRelocs );
+	cache->data.Swap( newData );
+	
+	cache->objectHash.Clear( cache->objectHash.GetHashSize(), Max( cache->objects.Num(), 1 ) );
+	for( int i = 0; i < cache->objects.Num(); i++ )
+	{
+		cache->objectHash.Add( ObjectKey( cache->objectHash, cache->objects[i].obj ), i );
+	}
+}
+
 /*
 ================
 idSaveGame::AddObject
@@ -205,7 +492,15 @@ idSaveGame::AddObject
 */
 void idSaveGame::AddObject( const idClass* obj )
 {
-	objects.AddUnique( obj );
+	const int key = ObjectKey( objectHash, obj );
+	for( int i = objectHash.First( key ); i != -1; i = objectHash.Next( i ) )
+	{
+		if( objects[i] == obj )
+		{
+			return;
+		}
+	}
+	objectHash.Add( key, objects.Append( obj ) );
 }
 
 /*
@@ -302,24 +597,24 @@ void idSaveGame::WriteString( const char* string )
 	}
 	
 	// If we already have this string in our hash, write out of the offset in the table and return
-	int hash = stringHash.GenerateKey( string );
-	for( int i = stringHash.First( hash ); i != -1; i = stringHash.Next( i ) )
+	int hash = strings->hash.GenerateKey( string );
+	for( int i = strings->hash.First( hash ); i != -1; i = strings->hash.Next( i ) )
 	{
-		if( stringTable[i].string.Cmp( string ) == 0 )
+		if( strings->table[i].string.Cmp( string ) == 0 )
 		{
-			WriteInt( stringTable[i].offset );
+			WriteInt( strings->table[i].offset );
 			return;
 		}
 	}
 	
 	// Add the string to our hash, generate the index, and update our current table offset
-	stringTableIndex_s& tableIndex = stringTable.Alloc();
-	tableIndex.offset = curStringTableOffset;
+	saveGameStringTable_t::entry_t& tableIndex = strings->table.Alloc();
+	tableIndex.offset = strings->curOffset;
 	tableIndex.string = string;
-	stringHash.Add( hash, stringTable.Num() - 1 );
+	strings->hash.Add( hash, strings->table.Num() - 1 );
 	
-	WriteInt( curStringTableOffset );
-	curStringTableOffset += ( strlen( string ) + 4 );
+	WriteInt( strings->curOffset );
+	strings->curOffset += ( strlen( string ) + 4 );
 }
 
 /*
@@ -417,9 +712,16 @@ idSaveGame::WriteObject
 */
 void idSaveGame::WriteObject( const idClass* obj )
 {
-	int index;
+	int index = -1;
 	
-	index = objects.FindIndex( obj );
+	for( int i = objectHash.First( ObjectKey( objectHash, obj ) ); i != -1; i = objectHash.Next( i ) )
+	{
+		if( objects[i] == obj )
+		{
+			index = i;
+			break;
+		}
+	}
 	if( index < 0 )
 	{
 		gameLocal.DPrintf( "idSaveGame::WriteObject - WriteObject FindIndex failed\n" );
@@ -427,6 +729,13 @@ void idSaveGame::WriteObject( const idClass* obj )
 		// Use the NULL index
 		index = 0;
 	}
+	else if( relocs != NULL && index > 0 )
+	{
+		// remember where the index went, so the blob can be patched when it's reused
+		idSaveGameCache::relocation_t& reloc = relocs->Alloc();
+		reloc.offset = file->Tell();
+		reloc.obj = obj;
+	}
 	
 	WriteInt( index );
 }
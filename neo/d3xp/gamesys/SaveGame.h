@@ -35,10 +35,96 @@ Save game related helper classes.
 
 */
 
+/*
+================================================
+saveGameStringTable_t
+
+Strings are written to the savegame as offsets into the string table file.
+================================================
+*/
+struct saveGameStringTable_t
+{
+	struct entry_t
+	{
+		idStr		string;
+		int			offset;
+	};
+	
+	idHashIndex			hash;
+	idList< entry_t >	table;
+	int					curOffset;
+	
+	saveGameStringTable_t() : curOffset( 0 ) {}
+	void				Clear()
+	{
+		hash.Free();
+		table.Clear();
+		curOffset = 0;
+	}
+};
+
+/*
+================================================
+idSaveGameCache
+
+Keeps the serialized state of every object from the previous save of the level, so entities
+nothing has touched since then can copy their old state instead of running their Save() again.
+
+An entity is considered unchanged when it didn't process any events, didn't think, has no gui
+and the checksum of the state that usually changes (health, flags, physics position, render
+entity, script object) is the same as last time. The object indices written by WriteObject are
+remembered for each blob and patched when it is reused, and the string table is kept across
+saves so the string offsets in a blob stay valid.
+================================================
+*/
+class idSaveGameCache
+{
+	friend class idSaveGame;
+public:
+	idSaveGameCache();
+	
+	void					Clear();
+	
+	int						NumReused() const
+	{
+		return numReused;
+	}
+	
+private:
+	struct cachedObject_t
+	{
+		const idClass* 		obj;
+		unsigned int		checksum;
+		int					offset;			// into data
+		int					length;
+		int					firstReloc;		// into relocs
+		int					numRelocs;
+	};
+	
+	struct relocation_t
+	{
+		int					offset;			// of the object index in the blob
+		const idClass* 		obj;
+	};
+	
+	idList< cachedObject_t, TAG_SAVEGAMES >	objects;
+	idHashIndex				objectHash;
+	idList< relocation_t, TAG_SAVEGAMES >	relocs;
+	idList< byte, TAG_SAVEGAMES >			data;
+	
+	saveGameStringTable_t	strings;
+	
+	int						numReused;
+	
+	const cachedObject_t* 	FindObject( const idClass* obj ) const;
+	static bool				CanReuse( const idClass* obj, unsigned int checksum );
+	static unsigned int		StateChecksum( const idClass* obj );
+};
+
 class idSaveGame
 {
 public:
-	idSaveGame( idFile* savefile, idFile* stringFile, int inVersion );
+	idSaveGame( idFile* savefile, idFile* stringFile, int inVersion, idSaveGameCache* cache = NULL );
 	~idSaveGame();
 	
 	void					Close();
@@ -109,19 +195,17 @@ private:
 	idCompressor* 			compressor;
 	
 	idList<const idClass*>	objects;
+	idHashIndex				objectHash;
 	int						version;
 	
-	void					CallSave_r( const idTypeInfo* cls, const idClass* obj );
+	idSaveGameCache* 		cache;
+	idList< idSaveGameCache::relocation_t, TAG_SAVEGAMES >* relocs;	// object indices written into the blob being recorded
 	
-	struct stringTableIndex_s
-	{
-		idStr		string;
-		int			offset;
-	};
+	void					CallSave_r( const idTypeInfo* cls, const idClass* obj );
+	void					SaveObjectsCached();
 	
-	idHashIndex						stringHash;
-	idList< stringTableIndex_s >	stringTable;
-	int								curStringTableOffset;
+	saveGameStringTable_t	localStrings;
+	saveGameStringTable_t* 	strings;		// localStrings, or the table kept by the cache
 	
 };
 
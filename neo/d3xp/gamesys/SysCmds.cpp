@@ -224,6 +224,86 @@ void Cmd_Script_f( const idCmdArgs& args )
 	}
 }
 
+/*
+===================
+Cmd_TimeScript_f
+
+Runs a script function repeatedly to time the interpreter.  Each run
+stops at the function's first wait, if it has one.
+===================
+*/
+void Cmd_TimeScript_f( const idCmdArgs& args )
+{
+	if( !gameLocal.CheatsOk() )
+	{
+		return;
+	}
+	
+	if( args.Argc() < 2 )
+	{
+		gameLocal.Printf( "usage: timeScript <function> [iterations]\n" );
+		return;
+	}
+	
+	const function_t* func = gameLocal.program.FindFunction( args.Argv( 1 ) );
+	if( func == NULL )
+	{
+		gameLocal.Printf( "Function '%s' not found\n", args.Argv( 1 ) );
+		return;
+	}
+	if( func->parmTotal != 0 )
+	{
+		gameLocal.Printf( "Function '%s' takes parameters\n", args.Argv( 1 ) );
+		return;
+	}
+	
+	const int iterations = ( args.Argc() > 2 ) ? Max( atoi( args.Argv( 2 ) ), 1 ) : 100;
+	
+	int numCompleted = 0;
+	const uint64 start = Sys_Microseconds();
+	for( int i = 0; i < iterations; i++ )
+	{
+		idThread* thread = new idThread( func );
+		thread->ManualDelete();
+		thread->ManualControl();
+		if( thread->Execute() )
+		{
+			numCompleted++;
+		}
+		delete thread;
+	}
+	const uint64 end = Sys_Microseconds();
+	
+	gameLocal.Printf( "%s: %d runs in %.2f ms, %.2f usec per run, %d ran to completion\n", func->Name(), iterations,
+					  ( end - start ) * 0.001f, ( float )( end - start ) / iterations, numCompleted );
+}
+
+/*
+===================
+Cmd_RecordClipQueries_f
+===================
+*/
+void Cmd_RecordClipQueries_f( const idCmdArgs& args )
+{
+	gameLocal.clip.RecordQueries( ( args.Argc() > 1 ) ? args.Argv( 1 ) : NULL );
+}
+
+/*
+===================
+Cmd_BenchmarkClipQueries_f
+===================
+*/
+void Cmd_BenchmarkClipQueries_f( const idCmdArgs& args )
+{
+	if( args.Argc() < 2 )
+	{
+		gameLocal.Printf( "usage: benchmarkClipQueries <file> [iterations]\n" );
+		return;
+	}
+	const int iterations = ( args.Argc() > 2 ) ? Max( atoi( args.Argv( 2 ) ), 1 ) : 10;
+	gameLocal.clip.BenchmarkQueries( args.Argv( 1 ), iterations );
+}
+
 /*
 ==================
 KillEntities
@@ -1576,6 +1656,16 @@ static void Cmd_ReloadAnims_f( const idCmdArgs& args )
 	animationLib.ReloadAnims();
 }
 
+/*
+==================
+Cmd_CompressAnims_f
+==================
+*/
+static void Cmd_CompressAnims_f( const idCmdArgs& args )
+{
+	animationLib.CompressAnims( ( args.Argc() > 1 ) ? args.Argv( 1 ) : "models" );
+}
+
 /*
 ==================
 Cmd_ListAnims_f
@@ -2714,10 +2804,14 @@ void idGameLocal::InitConsoleCommands()
 	cmdSystem->AddCommand( "testBlend",				idTestModel::TestBlend_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"tests animation blending" );
 	cmdSystem->AddCommand( "reloadScript",			Cmd_ReloadScript_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"reloads scripts" );
 	cmdSystem->AddCommand( "script",				Cmd_Script_f,				CMD_FL_GAME | CMD_FL_CHEAT,	"executes a line of script" );
+	cmdSystem->AddCommand( "timeScript",			Cmd_TimeScript_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"times repeated runs of a script function" );
+	cmdSystem->AddCommand( "recordClipQueries",		Cmd_RecordClipQueries_f,	CMD_FL_GAME,				"records clip model queries to a file, without a file name recording stops" );
+	cmdSystem->AddCommand( "benchmarkClipQueries",	Cmd_BenchmarkClipQueries_f,	CMD_FL_GAME,				"replays recorded clip model queries against the current map" );
 	cmdSystem->AddCommand( "listCollisionModels",	Cmd_ListCollisionModels_f,	CMD_FL_GAME,				"lists collision models" );
 	cmdSystem->AddCommand( "collisionModelInfo",	Cmd_CollisionModelInfo_f,	CMD_FL_GAME,				"shows collision model info" );
 	cmdSystem->AddCommand( "reloadanims",			Cmd_ReloadAnims_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"reloads animations" );
 	cmdSystem->AddCommand( "listAnims",				Cmd_ListAnims_f,			CMD_FL_GAME,				"lists all animations" );
+	cmdSystem->AddCommand( "compressAnims",			Cmd_CompressAnims_f,		CMD_FL_GAME,				"writes compressed binary anims for the md5 anims under a path and reports their error" );
 	cmdSystem->AddCommand( "aasStats",				Cmd_AASStats_f,				CMD_FL_GAME,				"shows AAS stats" );
 	cmdSystem->AddCommand( "testDamage",			Cmd_TestDamage_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"tests a damage def", idCmdSystem::ArgCompletion_Decl<DECL_ENTITYDEF> );
 	cmdSystem->AddCommand( "weaponSplat",			Cmd_WeaponSplat_f,			CMD_FL_GAME | CMD_FL_CHEAT,	"projects a blood splat on the player weapon" );
@@ -47,6 +47,7 @@ extern idCVar	g_muzzleFlash;
 extern idCVar	g_disasm;
 extern idCVar	g_debugBounds;
 extern idCVar	g_debugAnim;
+extern idCVar	g_animatorJobs;
 extern idCVar	g_debugMove;
 extern idCVar	g_debugDamage;
 extern idCVar	g_debugWeapon;
@@ -221,6 +222,8 @@ extern idCVar	g_testModelRotate;
 extern idCVar	g_testModelAnimate;
 extern idCVar	g_testModelBlend;
 extern idCVar	g_flushSave;
+extern idCVar	g_incrementalSaves;
+extern idCVar	g_incrementalSavesVerify;
 
 extern idCVar	g_enableSlowmo;
 extern idCVar	g_slowmoStepRate;
@@ -248,6 +251,7 @@ extern idCVar	aas_showHideArea;
 extern idCVar	aas_pullPlayer;
 extern idCVar	aas_randomPullPlayer;
 extern idCVar	aas_goalArea;
+extern idCVar	aas_useRouteTable;
 extern idCVar	aas_showPushIntoArea;
 
 extern idCVar	net_clientPredictGUI;
@@ -34,21 +34,27 @@ If you have questions concerning this license or the applicable additional terms
 
 #define	MAX_SECTOR_DEPTH				12
 #define MAX_SECTORS						((1<<(MAX_SECTOR_DEPTH+1))-1)
+#define MAX_LEAF_SECTORS				(1<<MAX_SECTOR_DEPTH)
 
+// The sectors form an implicit binary tree, the children of sector n are sectors 2n+1 and 2n+2.
+// Every leaf sector keeps the absolute bounds of the clip models linked into it in a structure
+// of arrays layout so four clip models can be tested against a bounds at once. The arrays are
+// padded to a multiple of four with empty bounds that never touch anything.
 typedef struct clipSector_s
 {
 	int						axis;		// -1 = leaf node
 	float					dist;
-	struct clipSector_s* 	children[2];
-	struct clipLink_s* 		clipLinks;
+	int						numLinks;
+	int						maxLinks;
+	struct clipLink_s** 	links;
+	float* 					bounds;		// maxLinks mins x, y, z followed by maxLinks maxs x, y, z
 } clipSector_t;
 
 typedef struct clipLink_s
 {
 	idClipModel* 			clipModel;
 	struct clipSector_s* 	sector;
-	struct clipLink_s* 		prevInSector;
-	struct clipLink_s* 		nextInSector;
+	int						index;		// index into the sector arrays
 	struct clipLink_s* 		nextLink;
 } clipLink_t;
 
@@ -646,71 +652,157 @@ void idClipModel::GetMassProperties( const float density, float& mass, idVec3& c
 
 /*
 ===============
-idClipModel::Unlink
+CM_SetSectorBounds
 ===============
 */
-void idClipModel::Unlink()
+static ID_INLINE void CM_SetSectorBounds( clipSector_t* sector, const int index, const idBounds& bounds )
 {
-	clipLink_t* link;
+	float* mins = sector->bounds;
+	float* maxs = sector->bounds + 3 * sector->maxLinks;
+	mins[0 * sector->maxLinks + index] = bounds[0][0];
+	mins[1 * sector->maxLinks + index] = bounds[0][1];
+	mins[2 * sector->maxLinks + index] = bounds[0][2];
+	maxs[0 * sector->maxLinks + index] = bounds[1][0];
+	maxs[1 * sector->maxLinks + index] = bounds[1][1];
+	maxs[2 * sector->maxLinks + index] = bounds[1][2];
+}
+
+/*
+===============
+CM_ClearSectorBounds
+===============
+*/
+static ID_INLINE void CM_ClearSectorBounds( clipSector_t* sector, const int index )
+{
+	idBounds empty;
+	empty.Clear();
+	CM_SetSectorBounds( sector, index, empty );
+}
 
-	for ( link = clipLinks; link; link = clipLinks )
+/*
+===============
+CM_AddSectorLink
+===============
+*/
+static void CM_AddSectorLink( clipSector_t* sector, clipLink_t* link, const idBounds& bounds )
+{
+	if( sector->numLinks >= sector->maxLinks )
 	{
-		clipLinks = link->nextLink;
-		if ( link->prevInSector )
+		const int newMaxLinks = Max( sector->maxLinks * 2, 8 );
+		clipLink_t** newLinks = ( clipLink_t** )Mem_Alloc( newMaxLinks * sizeof( clipLink_t* ), TAG_PHYSICS_CLIP );
+		float* newBounds = ( float* )Mem_Alloc16( newMaxLinks * 6 * sizeof( float ), TAG_PHYSICS_CLIP );
+		for( int i = 0; i < 6; i++ )
 		{
-			link->prevInSector->nextInSector = link->nextInSector;
+			if( sector->maxLinks > 0 )
+			{
+				memcpy( newBounds + i * newMaxLinks, sector->bounds + i * sector->maxLinks, sector->maxLinks * sizeof( float ) );
+			}
 		}
-		else
+		if( sector->numLinks > 0 )
 		{
-			link->sector->clipLinks = link->nextInSector;
+			memcpy( newLinks, sector->links, sector->numLinks * sizeof( clipLink_t* ) );
 		}
-		if ( link->nextInSector )
+		Mem_Free( sector->links );
+		Mem_Free16( sector->bounds );
+		sector->links = newLinks;
+		sector->bounds = newBounds;
+		const int oldMaxLinks = sector->maxLinks;
+		sector->maxLinks = newMaxLinks;
+		for( int i = oldMaxLinks; i < newMaxLinks; i++ )
 		{
-			link->nextInSector->prevInSector = link->prevInSector;
+			CM_ClearSectorBounds( sector, i );
 		}
-		clipLinkAllocator.Free( link );
 	}
-	
+	link->sector = sector;
+	link->index = sector->numLinks++;
+	sector->links[link->index] = link;
+	CM_SetSectorBounds( sector, link->index, bounds );
 }
 
 /*
 ===============
-idClipModel::Link_r
+CM_RemoveSectorLink
+
+  moves the last link of the sector into the slot of the removed link
 ===============
 */
-void idClipModel::Link_r( struct clipSector_s* node )
+static void CM_RemoveSectorLink( clipLink_t* link )
 {
-	clipLink_t* link;
-	
-	while( node->axis != -1 )
+	clipSector_t* sector = link->sector;
+	const int last = --sector->numLinks;
+	if( link->index != last )
 	{
-		if( absBounds[0][node->axis] > node->dist )
+		clipLink_t* moved = sector->links[last];
+		moved->index = link->index;
+		sector->links[moved->index] = moved;
+		for( int i = 0; i < 6; i++ )
 		{
-			node = node->children[0];
+			sector->bounds[i * sector->maxLinks + moved->index] = sector->bounds[i * sector->maxLinks + last];
 		}
-		else if( absBounds[1][node->axis] < node->dist )
+	}
+	CM_ClearSectorBounds( sector, last );
+}
+
+/*
+===============
+idClipModel::Unlink
+===============
+*/
+void idClipModel::Unlink()
+{
+	clipLink_t* link;
+	
+	for( link = clipLinks; link; link = clipLinks )
+	{
+		clipLinks = link->nextLink;
+		CM_RemoveSectorLink( link );
+		clipLinkAllocator.Free( link );
+	}
+}
+
+/*
+===============
+idClipModel::LinkSectors
+
+  If the clip model stays in the same sectors only the bounds stored
+  with the sectors are updated.
+===============
+*/
+void idClipModel::LinkSectors( idClip& clp )
+{
+	int sectorList[MAX_LEAF_SECTORS];
+	int numSectors = clp.SectorsTouchingBounds( absBounds, sectorList );
+	
+	clipLink_t* link = clipLinks;
+	int i;
+	for( i = 0; i < numSectors && link != NULL; i++, link = link->nextLink )
+	{
+		if( link->sector != &clp.clipSectors[sectorList[i]] )
 		{
-			node = node->children[1];
+			break;
 		}
-		else
+	}
+	if( i == numSectors && link == NULL )
+	{
+		for( link = clipLinks; link; link = link->nextLink )
 		{
-			Link_r( node->children[0] );
-			node = node->children[1];
+			CM_SetSectorBounds( link->sector, link->index, absBounds );
 		}
+		return;
 	}
 	
-	link = clipLinkAllocator.Alloc();
-	link->clipModel = this;
-	link->sector = node;
-	link->nextInSector = node->clipLinks;
-	link->prevInSector = NULL;
-	if( node->clipLinks )
+	Unlink();
+	
+	clipLink_t** lastLink = &clipLinks;
+	for( i = 0; i < numSectors; i++ )
 	{
-		node->clipLinks->prevInSector = link;
+		link = clipLinkAllocator.Alloc();
+		link->clipModel = this;
+		link->nextLink = NULL;
+		CM_AddSectorLink( &clp.clipSectors[sectorList[i]], link, absBounds );
+		*lastLink = link;
+		lastLink = &link->nextLink;
 	}
-	node->clipLinks = link;
-	link->nextLink = clipLinks;
-	clipLinks = link;
 }
 
 /*
@@ -727,13 +819,9 @@ void idClipModel::Link( idClip& clp )
 		return;
 	}
 	
-	if( clipLinks )
-	{
-		Unlink();	// unlink from old position
-	}
-	
 	if( bounds.IsCleared() )
 	{
+		Unlink();
 		return;
 	}
 	
@@ -755,7 +843,7 @@ void idClipModel::Link( idClip& clp )
 	absBounds[0] -= vec3_boxEpsilon;
 	absBounds[1] += vec3_boxEpsilon;
 	
-	Link_r( clp.clipSectors );
+	LinkSectors( clp );
 }
 
 /*
@@ -810,6 +898,7 @@ idClip::idClip()
 {
 	numClipSectors = 0;
 	clipSectors = NULL;
+	queryRecordFile = NULL;
 	worldBounds.Zero();
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
@@ -821,20 +910,19 @@ idClip::CreateClipSectors_r
 Builds a uniformly subdivided tree for the given world size
 ===============
 */
-clipSector_t* idClip::CreateClipSectors_r( const int depth, const idBounds& bounds, idVec3& maxSector )
+void idClip::CreateClipSectors_r( const int nodeNum, const int depth, const idBounds& bounds, idVec3& maxSector )
 {
 	int				i;
 	clipSector_t*	anode;
 	idVec3			size;
 	idBounds		front, back;
 	
-	anode = &clipSectors[idClip::numClipSectors];
+	anode = &clipSectors[nodeNum];
 	idClip::numClipSectors++;
 	
 	if( depth == MAX_SECTOR_DEPTH )
 	{
 		anode->axis = -1;
-		anode->children[0] = anode->children[1] = NULL;
 		
 		for( i = 0; i < 3; i++ )
 		{
@@ -843,7 +931,7 @@ clipSector_t* idClip::CreateClipSectors_r( const int depth, const idBounds& boun
 				maxSector[i] = bounds[1][i] - bounds[0][i];
 			}
 		}
-		return anode;
+		return;
 	}
 	
 	size = bounds[1] - bounds[0];
@@ -867,10 +955,53 @@ clipSector_t* idClip::CreateClipSectors_r( const int depth, const idBounds& boun
 	
 	front[0][anode->axis] = back[1][anode->axis] = anode->dist;
 	
-	anode->children[0] = CreateClipSectors_r( depth + 1, front, maxSector );
-	anode->children[1] = CreateClipSectors_r( depth + 1, back, maxSector );
+	CreateClipSectors_r( nodeNum * 2 + 1, depth + 1, front, maxSector );
+	CreateClipSectors_r( nodeNum * 2 + 2, depth + 1, back, maxSector );
+}
+
+/*
+===============
+idClip::SectorsTouchingBounds
+
+Walks the sector tree without recursion and stores the leaf sectors touching
+the bounds in the same order as a depth first walk, returns the number of sectors
+===============
+*/
+int idClip::SectorsTouchingBounds( const idBounds& bounds, int* sectorList ) const
+{
+	int stack[MAX_SECTOR_DEPTH];
+	int stackDepth = 0;
+	int numSectors = 0;
+	int nodeNum = 0;
 	
-	return anode;
+	while( 1 )
+	{
+		const clipSector_t* node = &clipSectors[nodeNum];
+		while( node->axis != -1 )
+		{
+			if( bounds[0][node->axis] > node->dist )
+			{
+				nodeNum = nodeNum * 2 + 1;
+			}
+			else if( bounds[1][node->axis] < node->dist )
+			{
+				nodeNum = nodeNum * 2 + 2;
+			}
+			else
+			{
+				stack[stackDepth++] = nodeNum * 2 + 2;
+				nodeNum = nodeNum * 2 + 1;
+			}
+			node = &clipSectors[nodeNum];
+		}
+		sectorList[numSectors++] = nodeNum;
+		if( stackDepth == 0 )
+		{
+			break;
+		}
+		nodeNum = stack[--stackDepth];
+	}
+	return numSectors;
 }
 
 /*
@@ -892,7 +1023,7 @@ void idClip::Init()
 	h = collisionModelManager->LoadModel( "worldMap" );
 	collisionModelManager->GetModelBounds( h, worldBounds );
 	// create world sectors
-	CreateClipSectors_r( 0, worldBounds, maxSector );
+	CreateClipSectors_r( 0, 0, worldBounds, maxSector );
 	
 	size = worldBounds[1] - worldBounds[0];
 	gameLocal.Printf( "map bounds are (%1.1f, %1.1f, %1.1f)\n", size[0], size[1], size[2] );
@@ -912,9 +1043,19 @@ idClip::Shutdown
 */
 void idClip::Shutdown()
 {
+	if( clipSectors != NULL )
+	{
+		for( int i = 0; i < MAX_SECTORS; i++ )
+		{
+			Mem_Free( clipSectors[i].links );
+			Mem_Free16( clipSectors[i].bounds );
+		}
+	}
 	delete[] clipSectors;
 	clipSectors = NULL;
 	
+	RecordQueries( NULL );
+	
 	// free the trace model used for the temporaryClipModel
 	if( temporaryClipModel.traceModelIndex != -1 )
 	{
@@ -934,7 +1075,7 @@ void idClip::Shutdown()
 
 /*
 ====================
-idClip::ClipModelsTouchingBounds_r
+idClip::ClipModelsTouchingSector
 ====================
 */
 typedef struct listParms_s
@@ -946,69 +1087,92 @@ typedef struct listParms_s
 	int				maxCount;
 } listParms_t;
 
-void idClip::ClipModelsTouchingBounds_r( const struct clipSector_s* node, listParms_t& parms ) const
+bool idClip::ClipModelsTouchingSector( const struct clipSector_s* sector, listParms_t& parms ) const
 {
-
-	while( node->axis != -1 )
-	{
-		if( parms.bounds[0][node->axis] > node->dist )
-		{
-			node = node->children[0];
-		}
-		else if( parms.bounds[1][node->axis] < node->dist )
-		{
-			node = node->children[1];
-		}
-		else
-		{
-			ClipModelsTouchingBounds_r( node->children[0], parms );
-			node = node->children[1];
-		}
-	}
+	const int maxLinks = sector->maxLinks;
+	const float* mins = sector->bounds;
+	const float* maxs = sector->bounds + 3 * maxLinks;
+	
+#if defined(USE_INTRINSICS)
+	const __m128 boundsMinX = _mm_set1_ps( parms.bounds[0][0] );
+	const __m128 boundsMinY = _mm_set1_ps( parms.bounds[0][1] );
+	const __m128 boundsMinZ = _mm_set1_ps( parms.bounds[0][2] );
+	const __m128 boundsMaxX = _mm_set1_ps( parms.bounds[1][0] );
+	const __m128 boundsMaxY = _mm_set1_ps( parms.bounds[1][1] );
+	const __m128 boundsMaxZ = _mm_set1_ps( parms.bounds[1][2] );
+#endif
 	
-	for( clipLink_t* link = node->clipLinks; link; link = link->nextInSector )
+	for( int i = 0; i < sector->numLinks; i += 4 )
 	{
-		idClipModel*	check = link->clipModel;
-		
-		// if the clip model is enabled
-		if( !check->enabled )
-		{
-			continue;
-		}
-		
-		// avoid duplicates in the list
-		if( check->touchCount == touchCount )
-		{
-			continue;
-		}
-		
-		// if the clip model does not have any contents we are looking for
-		if( !( check->contents & parms.contentMask ) )
-		{
-			continue;
-		}
-		
+#if defined(USE_INTRINSICS)
 		// if the bounds really do overlap
-		if(	check->absBounds[0][0] > parms.bounds[1][0] ||
-				check->absBounds[1][0] < parms.bounds[0][0] ||
-				check->absBounds[0][1] > parms.bounds[1][1] ||
-				check->absBounds[1][1] < parms.bounds[0][1] ||
-				check->absBounds[0][2] > parms.bounds[1][2] ||
-				check->absBounds[1][2] < parms.bounds[0][2] )
+		__m128 overlap = _mm_cmple_ps( _mm_load_ps( mins + 0 * maxLinks + i ), boundsMaxX );
+		overlap = _mm_and_ps( overlap, _mm_cmple_ps( _mm_load_ps( mins + 1 * maxLinks + i ), boundsMaxY ) );
+		overlap = _mm_and_ps( overlap, _mm_cmple_ps( _mm_load_ps( mins + 2 * maxLinks + i ), boundsMaxZ ) );
+		overlap = _mm_and_ps( overlap, _mm_cmpge_ps( _mm_load_ps( maxs + 0 * maxLinks + i ), boundsMinX ) );
+		overlap = _mm_and_ps( overlap, _mm_cmpge_ps( _mm_load_ps( maxs + 1 * maxLinks + i ), boundsMinY ) );
+		overlap = _mm_and_ps( overlap, _mm_cmpge_ps( _mm_load_ps( maxs + 2 * maxLinks + i ), boundsMinZ ) );
+		const int mask = _mm_movemask_ps( overlap );
+#else
+		int mask = 0;
+		for( int j = 0; j < 4; j++ )
+		{
+			// if the bounds really do overlap
+			if(	mins[0 * maxLinks + i + j] <= parms.bounds[1][0] &&
+					mins[1 * maxLinks + i + j] <= parms.bounds[1][1] &&
+					mins[2 * maxLinks + i + j] <= parms.bounds[1][2] &&
+					maxs[0 * maxLinks + i + j] >= parms.bounds[0][0] &&
+					maxs[1 * maxLinks + i + j] >= parms.bounds[0][1] &&
+					maxs[2 * maxLinks + i + j] >= parms.bounds[0][2] )
+			{
+				mask |= 1 << j;
+			}
+		}
+#endif
+		if( mask == 0 )
 		{
 			continue;
 		}
 		
-		if( parms.count >= parms.maxCount )
+		for( int j = 0; j < 4; j++ )
 		{
-			gameLocal.Warning( "idClip::ClipModelsTouchingBounds_r: max count" );
-			return;
+			if( ( mask & ( 1 << j ) ) == 0 )
+			{
+				continue;
+			}
+			
+			idClipModel* check = sector->links[i + j]->clipModel;
+			
+			// if the clip model is enabled
+			if( !check->enabled )
+			{
+				continue;
+			}
+			
+			// avoid duplicates in the list
+			if( check->touchCount == touchCount )
+			{
+				continue;
+			}
+			
+			// if the clip model does not have any contents we are looking for
+			if( !( check->contents & parms.contentMask ) )
+			{
+				continue;
+			}
+			
+			if( parms.count >= parms.maxCount )
+			{
+				gameLocal.Warning( "idClip::ClipModelsTouchingBounds: max count" );
+				return false;
+			}
+			
+			check->touchCount = touchCount;
+			parms.list[parms.count] = check;
+			parms.count++;
 		}
-		
-		check->touchCount = touchCount;
-		parms.list[parms.count] = check;
-		parms.count++;
 	}
+	return true;
 }
 
 /*
@@ -1019,6 +1183,7 @@ idClip::ClipModelsTouchingBounds
 int idClip::ClipModelsTouchingBounds( const idBounds& bounds, int contentMask, idClipModel** clipModelList, int maxCount ) const
 {
 	listParms_t parms;
+	int sectorList[MAX_LEAF_SECTORS];
 	
 	if(	bounds[0][0] > bounds[1][0] ||
 			bounds[0][1] > bounds[1][1] ||
@@ -1029,6 +1194,12 @@ int idClip::ClipModelsTouchingBounds( const idBounds& bounds, int contentMask, i
 		return 0;
 	}
 	
+	if( queryRecordFile != NULL )
+	{
+		queryRecordFile->WriteBig( bounds );
+		queryRecordFile->WriteBig( contentMask );
+	}
+	
 	parms.bounds[0] = bounds[0] - vec3_boxEpsilon;
 	parms.bounds[1] = bounds[1] + vec3_boxEpsilon;
 	parms.contentMask = contentMask;
@@ -1037,7 +1208,14 @@ int idClip::ClipModelsTouchingBounds( const idBounds& bounds, int contentMask, i
 	parms.maxCount = maxCount;
 	
 	touchCount++;
-	ClipModelsTouchingBounds_r( clipSectors, parms );
+	const int numSectors = SectorsTouchingBounds( parms.bounds, sectorList );
+	for( int i = 0; i < numSectors; i++ )
+	{
+		if( !ClipModelsTouchingSector( &clipSectors[sectorList[i]], parms ) )
+		{
+			break;
+		}
+	}
 	
 	return parms.count;
 }
@@ -1990,6 +2168,87 @@ void idClip::PrintStatistics()
 	numRotations = numTranslations = numMotions = numRenderModelTraces = numContents = numContacts = 0;
 }
 
+/*
+============
+idClip::RecordQueries
+
+  Writes the bounds and content mask of every ClipModelsTouchingBounds query
+  to the given file, a NULL file name stops recording.
+============
+*/
+void idClip::RecordQueries( const char* fileName )
+{
+	if( queryRecordFile != NULL )
+	{
+		gameLocal.Printf( "stopped recording clip queries to %s\n", queryRecordFile->GetName() );
+		fileSystem->CloseFile( queryRecordFile );
+		queryRecordFile = NULL;
+	}
+	if( fileName == NULL )
+	{
+		return;
+	}
+	queryRecordFile = fileSystem->OpenFileWrite( fileName );
+	if( queryRecordFile == NULL )
+	{
+		gameLocal.Warning( "couldn't open %s", fileName );
+		return;
+	}
+	gameLocal.Printf( "recording clip queries to %s\n", fileName );
+}
+
+/*
+============
+idClip::BenchmarkQueries
+
+  Replays queries recorded with RecordQueries against the currently linked clip models.
+============
+*/
+void idClip::BenchmarkQueries( const char* fileName, const int iterations )
+{
+	idFile* file = fileSystem->OpenFileRead( fileName );
+	if( file == NULL )
+	{
+		gameLocal.Warning( "couldn't open %s", fileName );
+		return;
+	}
+	
+	idList< idBounds > queryBounds;
+	idList< int > queryContents;
+	idBounds bounds;
+	int contentMask;
+	while( file->Tell() < file->Length() )
+	{
+		file->ReadBig( bounds );
+		file->ReadBig( contentMask );
+		queryBounds.Append( bounds );
+		queryContents.Append( contentMask );
+	}
+	fileSystem->CloseFile( file );
+	
+	if( queryBounds.Num() == 0 )
+	{
+		gameLocal.Printf( "no queries in %s\n", fileName );
+		return;
+	}
+	
+	idClipModel* clipModelList[MAX_GENTITIES];
+	int numTouched = 0;
+	const uint64 start = Sys_Microseconds();
+	for( int i = 0; i < iterations; i++ )
+	{
+		for( int j = 0; j < queryBounds.Num(); j++ )
+		{
+			numTouched += ClipModelsTouchingBounds( queryBounds[j], queryContents[j], clipModelList, MAX_GENTITIES );
+		}
+	}
+	const uint64 end = Sys_Microseconds();
+	
+	const int numQueries = queryBounds.Num() * iterations;
+	gameLocal.Printf( "%d queries in %.2f ms, %.3f usec per query, %.1f clip models per query\n", numQueries,
+					  ( end - start ) * 0.001f, ( float )( end - start ) / numQueries, ( float )numTouched / numQueries );
+}
+
 /*
 ============
 idClip::DrawClipModels
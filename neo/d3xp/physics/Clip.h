@@ -128,7 +128,7 @@ private:
 	int						touchCount;
 	
 	void					Init();			// initialize
-	void					Link_r( struct clipSector_s* node );
+	void					LinkSectors( idClip& clp );
 	
 	static int				AllocTraceModel( const idTraceModel& trm, bool persistantThroughSaves = true );
 	static void				FreeTraceModel( int traceModelIndex );
@@ -331,6 +331,8 @@ public:
 	
 	// stats and debug drawing
 	void					PrintStatistics();
+	void					RecordQueries( const char* fileName );
+	void					BenchmarkQueries( const char* fileName, const int iterations );
 	void					DrawClipModels( const idVec3& eye, const float radius, const idEntity* passEntity );
 	bool					DrawModelContactFeature( const contactInfo_t& contact, const idClipModel* clipModel, int lifetime ) const;
 	
@@ -341,6 +343,7 @@ private:
 	idClipModel				temporaryClipModel;
 	idClipModel				defaultClipModel;
 	mutable int				touchCount;
+	idFile* 				queryRecordFile;		// records the touching bounds queries for benchmarking
 	// statistics
 	int						numTranslations;
 	int						numRotations;
@@ -350,8 +353,9 @@ private:
 	int						numContacts;
 	
 private:
-	struct clipSector_s* 	CreateClipSectors_r( const int depth, const idBounds& bounds, idVec3& maxSector );
-	void					ClipModelsTouchingBounds_r( const struct clipSector_s* node, struct listParms_s& parms ) const;
+	void					CreateClipSectors_r( const int nodeNum, const int depth, const idBounds& bounds, idVec3& maxSector );
+	int						SectorsTouchingBounds( const idBounds& bounds, int* sectorList ) const;
+	bool					ClipModelsTouchingSector( const struct clipSector_s* sector, struct listParms_s& parms ) const;
 	const idTraceModel* 	TraceModelForClipModel( const idClipModel* mdl ) const;
 	int						GetTraceClipModels( const idBounds& bounds, int contentMask, const idEntity* passEntity, idClipModel** clipModelList ) const;
 	void					TraceRenderModel( trace_t& trace, const idVec3& start, const idVec3& end, const float radius, const idMat3& axis, idClipModel* touch ) const;
@@ -739,6 +739,20 @@ idVarDef* idCompiler::OptimizeOpcode( const opcode_t* op, idVarDef* var_a, idVar
 	return GetImmediate( type, &c, "" );
 }
 
+/*
+============
+idCompiler::IsConditionOpcode
+
+Returns true for the comparison and logical opcodes the interpreter can fuse with a following branch
+============
+*/
+bool idCompiler::IsConditionOpcode( int op )
+{
+	return ( ( op >= OP_EQ_F ) && ( op <= OP_GT ) ) ||
+		   ( ( op >= OP_NOT_BOOL ) && ( op <= OP_NOT_ENT ) ) ||
+		   ( ( op >= OP_AND ) && ( op <= OP_OR_BOOLBOOL ) );
+}
+
 /*
 ============
 idCompiler::EmitOpcode
@@ -766,9 +780,23 @@ idVarDef* idCompiler::EmitOpcode( const opcode_t* op, idVarDef* var_a, idVarDef*
 		var_b->numUsers++;
 	}
 	
+	if( ( op == &opcodes[ OP_IF ] ) || ( op == &opcodes[ OP_IFNOT ] ) )
+	{
+		// let the interpreter run the branch along with the comparison that computes its condition
+		if( gameLocal.program.NumStatements() > 0 )
+		{
+			statement_t& prev = gameLocal.program.GetStatement( gameLocal.program.NumStatements() - 1 );
+			if( ( prev.c == var_a ) && IsConditionOpcode( prev.op ) )
+			{
+				prev.fuseBranch = true;
+			}
+		}
+	}
+	
 	statement = gameLocal.program.AllocStatement();
 	statement->linenumber	= currentLineNumber;
 	statement->file 		= currentFileNumber;
+	statement->fuseBranch	= false;
 	
 	if( ( op->type_c == &def_void ) || op->rightAssociative )
 	{
@@ -230,6 +230,7 @@ private:
 	void			Error( VERIFY_FORMAT_STRING const char* error, ... ) const;
 	void			Warning( VERIFY_FORMAT_STRING const char* message, ... ) const;
 	idVarDef*		OptimizeOpcode( const opcode_t* op, idVarDef* var_a, idVarDef* var_b );
+	static bool		IsConditionOpcode( int op );
 	idVarDef*		EmitOpcode( const opcode_t* op, idVarDef* var_a, idVarDef* var_b );
 	idVarDef*		EmitOpcode( int op, idVarDef* var_a, idVarDef* var_b );
 	bool			EmitPush( idVarDef* expression, const idTypeDef* funcArg );
@@ -1084,6 +1084,47 @@ void idInterpreter::CallSysEvent( const function_t* func, int argsize )
 	popParms = 0;
 }
 
+/*
+====================
+Opcode dispatch
+
+With GCC and Clang every opcode jumps straight to the next one through a table
+of label addresses, so each opcode gets its own indirect branch instead of all
+of them sharing the one at the top of the switch.  The loop and the switch are
+kept for the first dispatch and for compilers without computed goto.
+====================
+*/
+#if defined( __GNUC__ )
+#define USE_THREADED_SCRIPT_DISPATCH
+#endif
+
+#if defined( USE_THREADED_SCRIPT_DISPATCH )
+#define SCRIPT_OP( op )		case op: label_##op
+#define SCRIPT_NEXT()																			\
+	if( doneProcessing || threadDying )															\
+	{																							\
+		break;																					\
+	}																							\
+	instructionPointer++;																		\
+	if( !--runaway )																			\
+	{																							\
+		Error( "runaway loop error" );															\
+	}																							\
+	st = &statements[ instructionPointer ];														\
+	goto *dispatchTable[ ( st->op < NUM_OPCODES ) ? st->op : OP_BREAK ]
+#else
+#define SCRIPT_OP( op )		case op
+#define SCRIPT_NEXT()		break
+#endif
+
+// a comparison is nearly always followed by a branch on its result.  The compiler flags
+// those pairs, and the comparison then runs the branch right away at fused_branch.
+#define SCRIPT_FUSE_BRANCH()																	\
+	if( st->fuseBranch )																		\
+	{																							\
+		goto fused_branch;																		\
+	}
+
 /*
 ====================
 idInterpreter::Execute
@@ -1115,6 +1156,139 @@ bool idInterpreter::Execute()
 	
 	runaway = 5000000;
 	
+	// statements live in a static list, so they can't move while running
+	statement_t* const statements = &gameLocal.program.GetStatement( 0 );
+	
+#if defined( USE_THREADED_SCRIPT_DISPATCH )
+	static void* const dispatchTable[] =
+	{
+		&&label_OP_RETURN,
+		&&label_OP_UINC_F,
+		&&label_OP_UINCP_F,
+		&&label_OP_UDEC_F,
+		&&label_OP_UDECP_F,
+		&&label_OP_COMP_F,
+		&&label_OP_MUL_F,
+		&&label_OP_MUL_V,
+		&&label_OP_MUL_FV,
+		&&label_OP_MUL_VF,
+		&&label_OP_DIV_F,
+		&&label_OP_MOD_F,
+		&&label_OP_ADD_F,
+		&&label_OP_ADD_V,
+		&&label_OP_ADD_S,
+		&&label_OP_ADD_FS,
+		&&label_OP_ADD_SF,
+		&&label_OP_ADD_VS,
+		&&label_OP_ADD_SV,
+		&&label_OP_SUB_F,
+		&&label_OP_SUB_V,
+		&&label_OP_EQ_F,
+		&&label_OP_EQ_V,
+		&&label_OP_EQ_S,
+		&&label_OP_EQ_E,
+		&&label_OP_EQ_EO,
+		&&label_OP_EQ_OE,
+		&&label_OP_EQ_OO,
+		&&label_OP_NE_F,
+		&&label_OP_NE_V,
+		&&label_OP_NE_S,
+		&&label_OP_NE_E,
+		&&label_OP_NE_EO,
+		&&label_OP_NE_OE,
+		&&label_OP_NE_OO,
+		&&label_OP_LE,
+		&&label_OP_GE,
+		&&label_OP_LT,
+		&&label_OP_GT,
+		&&label_OP_INDIRECT_F,
+		&&label_OP_INDIRECT_V,
+		&&label_OP_INDIRECT_S,
+		&&label_OP_INDIRECT_ENT,
+		&&label_OP_INDIRECT_BOOL,
+		&&label_OP_INDIRECT_OBJ,
+		&&label_OP_ADDRESS,
+		&&label_OP_EVENTCALL,
+		&&label_OP_OBJECTCALL,
+		&&label_OP_SYSCALL,
+		&&label_OP_STORE_F,
+		&&label_OP_STORE_V,
+		&&label_OP_STORE_S,
+		&&label_OP_STORE_ENT,
+		&&label_OP_STORE_BOOL,
+		&&label_OP_STORE_OBJENT,
+		&&label_OP_STORE_OBJ,
+		&&label_OP_STORE_ENTOBJ,
+		&&label_OP_STORE_FTOS,
+		&&label_OP_STORE_BTOS,
+		&&label_OP_STORE_VTOS,
+		&&label_OP_STORE_FTOBOOL,
+		&&label_OP_STORE_BOOLTOF,
+		&&label_OP_STOREP_F,
+		&&label_OP_STOREP_V,
+		&&label_OP_STOREP_S,
+		&&label_OP_STOREP_ENT,
+		&&label_OP_STOREP_FLD,
+		&&label_OP_STOREP_BOOL,
+		&&label_OP_STOREP_OBJ,
+		&&label_OP_STOREP_OBJENT,
+		&&label_OP_STOREP_FTOS,
+		&&label_OP_STOREP_BTOS,
+		&&label_OP_STOREP_VTOS,
+		&&label_OP_STOREP_FTOBOOL,
+		&&label_OP_STOREP_BOOLTOF,
+		&&label_OP_UMUL_F,
+		&&label_OP_UMUL_V,
+		&&label_OP_UDIV_F,
+		&&label_OP_UDIV_V,
+		&&label_OP_UMOD_F,
+		&&label_OP_UADD_F,
+		&&label_OP_UADD_V,
+		&&label_OP_USUB_F,
+		&&label_OP_USUB_V,
+		&&label_OP_UAND_F,
+		&&label_OP_UOR_F,
+		&&label_OP_NOT_BOOL,
+		&&label_OP_NOT_F,
+		&&label_OP_NOT_V,
+		&&label_OP_NOT_S,
+		&&label_OP_NOT_ENT,
+		&&label_OP_NEG_F,
+		&&label_OP_NEG_V,
+		&&label_OP_INT_F,
+		&&label_OP_IF,
+		&&label_OP_IFNOT,
+		&&label_OP_CALL,
+		&&label_OP_THREAD,
+		&&label_OP_OBJTHREAD,
+		&&label_OP_PUSH_F,
+		&&label_OP_PUSH_V,
+		&&label_OP_PUSH_S,
+		&&label_OP_PUSH_ENT,
+		&&label_OP_PUSH_OBJ,
+		&&label_OP_PUSH_OBJENT,
+		&&label_OP_PUSH_FTOS,
+		&&label_OP_PUSH_BTOF,
+		&&label_OP_PUSH_FTOB,
+		&&label_OP_PUSH_VTOS,
+		&&label_OP_PUSH_BTOS,
+		&&label_OP_GOTO,
+		&&label_OP_AND,
+		&&label_OP_AND_BOOLF,
+		&&label_OP_AND_FBOOL,
+		&&label_OP_AND_BOOLBOOL,
+		&&label_OP_OR,
+		&&label_OP_OR_BOOLF,
+		&&label_OP_OR_FBOOL,
+		&&label_OP_OR_BOOLBOOL,
+		&&label_OP_BITAND,
+		&&label_OP_BITOR,
+		&&label_OP_BREAK,
+		&&label_OP_CONTINUE,
+	};
+	compile_time_assert( sizeof( dispatchTable ) / sizeof( dispatchTable[0] ) == NUM_OPCODES );
+#endif
+	
 	doneProcessing = false;
 	while( !doneProcessing && !threadDying )
 	{
@@ -1126,24 +1300,24 @@ bool idInterpreter::Execute()
 		}
 		
 		// next statement
-		st = &gameLocal.program.GetStatement( instructionPointer );
+		st = &statements[ instructionPointer ];
 		
 		switch( st->op )
 		{
-			case OP_RETURN:
+			SCRIPT_OP( OP_RETURN ):
 				LeaveFunction( st->a );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_THREAD:
+			SCRIPT_OP( OP_THREAD ):
 				newThread = new idThread( this, st->a->value.functionPtr, st->b->value.argSize );
 				newThread->Start();
 				
 				// return the thread number to the script
 				gameLocal.program.ReturnFloat( newThread->GetThreadNum() );
 				PopParms( st->b->value.argSize );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_OBJTHREAD:
+			SCRIPT_OP( OP_OBJTHREAD ):
 				var_a = GetVariable( st->a );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if( obj )
@@ -1162,17 +1336,17 @@ bool idInterpreter::Execute()
 					gameLocal.program.ReturnFloat( 0.0f );
 				}
 				PopParms( st->c->value.argSize );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_CALL:
+			SCRIPT_OP( OP_CALL ):
 				EnterFunction( st->a->value.functionPtr, false );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_EVENTCALL:
+			SCRIPT_OP( OP_EVENTCALL ):
 				CallEvent( st->a->value.functionPtr, st->b->value.argSize );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_OBJECTCALL:
+			SCRIPT_OP( OP_OBJECTCALL ):
 				var_a = GetVariable( st->a );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if( obj )
@@ -1187,118 +1361,133 @@ bool idInterpreter::Execute()
 					gameLocal.program.ReturnString( "" );
 					PopParms( st->c->value.argSize );
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_SYSCALL:
+			SCRIPT_OP( OP_SYSCALL ):
 				CallSysEvent( st->a->value.functionPtr, st->b->value.argSize );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_IFNOT:
+			SCRIPT_OP( OP_IFNOT ):
 				var_a = GetVariable( st->a );
 				if( *var_a.intPtr == 0 )
 				{
 					NextInstruction( instructionPointer + st->b->value.jumpOffset );
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_IF:
+			SCRIPT_OP( OP_IF ):
 				var_a = GetVariable( st->a );
 				if( *var_a.intPtr != 0 )
 				{
 					NextInstruction( instructionPointer + st->b->value.jumpOffset );
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_GOTO:
+			// the OP_IF or OP_IFNOT on the result of a flagged comparison, it still
+			// counts against runaway like a separate statement
+fused_branch:
+				instructionPointer++;
+				if( !--runaway )
+				{
+					Error( "runaway loop error" );
+				}
+				st++;
+				if( ( *var_c.intPtr != 0 ) == ( st->op == OP_IF ) )
+				{
+					NextInstruction( instructionPointer + st->b->value.jumpOffset );
+				}
+				SCRIPT_NEXT();
+				
+			SCRIPT_OP( OP_GOTO ):
 				NextInstruction( instructionPointer + st->a->value.jumpOffset );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_ADD_F:
+			SCRIPT_OP( OP_ADD_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = *var_a.floatPtr + *var_b.floatPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_ADD_V:
+			SCRIPT_OP( OP_ADD_V ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.vectorPtr = *var_a.vectorPtr + *var_b.vectorPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_ADD_S:
+			SCRIPT_OP( OP_ADD_S ):
 				SetString( st->c, GetString( st->a ) );
 				AppendString( st->c, GetString( st->b ) );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_ADD_FS:
+			SCRIPT_OP( OP_ADD_FS ):
 				var_a = GetVariable( st->a );
 				SetString( st->c, FloatToString( *var_a.floatPtr ) );
 				AppendString( st->c, GetString( st->b ) );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_ADD_SF:
+			SCRIPT_OP( OP_ADD_SF ):
 				var_b = GetVariable( st->b );
 				SetString( st->c, GetString( st->a ) );
 				AppendString( st->c, FloatToString( *var_b.floatPtr ) );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_ADD_VS:
+			SCRIPT_OP( OP_ADD_VS ):
 				var_a = GetVariable( st->a );
 				SetString( st->c, var_a.vectorPtr->ToString() );
 				AppendString( st->c, GetString( st->b ) );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_ADD_SV:
+			SCRIPT_OP( OP_ADD_SV ):
 				var_b = GetVariable( st->b );
 				SetString( st->c, GetString( st->a ) );
 				AppendString( st->c, var_b.vectorPtr->ToString() );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_SUB_F:
+			SCRIPT_OP( OP_SUB_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = *var_a.floatPtr - *var_b.floatPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_SUB_V:
+			SCRIPT_OP( OP_SUB_V ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.vectorPtr = *var_a.vectorPtr - *var_b.vectorPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_MUL_F:
+			SCRIPT_OP( OP_MUL_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = *var_a.floatPtr** var_b.floatPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_MUL_V:
+			SCRIPT_OP( OP_MUL_V ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = *var_a.vectorPtr** var_b.vectorPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_MUL_FV:
+			SCRIPT_OP( OP_MUL_FV ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.vectorPtr = *var_a.floatPtr** var_b.vectorPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_MUL_VF:
+			SCRIPT_OP( OP_MUL_VF ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.vectorPtr = *var_a.vectorPtr** var_b.floatPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_DIV_F:
+			SCRIPT_OP( OP_DIV_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
@@ -1312,9 +1501,9 @@ bool idInterpreter::Execute()
 				{
 					*var_c.floatPtr = *var_a.floatPtr / *var_b.floatPtr;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_MOD_F:
+			SCRIPT_OP( OP_MOD_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
@@ -1328,250 +1517,275 @@ bool idInterpreter::Execute()
 				{
 					*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) % static_cast<int>( *var_b.floatPtr );
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_BITAND:
+			SCRIPT_OP( OP_BITAND ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) & static_cast<int>( *var_b.floatPtr );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_BITOR:
+			SCRIPT_OP( OP_BITOR ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr ) | static_cast<int>( *var_b.floatPtr );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_GE:
+			SCRIPT_OP( OP_GE ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr >= *var_b.floatPtr );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_LE:
+			SCRIPT_OP( OP_LE ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr <= *var_b.floatPtr );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_GT:
+			SCRIPT_OP( OP_GT ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr > *var_b.floatPtr );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_LT:
+			SCRIPT_OP( OP_LT ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr < *var_b.floatPtr );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_AND:
+			SCRIPT_OP( OP_AND ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.floatPtr != 0.0f );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_AND_BOOLF:
+			SCRIPT_OP( OP_AND_BOOLF ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.floatPtr != 0.0f );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_AND_FBOOL:
+			SCRIPT_OP( OP_AND_FBOOL ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) && ( *var_b.intPtr != 0 );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_AND_BOOLBOOL:
+			SCRIPT_OP( OP_AND_BOOLBOOL ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.intPtr != 0 ) && ( *var_b.intPtr != 0 );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_OR:
+			SCRIPT_OP( OP_OR ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.floatPtr != 0.0f );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_OR_BOOLF:
+			SCRIPT_OP( OP_OR_BOOLF ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.floatPtr != 0.0f );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_OR_FBOOL:
+			SCRIPT_OP( OP_OR_FBOOL ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr != 0.0f ) || ( *var_b.intPtr != 0 );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_OR_BOOLBOOL:
+			SCRIPT_OP( OP_OR_BOOLBOOL ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.intPtr != 0 ) || ( *var_b.intPtr != 0 );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_NOT_BOOL:
+			SCRIPT_OP( OP_NOT_BOOL ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.intPtr == 0 );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_NOT_F:
+			SCRIPT_OP( OP_NOT_F ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr == 0.0f );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_NOT_V:
+			SCRIPT_OP( OP_NOT_V ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.vectorPtr == vec3_zero );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_NOT_S:
+			SCRIPT_OP( OP_NOT_S ):
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( strlen( GetString( st->a ) ) == 0 );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_NOT_ENT:
+			SCRIPT_OP( OP_NOT_ENT ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( GetEntity( *var_a.entityNumberPtr ) == NULL );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_NEG_F:
+			SCRIPT_OP( OP_NEG_F ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = -*var_a.floatPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_NEG_V:
+			SCRIPT_OP( OP_NEG_V ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.vectorPtr = -*var_a.vectorPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_INT_F:
+			SCRIPT_OP( OP_INT_F ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = static_cast<int>( *var_a.floatPtr );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_EQ_F:
+			SCRIPT_OP( OP_EQ_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr == *var_b.floatPtr );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_EQ_V:
+			SCRIPT_OP( OP_EQ_V ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.vectorPtr == *var_b.vectorPtr );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_EQ_S:
+			SCRIPT_OP( OP_EQ_S ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) == 0 );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_EQ_E:
-			case OP_EQ_EO:
-			case OP_EQ_OE:
-			case OP_EQ_OO:
+			SCRIPT_OP( OP_EQ_E ):
+			SCRIPT_OP( OP_EQ_EO ):
+			SCRIPT_OP( OP_EQ_OE ):
+			SCRIPT_OP( OP_EQ_OO ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.entityNumberPtr == *var_b.entityNumberPtr );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_NE_F:
+			SCRIPT_OP( OP_NE_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.floatPtr != *var_b.floatPtr );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_NE_V:
+			SCRIPT_OP( OP_NE_V ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.vectorPtr != *var_b.vectorPtr );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_NE_S:
+			SCRIPT_OP( OP_NE_S ):
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( idStr::Cmp( GetString( st->a ), GetString( st->b ) ) != 0 );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_NE_E:
-			case OP_NE_EO:
-			case OP_NE_OE:
-			case OP_NE_OO:
+			SCRIPT_OP( OP_NE_E ):
+			SCRIPT_OP( OP_NE_EO ):
+			SCRIPT_OP( OP_NE_OE ):
+			SCRIPT_OP( OP_NE_OO ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ( *var_a.entityNumberPtr != *var_b.entityNumberPtr );
-				break;
+				SCRIPT_FUSE_BRANCH();
+				SCRIPT_NEXT();
 				
-			case OP_UADD_F:
+			SCRIPT_OP( OP_UADD_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr += *var_a.floatPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_UADD_V:
+			SCRIPT_OP( OP_UADD_V ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.vectorPtr += *var_a.vectorPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_USUB_F:
+			SCRIPT_OP( OP_USUB_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr -= *var_a.floatPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_USUB_V:
+			SCRIPT_OP( OP_USUB_V ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.vectorPtr -= *var_a.vectorPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_UMUL_F:
+			SCRIPT_OP( OP_UMUL_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr *= *var_a.floatPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_UMUL_V:
+			SCRIPT_OP( OP_UMUL_V ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.vectorPtr *= *var_a.floatPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_UDIV_F:
+			SCRIPT_OP( OP_UDIV_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				
@@ -1584,9 +1798,9 @@ bool idInterpreter::Execute()
 				{
 					*var_b.floatPtr = *var_b.floatPtr / *var_a.floatPtr;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_UDIV_V:
+			SCRIPT_OP( OP_UDIV_V ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				
@@ -1599,9 +1813,9 @@ bool idInterpreter::Execute()
 				{
 					*var_b.vectorPtr = *var_b.vectorPtr / *var_a.floatPtr;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_UMOD_F:
+			SCRIPT_OP( OP_UMOD_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				
@@ -1614,26 +1828,26 @@ bool idInterpreter::Execute()
 				{
 					*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) % static_cast<int>( *var_a.floatPtr );
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_UOR_F:
+			SCRIPT_OP( OP_UOR_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) | static_cast<int>( *var_a.floatPtr );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_UAND_F:
+			SCRIPT_OP( OP_UAND_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr = static_cast<int>( *var_b.floatPtr ) & static_cast<int>( *var_a.floatPtr );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_UINC_F:
+			SCRIPT_OP( OP_UINC_F ):
 				var_a = GetVariable( st->a );
 				( *var_a.floatPtr )++;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_UINCP_F:
+			SCRIPT_OP( OP_UINCP_F ):
 				var_a = GetVariable( st->a );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if( obj )
@@ -1641,14 +1855,14 @@ bool idInterpreter::Execute()
 					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
 					( *var.floatPtr )++;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_UDEC_F:
+			SCRIPT_OP( OP_UDEC_F ):
 				var_a = GetVariable( st->a );
 				( *var_a.floatPtr )--;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_UDECP_F:
+			SCRIPT_OP( OP_UDECP_F ):
 				var_a = GetVariable( st->a );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if( obj )
@@ -1656,33 +1870,33 @@ bool idInterpreter::Execute()
 					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
 					( *var.floatPtr )--;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_COMP_F:
+			SCRIPT_OP( OP_COMP_F ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				*var_c.floatPtr = ~static_cast<int>( *var_a.floatPtr );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STORE_F:
+			SCRIPT_OP( OP_STORE_F ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr = *var_a.floatPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STORE_ENT:
+			SCRIPT_OP( OP_STORE_ENT ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STORE_BOOL:
+			SCRIPT_OP( OP_STORE_BOOL ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.intPtr = *var_a.intPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STORE_OBJENT:
+			SCRIPT_OP( OP_STORE_OBJENT ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -1699,41 +1913,41 @@ bool idInterpreter::Execute()
 				{
 					*var_b.entityNumberPtr = *var_a.entityNumberPtr;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STORE_OBJ:
-			case OP_STORE_ENTOBJ:
+			SCRIPT_OP( OP_STORE_OBJ ):
+			SCRIPT_OP( OP_STORE_ENTOBJ ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.entityNumberPtr = *var_a.entityNumberPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STORE_S:
+			SCRIPT_OP( OP_STORE_S ):
 				SetString( st->b, GetString( st->a ) );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STORE_V:
+			SCRIPT_OP( OP_STORE_V ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.vectorPtr = *var_a.vectorPtr;
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STORE_FTOS:
+			SCRIPT_OP( OP_STORE_FTOS ):
 				var_a = GetVariable( st->a );
 				SetString( st->b, FloatToString( *var_a.floatPtr ) );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STORE_BTOS:
+			SCRIPT_OP( OP_STORE_BTOS ):
 				var_a = GetVariable( st->a );
 				SetString( st->b, *var_a.intPtr ? "true" : "false" );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STORE_VTOS:
+			SCRIPT_OP( OP_STORE_VTOS ):
 				var_a = GetVariable( st->a );
 				SetString( st->b, var_a.vectorPtr->ToString() );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STORE_FTOBOOL:
+			SCRIPT_OP( OP_STORE_FTOBOOL ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				if( *var_a.floatPtr != 0.0f )
@@ -1744,77 +1958,77 @@ bool idInterpreter::Execute()
 				{
 					*var_b.intPtr = 0;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STORE_BOOLTOF:
+			SCRIPT_OP( OP_STORE_BOOLTOF ):
 				var_a = GetVariable( st->a );
 				var_b = GetVariable( st->b );
 				*var_b.floatPtr = static_cast<float>( *var_a.intPtr );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_F:
+			SCRIPT_OP( OP_STOREP_F ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->floatPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->floatPtr = *var_a.floatPtr;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_ENT:
+			SCRIPT_OP( OP_STOREP_ENT ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->entityNumberPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_FLD:
+			SCRIPT_OP( OP_STOREP_FLD ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->intPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->intPtr = *var_a.intPtr;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_BOOL:
+			SCRIPT_OP( OP_STOREP_BOOL ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->intPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->intPtr = *var_a.intPtr;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_S:
+			SCRIPT_OP( OP_STOREP_S ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->stringPtr )
 				{
 					idStr::Copynz( var_b.evalPtr->stringPtr, GetString( st->a ), MAX_STRING_LEN );
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_V:
+			SCRIPT_OP( OP_STOREP_V ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->vectorPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->vectorPtr = *var_a.vectorPtr;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_FTOS:
+			SCRIPT_OP( OP_STOREP_FTOS ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->stringPtr )
 				{
 					var_a = GetVariable( st->a );
 					idStr::Copynz( var_b.evalPtr->stringPtr, FloatToString( *var_a.floatPtr ), MAX_STRING_LEN );
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_BTOS:
+			SCRIPT_OP( OP_STOREP_BTOS ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->stringPtr )
 				{
@@ -1828,18 +2042,18 @@ bool idInterpreter::Execute()
 						idStr::Copynz( var_b.evalPtr->stringPtr, "false", MAX_STRING_LEN );
 					}
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_VTOS:
+			SCRIPT_OP( OP_STOREP_VTOS ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->stringPtr )
 				{
 					var_a = GetVariable( st->a );
 					idStr::Copynz( var_b.evalPtr->stringPtr, var_a.vectorPtr->ToString(), MAX_STRING_LEN );
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_FTOBOOL:
+			SCRIPT_OP( OP_STOREP_FTOBOOL ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->intPtr )
 				{
@@ -1853,27 +2067,27 @@ bool idInterpreter::Execute()
 						*var_b.evalPtr->intPtr = 0;
 					}
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_BOOLTOF:
+			SCRIPT_OP( OP_STOREP_BOOLTOF ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->floatPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->floatPtr = static_cast<float>( *var_a.intPtr );
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_OBJ:
+			SCRIPT_OP( OP_STOREP_OBJ ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->entityNumberPtr )
 				{
 					var_a = GetVariable( st->a );
 					*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_STOREP_OBJENT:
+			SCRIPT_OP( OP_STOREP_OBJENT ):
 				var_b = GetVariable( st->b );
 				if( var_b.evalPtr && var_b.evalPtr->entityNumberPtr )
 				{
@@ -1897,9 +2111,9 @@ bool idInterpreter::Execute()
 						*var_b.evalPtr->entityNumberPtr = *var_a.entityNumberPtr;
 					}
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_ADDRESS:
+			SCRIPT_OP( OP_ADDRESS ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -1911,9 +2125,9 @@ bool idInterpreter::Execute()
 				{
 					var_c.evalPtr->bytePtr = NULL;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_INDIRECT_F:
+			SCRIPT_OP( OP_INDIRECT_F ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -1926,9 +2140,9 @@ bool idInterpreter::Execute()
 				{
 					*var_c.floatPtr = 0.0f;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_INDIRECT_ENT:
+			SCRIPT_OP( OP_INDIRECT_ENT ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -1941,9 +2155,9 @@ bool idInterpreter::Execute()
 				{
 					*var_c.entityNumberPtr = 0;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_INDIRECT_BOOL:
+			SCRIPT_OP( OP_INDIRECT_BOOL ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -1956,9 +2170,9 @@ bool idInterpreter::Execute()
 				{
 					*var_c.intPtr = 0;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_INDIRECT_S:
+			SCRIPT_OP( OP_INDIRECT_S ):
 				var_a = GetVariable( st->a );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
 				if( obj )
@@ -1970,9 +2184,9 @@ bool idInterpreter::Execute()
 				{
 					SetString( st->c, "" );
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_INDIRECT_V:
+			SCRIPT_OP( OP_INDIRECT_V ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -1985,9 +2199,9 @@ bool idInterpreter::Execute()
 				{
 					var_c.vectorPtr->Zero();
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_INDIRECT_OBJ:
+			SCRIPT_OP( OP_INDIRECT_OBJ ):
 				var_a = GetVariable( st->a );
 				var_c = GetVariable( st->c );
 				obj = GetScriptObject( *var_a.entityNumberPtr );
@@ -2000,25 +2214,25 @@ bool idInterpreter::Execute()
 					var.bytePtr = &obj->data[ st->b->value.ptrOffset ];
 					*var_c.entityNumberPtr = *var.entityNumberPtr;
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_PUSH_F:
+			SCRIPT_OP( OP_PUSH_F ):
 				var_a = GetVariable( st->a );
 				Push( *var_a.intPtr );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_PUSH_FTOS:
+			SCRIPT_OP( OP_PUSH_FTOS ):
 				var_a = GetVariable( st->a );
 				PushString( FloatToString( *var_a.floatPtr ) );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_PUSH_BTOF:
+			SCRIPT_OP( OP_PUSH_BTOF ):
 				var_a = GetVariable( st->a );
 				floatVal = *var_a.intPtr;
 				Push( *reinterpret_cast<int*>( &floatVal ) );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_PUSH_FTOB:
+			SCRIPT_OP( OP_PUSH_FTOB ):
 				var_a = GetVariable( st->a );
 				if( *var_a.floatPtr != 0.0f )
 				{
@@ -2028,28 +2242,28 @@ bool idInterpreter::Execute()
 				{
 					Push( 0 );
 				}
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_PUSH_VTOS:
+			SCRIPT_OP( OP_PUSH_VTOS ):
 				var_a = GetVariable( st->a );
 				PushString( var_a.vectorPtr->ToString() );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_PUSH_BTOS:
+			SCRIPT_OP( OP_PUSH_BTOS ):
 				var_a = GetVariable( st->a );
 				PushString( *var_a.intPtr ? "true" : "false" );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_PUSH_ENT:
+			SCRIPT_OP( OP_PUSH_ENT ):
 				var_a = GetVariable( st->a );
 				Push( *var_a.entityNumberPtr );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_PUSH_S:
+			SCRIPT_OP( OP_PUSH_S ):
 				PushString( GetString( st->a ) );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_PUSH_V:
+			SCRIPT_OP( OP_PUSH_V ):
 				var_a = GetVariable( st->a );
 				// RB: 64 bit fix, changed individual pushes with PushVector
 				/*
@@ -2059,23 +2273,23 @@ bool idInterpreter::Execute()
 				*/
 				PushVector( *var_a.vectorPtr );
 				// RB end
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_PUSH_OBJ:
+			SCRIPT_OP( OP_PUSH_OBJ ):
 				var_a = GetVariable( st->a );
 				Push( *var_a.entityNumberPtr );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_PUSH_OBJENT:
+			SCRIPT_OP( OP_PUSH_OBJENT ):
 				var_a = GetVariable( st->a );
 				Push( *var_a.entityNumberPtr );
-				break;
+				SCRIPT_NEXT();
 				
-			case OP_BREAK:
-			case OP_CONTINUE:
+			SCRIPT_OP( OP_BREAK ):
+			SCRIPT_OP( OP_CONTINUE ):
 			default:
 				Error( "Bad opcode %i", st->op );
-				break;
+				SCRIPT_NEXT();
 		}
 	}
 	
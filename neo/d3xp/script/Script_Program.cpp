@@ -1938,6 +1938,7 @@ void idProgram::BeginCompilation()
 		statement->linenumber	= 0;
 		statement->file 		= 0;
 		statement->op			= OP_RETURN;
+		statement->fuseBranch	= false;
 		statement->a			= NULL;
 		statement->b			= NULL;
 		statement->c			= NULL;
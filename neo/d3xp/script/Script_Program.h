@@ -464,6 +464,7 @@ extern	idVarDef	def_boolean;
 typedef struct statement_s
 {
 	unsigned short	op;
+	bool			fuseBranch;		// next statement is an OP_IF or OP_IFNOT on c, set by the compiler
 	idVarDef*		a;
 	idVarDef*		b;
 	idVarDef*		c;
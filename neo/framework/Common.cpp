@@ -211,6 +211,9 @@ idCommonLocal::idCommonLocal() :
 	saveFile = NULL;
 	stringsFile = NULL;
 	
+	backgroundSaveCompressing = false;
+	backgroundSaveHandle = 0;
+	
 	ClearWipe();
 }
 
@@ -1258,15 +1261,15 @@ void idCommonLocal::Init( int argc, const char* const* argv, const char* cmdline
 		
 		fileSystem->BeginLevelLoad( "_startup", saveFile.GetDataPtr(), saveFile.GetAllocated() );
 		
+		// init the parallel job manager, the declaration manager lexes decl files on it
+		parallelJobManager->Init();
+		
 		// initialize the declaration manager
 		declManager->Init();
 		
 		// init journalling, etc
 		eventLoop->Init();
 		
-		// init the parallel job manager
-		parallelJobManager->Init();
-		
 		// Carl: init the Virtual Reality head tracking, detect any connected HMDs, and read display parameters
 		// this needs to happen before the cfg files are loaded.
 		
@@ -1667,7 +1670,8 @@ void idCommonLocal::Shutdown()
 	com_shuttingDown = true;
 	
 	
-	// Kill any pending saves...
+	// Let a background save finish, then kill any pending saves...
+	WaitForBackgroundSave();
 	printf( "session->GetSaveGameManager().CancelToTerminate();\n" );
 	session->GetSaveGameManager().CancelToTerminate();
 	
@@ -1882,6 +1886,7 @@ void idCommonLocal::InitCommands()
 	cmdSystem->AddCommand( "runAAS", RunAAS_f, CMD_FL_TOOL, "compiles an AAS file for a map", idCmdSystem::ArgCompletion_MapName );
 	cmdSystem->AddCommand( "runAASDir", RunAASDir_f, CMD_FL_TOOL, "compiles AAS files for all maps in a folder", idCmdSystem::ArgCompletion_MapName );
 	cmdSystem->AddCommand( "runReach", RunReach_f, CMD_FL_TOOL, "calculates reachability for an AAS file", idCmdSystem::ArgCompletion_MapName );
+	cmdSystem->AddCommand( "runAASRoutes", RunAASRoutes_f, CMD_FL_TOOL, "precomputes the portal travel times for the AAS files of a map", idCmdSystem::ArgCompletion_MapName );
 }
 
 /*
@@ -266,6 +266,311 @@ void idCommonLocal::TimeRenderDemo( const char* demoName, bool twice, bool quit
 }
 
 
+/*
+================
+JSONEscape
+
+Escapes a string for a JSON string literal
+================
+*/
+static idStr JSONEscape( const char* text )
+{
+	idStr escaped;
+	for( const char* c = text; *c != '\0'; c++ )
+	{
+		switch( *c )
+		{
+			case '"':
+				escaped += "\\\"";
+				break;
+			case '\\':
+				escaped += "\\\\";
+				break;
+			case '\n':
+				escaped += "\\n";
+				break;
+			case '\r':
+				escaped += "\\r";
+				break;
+			case '\t':
+				escaped += "\\t";
+				break;
+			default:
+				if( ( unsigned char )*c < 0x20 )
+				{
+					escaped += va( "\\u%04x", ( unsigned char )*c );
+				}
+				else
+				{
+					escaped += *c;
+				}
+				break;
+		}
+	}
+	return escaped;
+}
+
+/*
+================================================
+idDemoStageTimes
+
+Frame times of one stage of a headless timeDemo. The histogram buckets double
+from 64 usec up to 131 msec, with a last bucket for everything slower.
+================================================
+*/
+static const int NUM_DEMO_STAGE_BUCKETS = 12;
+
+class idDemoStageTimes
+{
+public:
+	idDemoStageTimes( const char* name_ ) : name( name_ ) {}
+	
+	void		Add( uint64 microSec )
+	{
+		samples.Append( ( int )microSec );
+	}
+	
+	int			Num() const
+	{
+		return samples.Num();
+	}
+	
+	static int	BucketLimit( int bucket )
+	{
+		return 64 << bucket;
+	}
+	
+	void		Print() const;
+	void		WriteJSON( idFile* f, bool last ) const;
+	
+private:
+	int			Percentile( const idList<int>& sorted, float fraction ) const
+	{
+		return sorted[ Min( sorted.Num() - 1, idMath::Ftoi( sorted.Num() * fraction ) ) ];
+	}
+	
+	const char* name;
+	idList<int>	samples;
+};
+
+/*
+========================
+idDemoStageTimes::Print
+========================
+*/
+void idDemoStageTimes::Print() const
+{
+	if( samples.Num() == 0 )
+	{
+		return;
+	}
+	
+	idList<int> sorted = samples;
+	sorted.SortWithTemplate();
+	
+	int64 total = 0;
+	for( int i = 0; i < sorted.Num(); i++ )
+	{
+		total += sorted[i];
+	}
+	
+	common->Printf( "%-14s mean %7.3f  p95 %7.3f  max %7.3f msec\n", name,
+					total * 0.001f / sorted.Num(), Percentile( sorted, 0.95f ) * 0.001f, sorted[sorted.Num() - 1] * 0.001f );
+}
+
+/*
+========================
+idDemoStageTimes::WriteJSON
+========================
+*/
+void idDemoStageTimes::WriteJSON( idFile* f, bool last ) const
+{
+	int64 total = 0;
+	int buckets[NUM_DEMO_STAGE_BUCKETS + 1] = { 0 };
+	
+	idList<int> sorted = samples;
+	sorted.SortWithTemplate();
+	
+	for( int i = 0; i < sorted.Num(); i++ )
+	{
+		total += sorted[i];
+		
+		int b = 0;
+		while( b < NUM_DEMO_STAGE_BUCKETS && sorted[i] >= BucketLimit( b ) )
+		{
+			b++;
+		}
+		buckets[b]++;
+	}
+	
+	f->Printf( "\t\t\"%s\": {\n", name );
+	if( sorted.Num() > 0 )
+	{
+		f->Printf( "\t\t\t\"minMicroSec\": %i,\n", sorted[0] );
+		f->Printf( "\t\t\t\"meanMicroSec\": %i,\n", ( int )( total / sorted.Num() ) );
+		f->Printf( "\t\t\t\"p50MicroSec\": %i,\n", Percentile( sorted, 0.50f ) );
+		f->Printf( "\t\t\t\"p95MicroSec\": %i,\n", Percentile( sorted, 0.95f ) );
+		f->Printf( "\t\t\t\"p99MicroSec\": %i,\n", Percentile( sorted, 0.99f ) );
+		f->Printf( "\t\t\t\"maxMicroSec\": %i,\n", sorted[sorted.Num() - 1] );
+	}
+	f->Printf( "\t\t\t\"histogram\": [ " );
+	for( int b = 0; b <= NUM_DEMO_STAGE_BUCKETS; b++ )
+	{
+		f->Printf( b < NUM_DEMO_STAGE_BUCKETS ? "%i, " : "%i ]\n", buckets[b] );
+	}
+	f->Printf( last ? "\t\t}\n" : "\t\t},\n" );
+}
+
+/*
+================
+idCommonLocal::TimeRenderDemoHeadless
+
+Replays a demo through the render world, the renderer front end and the sound
+world without ever running the back end, so the numbers only contain the CPU
+cost of a frame and can be compared between builds on machines without a GPU.
+The per stage frame times are written to a JSON report.
+================
+*/
+void idCommonLocal::TimeRenderDemoHeadless( const char* demoName, const char* reportName )
+{
+	idStr demo = demoName;
+	idStr report;
+	if( reportName != NULL && reportName[0] )
+	{
+		report = reportName;
+	}
+	else
+	{
+		report = demo;
+		report.StripFileExtension();
+		report.Append( "_headless.json" );
+	}
+	
+	// the back end commands are still built, but dropped by RenderCommandBuffers
+	const bool savedSkipBackEnd = cvarSystem->GetCVarBool( "r_skipBackEnd" );
+	cvarSystem->SetCVarBool( "r_skipBackEnd", true );
+	
+	StartPlayingRenderDemo( demo );
+	if( !readDemo )
+	{
+		cvarSystem->SetCVarBool( "r_skipBackEnd", savedSkipBackEnd );
+		return;
+	}
+	
+	demo = readDemo->GetName();
+	soundSystem->SetPlayingSoundWorld( soundWorld );
+	
+	idDemoStageTimes frameTimes( "frame" );
+	idDemoStageTimes demoTimes( "demo" );
+	idDemoStageTimes drawTimes( "draw" );
+	idDemoStageTimes frontEndTimes( "frontEnd" );
+	idDemoStageTimes addLightsTimes( "addLights" );
+	idDemoStageTimes addModelsTimes( "addModels" );
+	idDemoStageTimes shadowVolumeTimes( "shadowVolumes" );
+	idDemoStageTimes soundTimes( "sound" );
+	idDemoStageTimes swapTimes( "swap" );
+	
+	const uint64 startTime = Sys_Microseconds();
+	
+	while( readDemo != NULL )
+	{
+		const uint64 frameStart = Sys_Microseconds();
+		
+		// replay the entity, light and sound updates up to the next view
+		const int lastDemoFrame = numDemoFrames;
+		bool demoRunning = true;
+		while( readDemo != NULL && numDemoFrames == lastDemoFrame && demoRunning )
+		{
+			demoRunning = AdvanceRenderDemo( true );
+		}
+		if( readDemo == NULL || !demoRunning )
+		{
+			break;
+		}
+		const uint64 demoEnd = Sys_Microseconds();
+		
+		// RenderScene runs R_RenderView for the view and all of its subviews
+		Draw();
+		const uint64 drawEnd = Sys_Microseconds();
+		
+		uint64 frontEnd, addLights, addModels, shadowVolumes;
+		renderSystem->GetFrontEndTimes( &frontEnd, &addLights, &addModels, &shadowVolumes );
+		
+		soundSystem->Render();
+		const uint64 soundEnd = Sys_Microseconds();
+		
+		renderSystem->RenderCommandBuffers( renderSystem->SwapCommandBuffers( NULL, NULL, NULL, NULL ) );
+		const uint64 frameEnd = Sys_Microseconds();
+		
+		frameTimes.Add( frameEnd - frameStart );
+		demoTimes.Add( demoEnd - frameStart );
+		drawTimes.Add( drawEnd - demoEnd );
+		frontEndTimes.Add( frontEnd );
+		addLightsTimes.Add( addLights );
+		addModelsTimes.Add( addModels );
+		shadowVolumeTimes.Add( shadowVolumes );
+		soundTimes.Add( soundEnd - drawEnd );
+		swapTimes.Add( frameEnd - soundEnd );
+	}
+	
+	const uint64 endTime = Sys_Microseconds();
+	
+	// a demo without any complete view doesn't stop by itself
+	if( readDemo != NULL )
+	{
+		Stop();
+		StartMenu();
+	}
+	
+	cvarSystem->SetCVarBool( "r_skipBackEnd", savedSkipBackEnd );
+	
+	const idDemoStageTimes* stages[] =
+	{
+		&frameTimes, &demoTimes, &drawTimes, &frontEndTimes, &addLightsTimes,
+		&addModelsTimes, &shadowVolumeTimes, &soundTimes, &swapTimes
+	};
+	const int numStages = sizeof( stages ) / sizeof( stages[0] );
+	
+	const int numFrames = frameTimes.Num();
+	const float demoSeconds = ( endTime - startTime ) * 0.000001f;
+	const float demoFPS = ( demoSeconds > 0.0f ) ? numFrames / demoSeconds : 0.0f;
+	
+	common->Printf( "%i frames replayed headless in %3.1f seconds = %3.1f fps\n", numFrames, demoSeconds, demoFPS );
+	for( int i = 0; i < numStages; i++ )
+	{
+		stages[i]->Print();
+	}
+	
+	idFile* f = fileSystem->OpenFileWrite( report );
+	if( f == NULL )
+	{
+		common->Warning( "couldn't write %s", report.c_str() );
+		return;
+	}
+	
+	f->Printf( "{\n" );
+	f->Printf( "\t\"demo\": \"%s\",\n", JSONEscape( demo ).c_str() );
+	f->Printf( "\t\"frames\": %i,\n", numFrames );
+	f->Printf( "\t\"seconds\": %.3f,\n", demoSeconds );
+	f->Printf( "\t\"fps\": %.1f,\n", demoFPS );
+	f->Printf( "\t\"bucketLimitsMicroSec\": [ " );
+	for( int b = 0; b < NUM_DEMO_STAGE_BUCKETS; b++ )
+	{
+		f->Printf( b < NUM_DEMO_STAGE_BUCKETS - 1 ? "%i, " : "%i ],\n", idDemoStageTimes::BucketLimit( b ) );
+	}
+	f->Printf( "\t\"stages\": {\n" );
+	for( int i = 0; i < numStages; i++ )
+	{
+		stages[i]->WriteJSON( f, i == numStages - 1 );
+	}
+	f->Printf( "\t}\n" );
+	f->Printf( "}\n" );
+	delete f;
+	
+	common->Printf( "wrote %s\n", report.c_str() );
+}
+
+
 /*
 ================
 idCommonLocal::BeginAVICapture
@@ -424,9 +729,11 @@ void idCommonLocal::CompressDemoFile( const char* scheme, const char* demoName )
 /*
 ===============
 idCommonLocal::AdvanceRenderDemo
+
+Returns false when the end of the demo has been reached
 ===============
 */
-void idCommonLocal::AdvanceRenderDemo( bool singleFrameOnly )
+bool idCommonLocal::AdvanceRenderDemo( bool singleFrameOnly )
 {
 	int	ds = DS_FINISHED;
 	readDemo->ReadInt( ds );
@@ -441,7 +748,7 @@ void idCommonLocal::AdvanceRenderDemo( bool singleFrameOnly )
 				Stop();
 				StartMenu();
 			}
-			return;
+			return false;
 		case DS_RENDER:
 			if( renderWorld->ProcessDemoCommand( readDemo, &currentDemoRenderView, &demoTimeOffset ) )
 			{
@@ -455,6 +762,7 @@ void idCommonLocal::AdvanceRenderDemo( bool singleFrameOnly )
 		default:
 			common->Error( "Bad render demo token" );
 	}
+	return true;
 }
 
 /*
@@ -550,6 +858,21 @@ CONSOLE_COMMAND( timeDemo, "times a demo", idCmdSystem::ArgCompletion_DemoName )
 	}
 }
 
+/*
+================
+Common_TimeDemoHeadless_f
+================
+*/
+CONSOLE_COMMAND( timeDemoHeadless, "times the CPU cost of a demo without the render back end", idCmdSystem::ArgCompletion_DemoName )
+{
+	if( args.Argc() < 2 )
+	{
+		common->Printf( "usage: timeDemoHeadless <demo> [report.json]\n" );
+		return;
+	}
+	commonLocal.TimeRenderDemoHeadless( va( "demos/%s", args.Argv( 1 ) ), ( args.Argc() > 2 ) ? args.Argv( 2 ) : NULL );
+}
+
 /*
 ================
 Common_TimeDemoQuit_f
@@ -46,6 +46,7 @@ If you have questions concerning this license or the applicable additional terms
 idCVar com_wipeSeconds( "com_wipeSeconds", "1", CVAR_SYSTEM, "" );
 idCVar com_disableAutoSaves( "com_disableAutoSaves", "0", CVAR_SYSTEM | CVAR_BOOL, "" );
 idCVar com_disableAllSaves( "com_disableAllSaves", "0", CVAR_SYSTEM | CVAR_BOOL, "" );
+idCVar com_backgroundSaves( "com_backgroundSaves", "1", CVAR_SYSTEM | CVAR_INTEGER, "0 = off, 1 = autosaves, 2 = all saves only stop the game to snapshot its state, the compression and writing happen in the background", 0, 2 );
 
 
 extern idCVar sys_lang;
@@ -427,6 +428,9 @@ void idCommonLocal::ExecuteMapChange()
 		return;
 	}
 	
+	// the level load reuses the memory of saveFile
+	WaitForBackgroundSave();
+	
 	insideExecuteMapChange = true;
 	
 	common->Printf( "--------- Execute Map Change ---------\n" );
@@ -919,6 +923,14 @@ idCommonLocal::SaveGame
 */
 bool idCommonLocal::SaveGame( const char* saveName )
 {
+	const bool backgroundSave = !insideExecuteMapChange && ( com_backgroundSaves.GetInteger() == 2 || ( com_backgroundSaves.GetInteger() == 1 && idStr::Icmp( saveName, "autosave" ) == 0 ) );
+	
+	if( !backgroundSave )
+	{
+		// a save that was asked for explicitly shouldn't be dropped because of a background save
+		WaitForBackgroundSave();
+	}
+	
 	if( pipelineFile != NULL )
 	{
 		// We're already in the middle of a save. Leave us alone.
@@ -948,6 +960,11 @@ bool idCommonLocal::SaveGame( const char* saveName )
 		return false;
 	}
 	
+	if( backgroundSave )
+	{
+		return SaveGameInBackground( saveName );
+	}
+	
 	soundWorld->Pause();
 	soundSystem->SetPlayingSoundWorld( menuSoundWorld );
 	soundSystem->Render();
@@ -978,19 +995,7 @@ bool idCommonLocal::SaveGame( const char* saveName )
 	pipelineFile = new( TAG_SAVEGAMES ) idFile_SaveGamePipelined();
 	pipelineFile->OpenForWriting( &saveFile );
 	
-	// Write SaveGame Header:
-	// Game Name / Version / Map Name / Persistant Player Info
-	
-	// game
-	const char* gamename = GAME_NAME;
-	saveFile.WriteString( gamename );
-	
-	// map
-	saveFile.WriteString( currentMapName );
-	
-	saveFile.WriteBool( consoleUsed );
-	
-	game->GetServerInfo().WriteToFileHandle( &saveFile );
+	WriteSaveGameHeader();
 	
 	// let the game save its state
 	game->SaveGame( pipelineFile, &stringsFile );
@@ -998,13 +1003,7 @@ bool idCommonLocal::SaveGame( const char* saveName )
 	pipelineFile->Finish();
 	
 	idSaveGameDetails gameDetails;
-	game->GetSaveGameDetails( gameDetails );
-	
-	gameDetails.descriptors.Set( SAVEGAME_DETAIL_FIELD_LANGUAGE, sys_lang.GetString() );
-	gameDetails.descriptors.SetInt( SAVEGAME_DETAIL_FIELD_CHECKSUM, ( int )gameDetails.descriptors.Checksum() );
-	
-	gameDetails.slotName = saveName;
-	ScrubSaveGameFileName( gameDetails.slotName );
+	FillSaveGameDetails( saveName, gameDetails );
 	
 	saveFileEntryList_t files;
 	files.Append( &stringsFile );
@@ -1042,6 +1041,162 @@ bool idCommonLocal::SaveGame( const char* saveName )
 	return true;
 }
 
+/*
+===============
+idCommonLocal::WriteSaveGameHeader
+
+Game Name / Version / Map Name / Persistant Player Info
+===============
+*/
+void idCommonLocal::WriteSaveGameHeader()
+{
+	// game
+	const char* gamename = GAME_NAME;
+	saveFile.WriteString( gamename );
+	
+	// map
+	saveFile.WriteString( currentMapName );
+	
+	saveFile.WriteBool( consoleUsed );
+	
+	game->GetServerInfo().WriteToFileHandle( &saveFile );
+}
+
+/*
+===============
+idCommonLocal::FillSaveGameDetails
+===============
+*/
+void idCommonLocal::FillSaveGameDetails( const char* saveName, idSaveGameDetails& gameDetails )
+{
+	game->GetSaveGameDetails( gameDetails );
+	
+	gameDetails.descriptors.Set( SAVEGAME_DETAIL_FIELD_LANGUAGE, sys_lang.GetString() );
+	gameDetails.descriptors.SetInt( SAVEGAME_DETAIL_FIELD_CHECKSUM, ( int )gameDetails.descriptors.Checksum() );
+	
+	gameDetails.slotName = saveName;
+	ScrubSaveGameFileName( gameDetails.slotName );
+}
+
+/*
+===============
+idSaveGameCompressThread::Run
+===============
+*/
+int idSaveGameCompressThread::Run()
+{
+	pipelineFile->Write( stateFile->GetDataPtr(), stateFile->Length() );
+	pipelineFile->Finish();
+	return 0;
+}
+
+/*
+===============
+idCommonLocal::SaveGameInBackground
+
+The game only stops while it writes its state to memory. The compression runs on saveGameThread,
+and UpdateBackgroundSave passes the files to the savegame manager once that is done.
+===============
+*/
+bool idCommonLocal::SaveGameInBackground( const char* saveName )
+{
+	// the indicator is only up while the game writes its state, GDM_SAVING pauses the game
+	Dialog().ShowSaveIndicator( true );
+	commonVr->vrIsBackgroundSaving = true;
+	
+	saveFile.MakeWritable();
+	saveFile.Clear( false );
+	stringsFile.MakeWritable();
+	stringsFile.Clear( false );
+	saveStateFile.MakeWritable();
+	saveStateFile.Clear( false );
+	
+	pipelineFile = new( TAG_SAVEGAMES ) idFile_SaveGamePipelined();
+	pipelineFile->OpenForWriting( &saveFile );
+	
+	WriteSaveGameHeader();
+	
+	// let the game save its state
+	game->SaveGame( &saveStateFile, &stringsFile );
+	
+	FillSaveGameDetails( saveName, backgroundSaveDetails );
+	
+	if( !saveGameThread.IsRunning() )
+	{
+		saveGameThread.StartWorkerThread( "SaveGame", CORE_ANY, THREAD_BELOW_NORMAL );
+	}
+	saveGameThread.pipelineFile = pipelineFile;
+	saveGameThread.stateFile = &saveStateFile;
+	saveGameThread.SignalWork();
+	
+	backgroundSaveCompressing = true;
+	syncNextGameFrame = true;
+	
+	// the state is with the compression thread now, let the game run on
+	Dialog().ShowSaveIndicator( false );
+	commonVr->vrIsBackgroundSaving = false;
+	
+	return true;
+}
+
+/*
+===============
+idCommonLocal::UpdateBackgroundSave
+
+Called every frame, hands a background save to the savegame manager when the compression is done
+===============
+*/
+void idCommonLocal::UpdateBackgroundSave( bool wait )
+{
+	if( !backgroundSaveCompressing )
+	{
+		return;
+	}
+	
+	if( !wait && !saveGameThread.IsWorkDone() )
+	{
+		return;
+	}
+	
+	saveGameThread.WaitForThread();
+	backgroundSaveCompressing = false;
+	
+	saveFileEntryList_t files;
+	files.Append( &stringsFile );
+	files.Append( &saveFile );
+	
+	if( wait )
+	{
+		session->SaveGameSync( backgroundSaveDetails.slotName, files, backgroundSaveDetails );
+	}
+	else
+	{
+		backgroundSaveHandle = session->SaveGameAsync( backgroundSaveDetails.slotName, files, backgroundSaveDetails );
+	}
+	
+	commonVr->lastSaveTime = Sys_Milliseconds();
+	commonVr->wasSaved = true;
+}
+
+/*
+===============
+idCommonLocal::WaitForBackgroundSave
+
+Finishes a background save, before anything else gets to use saveFile and stringsFile
+===============
+*/
+void idCommonLocal::WaitForBackgroundSave()
+{
+	UpdateBackgroundSave( true );
+	
+	while( backgroundSaveHandle != 0 && !session->IsSaveGameCompletedFromHandle( backgroundSaveHandle ) )
+	{
+		session->GetSaveGameManager().Pump();
+		Sys_Sleep( 10 );
+	}
+	backgroundSaveHandle = 0;
+}
+
 /*
 ===============
 idCommonLocal::LoadGame
@@ -1049,6 +1204,8 @@ idCommonLocal::LoadGame
 */
 bool idCommonLocal::LoadGame( const char* saveName )
 {
+	WaitForBackgroundSave();
+	
 	// Koz begin
 	// koz fixme do this right.
 	// Make sure the pda is in a valid state on game load.
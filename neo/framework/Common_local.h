@@ -99,6 +99,21 @@ private:
 	bool			isClient;
 };
 
+// Compresses the game state of a background save while the game keeps running
+class idSaveGameCompressThread : public idSysThread
+{
+public:
+	idSaveGameCompressThread() :
+		pipelineFile( NULL ),
+		stateFile( NULL )
+	{}
+	
+	virtual int		Run();
+	
+	idFile_SaveGamePipelined* 	pipelineFile;
+	const idFile_Memory* 		stateFile;
+};
+
 enum errorParm_t
 {
 	ERP_NONE,
@@ -334,6 +349,7 @@ public:	// These are public because they are called directly by static functions
 	void	StopPlayingRenderDemo();
 	void	CompressDemoFile( const char* scheme, const char* name );
 	void	TimeRenderDemo( const char* name, bool twice = false, bool quit = false );
+	void	TimeRenderDemoHeadless( const char* name, const char* reportName );
 	void	AVIRenderDemo( const char* name );
 	void	AVIGame( const char* name );
 	
@@ -375,6 +391,14 @@ private:
 	idFile_SaveGame 			stringsFile;
 	idFile_SaveGamePipelined*	 pipelineFile;
 	
+	// Background saves snapshot the game state into saveStateFile, compress it on saveGameThread,
+	// and then hand it to the savegame manager without waiting for it
+	idFile_Memory				saveStateFile;
+	idSaveGameCompressThread			saveGameThread;
+	bool						backgroundSaveCompressing;
+	saveGameHandle_t			backgroundSaveHandle;
+	idSaveGameDetails			backgroundSaveDetails;
+	
 	// The main render world and sound world
 	idRenderWorld* 		renderWorld;
 	idSoundWorld* 		soundWorld;
@@ -562,7 +586,7 @@ private:
 	void	BeginAVICapture( const char* name );
 	void	EndAVICapture();
 	
-	void	AdvanceRenderDemo( bool singleFrameOnly );
+	bool	AdvanceRenderDemo( bool singleFrameOnly );
 	
 	void	ProcessGameReturn( const gameReturn_t& ret );
 	
@@ -604,6 +628,12 @@ private:
 	void	PlayIntroGui();
 	
 	void	ScrubSaveGameFileName( idStr& saveFileName ) const;
+	void	WriteSaveGameHeader();
+	void	FillSaveGameDetails( const char* saveName, idSaveGameDetails& gameDetails );
+	
+	bool	SaveGameInBackground( const char* saveName );
+	void	UpdateBackgroundSave( bool wait );
+	void	WaitForBackgroundSave();
 	
 	// RB begin
 #if defined(USE_DOOMCLASSIC)
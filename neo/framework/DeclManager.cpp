@@ -64,6 +64,13 @@ missing reload over a previously explicit definition
 #define USE_COMPRESSED_DECLS
 //#define GET_HUFFMAN_FREQUENCIES
 
+// generated index of the declarations in each decl file, so unchanged files don't have to be lexed
+static const char* DECL_INDEX_FILE_EXT		= ".bdecl";
+static const char* DECL_INDEX_FILEID		= "BDI";
+static const char* DECL_INDEX_FILEVERSION	= "1";
+
+idCVar binaryLoadDecls( "binaryLoadDecls", "1", 0, "enable binary load/write of decl file indexes" );
+
 class idDeclType
 {
 public:
@@ -156,6 +163,16 @@ private:
 	idDeclLocal* 				nextInFile;				// next decl in the decl file
 };
 
+// one declaration found in a decl file, the text itself stays in the file
+struct declFileEntry_t
+{
+	declType_t					type;
+	idStr						name;
+	int							textOffset;
+	int							textLength;
+	int							sourceLine;
+};
+
 class idDeclFile
 {
 public:
@@ -165,6 +182,28 @@ public:
 	void						Reload( bool force );
 	int							LoadAndParse();
 	
+	// LoadAndParse in three steps, only FindDecls is safe to run on a job thread
+	bool						ReadSource();
+	void						FindDecls();
+	int							AddDecls();
+	
+private:
+	bool						ScanText( const char* buffer, int length, idList< declFileEntry_t >& entries );
+	void						AddDecl( const declFileEntry_t& entry, const char* buffer );
+	
+	void						GetBinaryIndexName( idStr& generatedFileName ) const;
+	bool						LoadBinaryIndex( idFile* file, idList< declFileEntry_t >& entries );
+	void						WriteBinaryIndex( const idList< declFileEntry_t >& entries ) const;
+	
+	// state carried between the load steps
+	char* 						loadBuffer;
+	idFile* 					loadIndexFile;
+	bool						loadScanned;		// entries came from the text, the index needs to be written
+	bool						loadFailed;
+	bool						loadIndexCorrupt;
+	bool						loadWarnings;		// a scan on a job thread suppressed lexer warnings
+	idList< declFileEntry_t >	loadEntries;
+	
 public:
 	idStr						fileName;
 	declType_t					defaultType;
@@ -190,6 +229,7 @@ public:
 	virtual void				EndLevelLoad();
 	virtual void				RegisterDeclType( const char* typeName, declType_t type, idDecl * ( *allocator )() );
 	virtual void				RegisterDeclFolder( const char* folder, const char* extension, declType_t defaultType );
+	void						LoadDeclFiles( const idList< idDeclFile* >& files );
 	virtual int					GetChecksum() const;
 	virtual int					GetNumDeclTypes() const;
 	virtual int					GetNumDecls( declType_t type );
@@ -611,6 +651,12 @@ idDeclFile::idDeclFile( const char* fileName, declType_t defaultType )
 	this->fileSize = 0;
 	this->numLines = 0;
 	this->decls = NULL;
+	this->loadBuffer = NULL;
+	this->loadIndexFile = NULL;
+	this->loadScanned = false;
+	this->loadFailed = false;
+	this->loadIndexCorrupt = false;
+	this->loadWarnings = false;
 }
 
 /*
@@ -627,6 +673,12 @@ idDeclFile::idDeclFile()
 	this->fileSize = 0;
 	this->numLines = 0;
 	this->decls = NULL;
+	this->loadBuffer = NULL;
+	this->loadIndexFile = NULL;
+	this->loadScanned = false;
+	this->loadFailed = false;
+	this->loadIndexCorrupt = false;
+	this->loadWarnings = false;
 }
 
 /*
@@ -665,44 +717,156 @@ int c_savedMemory = 0;
 
 int idDeclFile::LoadAndParse()
 {
-	int			i, numTypes;
-	idLexer		src;
-	idToken		token;
-	int			startMarker;
-	char* 		buffer;
-	int			length, size;
-	int			sourceLine;
-	idStr		name;
-	idDeclLocal* newDecl;
-	bool		reparse;
-	
-	// load the text
+	if( !ReadSource() )
+	{
+		return 0;
+	}
+	FindDecls();
+	return AddDecls();
+}
+
+/*
+================
+idDeclFile::ReadSource
+
+Loads the text and the generated index, the file system can only be used from the main thread
+================
+*/
+bool idDeclFile::ReadSource()
+{
 	common->DPrintf( "...loading '%s'\n", fileName.c_str() );
-	length = fileSystem->ReadFile( fileName, ( void** )&buffer, &timestamp );
-	if( length == -1 )
+	fileSize = fileSystem->ReadFile( fileName, ( void** )&loadBuffer, &timestamp );
+	if( fileSize == -1 )
 	{
 		common->FatalError( "couldn't load %s", fileName.c_str() );
-		return 0;
+		return false;
 	}
 	
-	if( !src.LoadMemory( buffer, length, fileName ) )
+	if( binaryLoadDecls.GetBool() )
+	{
+		idStr generatedFileName;
+		GetBinaryIndexName( generatedFileName );
+		loadIndexFile = fileSystem->OpenFileReadMemory( generatedFileName );
+	}
+	return true;
+}
+
+/*
+================
+idDeclFile::FindDecls
+
+Finds the individual declarations, from the generated index if the text hasn't changed.
+This only touches the file itself, so the files can be processed in parallel.
+================
+*/
+void idDeclFile::FindDecls()
+{
+	checksum = MD5_BlockChecksum( loadBuffer, fileSize );
+	
+	loadEntries.Clear();
+	loadScanned = false;
+	loadFailed = false;
+	loadIndexCorrupt = false;
+	loadWarnings = false;
+	if( loadIndexFile == NULL || !LoadBinaryIndex( loadIndexFile, loadEntries ) )
+	{
+		loadScanned = true;
+		loadFailed = !ScanText( loadBuffer, fileSize, loadEntries );
+	}
+}
+
+/*
+================
+idDeclFile::AddDecls
+
+Registers the declarations found by FindDecls.  Files must be added in the same
+order as a serial load, decl indices and the decl checksum depend on it.
+Warnings can only be printed from the main thread, so the ones from FindDecls
+on a job thread are printed here.
+================
+*/
+int idDeclFile::AddDecls()
+{
+	if( loadIndexCorrupt )
+	{
+		common->Warning( "%s is corrupt, reparsing %s", loadIndexFile->GetName(), fileName.c_str() );
+	}
+	delete loadIndexFile;
+	loadIndexFile = NULL;
+	
+	// scan the text again to print the lexer warnings in order
+	if( loadWarnings )
 	{
+		loadEntries.Clear();
+		loadFailed = !ScanText( loadBuffer, fileSize, loadEntries );
+	}
+	
+	if( loadFailed )
+	{
+		Mem_Free( loadBuffer );
+		loadBuffer = NULL;
 		common->Error( "Couldn't parse %s", fileName.c_str() );
-		Mem_Free( buffer );
 		return 0;
 	}
 	
+	if( loadScanned && binaryLoadDecls.GetBool() )
+	{
+		WriteBinaryIndex( loadEntries );
+	}
+	
 	// mark all the defs that were from the last reload of this file
 	for( idDeclLocal* decl = decls; decl; decl = decl->nextInFile )
 	{
 		decl->redefinedInReload = false;
 	}
 	
-	src.SetFlags( DECL_LEXER_FLAGS );
+	for( int i = 0; i < loadEntries.Num(); i++ )
+	{
+		AddDecl( loadEntries[i], loadBuffer );
+	}
+	loadEntries.Clear();
+	
+	Mem_Free( loadBuffer );
+	loadBuffer = NULL;
+	
+	// any defs that weren't redefinedInReload should now be defaulted
+	for( idDeclLocal* decl = decls ; decl ; decl = decl->nextInFile )
+	{
+		if( decl->redefinedInReload == false )
+		{
+			decl->MakeDefault();
+			decl->sourceTextOffset = decl->sourceFile->fileSize;
+			decl->sourceTextLength = 0;
+			decl->sourceLine = decl->sourceFile->numLines;
+		}
+	}
+	
+	return checksum;
+}
+
+/*
+================
+idDeclFile::ScanText
+
+Lexes the file text, identifying each individual declaration
+================
+*/
+bool idDeclFile::ScanText( const char* buffer, int length, idList< declFileEntry_t >& entries )
+{
+	int			i, numTypes;
+	idLexer		src;
+	idToken		token;
+	int			startMarker;
+	int			sourceLine;
 	
-	checksum = MD5_BlockChecksum( buffer, length );
+	if( !src.LoadMemory( buffer, length, fileName ) )
+	{
+		return false;
+	}
 	
-	fileSize = length;
+	// a scan on a job thread stays quiet, AddDecls scans again if there was anything to print
+	const bool quiet = !idLib::IsMainThread();
+	src.SetFlags( quiet ? ( DECL_LEXER_FLAGS | LEXFL_NOWARNINGS | LEXFL_NOERRORS ) : DECL_LEXER_FLAGS );
 	
 	// scan through, identifying each individual declaration
 	while( 1 )
@@ -779,89 +943,199 @@ int idDeclFile::LoadAndParse()
 			continue;
 		}
 		
-		name = token;
+		declFileEntry_t& entry = entries.Alloc();
+		entry.type = identifiedType;
+		entry.name = token;
 		
 		// make sure there's a '{'
 		if( !src.ReadToken( &token ) )
 		{
 			src.Warning( "Type without definition at end of file" );
+			entries.RemoveIndex( entries.Num() - 1 );
 			break;
 		}
 		if( token != "{" )
 		{
 			src.Warning( "Expecting '{' but found '%s'", token.c_str() );
+			entries.RemoveIndex( entries.Num() - 1 );
 			continue;
 		}
 		src.UnreadToken( &token );
 		
 		// now take everything until a matched closing brace
 		src.SkipBracedSection();
-		size = src.GetFileOffset() - startMarker;
 		
-		// look it up, possibly getting a newly created default decl
-		reparse = false;
-		newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, false );
-		if( newDecl )
-		{
-			// update the existing copy
-			if( newDecl->sourceFile != this || newDecl->redefinedInReload )
-			{
-				src.Warning( "%s '%s' previously defined at %s:%i", declManagerLocal.GetDeclNameFromType( identifiedType ),
-							 name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
-				continue;
-			}
-			if( newDecl->declState != DS_UNPARSED )
-			{
-				reparse = true;
-			}
-		}
-		else
-		{
-			// allow it to be created as a default, then add it to the per-file list
-			newDecl = declManagerLocal.FindTypeWithoutParsing( identifiedType, name, true );
-			newDecl->nextInFile = this->decls;
-			this->decls = newDecl;
-		}
-		
-		newDecl->redefinedInReload = true;
-		
-		if( newDecl->textSource )
+		entry.textOffset = startMarker;
+		entry.textLength = src.GetFileOffset() - startMarker;
+		entry.sourceLine = sourceLine;
+	}
+	
+	numLines = src.GetLineNum();
+	loadWarnings = quiet && ( src.HadWarning() || src.HadError() );
+	
+	return true;
+}
+
+/*
+================
+idDeclFile::AddDecl
+================
+*/
+void idDeclFile::AddDecl( const declFileEntry_t& entry, const char* buffer )
+{
+	// look it up, possibly getting a newly created default decl
+	bool reparse = false;
+	idDeclLocal* newDecl = declManagerLocal.FindTypeWithoutParsing( entry.type, entry.name, false );
+	if( newDecl )
+	{
+		// update the existing copy
+		if( newDecl->sourceFile != this || newDecl->redefinedInReload )
 		{
-			Mem_Free( newDecl->textSource );
-			newDecl->textSource = NULL;
+			common->Warning( "file %s, line %d: %s '%s' previously defined at %s:%i", fileName.c_str(), entry.sourceLine,
+							 declManagerLocal.GetDeclNameFromType( entry.type ), entry.name.c_str(), newDecl->sourceFile->fileName.c_str(), newDecl->sourceLine );
+			return;
 		}
-		
-		newDecl->SetTextLocal( buffer + startMarker, size );
-		newDecl->sourceFile = this;
-		newDecl->sourceTextOffset = startMarker;
-		newDecl->sourceTextLength = size;
-		newDecl->sourceLine = sourceLine;
-		newDecl->declState = DS_UNPARSED;
-		
-		// if it is currently in use, reparse it immedaitely
-		if( reparse )
+		if( newDecl->declState != DS_UNPARSED )
 		{
-			newDecl->ParseLocal();
+			reparse = true;
 		}
 	}
+	else
+	{
+		// allow it to be created as a default, then add it to the per-file list
+		newDecl = declManagerLocal.FindTypeWithoutParsing( entry.type, entry.name, true );
+		newDecl->nextInFile = this->decls;
+		this->decls = newDecl;
+	}
 	
-	numLines = src.GetLineNum();
+	newDecl->redefinedInReload = true;
 	
-	Mem_Free( buffer );
+	if( newDecl->textSource )
+	{
+		Mem_Free( newDecl->textSource );
+		newDecl->textSource = NULL;
+	}
 	
-	// any defs that weren't redefinedInReload should now be defaulted
-	for( idDeclLocal* decl = decls ; decl ; decl = decl->nextInFile )
+	newDecl->SetTextLocal( buffer + entry.textOffset, entry.textLength );
+	newDecl->sourceFile = this;
+	newDecl->sourceTextOffset = entry.textOffset;
+	newDecl->sourceTextLength = entry.textLength;
+	newDecl->sourceLine = entry.sourceLine;
+	newDecl->declState = DS_UNPARSED;
+	
+	// if it is currently in use, reparse it immedaitely
+	if( reparse )
 	{
-		if( decl->redefinedInReload == false )
+		newDecl->ParseLocal();
+	}
+}
+
+/*
+================
+idDeclFile::GetBinaryIndexName
+================
+*/
+void idDeclFile::GetBinaryIndexName( idStr& generatedFileName ) const
+{
+	// keep the source extension, the same base name is used by different decl types
+	generatedFileName = "generated/decls/";
+	generatedFileName.AppendPath( fileName );
+	generatedFileName.Append( DECL_INDEX_FILE_EXT );
+}
+
+/*
+================
+idDeclFile::LoadBinaryIndex
+
+The generated index is only used if it was built from the exact same text
+with the same set of registered decl types, anything else falls back to lexing
+================
+*/
+bool idDeclFile::LoadBinaryIndex( idFile* file, idList< declFileEntry_t >& entries )
+{
+	idStrStatic< 32 > fileID;
+	idStrStatic< 32 > fileVersion;
+	file->ReadString( fileID );
+	file->ReadString( fileVersion );
+	if( fileID != DECL_INDEX_FILEID || fileVersion != DECL_INDEX_FILEVERSION )
+	{
+		return false;
+	}
+	
+	int64 fileTimestamp;
+	int fileChecksum, fileLength, numTypes, numEntries;
+	file->ReadBig( fileTimestamp );
+	file->ReadBig( fileChecksum );
+	file->ReadBig( fileLength );
+	file->ReadBig( numTypes );
+	if( fileTimestamp != ( int64 )timestamp || fileChecksum != checksum || fileLength != fileSize || numTypes != declManagerLocal.GetNumDeclTypes() )
+	{
+		return false;
+	}
+	
+	file->ReadBig( numLines );
+	file->ReadBig( numEntries );
+	if( numEntries < 0 )
+	{
+		return false;
+	}
+	
+	entries.SetNum( numEntries );
+	for( int i = 0; i < numEntries; i++ )
+	{
+		declFileEntry_t& entry = entries[i];
+		int type;
+		file->ReadBig( type );
+		file->ReadString( entry.name );
+		file->ReadBig( entry.textOffset );
+		file->ReadBig( entry.textLength );
+		file->ReadBig( entry.sourceLine );
+		entry.type = ( declType_t )type;
+		
+		if( type < 0 || type >= numTypes || entry.textOffset < 0 || entry.textLength < 0 || entry.textOffset > fileSize - entry.textLength )
 		{
-			decl->MakeDefault();
-			decl->sourceTextOffset = decl->sourceFile->fileSize;
-			decl->sourceTextLength = 0;
-			decl->sourceLine = decl->sourceFile->numLines;
+			loadIndexCorrupt = true;
+			entries.Clear();
+			return false;
 		}
 	}
 	
-	return checksum;
+	return true;
+}
+
+/*
+================
+idDeclFile::WriteBinaryIndex
+================
+*/
+void idDeclFile::WriteBinaryIndex( const idList< declFileEntry_t >& entries ) const
+{
+	idStr generatedFileName;
+	GetBinaryIndexName( generatedFileName );
+	
+	idFileLocal file( fileSystem->OpenFileWrite( generatedFileName, "fs_basepath" ) );
+	if( file == NULL )
+	{
+		return;
+	}
+	
+	file->WriteString( DECL_INDEX_FILEID );
+	file->WriteString( DECL_INDEX_FILEVERSION );
+	file->WriteBig( ( int64 )timestamp );
+	file->WriteBig( checksum );
+	file->WriteBig( fileSize );
+	file->WriteBig( declManagerLocal.GetNumDeclTypes() );
+	file->WriteBig( numLines );
+	file->WriteBig( entries.Num() );
+	for( int i = 0; i < entries.Num(); i++ )
+	{
+		const declFileEntry_t& entry = entries[i];
+		file->WriteBig( ( int )entry.type );
+		file->WriteString( entry.name );
+		file->WriteBig( entry.textOffset );
+		file->WriteBig( entry.textLength );
+		file->WriteBig( entry.sourceLine );
+	}
 }
 
 /*
@@ -1118,6 +1392,7 @@ void idDeclManagerLocal::RegisterDeclFolder( const char* folder, const char* ext
 	fileList = fileSystem->ListFiles( declFolder->folder, declFolder->extension, true );
 	
 	// load and parse decl files
+	idList< idDeclFile* > files;
 	for( i = 0; i < fileList->GetNumFiles(); i++ )
 	{
 		fileName = declFolder->folder + "/" + fileList->GetFile( i );
@@ -1139,12 +1414,65 @@ void idDeclManagerLocal::RegisterDeclFolder( const char* folder, const char* ext
 			df = new( TAG_DECL ) idDeclFile( fileName, defaultType );
 			loadedFiles.Append( df );
 		}
-		df->LoadAndParse();
+		files.Append( df );
 	}
+	LoadDeclFiles( files );
 	
 	fileSystem->FreeFileList( fileList );
 }
 
+/*
+===================
+idDeclManagerLocal::LoadDeclFiles
+
+The files are read on the main thread and lexed in parallel, then the decls
+are registered in file order so the result is the same as a serial load.
+===================
+*/
+static void DeclFileFindDeclsJob( idDeclFile* declFile )
+{
+	declFile->FindDecls();
+}
+
+REGISTER_PARALLEL_JOB( DeclFileFindDeclsJob, "DeclFileFindDeclsJob" );
+
+void idDeclManagerLocal::LoadDeclFiles( const idList< idDeclFile* >& files )
+{
+	int numRead = 0;
+	for( int i = 0; i < files.Num(); i++ )
+	{
+		if( !files[i]->ReadSource() )
+		{
+			break;
+		}
+		numRead++;
+	}
+	
+	if( numRead > 1 && parallelJobManager->GetNumProcessingUnits() > 0 )
+	{
+		idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, numRead, 0, NULL );
+		for( int i = 0; i < numRead; i++ )
+		{
+			jobList->AddJob( ( jobRun_t )DeclFileFindDeclsJob, files[i] );
+		}
+		jobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+		jobList->Wait();
+		parallelJobManager->FreeJobList( jobList );
+	}
+	else
+	{
+		for( int i = 0; i < numRead; i++ )
+		{
+			files[i]->FindDecls();
+		}
+	}
+	
+	for( int i = 0; i < numRead; i++ )
+	{
+		files[i]->AddDecls();
+	}
+}
+
 /*
 ===================
 idDeclManagerLocal::GetChecksum
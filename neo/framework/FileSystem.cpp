@@ -259,6 +259,8 @@ private:
 	idPreloadManifest		preloadList;
 	
 	idList< idResourceContainer* > resourceFiles;
+	idSysInterlockedPointer< idResourceDirectory > resourceDirectory;
+	idSysInterlockedInteger	resourceDirectoryReaders;
 	byte* 	resourceBufferPtr;
 	int		resourceBufferSize;
 	int		resourceBufferAvailable;
@@ -290,6 +292,7 @@ private:
 	void					RemoveResourceFileByIndex( const int& idx );
 	void					RemoveResourceFile( const char* resourceFileName );
 	int						FindResourceFile( const char* resourceFileName );
+	void					RebuildResourceDirectory();
 	
 	void					SetupGameDirectories( const char* gameName );
 	void					Startup();
@@ -2874,6 +2877,7 @@ int idFileSystemLocal::AddResourceFile( const char* resourceFileName )
 	if( rc->Init( resourceFile, resourceFiles.Num() ) )
 	{
 		resourceFiles.Append( rc );
+		RebuildResourceDirectory();
 		common->Printf( "Loaded resource file %s\n", resourceFile.c_str() );
 		return resourceFiles.Num() - 1;
 	}
@@ -2907,13 +2911,16 @@ void idFileSystemLocal::RemoveResourceFileByIndex( const int& idx )
 	{
 		if( idx >= 0 && idx < resourceFiles.Num() )
 		{
-			delete resourceFiles[ idx ];
+			// the container can't be deleted until no lookup can reach it
+			idResourceContainer* rc = resourceFiles[ idx ];
 			resourceFiles.RemoveIndex( idx );
 			for( int i = 0; i < resourceFiles.Num(); i++ )
 			{
 				// fixup any container indexes
 				resourceFiles[ i ]->SetContainerIndex( i );
 			}
+			RebuildResourceDirectory();
+			delete rc;
 		}
 	}
 }
@@ -3012,6 +3019,7 @@ void idFileSystemLocal::AddGameDirectory( const char* path, const char* dir )
 					//com_productionMode.SetInteger( 2 );
 				}
 			}
+			RebuildResourceDirectory();
 		}
 	}
 	// RB end
@@ -3191,7 +3199,10 @@ void idFileSystemLocal::Shutdown( bool reloading )
 	gameFolder.Clear();
 	searchPaths.Clear();
 	
-	resourceFiles.DeleteContents();
+	idList< idResourceContainer* > oldResourceFiles = resourceFiles;
+	resourceFiles.Clear();
+	RebuildResourceDirectory();
+	oldResourceFiles.DeleteContents();
 	
 	
 	cmdSystem->RemoveCommand( "path" );
@@ -3244,25 +3255,61 @@ bool idFileSystemLocal::GetResourceCacheEntry( const char* fileName, idResourceC
 	
 	canonical.BackSlashesToSlashes();
 	canonical.ToLower();
-	int idx = resourceFiles.Num() - 1;
-	while( idx >= 0 )
+	
+	// the reader count keeps RebuildResourceDirectory from freeing the
+	// directory or its containers out from under the background loader
+	resourceDirectoryReaders.Increment();
+	
+	bool found = false;
+	const idResourceDirectory* directory = resourceDirectory.Get();
+	if( directory != NULL )
 	{
-		const int key = resourceFiles[ idx ]->cacheHash.GenerateKey( canonical, false );
-		for( int index = resourceFiles[ idx ]->cacheHash.GetFirst( key ); index != idHashIndex::NULL_INDEX; index = resourceFiles[ idx ]->cacheHash.GetNext( index ) )
+		int idx;
+		const idResourceCacheEntry* rt = directory->Find( canonical, idx );
+		if( rt != NULL )
 		{
-			idResourceCacheEntry& rt = resourceFiles[ idx ]->cacheTable[ index ];
-			if( idStr::Icmp( rt.filename, canonical ) == 0 )
-			{
-				rc.filename = rt.filename;
-				rc.length = rt.length;
-				rc.containerIndex = idx;
-				rc.offset = rt.offset;
-				return true;
-			}
+			rc.filename = rt->filename;
+			rc.length = rt->length;
+			rc.containerIndex = idx;
+			rc.offset = rt->offset;
+			found = true;
 		}
-		idx--;
 	}
-	return false;
+	
+	resourceDirectoryReaders.Decrement();
+	
+	return found;
+}
+
+/*
+========================
+idFileSystemLocal::RebuildResourceDirectory
+
+Called from the main thread whenever a resource container is mounted or
+removed.  The new directory is published with a single pointer swap, and
+the old one is only freed once no lookup is still searching it.
+========================
+*/
+void idFileSystemLocal::RebuildResourceDirectory()
+{
+	idResourceDirectory* directory = NULL;
+	if( resourceFiles.Num() > 0 )
+	{
+		directory = new( TAG_RESOURCE ) idResourceDirectory;
+		directory->Build( resourceFiles );
+	}
+	
+	idResourceDirectory* oldDirectory = resourceDirectory.Set( directory );
+	while( resourceDirectoryReaders.GetValue() > 0 )
+	{
+		Sys_Yield();
+	}
+	delete oldDirectory;
+	
+	if( fs_debugResources.GetBool() && directory != NULL )
+	{
+		idLib::Printf( "RES: %i files in %i resource containers\n", directory->Num(), resourceFiles.Num() );
+	}
 }
 
 /*
@@ -3288,6 +3335,15 @@ idFile* idFileSystemLocal::GetResourceFile( const char* fileName, bool memFile )
 		{
 			idLib::Printf( "RES: loading file %s\n", rc.filename.c_str() );
 		}
+		
+		// serve it straight out of the mapping when the container has one
+		const idResourceContainer* container = resourceFiles[ rc.containerIndex ];
+		if( container->mappedData != NULL && rc.offset >= 0 && rc.length >= 0 && rc.offset <= container->mappedLength - rc.length )
+		{
+			Sys_PrefetchMappedRange( container->mappedData, rc.offset, rc.length );
+			return new( TAG_IDFILE ) idFile_Memory( rc.filename, ( const char* )container->mappedData + rc.offset, rc.length );
+		}
+		
 		idFile_InnerResource* file = new idFile_InnerResource( rc.filename, resourceFiles[ rc.containerIndex ]->resourceFile, rc.offset, rc.length );
 		// DG: add parenthesis to make sure this block is only entered when file != NULL - bug found by clang.
 		if( file != NULL && ( ( memFile || rc.length <= resourceBufferAvailable ) || rc.length < 8 * 1024 * 1024 ) )
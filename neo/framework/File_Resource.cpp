@@ -29,6 +29,8 @@ If you have questions concerning this license or the applicable additional terms
 #include "precompiled.h"
 #pragma hdrstop
 
+idCVar fs_mapResources( "fs_mapResources", "1", CVAR_SYSTEM | CVAR_BOOL | CVAR_INIT, "serve resource file reads from a memory mapping of the container where the platform supports it" );
+
 /*
 ================================================================================================
 
@@ -118,6 +120,11 @@ bool idResourceContainer::Init( const char* _fileName, uint8 containerIndex )
 	}
 	Mem_Free( buf );
 	
+	if( fs_mapResources.GetBool() )
+	{
+		mappedData = ( byte* )Sys_MapFile( resourceFile->GetFullPath(), mappedLength );
+	}
+	
 	return true;
 }
 
@@ -554,3 +561,83 @@ void idResourceContainer::WriteResourceFile( const char* manifestName, const idS
 		delete resFile;
 	}
 }
+
+/*
+================================================================================================
+
+idResourceDirectory
+
+================================================================================================
+*/
+
+/*
+========================
+idResourceDirectory::Build
+========================
+*/
+void idResourceDirectory::Build( const idList< idResourceContainer* >& containers )
+{
+	int total = 0;
+	for( int i = 0; i < containers.Num(); i++ )
+	{
+		total += containers[ i ]->cacheTable.Num();
+	}
+	
+	// keep the load factor at or below one half so probe sequences stay short
+	const int tableSize = idMath::CeilPowerOfTwo( Max( total * 2, 16 ) );
+	table.SetNum( tableSize );
+	memset( table.Ptr(), 0, tableSize * sizeof( entry_t ) );
+	mask = tableSize - 1;
+	numEntries = 0;
+	
+	// later containers replace the entries of earlier ones
+	for( int i = 0; i < containers.Num(); i++ )
+	{
+		const idList< idResourceCacheEntry, TAG_RESOURCE >& cacheTable = containers[ i ]->cacheTable;
+		for( int j = 0; j < cacheTable.Num(); j++ )
+		{
+			const idResourceCacheEntry& rt = cacheTable[ j ];
+			const int hash = idStr::Hash( rt.filename );
+			int slot = hash & mask;
+			while( table[ slot ].rc != NULL )
+			{
+				if( table[ slot ].hash == hash && idStr::Cmp( table[ slot ].rc->filename, rt.filename ) == 0 )
+				{
+					break;
+				}
+				slot = ( slot + 1 ) & mask;
+			}
+			if( table[ slot ].rc == NULL )
+			{
+				numEntries++;
+			}
+			table[ slot ].hash = hash;
+			table[ slot ].containerIndex = i;
+			table[ slot ].rc = &rt;
+		}
+	}
+}
+
+/*
+========================
+idResourceDirectory::Find
+========================
+*/
+const idResourceCacheEntry* idResourceDirectory::Find( const char* canonical, int& containerIndex ) const
+{
+	if( numEntries == 0 )
+	{
+		return NULL;
+	}
+	
+	const int hash = idStr::Hash( canonical );
+	for( int slot = hash & mask; table[ slot ].rc != NULL; slot = ( slot + 1 ) & mask )
+	{
+		if( table[ slot ].hash == hash && idStr::Cmp( table[ slot ].rc->filename, canonical ) == 0 )
+		{
+			containerIndex = table[ slot ].containerIndex;
+			return table[ slot ].rc;
+		}
+	}
+	return NULL;
+}
@@ -76,6 +76,7 @@ static const uint32 RESOURCE_FILE_MAGIC = 0xD000000D;
 class idResourceContainer
 {
 	friend class	idFileSystemLocal;
+	friend class	idResourceDirectory;
 	//friend class	idReadSpawnThread;
 public:
 	idResourceContainer()
@@ -85,9 +86,12 @@ public:
 		tableLength = 0;
 		resourceMagic = 0;
 		numFileResources = 0;
+		mappedData = NULL;
+		mappedLength = 0;
 	}
 	~idResourceContainer()
 	{
+		Sys_UnmapFile( mappedData, mappedLength );
 		delete resourceFile;
 		cacheTable.Clear();
 	}
@@ -107,6 +111,8 @@ public:
 private:
 	idStrStatic< 256 > fileName;
 	idFile* 	resourceFile;			// open file handle
+	byte* 		mappedData;				// whole file mapped, NULL if reads go through resourceFile
+	int			mappedLength;
 	// offset should probably be a 64 bit value for development, but 4 gigs won't fit on
 	// a DVD layer, so it isn't a retail limitation.
 	int		tableOffset;			// table offset
@@ -118,4 +124,44 @@ private:
 };
 
 
+/*
+==============================================================
+
+  Resource directory
+
+  Every file in every mounted container merged into one open addressed
+  table, with later containers already overriding earlier ones.  It is
+  immutable once built, so any number of threads can search it.
+
+==============================================================
+*/
+
+class idResourceDirectory
+{
+public:
+	idResourceDirectory() : mask( 0 ), numEntries( 0 ) {}
+	
+	void							Build( const idList< idResourceContainer* >& containers );
+	
+	// canonical must be lower case with forward slashes
+	const idResourceCacheEntry* 	Find( const char* canonical, int& containerIndex ) const;
+	
+	int								Num() const
+	{
+		return numEntries;
+	}
+	
+private:
+	struct entry_t
+	{
+		int							hash;
+		int							containerIndex;
+		const idResourceCacheEntry* rc;			// NULL for an empty slot
+	};
+	
+	idList< entry_t, TAG_RESOURCE >	table;
+	int								mask;
+	int								numEntries;
+};
+
 #endif /* !__FILE_RESOURCE_H__ */
@@ -516,6 +516,9 @@ void idCommonLocal::Frame()
 		
 		// This is the only place this is incremented
 		idLib::frameNumber++;
+		
+		// export the per tag memory stats of the last frame
+		Mem_FrameStats( idLib::frameNumber );
 				
 		if ( game->isVR && commonVr->hasOculusRift ) commonVr->FrameStart();
 
@@ -819,7 +822,14 @@ void idCommonLocal::Frame()
 			// not enough time has passed to run a frame, as might happen if
 			// we don't have vsync on, or the monitor is running at 120hz while
 			// com_engineHz is 60, so sleep a bit and check again
+#if defined(ID_DEDICATED)
+			// nothing paces a headless server, so sleep until the next tic is due
+			// instead of spinning a core
+			const int nextFrameDelay = FRAME_TO_MSEC( gameFrame + 1 ) - FRAME_TO_MSEC( gameFrame );
+			Sys_Sleep( Max( 1, nextFrameDelay - ( int )gameTimeResidual ) );
+#else
 			Sys_Sleep( 0 );
+#endif
 		}
 		
 		//--------------------------------------------
@@ -828,6 +838,9 @@ void idCommonLocal::Frame()
 		// because the GPU is completely idle.
 		//--------------------------------------------
 		
+		// hand finished background saves to the savegame manager
+		UpdateBackgroundSave( false );
+		
 		// Update session and syncronize to the new session state after sleeping
 		session->UpdateSignInManager();
 		session->Pump();
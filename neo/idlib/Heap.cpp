@@ -39,27 +39,124 @@ If you have questions concerning this license or the applicable additional terms
 #include <stdlib.h>
 #undef new
 
+// small allocations are served from per-thread free lists instead of the system heap
+#define USE_SMALL_BLOCK_ALLOCATOR
+
+#ifdef _MSC_VER
+#define MEM_THREAD_LOCAL		__declspec( thread )
+#else
+#define MEM_THREAD_LOCAL		__thread
+#endif
+
+/*
+================================================================================================
+
+	Allocation header
+
+	Every allocation is preceded by a 16 byte header that remembers the size, tag and
+	backend of the allocation, so Mem_Free16 can update the tag stats and hand the
+	memory back to the backend it came from.
+
+================================================================================================
+*/
+
+static const int MEM_HEADER_SIZE	= 16;
+static const int MEM_HEADER_MAGIC	= 0xA5;
+
+struct memHeader_t
+{
+	size_t			size;			// padded size of the user allocation
+	unsigned short	tag;
+	unsigned char	allocator;
+	unsigned char	magic;
+};
+
+compile_time_assert( sizeof( memHeader_t ) <= MEM_HEADER_SIZE );
+compile_time_assert( TAG_NUM_TAGS <= MAX_TAGS );
+
+/*
+================================================================================================
+
+	Per tag stats
+
+	These are plain integers so they are valid before any static constructor has run.
+	Sizes are counted in 16 byte units, all allocations are padded to that anyway.
+
+================================================================================================
+*/
+
+static interlockedInt_t		tagLiveUnits[TAG_NUM_TAGS];
+static interlockedInt_t		tagPeakUnits[TAG_NUM_TAGS];
+static interlockedInt_t		tagLiveAllocs[TAG_NUM_TAGS];
+static int64				tagTotalAllocs[TAG_NUM_TAGS];
+
+static memFrameStatsHook_t	frameStatsHook;
+
+static const char* tagNames[] =
+{
+#define MEM_TAG( x )	#x,
+#include "sys/sys_alloc_tags.h"
+};
+
+compile_time_assert( sizeof( tagNames ) / sizeof( tagNames[0] ) == TAG_NUM_TAGS );
+
 /*
 ==================
-Mem_Alloc16
+Mem_TrackAlloc
 ==================
 */
-// RB: 64 bit fixes, changed int to size_t
-void* Mem_Alloc16( const size_t size, const memTag_t tag )
-// RB end
+static ID_INLINE void Mem_TrackAlloc( const int tag, const size_t paddedSize )
 {
-	if( !size )
+	const interlockedInt_t units = ( interlockedInt_t )( paddedSize >> 4 );
+	const interlockedInt_t live = Sys_InterlockedAdd( tagLiveUnits[tag], units );
+	Sys_InterlockedIncrement( tagLiveAllocs[tag] );
+	Sys_InterlockedIncrement64( tagTotalAllocs[tag] );
+	
+	for( interlockedInt_t peak = tagPeakUnits[tag]; live > peak; peak = tagPeakUnits[tag] )
 	{
-		return NULL;
+		if( Sys_InterlockedCompareExchange( tagPeakUnits[tag], peak, live ) == peak )
+		{
+			break;
+		}
 	}
-	const size_t paddedSize = ( size + 15 ) & ~15;
+}
+
+/*
+==================
+Mem_TrackFree
+==================
+*/
+static ID_INLINE void Mem_TrackFree( const int tag, const size_t paddedSize )
+{
+	Sys_InterlockedSub( tagLiveUnits[tag], ( interlockedInt_t )( paddedSize >> 4 ) );
+	Sys_InterlockedDecrement( tagLiveAllocs[tag] );
+}
+
+/*
+================================================================================================
+
+	System allocator
+
+================================================================================================
+*/
+
+/*
+==================
+Mem_SystemAlloc
+==================
+*/
+static void* Mem_SystemAlloc( const size_t size )
+{
 #ifdef _WIN32
 	// this should work with MSVC and mingw, as long as __MSVCRT_VERSION__ >= 0x0700
-	return _aligned_malloc( paddedSize, 16 );
+	return _aligned_malloc( size, 16 );
 #else // not _WIN32
 	// DG: the POSIX solution for linux etc
 	void* ret;
-	posix_memalign( &ret, 16, paddedSize );
+	if( posix_memalign( &ret, 16, size ) != 0 )
+	{
+		return NULL;
+	}
 	return ret;
 	// DG end
 #endif // _WIN32
@@ -67,15 +164,11 @@ void* Mem_Alloc16( const size_t size, const memTag_t tag )
 
 /*
 ==================
-Mem_Free16
+Mem_SystemFree
 ==================
 */
-void Mem_Free16( void* ptr )
+static void Mem_SystemFree( void* ptr, const size_t size )
 {
-	if( ptr == NULL )
-	{
-		return;
-	}
 #ifdef _WIN32
 	_aligned_free( ptr );
 #else // not _WIN32
@@ -86,6 +179,383 @@ void Mem_Free16( void* ptr )
 #endif // _WIN32
 }
 
+static const memAllocator_t systemAllocator = { "system", Mem_SystemAlloc, Mem_SystemFree };
+
+/*
+================================================================================================
+
+	Small block allocator
+
+	Blocks of up to MAX_SMALL_BLOCK_SIZE bytes (header included) are sorted into size
+	classes of 16 bytes. Every thread keeps its own free list per class, so most small
+	allocations and frees don't touch any shared state. Threads trade blocks in batches
+	with a central free list that is guarded by a spin lock. The chunks the blocks are
+	carved from are never returned to the system.
+
+================================================================================================
+*/
+
+static const int SMALL_BLOCK_GRANULARITY	= 16;
+static const int MAX_SMALL_BLOCK_SIZE		= 256;
+static const int NUM_SMALL_BLOCK_CLASSES	= MAX_SMALL_BLOCK_SIZE / SMALL_BLOCK_GRANULARITY;
+static const int SMALL_BLOCK_CHUNK_SIZE		= 64 * 1024;
+static const int SMALL_BLOCK_BATCH			= 32;		// number of blocks moved between a thread and the central list at once
+
+struct smallBlock_t
+{
+	smallBlock_t* 	next;
+};
+
+struct smallBlockThreadCache_t
+{
+	smallBlock_t* 	freeList[NUM_SMALL_BLOCK_CLASSES];
+	int				numFree[NUM_SMALL_BLOCK_CLASSES];
+};
+
+struct smallBlockCentralList_t
+{
+	interlockedInt_t	lock;
+	smallBlock_t* 		freeList;
+	int					numFree;
+};
+
+static MEM_THREAD_LOCAL smallBlockThreadCache_t	smallBlockCache;
+static smallBlockCentralList_t						smallBlockCentral[NUM_SMALL_BLOCK_CLASSES];
+
+/*
+==================
+Mem_SmallBlockClass
+==================
+*/
+static ID_INLINE int Mem_SmallBlockClass( const size_t size )
+{
+	return ( int )( ( size - 1 ) / SMALL_BLOCK_GRANULARITY );
+}
+
+/*
+==================
+Mem_LockCentralList
+==================
+*/
+static ID_INLINE void Mem_LockCentralList( smallBlockCentralList_t& central )
+{
+	while( Sys_InterlockedCompareExchange( central.lock, 0, 1 ) != 0 )
+	{
+		Sys_Yield();
+	}
+}
+
+/*
+==================
+Mem_UnlockCentralList
+==================
+*/
+static ID_INLINE void Mem_UnlockCentralList( smallBlockCentralList_t& central )
+{
+	Sys_InterlockedExchange( central.lock, 0 );
+}
+
+/*
+==================
+Mem_RefillSmallBlocks
+
+Moves a batch of blocks from the central list to the thread cache, carving up a new chunk if needed.
+==================
+*/
+static void Mem_RefillSmallBlocks( smallBlockThreadCache_t& cache, const int blockClass )
+{
+	smallBlockCentralList_t& central = smallBlockCentral[blockClass];
+	
+	Mem_LockCentralList( central );
+	if( central.freeList == NULL )
+	{
+		const int blockSize = ( blockClass + 1 ) * SMALL_BLOCK_GRANULARITY;
+		byte* chunk = ( byte* )Mem_SystemAlloc( SMALL_BLOCK_CHUNK_SIZE );
+		if( chunk == NULL )
+		{
+			Mem_UnlockCentralList( central );
+			return;
+		}
+		for( int offset = SMALL_BLOCK_CHUNK_SIZE - blockSize; offset >= 0; offset -= blockSize )
+		{
+			smallBlock_t* block = ( smallBlock_t* )( chunk + offset );
+			block->next = central.freeList;
+			central.freeList = block;
+			central.numFree++;
+		}
+	}
+	for( int i = 0; i < SMALL_BLOCK_BATCH && central.freeList != NULL; i++ )
+	{
+		smallBlock_t* block = central.freeList;
+		central.freeList = block->next;
+		central.numFree--;
+		block->next = cache.freeList[blockClass];
+		cache.freeList[blockClass] = block;
+		cache.numFree[blockClass]++;
+	}
+	Mem_UnlockCentralList( central );
+}
+
+/*
+==================
+Mem_SmallBlockAlloc
+==================
+*/
+static void* Mem_SmallBlockAlloc( const size_t size )
+{
+	const int blockClass = Mem_SmallBlockClass( size );
+	smallBlockThreadCache_t& cache = smallBlockCache;
+	if( cache.freeList[blockClass] == NULL )
+	{
+		Mem_RefillSmallBlocks( cache, blockClass );
+		if( cache.freeList[blockClass] == NULL )
+		{
+			return NULL;
+		}
+	}
+	smallBlock_t* block = cache.freeList[blockClass];
+	cache.freeList[blockClass] = block->next;
+	cache.numFree[blockClass]--;
+	return block;
+}
+
+/*
+==================
+Mem_SmallBlockFree
+==================
+*/
+static void Mem_SmallBlockFree( void* ptr, const size_t size )
+{
+	const int blockClass = Mem_SmallBlockClass( size );
+	smallBlockThreadCache_t& cache = smallBlockCache;
+	smallBlock_t* block = ( smallBlock_t* )ptr;
+	block->next = cache.freeList[blockClass];
+	cache.freeList[blockClass] = block;
+	cache.numFree[blockClass]++;
+	
+	// hand a batch back when this thread frees a lot more than it allocates
+	if( cache.numFree[blockClass] > SMALL_BLOCK_BATCH * 2 )
+	{
+		smallBlockCentralList_t& central = smallBlockCentral[blockClass];
+		Mem_LockCentralList( central );
+		for( int i = 0; i < SMALL_BLOCK_BATCH; i++ )
+		{
+			block = cache.freeList[blockClass];
+			cache.freeList[blockClass] = block->next;
+			cache.numFree[blockClass]--;
+			block->next = central.freeList;
+			central.freeList = block;
+			central.numFree++;
+		}
+		Mem_UnlockCentralList( central );
+	}
+}
+
+static const memAllocator_t smallBlockAllocator = { "small block", Mem_SmallBlockAlloc, Mem_SmallBlockFree };
+
+/*
+==================
+Mem_ReleaseThreadCache
+
+Hands all blocks cached by the calling thread back to the central lists.
+==================
+*/
+void Mem_ReleaseThreadCache()
+{
+	smallBlockThreadCache_t& cache = smallBlockCache;
+	for( int blockClass = 0; blockClass < NUM_SMALL_BLOCK_CLASSES; blockClass++ )
+	{
+		smallBlock_t* first = cache.freeList[blockClass];
+		if( first == NULL )
+		{
+			continue;
+		}
+		smallBlock_t* last = first;
+		while( last->next != NULL )
+		{
+			last = last->next;
+		}
+		
+		smallBlockCentralList_t& central = smallBlockCentral[blockClass];
+		Mem_LockCentralList( central );
+		last->next = central.freeList;
+		central.freeList = first;
+		central.numFree += cache.numFree[blockClass];
+		Mem_UnlockCentralList( central );
+		
+		cache.freeList[blockClass] = NULL;
+		cache.numFree[blockClass] = 0;
+	}
+}
+
+/*
+================================================================================================
+
+	Allocator selection
+
+================================================================================================
+*/
+
+static const int MAX_ALLOCATORS		= 8;
+static const int SYSTEM_ALLOCATOR		= 0;
+static const int SMALL_BLOCK_ALLOCATOR	= 1;
+
+static const memAllocator_t* allocators[MAX_ALLOCATORS] = { &systemAllocator, &smallBlockAllocator };
+static int numAllocators = 2;
+static int largeAllocator = SYSTEM_ALLOCATOR;
+
+/*
+==================
+Mem_SetAllocator
+
+This is not thread safe and should only be called during startup.
+==================
+*/
+void Mem_SetAllocator( const memAllocator_t* allocator )
+{
+	if( allocator == NULL )
+	{
+		largeAllocator = SYSTEM_ALLOCATOR;
+		return;
+	}
+	for( int i = 0; i < numAllocators; i++ )
+	{
+		if( allocators[i] == allocator )
+		{
+			largeAllocator = i;
+			return;
+		}
+	}
+	if( numAllocators >= MAX_ALLOCATORS )
+	{
+		idLib::Error( "Mem_SetAllocator: too many allocators" );
+	}
+	allocators[numAllocators] = allocator;
+	largeAllocator = numAllocators++;
+}
+
+/*
+==================
+Mem_Alloc16
+==================
+*/
+// RB: 64 bit fixes, changed int to size_t
+void* Mem_Alloc16( const size_t size, const memTag_t tag )
+// RB end
+{
+	if( !size )
+	{
+		return NULL;
+	}
+	const size_t paddedSize = ( size + 15 ) & ~15;
+	const size_t blockSize = paddedSize + MEM_HEADER_SIZE;
+	
+#ifdef USE_SMALL_BLOCK_ALLOCATOR
+	const int allocator = ( blockSize <= MAX_SMALL_BLOCK_SIZE ) ? SMALL_BLOCK_ALLOCATOR : largeAllocator;
+#else
+	const int allocator = largeAllocator;
+#endif
+	
+	byte* block = ( byte* )allocators[allocator]->Alloc( blockSize );
+	if( block == NULL )
+	{
+		return NULL;
+	}
+	
+	assert( tag >= 0 && tag < TAG_NUM_TAGS );
+	memHeader_t* header = ( memHeader_t* )block;
+	header->size = paddedSize;
+	header->tag = ( unsigned short )tag;
+	header->allocator = ( unsigned char )allocator;
+	header->magic = MEM_HEADER_MAGIC;
+	
+	Mem_TrackAlloc( tag, paddedSize );
+	
+	return block + MEM_HEADER_SIZE;
+}
+
+/*
+==================
+Mem_Free16
+==================
+*/
+void Mem_Free16( void* ptr )
+{
+	if( ptr == NULL )
+	{
+		return;
+	}
+	byte* block = ( byte* )ptr - MEM_HEADER_SIZE;
+	memHeader_t* header = ( memHeader_t* )block;
+	assert( header->magic == MEM_HEADER_MAGIC );	// not allocated with Mem_Alloc16 or freed twice
+	header->magic = 0;
+	
+	Mem_TrackFree( header->tag, header->size );
+	
+	allocators[header->allocator]->Free( block, header->size + MEM_HEADER_SIZE );
+}
+
+/*
+==================
+Mem_GetTagName
+==================
+*/
+const char* Mem_GetTagName( const memTag_t tag )
+{
+	if( tag < 0 || tag >= TAG_NUM_TAGS )
+	{
+		return "unknown";
+	}
+	return tagNames[tag];
+}
+
+/*
+==================
+Mem_GetTagStats
+==================
+*/
+void Mem_GetTagStats( const memTag_t tag, memTagStats_t& stats )
+{
+	memset( &stats, 0, sizeof( stats ) );
+	if( tag < 0 || tag >= TAG_NUM_TAGS )
+	{
+		return;
+	}
+	stats.liveBytes = ( size_t )( unsigned int )tagLiveUnits[tag] << 4;
+	stats.peakBytes = ( size_t )( unsigned int )tagPeakUnits[tag] << 4;
+	stats.liveAllocs = tagLiveAllocs[tag];
+	stats.totalAllocs = tagTotalAllocs[tag];
+}
+
+/*
+==================
+Mem_SetFrameStatsHook
+==================
+*/
+void Mem_SetFrameStatsHook( memFrameStatsHook_t hook )
+{
+	frameStatsHook = hook;
+}
+
+/*
+==================
+Mem_FrameStats
+==================
+*/
+void Mem_FrameStats( const int frameNumber )
+{
+	if( frameStatsHook == NULL )
+	{
+		return;
+	}
+	memTagStats_t stats[TAG_NUM_TAGS];
+	for( int i = 0; i < TAG_NUM_TAGS; i++ )
+	{
+		Mem_GetTagStats( ( memTag_t )i, stats[i] );
+	}
+	frameStatsHook( frameNumber, stats, TAG_NUM_TAGS );
+}
+
 /*
 ==================
 Mem_ClearedAlloc
@@ -110,3 +580,40 @@ char* Mem_CopyString( const char* in )
 	return out;
 }
 
+
+/*
+==================
+Mem_SortTagsByLiveBytes
+==================
+*/
+static int Mem_SortTagsByLiveBytes( const void* a, const void* b )
+{
+	const interlockedInt_t liveA = tagLiveUnits[*( const int* )a];
+	const interlockedInt_t liveB = tagLiveUnits[*( const int* )b];
+	return ( liveA < liveB ) - ( liveA > liveB );
+}
+
+CONSOLE_COMMAND( printMemTags, "prints live bytes, peak bytes and allocation counts per memory tag", 0 )
+{
+	int order[TAG_NUM_TAGS];
+	for( int i = 0; i < TAG_NUM_TAGS; i++ )
+	{
+		order[i] = i;
+	}
+	qsort( order, TAG_NUM_TAGS, sizeof( order[0] ), Mem_SortTagsByLiveBytes );
+	
+	idLib::Printf( "%-24s %12s %12s %10s %10s\n", "tag", "live KB", "peak KB", "live", "total" );
+	size_t totalLive = 0;
+	for( int i = 0; i < TAG_NUM_TAGS; i++ )
+	{
+		memTagStats_t stats;
+		Mem_GetTagStats( ( memTag_t )order[i], stats );
+		if( stats.totalAllocs == 0 )
+		{
+			continue;
+		}
+		idLib::Printf( "%-24s %12d %12d %10d %10lld\n", Mem_GetTagName( ( memTag_t )order[i] ), ( int )( stats.liveBytes >> 10 ), ( int )( stats.peakBytes >> 10 ), stats.liveAllocs, stats.totalAllocs );
+		totalLive += stats.liveBytes;
+	}
+	idLib::Printf( "%d KB live in total\n", ( int )( totalLive >> 10 ) );
+}
@@ -67,6 +67,43 @@ void* 		Mem_ClearedAlloc( const size_t size, const memTag_t tag );
 char* 		Mem_CopyString( const char* in );
 // RB end
 
+/*
+================================================
+memAllocator_t is a backend behind Mem_Alloc16. The size passed to Free
+is the size that was passed to Alloc. The returned memory must be 16 byte
+aligned. Every allocation remembers the backend it came from, so a new
+backend can be set at any time.
+================================================
+*/
+struct memAllocator_t
+{
+	const char* 	name;
+	void* 		( *Alloc )( const size_t size );
+	void		( *Free )( void* ptr, const size_t size );
+};
+
+// sets the backend used for all allocations that are too big for the small block allocator, NULL restores the system allocator
+void		Mem_SetAllocator( const memAllocator_t* allocator );
+
+// hands the small blocks cached by the calling thread back to the shared lists, called when a thread exits
+void		Mem_ReleaseThreadCache();
+
+struct memTagStats_t
+{
+	size_t			liveBytes;		// bytes currently allocated
+	size_t			peakBytes;		// highest number of live bytes ever
+	int				liveAllocs;		// number of allocations currently alive
+	int64			totalAllocs;	// number of allocations ever made
+};
+
+typedef void ( *memFrameStatsHook_t )( const int frameNumber, const memTagStats_t* stats, const int numTags );
+
+const char* Mem_GetTagName( const memTag_t tag );
+void		Mem_GetTagStats( const memTag_t tag, memTagStats_t& stats );
+// the hook is called from Mem_FrameStats with the stats of all TAG_NUM_TAGS tags
+void		Mem_SetFrameStatsHook( memFrameStatsHook_t hook );
+void		Mem_FrameStats( const int frameNumber );
+
 ID_INLINE void* operator new( size_t s )
 #if !defined(_MSC_VER)
 throw( std::bad_alloc ) // DG: standard signature seems to include throw(..)
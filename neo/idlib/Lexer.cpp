@@ -270,6 +270,8 @@ void idLexer::Warning( const char* str, ... )
 	char text[MAX_STRING_CHARS];
 	va_list ap;
 	
+	hadWarning = true;
+	
 	if( idLexer::flags & LEXFL_NOWARNINGS )
 	{
 		return;
@@ -2191,6 +2193,7 @@ idLexer::idLexer()
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 }
 
 /*
@@ -2213,6 +2216,7 @@ idLexer::idLexer( int flags )
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 }
 
 /*
@@ -2229,6 +2233,7 @@ idLexer::idLexer( const char* filename, int flags, bool OSPath )
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 	idLexer::LoadFile( filename, OSPath );
 }
 
@@ -2246,6 +2251,7 @@ idLexer::idLexer( const char* ptr, int length, const char* name, int flags )
 	idLexer::token = "";
 	idLexer::next = NULL;
 	idLexer::hadError = false;
+	idLexer::hadWarning = false;
 	idLexer::LoadMemory( ptr, length, name );
 }
 
@@ -2279,3 +2285,13 @@ bool idLexer::HadError() const
 	return hadError;
 }
 
+/*
+================
+idLexer::HadWarning
+================
+*/
+bool idLexer::HadWarning() const
+{
+	return hadWarning;
+}
+
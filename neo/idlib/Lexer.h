@@ -246,6 +246,8 @@ public:
 	void			Warning( VERIFY_FORMAT_STRING const char* str, ... );
 	// returns true if Error() was called with LEXFL_NOFATALERRORS or LEXFL_NOERRORS set
 	bool			HadError() const;
+	// returns true if Warning() was called, even with LEXFL_NOWARNINGS set
+	bool			HadWarning() const;
 	
 	// set the base folder to load files from
 	static void		SetBaseFolder( const char* path );
@@ -272,6 +274,7 @@ private:
 	idToken			token;					// available token
 	idLexer* 		next;					// next script in a chain
 	bool			hadError;				// set by idLexer::Error, even if the error is supressed
+	bool			hadWarning;				// set by idLexer::Warning, even if the warning is supressed
 	
 	static char		baseFolder[ 256 ];		// base folder to load files from
 	
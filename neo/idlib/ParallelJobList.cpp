@@ -144,25 +144,22 @@ static idCVar jobs_longJobMicroSec( "jobs_longJobMicroSec", "10000", CVAR_INTEGE
 
 const static int		MAX_THREADS	= 32;
 
+// job ranges are packed as two 16 bit indices into a single interlocked integer
+const static int		MAX_JOB_RANGE_INDEX	= 0xFFFF;
+
 struct threadJobListState_t
 {
 	threadJobListState_t() :
 		jobList( NULL ),
 		version( 0xFFFFFFFF ),
-		signalIndex( 0 ),
-		lastJobIndex( 0 ),
-		nextJobIndex( -1 ) {}
+		phase( 0 ) {}
 	threadJobListState_t( int _version ) :
 		jobList( NULL ),
 		version( _version ),
-		signalIndex( 0 ),
-		lastJobIndex( 0 ),
-		nextJobIndex( -1 ) {}
+		phase( 0 ) {}
 	idParallelJobList_Threads* 	jobList;
 	int							version;
-	int							signalIndex;
-	int							lastJobIndex;
-	int							nextJobIndex;
+	int							phase;		// first phase of the job list that may still have jobs to grab
 };
 
 struct threadStats_t
@@ -237,6 +234,9 @@ public:
 	
 	bool					WaitForOtherJobList();
 	
+	// Called by the manager before the list is handed to any job thread.
+	void					DistributeJobs( int numUnits );
+	
 	//------------------------
 	// This is thread safe and called from the job threads.
 	//------------------------
@@ -271,17 +271,44 @@ private:
 		jobRun_t	function;
 		void* 		data;
 		int			executed;
+		int			signalIndex;	// index of the signalJobCount this job counts towards
+	};
+	// A phase is a run of jobs that can be executed in any order once the synchronization
+	// point at the start of the phase has been passed. Every processing unit owns a range
+	// of jobs in each phase. It takes jobs from the front of its own range and steals the
+	// back half of the range of another unit once its own range is exhausted.
+	struct jobPhase_t
+	{
+		int			firstJob;
+		int			numJobs;
+		int			gateSignal;		// signalJobCount that must reach zero before the phase starts, -1 if none
 	};
 	idList< job_t, TAG_JOBLIST >		jobList;
 	idList< idSysInterlockedInteger, TAG_JOBLIST >	signalJobCount;
-	idSysInterlockedInteger				currentJob;
-	idSysInterlockedInteger				fetchLock;
+	idList< jobPhase_t, TAG_JOBLIST >	phases;
+	idList< idSysInterlockedInteger, TAG_JOBLIST >	jobRanges;		// [phase * numUnits + unit]
+	int									numUnits;
 	idSysInterlockedInteger				numThreadsExecuting;
+	idSysSignal							doneSignal;		// raised when the last job of the list has executed
 	
 	threadStats_t						deferredThreadStats;
 	threadStats_t						threadStats;
 	
 	int						RunJobsInternal( unsigned int threadNum, threadJobListState_t& state, bool singleJob );
+	int						FetchJob( unsigned int threadNum, int phase );
+	
+	static int				PackRange( int first, int end )
+	{
+		return ( int )( ( ( unsigned int ) end << 16 ) | ( unsigned int ) first );
+	}
+	static int				RangeFirst( int range )
+	{
+		return range & MAX_JOB_RANGE_INDEX;
+	}
+	static int				RangeEnd( int range )
+	{
+		return ( range >> 16 ) & MAX_JOB_RANGE_INDEX;
+	}
 	
 	static void				Nop( void* data ) {}
 	
@@ -309,7 +336,8 @@ idParallelJobList_Threads::idParallelJobList_Threads( jobListId_t id, jobListPri
 	lastSignalJob( 0 ),
 	waitForGuard( NULL ),
 	currentDoneGuard( 0 ),
-	jobList()
+	jobList(),
+	numUnits( 1 )
 {
 
 	assert( listPriority != JOBLIST_PRIORITY_NONE );
@@ -320,6 +348,10 @@ idParallelJobList_Threads::idParallelJobList_Threads( jobListId_t id, jobListPri
 	jobList.SetNum( 0 );
 	signalJobCount.AssureSize( maxSyncs + 1 );			// need one extra for submit
 	signalJobCount.SetNum( 0 );
+	phases.AssureSize( maxSyncs + 2 );					// one more for the list done phase
+	phases.SetNum( 0 );
+	jobRanges.AssureSize( ( maxSyncs + 2 ) * MAX_THREADS );
+	jobRanges.SetNum( 0 );
 	
 	memset( &deferredThreadStats, 0, sizeof( threadStats_t ) );
 	memset( &threadStats, 0, sizeof( threadStats_t ) );
@@ -441,10 +473,8 @@ void idParallelJobList_Threads::Submit( idParallelJobList_Threads* waitForJobLis
 	assert( done );
 	assert( numSyncs <= maxSyncs );
 	assert( ( unsigned int ) jobList.Num() <= maxJobs + numSyncs * 2 );
-	assert( fetchLock.GetValue() == 0 );
 	
 	done = false;
-	currentJob.SetValue( 0 );
 	
 	memset( &deferredThreadStats, 0, sizeof( deferredThreadStats ) );
 	deferredThreadStats.numExecutedJobs = jobList.Num() - numSyncs * 2;
@@ -478,6 +508,37 @@ void idParallelJobList_Threads::Submit( idParallelJobList_Threads* waitForJobLis
 	job.function = Nop;
 	job.data = & JOB_LIST_DONE;
 	
+	if( jobList.Num() > MAX_JOB_RANGE_INDEX )
+	{
+		idLib::Error( "Can't submit job list %s, too many jobs %d", GetJobListName( listId ), jobList.Num() );
+	}
+	
+	// split the list into phases at the synchronization points and
+	// remember which signal each job counts towards
+	int signalIndex = 0;
+	phases.SetNum( 0 );
+	jobPhase_t& firstPhase = phases.Alloc();
+	firstPhase.firstJob = 0;
+	firstPhase.gateSignal = -1;
+	for( int i = 0; i < jobList.Num(); i++ )
+	{
+		if( jobList[i].data == & JOB_SIGNAL )
+		{
+			signalIndex++;
+		}
+		else if( jobList[i].data == & JOB_SYNCHRONIZE || jobList[i].data == & JOB_LIST_DONE )
+		{
+			phases[phases.Num() - 1].numJobs = i - phases[phases.Num() - 1].firstJob;
+			jobPhase_t& phase = phases.Alloc();
+			phase.firstJob = i;
+			phase.gateSignal = ( jobList[i].data == & JOB_SYNCHRONIZE ) ? signalIndex - 1 : signalJobCount.Num() - 1;
+		}
+		jobList[i].signalIndex = signalIndex;
+	}
+	phases[phases.Num() - 1].numJobs = jobList.Num() - phases[phases.Num() - 1].firstJob;
+	
+	doneSignal.Clear();
+	
 	if( threaded )
 	{
 		// hand over to the manager
@@ -487,11 +548,35 @@ void idParallelJobList_Threads::Submit( idParallelJobList_Threads* waitForJobLis
 	else
 	{
 		// run all the jobs right here
+		DistributeJobs( 1 );
 		threadJobListState_t state( GetVersion() );
 		RunJobs( 0, state, false );
 	}
 }
 
+/*
+========================
+idParallelJobList_Threads::DistributeJobs
+
+Hands every processing unit an equally sized, contiguous range of the jobs in each phase.
+========================
+*/
+void idParallelJobList_Threads::DistributeJobs( int numUnits_ )
+{
+	numUnits = idMath::ClampInt( 1, MAX_THREADS, numUnits_ );
+	jobRanges.SetNum( phases.Num() * numUnits );
+	for( int i = 0; i < phases.Num(); i++ )
+	{
+		const jobPhase_t& phase = phases[i];
+		for( int unit = 0; unit < numUnits; unit++ )
+		{
+			const int first = phase.firstJob + ( phase.numJobs * unit ) / numUnits;
+			const int end = phase.firstJob + ( phase.numJobs * ( unit + 1 ) ) / numUnits;
+			jobRanges[i * numUnits + unit].SetValue( PackRange( first, end ) );
+		}
+	}
+}
+
 /*
 ========================
 idParallelJobList_Threads::Wait
@@ -510,9 +595,10 @@ void idParallelJobList_Threads::Wait()
 		bool waited = false;
 		uint64 waitStart = Sys_Microseconds();
 		
+		// sleep until the thread that executes the last job raises the done signal
 		while( signalJobCount[signalJobCount.Num() - 1].GetValue() > 0 )
 		{
-			Sys_Yield();
+			doneSignal.Wait( idSysSignal::WAIT_INFINITE );
 			waited = true;
 		}
 		version.Increment();
@@ -648,100 +734,43 @@ int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJo
 	do
 	{
 	
-		// run through all signals and syncs before the last job that has been or is being executed
-		// this loop is really an optimization to minimize the time spent in the fetchLock section below
-		for( ; state.lastJobIndex < ( int ) currentJob.GetValue() && state.lastJobIndex < jobList.Num(); state.lastJobIndex++ )
+		// grab a job from the first phase that still has jobs left
+		int jobIndex = -1;
+		while( state.phase < phases.Num() )
 		{
-			if( jobList[state.lastJobIndex].data == & JOB_SIGNAL )
+			const jobPhase_t& phase = phases[state.phase];
+			if( phase.gateSignal >= 0 && signalJobCount[phase.gateSignal].GetValue() > 0 )
 			{
-				state.signalIndex++;
-				assert( state.signalIndex < signalJobCount.Num() );
+				// stalled on a synchronization point
+				return ( result | RUN_STALLED );
 			}
-			else if( jobList[state.lastJobIndex].data == & JOB_SYNCHRONIZE )
+			jobIndex = FetchJob( threadNum, state.phase );
+			if( jobIndex >= 0 )
 			{
-				assert( state.signalIndex > 0 );
-				if( signalJobCount[state.signalIndex - 1].GetValue() > 0 )
-				{
-					// stalled on a synchronization point
-					return ( result | RUN_STALLED );
-				}
-			}
-			else if( jobList[state.lastJobIndex].data == & JOB_LIST_DONE )
-			{
-				if( signalJobCount[signalJobCount.Num() - 1].GetValue() > 0 )
-				{
-					// stalled on a synchronization point
-					return ( result | RUN_STALLED );
-				}
+				break;
 			}
+			state.phase++;
 		}
 		
-		// try to lock to fetch a new job
-		if( fetchLock.Increment() == 1 )
+		// if all the jobs have been grabbed we're done
+		if( jobIndex < 0 )
 		{
-		
-			// grab a new job
-			state.nextJobIndex = currentJob.Increment() - 1;
-			
-			// run through any remaining signals and syncs (this should rarely iterate more than once)
-			for( ; state.lastJobIndex <= state.nextJobIndex && state.lastJobIndex < jobList.Num(); state.lastJobIndex++ )
-			{
-				if( jobList[state.lastJobIndex].data == & JOB_SIGNAL )
-				{
-					state.signalIndex++;
-					assert( state.signalIndex < signalJobCount.Num() );
-				}
-				else if( jobList[state.lastJobIndex].data == & JOB_SYNCHRONIZE )
-				{
-					assert( state.signalIndex > 0 );
-					if( signalJobCount[state.signalIndex - 1].GetValue() > 0 )
-					{
-						// return this job to the list
-						currentJob.Decrement();
-						// release the fetch lock
-						fetchLock.Decrement();
-						// stalled on a synchronization point
-						return ( result | RUN_STALLED );
-					}
-				}
-				else if( jobList[state.lastJobIndex].data == & JOB_LIST_DONE )
-				{
-					if( signalJobCount[signalJobCount.Num() - 1].GetValue() > 0 )
-					{
-						// return this job to the list
-						currentJob.Decrement();
-						// release the fetch lock
-						fetchLock.Decrement();
-						// stalled on a synchronization point
-						return ( result | RUN_STALLED );
-					}
-					// decrement the done count
-					doneGuards[currentDoneGuard].Decrement();
-				}
-			}
-			// release the fetch lock
-			fetchLock.Decrement();
-		}
-		else
-		{
-			// release the fetch lock
-			fetchLock.Decrement();
-			// another thread is fetching right now so consider stalled
-			return ( result | RUN_STALLED );
+			return ( result | RUN_DONE );
 		}
 		
-		// if at the end of the job list we're done
-		if( state.nextJobIndex >= jobList.Num() )
+		if( jobList[jobIndex].data == & JOB_LIST_DONE )
 		{
-			return ( result | RUN_DONE );
+			// decrement the done count and wake up anyone waiting on this list
+			doneGuards[currentDoneGuard].Decrement();
+			WakeJobThreads();
 		}
 		
 		// execute the next job
 		{
 			uint64 jobStart = Sys_Microseconds();
 			
-			jobList[state.nextJobIndex].function( jobList[state.nextJobIndex].data );
-			jobList[state.nextJobIndex].executed = 1;
+			jobList[jobIndex].function( jobList[jobIndex].data );
+			jobList[jobIndex].executed = 1;
 			
 			uint64 jobEnd = Sys_Microseconds();
 			deferredThreadStats.threadExecTime[threadNum] += jobEnd - jobStart;
@@ -753,9 +782,9 @@ int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJo
 						&& GetId() != JOBLIST_UTILITY )
 				{
 					longJobTime = ( jobEnd - jobStart ) * ( 1.0f / 1000.0f );
-					longJobFunc = jobList[state.nextJobIndex].function;
-					longJobData = jobList[state.nextJobIndex].data;
-					const char* jobName = GetJobName( jobList[state.nextJobIndex].function );
+					longJobFunc = jobList[jobIndex].function;
+					longJobData = jobList[jobIndex].data;
+					const char* jobName = GetJobName( jobList[jobIndex].function );
 					const char* jobListName = GetJobListName( GetId() );
 					idLib::Printf( "%1.1f milliseconds for a single '%s' job from job list %s on thread %d\n", longJobTime, jobName, jobListName, threadNum );
 				}
@@ -765,13 +794,18 @@ int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJo
 		
 		result |= RUN_PROGRESS;
 		
-		// decrease the job count for the current signal
-		if( signalJobCount[state.signalIndex].Decrement() == 0 )
+		// decrease the job count for the signal of this job
+		const int signalIndex = jobList[jobIndex].signalIndex;
+		if( signalJobCount[signalIndex].Decrement() == 0 )
 		{
+			// a synchronization point may have been passed so wake up any threads that are parked on it
+			WakeJobThreads();
+			
 			// if this was the very last job of the job list
-			if( state.signalIndex == signalJobCount.Num() - 1 )
+			if( signalIndex == signalJobCount.Num() - 1 )
 			{
 				deferredThreadStats.endTime = Sys_Microseconds();
+				doneSignal.Raise();
 				return ( result | RUN_DONE );
 			}
 		}
@@ -782,6 +816,62 @@ int idParallelJobList_Threads::RunJobsInternal( unsigned int threadNum, threadJo
 	return result;
 }
 
+/*
+========================
+idParallelJobList_Threads::FetchJob
+
+Returns the index of the next job to execute in the given phase or -1 if the phase has no jobs left.
+========================
+*/
+int idParallelJobList_Threads::FetchJob( unsigned int threadNum, int phase )
+{
+	assert( threadNum < ( unsigned int ) numUnits );
+	
+	idSysInterlockedInteger* ranges = &jobRanges[phase * numUnits];
+	idSysInterlockedInteger& ownRange = ranges[threadNum];
+	
+	// take a job from the front of our own range, only the owner ever moves the front
+	for( ; ; )
+	{
+		const int range = ownRange.GetValue();
+		const int first = RangeFirst( range );
+		const int end = RangeEnd( range );
+		if( first >= end )
+		{
+			break;
+		}
+		if( ownRange.CompareExchange( range, PackRange( first + 1, end ) ) == range )
+		{
+			return first;
+		}
+	}
+	
+	// steal the back half of the range of another unit
+	for( int i = 1; i < numUnits; i++ )
+	{
+		idSysInterlockedInteger& victimRange = ranges[( threadNum + i ) % numUnits];
+		for( ; ; )
+		{
+			const int range = victimRange.GetValue();
+			const int first = RangeFirst( range );
+			const int end = RangeEnd( range );
+			if( first >= end )
+			{
+				break;
+			}
+			const int split = first + ( end - first ) / 2;
+			if( victimRange.CompareExchange( range, PackRange( first, split ) ) == range )
+			{
+				// our own range is empty so nobody else can be modifying it
+				ownRange.SetValue( PackRange( split + 1, end ) );
+				return split;
+			}
+		}
+	}
+	
+	return -1;
+}
+
 /*
 ========================
 idParallelJobList_Threads::RunJobs
@@ -1067,11 +1157,18 @@ public:
 	
 	void						AddJobList( idParallelJobList_Threads* jobList );
 	
+	// Wakes up the thread if it is parked on a stalled job list.
+	void						Wake()
+	{
+		wakeSignal.Raise();
+	}
+	
 private:
 	threadJobList_t				jobLists[MAX_JOBLISTS];	// cyclic buffer with job lists
 	unsigned int				firstJobList;			// index of the last job list the thread grabbed
 	unsigned int				lastJobList;			// index where the next job list to work on will be added
 	idSysMutex					addJobMutex;
+	idSysSignal					wakeSignal;				// raised when new jobs may have become available
 	
 	unsigned int				threadNum;
 	
@@ -1135,6 +1232,8 @@ void idJobThread::AddJobList( idParallelJobList_Threads* jobList )
 	jobLists[lastJobList & ( MAX_JOBLISTS - 1 )].version = jobList->GetVersion();
 	lastJobList++;
 	addJobMutex.Unlock();
+	// the thread may be parked on another job list that is stalled
+	Wake();
 }
 
 /*
@@ -1156,9 +1255,7 @@ int idJobThread::Run()
 		{
 			threadJobListState[numJobLists].jobList = jobLists[firstJobList & ( MAX_JOBLISTS - 1 )].jobList;
 			threadJobListState[numJobLists].version = jobLists[firstJobList & ( MAX_JOBLISTS - 1 )].version;
-			threadJobListState[numJobLists].signalIndex = 0;
-			threadJobListState[numJobLists].lastJobIndex = 0;
-			threadJobListState[numJobLists].nextJobIndex = -1;
+			threadJobListState[numJobLists].phase = 0;
 			numJobLists++;
 			firstJobList++;
 		}
@@ -1215,12 +1312,13 @@ int idJobThread::Run()
 		}
 		else if( ( result & idParallelJobList_Threads::RUN_STALLED ) != 0 )
 		{
-			// yield when stalled on the same job list again without making any progress
+			// park when stalled on the same job list again without making any progress,
+			// the thread is woken up when a synchronization point is passed or a new job list is added
 			if( currentJobList == lastStalledJobList )
 			{
 				if( ( result & idParallelJobList_Threads::RUN_PROGRESS ) == 0 )
 				{
-					Sys_Yield();
+					wakeSignal.Wait( idSysSignal::WAIT_INFINITE );
 				}
 			}
 			lastStalledJobList = currentJobList;
@@ -1264,9 +1362,10 @@ extern void Sys_CPUCount( int& logicalNum, int& coreNum, int& packageNum );
 //
 // Hyperthreading is not dead yet.  Intel's Core i7 Processor is quad-core with HT for 8 logicals.
 
-// DOOM3: We don't have that many jobs, so just set this fairly low so we don't spin up a ton of idle threads
-#define MAX_JOB_THREADS		2
-#define NUM_JOB_THREADS		"2"
+// Idle job threads are parked on a signal, so spinning up a thread per logical core is cheap.
+// By default one thread is used for each logical core except the one running the main thread.
+#define MAX_JOB_THREADS		MAX_THREADS
+#define NUM_JOB_THREADS		"-1"
 #define JOB_THREAD_CORES	{	CORE_ANY, CORE_ANY, CORE_ANY, CORE_ANY,	\
 								CORE_ANY, CORE_ANY, CORE_ANY, CORE_ANY,	\
 								CORE_ANY, CORE_ANY, CORE_ANY, CORE_ANY,	\
@@ -1277,7 +1376,7 @@ extern void Sys_CPUCount( int& logicalNum, int& coreNum, int& packageNum );
 								CORE_ANY, CORE_ANY, CORE_ANY, CORE_ANY }
 
 
-idCVar jobs_numThreads( "jobs_numThreads", NUM_JOB_THREADS, CVAR_INTEGER | CVAR_NOCHEAT, "number of threads used to crunch through jobs", 0, MAX_JOB_THREADS );
+idCVar jobs_numThreads( "jobs_numThreads", NUM_JOB_THREADS, CVAR_INTEGER | CVAR_NOCHEAT, "number of threads used to crunch through jobs, -1 = one less than the number of logical cores", -1, MAX_JOB_THREADS );
 
 class idParallelJobManagerLocal : public idParallelJobManager
 {
@@ -1299,8 +1398,11 @@ public:
 	virtual void				WaitForAllJobLists();
 	
 	void						Submit( idParallelJobList_Threads* jobList, int parallelism );
+	void						WakeThreads();
 	
 private:
+	void						UpdateMaxThreads();
+	
 	idJobThread						threads[MAX_JOB_THREADS];
 	unsigned int					maxThreads;
 	int								numPhysicalCpuCores;
@@ -1322,6 +1424,16 @@ void SubmitJobList( idParallelJobList_Threads* jobList, int parallelism )
 	parallelJobManagerLocal.Submit( jobList, parallelism );
 }
 
+/*
+========================
+WakeJobThreads
+========================
+*/
+void WakeJobThreads()
+{
+	parallelJobManagerLocal.WakeThreads();
+}
+
 /*
 ========================
 idParallelJobManagerLocal::Init
@@ -1337,9 +1449,40 @@ void idParallelJobManagerLocal::Init()
 	{
 		threads[i].Start( cores[i], i );
 	}
-	maxThreads = jobs_numThreads.GetInteger();
 	
-	Sys_CPUCount( numPhysicalCpuCores, numLogicalCpuCores, numCpuPackages );
+	Sys_CPUCount( numLogicalCpuCores, numPhysicalCpuCores, numCpuPackages );
+	
+	UpdateMaxThreads();
+}
+
+/*
+========================
+idParallelJobManagerLocal::UpdateMaxThreads
+========================
+*/
+void idParallelJobManagerLocal::UpdateMaxThreads()
+{
+	int numThreads = jobs_numThreads.GetInteger();
+	if( numThreads < 0 )
+	{
+		// leave a core for the main thread
+		numThreads = Max( numLogicalCpuCores - 1, 1 );
+	}
+	maxThreads = idMath::ClampInt( 0, MAX_JOB_THREADS, numThreads );
+	jobs_numThreads.ClearModified();
+}
+
+/*
+========================
+idParallelJobManagerLocal::WakeThreads
+========================
+*/
+void idParallelJobManagerLocal::WakeThreads()
+{
+	for( int i = 0; i < MAX_JOB_THREADS; i++ )
+	{
+		threads[i].Wake();
+	}
 }
 
 /*
@@ -1351,7 +1494,10 @@ void idParallelJobManagerLocal::Shutdown()
 {
 	for( int i = 0; i < MAX_JOB_THREADS; i++ )
 	{
-		threads[i].StopThread();
+		// wake the thread in case it is parked on a stalled job list
+		threads[i].StopThread( false );
+		threads[i].Wake();
+		threads[i].WaitForThread();
 	}
 }
 
@@ -1460,8 +1606,7 @@ void idParallelJobManagerLocal::Submit( idParallelJobList_Threads* jobList, int
 {
 	if( jobs_numThreads.IsModified() )
 	{
-		maxThreads = idMath::ClampInt( 0, MAX_JOB_THREADS, jobs_numThreads.GetInteger() );
-		jobs_numThreads.ClearModified();
+		UpdateMaxThreads();
 	}
 	
 	// determine the number of threads to use
@@ -1472,7 +1617,7 @@ void idParallelJobManagerLocal::Submit( idParallelJobList_Threads* jobList, int
 	}
 	else if( parallelism == JOBLIST_PARALLELISM_MAX_CORES )
 	{
-		numThreads = numLogicalCpuCores;
+		numThreads = Min( numLogicalCpuCores, MAX_JOB_THREADS );
 	}
 	else if( parallelism == JOBLIST_PARALLELISM_MAX_THREADS )
 	{
@@ -1489,11 +1634,14 @@ void idParallelJobManagerLocal::Submit( idParallelJobList_Threads* jobList, int
 	
 	if( numThreads <= 0 )
 	{
+		jobList->DistributeJobs( 1 );
 		threadJobListState_t state( jobList->GetVersion() );
 		jobList->RunJobs( 0, state, false );
 		return;
 	}
 	
+	jobList->DistributeJobs( numThreads );
+	
 	for( int i = 0; i < numThreads; i++ )
 	{
 		threads[i].AddJobList( jobList );
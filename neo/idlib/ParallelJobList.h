@@ -171,6 +171,9 @@ extern idParallelJobManager* 	parallelJobManager;
 // static variable macro.
 void RegisterJob( jobRun_t function, const char* name );
 
+// wakes the parked job threads, called when a job list passes a signal or a sync point
+void WakeJobThreads();
+
 /*
 ================================================
 idParallelJobRegistration
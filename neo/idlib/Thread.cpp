@@ -254,6 +254,9 @@ int idSysThread::ThreadProc( idSysThread* thread )
 		exit( 0 );
 	}
 	
+	// don't strand the small blocks this thread cached
+	Mem_ReleaseThreadCache();
+	
 	thread->isRunning = false;
 	
 	return retVal;
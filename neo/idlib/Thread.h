@@ -166,6 +166,13 @@ public:
 		return Sys_InterlockedSub( value, ( interlockedInt_t ) v );
 	}
 	
+	// atomically sets the integer to 'newValue' only if the previous value is equal to 'comparand'
+	// and returns the previous value
+	int					CompareExchange( int comparand, int newValue )
+	{
+		return Sys_InterlockedCompareExchange( value, ( interlockedInt_t ) comparand, ( interlockedInt_t ) newValue );
+	}
+	
 	// returns the current value of the integer
 	int					GetValue() const
 	{
@@ -36,6 +36,7 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "Simd_Generic.h"
 #include "Simd_SSE.h"
+#include "Simd_AVX2.h"
 
 idSIMDProcessor*		processor = NULL;			// pointer to SIMD processor
 idSIMDProcessor* 	generic = NULL;				// pointer to generic SIMD implementation
@@ -78,7 +79,11 @@ void idSIMD::InitProcessor( const char* module, bool forceGeneric )
 		if( processor == NULL )
 		{
 #if defined(USE_INTRINSICS)
-			if( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) )
+			if( cpuid & CPUID_AVX2 )
+			{
+				processor = new( TAG_MATH ) idSIMD_AVX2;
+			}
+			else if( ( cpuid & CPUID_MMX ) && ( cpuid & CPUID_SSE ) )
 			{
 				processor = new( TAG_MATH ) idSIMD_SSE;
 			}
@@ -145,6 +150,7 @@ void idSIMD::Shutdown()
 idSIMDProcessor* p_simd;
 idSIMDProcessor* p_generic;
 int baseClocks = 0; // DG: use int instead of long for 64bit compatibility
+int numTestFailures = 0;
 
 #if defined(_MSC_VER) && defined(_M_IX86)
 #define TIME_TYPE int
@@ -183,7 +189,18 @@ double ticksPerNanosecond;
 #define StopRecordTime( end )				\
 	end = mach_absolute_time();
 
-#else // not _MSC_VER and _M_IX86 or __APPLE__
+#elif defined(__GNUC__) && ( defined(__i386__) || defined(__x86_64__) )
+
+#define TIME_TYPE uint64_t
+
+// x86intrin.h clashes with the macros in sys_intrinsics.h, so use the builtin
+#define StartRecordTime( start )			\
+	start = __builtin_ia32_rdtsc();
+
+#define StopRecordTime( end )				\
+	end = __builtin_ia32_rdtsc();
+
+#else // not _MSC_VER and _M_IX86 or __APPLE__ or x86 GCC
 // FIXME: meaningful values/functions here for Linux?
 #define TIME_TYPE int
 
@@ -228,6 +245,17 @@ void PrintClocks( const char* string, int dataCount, int clocks, int otherClocks
 	}
 }
 
+/*
+============
+TestFailed
+============
+*/
+const char* TestFailed()
+{
+	numTestFailures++;
+	return S_COLOR_RED"X";
+}
+
 /*
 ============
 GetBaseClocks
@@ -303,7 +331,7 @@ void TestMinMax()
 		GetBest( start, end, bestClocksSIMD );
 	}
 	
-	result = ( min == min2 && max == max2 ) ? "ok" : S_COLOR_RED"X";
+	result = ( min == min2 && max == max2 ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->MinMax( float[] ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 	
 	bestClocksGeneric = 0;
@@ -325,7 +353,7 @@ void TestMinMax()
 		GetBest( start, end, bestClocksSIMD );
 	}
 	
-	result = ( v2min == v2min2 && v2max == v2max2 ) ? "ok" : S_COLOR_RED"X";
+	result = ( v2min == v2min2 && v2max == v2max2 ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->MinMax( idVec2[] ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 	
 	bestClocksGeneric = 0;
@@ -347,7 +375,7 @@ void TestMinMax()
 		GetBest( start, end, bestClocksSIMD );
 	}
 	
-	result = ( vmin == vmin2 && vmax == vmax2 ) ? "ok" : S_COLOR_RED"X";
+	result = ( vmin == vmin2 && vmax == vmax2 ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->MinMax( idVec3[] ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 	
 	bestClocksGeneric = 0;
@@ -369,7 +397,7 @@ void TestMinMax()
 		GetBest( start, end, bestClocksSIMD );
 	}
 	
-	result = ( vmin == vmin2 && vmax == vmax2 ) ? "ok" : S_COLOR_RED"X";
+	result = ( vmin == vmin2 && vmax == vmax2 ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->MinMax( idDrawVert[] ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 	
 	bestClocksGeneric = 0;
@@ -391,7 +419,7 @@ void TestMinMax()
 		GetBest( start, end, bestClocksSIMD );
 	}
 	
-	result = ( vmin == vmin2 && vmax == vmax2 ) ? "ok" : S_COLOR_RED"X";
+	result = ( vmin == vmin2 && vmax == vmax2 ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->MinMax( idDrawVert[], indexes[] ) %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
@@ -446,7 +474,7 @@ void TestMemcpy()
 			break;
 		}
 	}
-	result = ( i >= BIG_COUNT ) ? "ok" : S_COLOR_RED"X";
+	result = ( i >= BIG_COUNT ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->Memcpy() %s", result ), BIG_COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
@@ -494,7 +522,7 @@ void TestMemset()
 			break;
 		}
 	}
-	result = ( i >= BIG_COUNT ) ? "ok" : S_COLOR_RED"X";
+	result = ( i >= BIG_COUNT ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->Memset() %s", result ), BIG_COUNT, bestClocksSIMD, bestClocksGeneric );
 	
 	j = 0;
@@ -524,7 +552,7 @@ void TestMemset()
 			break;
 		}
 	}
-	result = ( i >= BIG_COUNT ) ? "ok" : S_COLOR_RED"X";
+	result = ( i >= BIG_COUNT ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->Memset( 0 ) %s", result ), BIG_COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
@@ -607,7 +635,7 @@ void TestBlendJoints()
 			break;
 		}
 	}
-	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	result = ( i >= COUNT ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->BlendJoints() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
@@ -690,7 +718,7 @@ void TestBlendJointsFast()
 			break;
 		}
 	}
-	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	result = ( i >= COUNT ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->BlendJointsFast() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
@@ -748,7 +776,7 @@ void TestConvertJointQuatsToJointMats()
 			break;
 		}
 	}
-	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	result = ( i >= COUNT ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->ConvertJointQuatsToJointMats() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
@@ -812,7 +840,7 @@ void TestConvertJointMatsToJointQuats()
 			break;
 		}
 	}
-	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	result = ( i >= COUNT ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->ConvertJointMatsToJointQuats() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
@@ -882,7 +910,7 @@ void TestTransformJoints()
 			break;
 		}
 	}
-	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	result = ( i >= COUNT ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->TransformJoints() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
@@ -952,10 +980,84 @@ void TestUntransformJoints()
 			break;
 		}
 	}
-	result = ( i >= COUNT ) ? "ok" : S_COLOR_RED"X";
+	result = ( i >= COUNT ) ? "ok" : TestFailed();
 	PrintClocks( va( "   simd->UntransformJoints() %s", result ), COUNT, bestClocksSIMD, bestClocksGeneric );
 }
 
+/*
+============
+TestDequantizeComponents
+============
+*/
+void TestDequantizeComponents()
+{
+	int i, j;
+	TIME_TYPE start, end, bestClocksGeneric, bestClocksSIMD;
+	idTempArray< unsigned short > src16( COUNT );
+	idTempArray< byte > src8( COUNT );
+	idTempArray< float > scale( COUNT );
+	idTempArray< float > bias( COUNT );
+	idTempArray< float > dst1( COUNT );
+	idTempArray< float > dst2( COUNT );
+	const char* result;
+	
+	idRandom srnd( RANDOM_SEED );
+	
+	for( i = 0; i < COUNT; i++ )
+	{
+		src16[i] = ( srnd.RandomInt() << 1 ) | srnd.RandomInt( 2 );
+		src8[i] = srnd.RandomInt( 256 );
+		scale[i] = srnd.RandomFloat() * 0.01f;
+		bias[i] = srnd.CRandomFloat() * 100.0f;
+	}
+	
+	for( j = 0; j < 2; j++ )
+	{
+		bestClocksGeneric = 0;
+		for( i = 0; i < NUMTESTS; i++ )
+		{
+			StartRecordTime( start );
+			if( j == 0 )
+			{
+				p_generic->DequantizeComponents( dst1.Ptr(), src16.Ptr(), scale.Ptr(), bias.Ptr(), COUNT );
+			}
+			else
+			{
+				p_generic->DequantizeComponents( dst1.Ptr(), src8.Ptr(), scale.Ptr(), bias.Ptr(), COUNT );
+			}
+			StopRecordTime( end );
+			GetBest( start, end, bestClocksGeneric );
+		}
+		PrintClocks( va( "generic->DequantizeComponents( %d bits )", j == 0 ? 16 : 8 ), COUNT, bestClocksGeneric );
+		
+		bestClocksSIMD = 0;
+		for( i = 0; i < NUMTESTS; i++ )
+		{
+			StartRecordTime( start );
+			if( j == 0 )
+			{
+				p_simd->DequantizeComponents( dst2.Ptr(), src16.Ptr(), scale.Ptr(), bias.Ptr(), COUNT );
+			}
+			else
+			{
+				p_simd->DequantizeComponents( dst2.Ptr(), src8.Ptr(), scale.Ptr(), bias.Ptr(), COUNT );
+			}
+			StopRecordTime( end );
+			GetBest( start, end, bestClocksSIMD );
+		}
+		
+		for( i = 0; i < COUNT; i++ )
+		{
+			if( idMath::Fabs( dst1[i] - dst2[i] ) > 1e-4f )
+			{
+				break;
+			}
+		}
+		result = ( i >= COUNT ) ? "ok" : TestFailed();
+		PrintClocks( va( "   simd->DequantizeComponents( %d bits ) %s", j == 0 ? 16 : 8, result ), COUNT, bestClocksSIMD, bestClocksGeneric );
+	}
+}
+
 /*
 ============
 TestMath
@@ -1399,10 +1501,19 @@ void idSIMD::Test_f( const idCmdArgs& args )
 			}
 			p_simd = new( TAG_MATH ) idSIMD_SSE;
 		}
+		else if( idStr::Icmp( argString, "AVX2" ) == 0 )
+		{
+			if( !( cpuid & CPUID_AVX2 ) )
+			{
+				common->Printf( "CPU does not support AVX2\n" );
+				return;
+			}
+			p_simd = new( TAG_MATH ) idSIMD_AVX2;
+		}
 		else
 #endif
 		{
-			common->Printf( "invalid argument, use: MMX, 3DNow, SSE, SSE2, SSE3, AltiVec\n" );
+			common->Printf( "invalid argument, use: SSE, AVX2\n" );
 			return;
 		}
 	}
@@ -1411,6 +1522,8 @@ void idSIMD::Test_f( const idCmdArgs& args )
 	
 	idLib::common->Printf( "using %s for SIMD processing\n", p_simd->GetName() );
 	
+	numTestFailures = 0;
+	
 	GetBaseClocks();
 	
 	TestMath();
@@ -1426,9 +1539,20 @@ void idSIMD::Test_f( const idCmdArgs& args )
 	TestConvertJointMatsToJointQuats();
 	TestTransformJoints();
 	TestUntransformJoints();
+	TestDequantizeComponents();
 	
 	idLib::common->Printf( "====================================\n" );
 	
+	// the summary is what scripts running "+testSIMD +quit" look for
+	if( numTestFailures > 0 )
+	{
+		idLib::common->Printf( S_COLOR_RED"%s: %d results differ from %s\n", p_simd->GetName(), numTestFailures, p_generic->GetName() );
+	}
+	else
+	{
+		idLib::common->Printf( "%s: all results match %s\n", p_simd->GetName(), p_generic->GetName() );
+	}
+	
 	idLib::common->SetRefreshOnPrint( false );
 	
 	if( p_simd != processor )
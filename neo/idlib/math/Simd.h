@@ -112,6 +112,10 @@ public:
 	virtual void VPCALL ConvertJointMatsToJointQuats( idJointQuat* jointQuats, const idJointMat* jointMats, const int numJoints ) = 0;
 	virtual void VPCALL TransformJoints( idJointMat* jointMats, const int* parents, const int firstJoint, const int lastJoint ) = 0;
 	virtual void VPCALL UntransformJoints( idJointMat* jointMats, const int* parents, const int firstJoint, const int lastJoint ) = 0;
+	
+	// dst[i] = bias[i] + scale[i] * src[i], used to decode compressed animation frames
+	virtual void VPCALL DequantizeComponents( float* dst, const unsigned short* src, const float* scale, const float* bias, const int count ) = 0;
+	virtual void VPCALL DequantizeComponents( float* dst, const byte* src, const float* scale, const float* bias, const int count ) = 0;
 };
 
 // pointer to SIMD processor
@@ -0,0 +1,935 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+Copyright (C) 2012 Robert Beckebans
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+
+#pragma hdrstop
+#include "precompiled.h"
+#include "Simd_Generic.h"
+#include "Simd_SSE.h"
+#include "Simd_AVX2.h"
+
+//===============================================================
+//
+//	AVX2 implementation of idSIMDProcessor
+//
+//===============================================================
+
+#if defined(USE_INTRINSICS)
+
+#include <immintrin.h>
+
+// only these functions may use 256-bit instructions, everything else is still built for SSE2
+#if defined(_MSC_VER)
+#define AVX2_FUNCTION
+#else
+#define AVX2_FUNCTION						__attribute__(( target( "avx2" ) ))
+#endif
+
+#define _mm256_madd_ps( a, b, c )			_mm256_add_ps( _mm256_mul_ps( (a), (b) ), (c) )
+#define _mm256_nmsub_ps( a, b, c )			_mm256_sub_ps( (c), _mm256_mul_ps( (a), (b) ) )
+
+// two 128-bit vectors from unrelated addresses in the low and high lane
+#define _mm256_load2_ps( lo, hi )			_mm256_insertf128_ps( _mm256_castps128_ps256( _mm_load_ps( lo ) ), _mm_load_ps( hi ), 1 )
+#define _mm256_loadu2_ps( lo, hi )			_mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( lo ) ), _mm_loadu_ps( hi ), 1 )
+#define _mm256_store2_ps( lo, hi, x )		_mm_store_ps( lo, _mm256_castps256_ps128( x ) ); _mm_store_ps( hi, _mm256_extractf128_ps( x, 1 ) )
+
+#ifndef M_PI // DG: this is already defined in math.h
+#define M_PI	3.14159265358979323846f
+#endif
+
+/*
+============
+idSIMD_AVX2::GetName
+============
+*/
+const char* idSIMD_AVX2::GetName() const
+{
+	return "AVX2";
+}
+
+/*
+============
+idSIMD_AVX2::MinMax
+============
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::MinMax( float& min, float& max, const float* src, const int count )
+{
+	__m256 vmin = _mm256_set1_ps( idMath::INFINITY );
+	__m256 vmax = _mm256_set1_ps( -idMath::INFINITY );
+	
+	int i = 0;
+	for( ; i + 8 <= count; i += 8 )
+	{
+		__m256 v = _mm256_loadu_ps( src + i );
+		vmin = _mm256_min_ps( vmin, v );
+		vmax = _mm256_max_ps( vmax, v );
+	}
+	
+	__m128 min4 = _mm_min_ps( _mm256_castps256_ps128( vmin ), _mm256_extractf128_ps( vmin, 1 ) );
+	__m128 max4 = _mm_max_ps( _mm256_castps256_ps128( vmax ), _mm256_extractf128_ps( vmax, 1 ) );
+	min4 = _mm_min_ps( min4, _mm_movehl_ps( min4, min4 ) );
+	max4 = _mm_max_ps( max4, _mm_movehl_ps( max4, max4 ) );
+	min4 = _mm_min_ss( min4, _mm_shuffle_ps( min4, min4, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	max4 = _mm_max_ss( max4, _mm_shuffle_ps( max4, max4, _MM_SHUFFLE( 1, 1, 1, 1 ) ) );
+	
+	min = _mm_cvtss_f32( min4 );
+	max = _mm_cvtss_f32( max4 );
+	
+	for( ; i < count; i++ )
+	{
+		if( src[i] < min )
+		{
+			min = src[i];
+		}
+		if( src[i] > max )
+		{
+			max = src[i];
+		}
+	}
+}
+
+/*
+============
+idSIMD_AVX2::MinMax
+============
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::MinMax( idVec2& min, idVec2& max, const idVec2* src, const int count )
+{
+	const float* srcPtr = src->ToFloatPtr();
+	
+	// even lanes hold x, odd lanes hold y
+	__m256 vmin = _mm256_set1_ps( idMath::INFINITY );
+	__m256 vmax = _mm256_set1_ps( -idMath::INFINITY );
+	
+	int i = 0;
+	for( ; i + 4 <= count; i += 4 )
+	{
+		__m256 v = _mm256_loadu_ps( srcPtr + i * 2 );
+		vmin = _mm256_min_ps( vmin, v );
+		vmax = _mm256_max_ps( vmax, v );
+	}
+	
+	__m128 min4 = _mm_min_ps( _mm256_castps256_ps128( vmin ), _mm256_extractf128_ps( vmin, 1 ) );
+	__m128 max4 = _mm_max_ps( _mm256_castps256_ps128( vmax ), _mm256_extractf128_ps( vmax, 1 ) );
+	min4 = _mm_min_ps( min4, _mm_movehl_ps( min4, min4 ) );
+	max4 = _mm_max_ps( max4, _mm_movehl_ps( max4, max4 ) );
+	
+	ALIGN16( float tmin[4] );
+	ALIGN16( float tmax[4] );
+	_mm_store_ps( tmin, min4 );
+	_mm_store_ps( tmax, max4 );
+	
+	min.Set( tmin[0], tmin[1] );
+	max.Set( tmax[0], tmax[1] );
+	
+	for( ; i < count; i++ )
+	{
+		const idVec2& v = src[i];
+		if( v[0] < min[0] )
+		{
+			min[0] = v[0];
+		}
+		if( v[0] > max[0] )
+		{
+			max[0] = v[0];
+		}
+		if( v[1] < min[1] )
+		{
+			min[1] = v[1];
+		}
+		if( v[1] > max[1] )
+		{
+			max[1] = v[1];
+		}
+	}
+}
+
+/*
+============
+idSIMD_AVX2::MinMax
+============
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::MinMax( idVec3& min, idVec3& max, const idVec3* src, const int count )
+{
+	const float* srcPtr = src->ToFloatPtr();
+	
+	// 8 vectors are 3 registers, float k of the block is component k % 3
+	__m256 vmin0 = _mm256_set1_ps( idMath::INFINITY );
+	__m256 vmin1 = vmin0;
+	__m256 vmin2 = vmin0;
+	__m256 vmax0 = _mm256_set1_ps( -idMath::INFINITY );
+	__m256 vmax1 = vmax0;
+	__m256 vmax2 = vmax0;
+	
+	int i = 0;
+	for( ; i + 8 <= count; i += 8 )
+	{
+		__m256 v0 = _mm256_loadu_ps( srcPtr + i * 3 + 0 );
+		__m256 v1 = _mm256_loadu_ps( srcPtr + i * 3 + 8 );
+		__m256 v2 = _mm256_loadu_ps( srcPtr + i * 3 + 16 );
+		vmin0 = _mm256_min_ps( vmin0, v0 );
+		vmin1 = _mm256_min_ps( vmin1, v1 );
+		vmin2 = _mm256_min_ps( vmin2, v2 );
+		vmax0 = _mm256_max_ps( vmax0, v0 );
+		vmax1 = _mm256_max_ps( vmax1, v1 );
+		vmax2 = _mm256_max_ps( vmax2, v2 );
+	}
+	
+	ALIGN16( float tmin[24] );
+	ALIGN16( float tmax[24] );
+	_mm256_storeu_ps( tmin + 0, vmin0 );
+	_mm256_storeu_ps( tmin + 8, vmin1 );
+	_mm256_storeu_ps( tmin + 16, vmin2 );
+	_mm256_storeu_ps( tmax + 0, vmax0 );
+	_mm256_storeu_ps( tmax + 8, vmax1 );
+	_mm256_storeu_ps( tmax + 16, vmax2 );
+	
+	min[0] = min[1] = min[2] = idMath::INFINITY;
+	max[0] = max[1] = max[2] = -idMath::INFINITY;
+	for( int j = 0; j < 24; j++ )
+	{
+		const int c = j % 3;
+		if( tmin[j] < min[c] )
+		{
+			min[c] = tmin[j];
+		}
+		if( tmax[j] > max[c] )
+		{
+			max[c] = tmax[j];
+		}
+	}
+	
+	for( ; i < count; i++ )
+	{
+		const idVec3& v = src[i];
+		for( int c = 0; c < 3; c++ )
+		{
+			if( v[c] < min[c] )
+			{
+				min[c] = v[c];
+			}
+			if( v[c] > max[c] )
+			{
+				max[c] = v[c];
+			}
+		}
+	}
+}
+
+/*
+============
+idSIMD_AVX2::MinMax
+
+Reads 16 bytes per vertex, the fourth lane is the start of st and ignored
+============
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::MinMax( idVec3& min, idVec3& max, const idDrawVert* src, const int count )
+{
+	__m256 vmin0 = _mm256_set1_ps( idMath::INFINITY );
+	__m256 vmin1 = vmin0;
+	__m256 vmax0 = _mm256_set1_ps( -idMath::INFINITY );
+	__m256 vmax1 = vmax0;
+	
+	int i = 0;
+	for( ; i + 4 <= count; i += 4 )
+	{
+		__m256 v0 = _mm256_loadu2_ps( src[i + 0].xyz.ToFloatPtr(), src[i + 1].xyz.ToFloatPtr() );
+		__m256 v1 = _mm256_loadu2_ps( src[i + 2].xyz.ToFloatPtr(), src[i + 3].xyz.ToFloatPtr() );
+		vmin0 = _mm256_min_ps( vmin0, v0 );
+		vmin1 = _mm256_min_ps( vmin1, v1 );
+		vmax0 = _mm256_max_ps( vmax0, v0 );
+		vmax1 = _mm256_max_ps( vmax1, v1 );
+	}
+	
+	vmin0 = _mm256_min_ps( vmin0, vmin1 );
+	vmax0 = _mm256_max_ps( vmax0, vmax1 );
+	
+	__m128 min4 = _mm_min_ps( _mm256_castps256_ps128( vmin0 ), _mm256_extractf128_ps( vmin0, 1 ) );
+	__m128 max4 = _mm_max_ps( _mm256_castps256_ps128( vmax0 ), _mm256_extractf128_ps( vmax0, 1 ) );
+	
+	for( ; i < count; i++ )
+	{
+		__m128 v = _mm_loadu_ps( src[i].xyz.ToFloatPtr() );
+		min4 = _mm_min_ps( min4, v );
+		max4 = _mm_max_ps( max4, v );
+	}
+	
+	ALIGN16( float tmin[4] );
+	ALIGN16( float tmax[4] );
+	_mm_store_ps( tmin, min4 );
+	_mm_store_ps( tmax, max4 );
+	
+	min.Set( tmin[0], tmin[1], tmin[2] );
+	max.Set( tmax[0], tmax[1], tmax[2] );
+}
+
+/*
+============
+idSIMD_AVX2::MinMax
+============
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::MinMax( idVec3& min, idVec3& max, const idDrawVert* src, const triIndex_t* indexes, const int count )
+{
+	__m256 vmin0 = _mm256_set1_ps( idMath::INFINITY );
+	__m256 vmin1 = vmin0;
+	__m256 vmax0 = _mm256_set1_ps( -idMath::INFINITY );
+	__m256 vmax1 = vmax0;
+	
+	int i = 0;
+	for( ; i + 4 <= count; i += 4 )
+	{
+		__m256 v0 = _mm256_loadu2_ps( src[indexes[i + 0]].xyz.ToFloatPtr(), src[indexes[i + 1]].xyz.ToFloatPtr() );
+		__m256 v1 = _mm256_loadu2_ps( src[indexes[i + 2]].xyz.ToFloatPtr(), src[indexes[i + 3]].xyz.ToFloatPtr() );
+		vmin0 = _mm256_min_ps( vmin0, v0 );
+		vmin1 = _mm256_min_ps( vmin1, v1 );
+		vmax0 = _mm256_max_ps( vmax0, v0 );
+		vmax1 = _mm256_max_ps( vmax1, v1 );
+	}
+	
+	vmin0 = _mm256_min_ps( vmin0, vmin1 );
+	vmax0 = _mm256_max_ps( vmax0, vmax1 );
+	
+	__m128 min4 = _mm_min_ps( _mm256_castps256_ps128( vmin0 ), _mm256_extractf128_ps( vmin0, 1 ) );
+	__m128 max4 = _mm_max_ps( _mm256_castps256_ps128( vmax0 ), _mm256_extractf128_ps( vmax0, 1 ) );
+	
+	for( ; i < count; i++ )
+	{
+		__m128 v = _mm_loadu_ps( src[indexes[i]].xyz.ToFloatPtr() );
+		min4 = _mm_min_ps( min4, v );
+		max4 = _mm_max_ps( max4, v );
+	}
+	
+	ALIGN16( float tmin[4] );
+	ALIGN16( float tmax[4] );
+	_mm_store_ps( tmin, min4 );
+	_mm_store_ps( tmax, max4 );
+	
+	min.Set( tmin[0], tmin[1], tmin[2] );
+	max.Set( tmax[0], tmax[1], tmax[2] );
+}
+
+/*
+================
+idSIMD_AVX2::Memcpy
+
+Small copies go to the CRT, large copies align the destination and move 128 bytes per iteration
+================
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::Memcpy( void* dst, const void* src, const int count )
+{
+	if( count < 256 )
+	{
+		memcpy( dst, src, count );
+		return;
+	}
+	
+	byte* d = ( byte* )dst;
+	const byte* s = ( const byte* )src;
+	
+	int head = ( int )( ( 32 - ( ( uintptr_t )d & 31 ) ) & 31 );
+	memcpy( d, s, head );
+	
+	int i = head;
+	for( ; i + 128 <= count; i += 128 )
+	{
+		__m256i a = _mm256_loadu_si256( ( const __m256i* )( s + i + 0 ) );
+		__m256i b = _mm256_loadu_si256( ( const __m256i* )( s + i + 32 ) );
+		__m256i c = _mm256_loadu_si256( ( const __m256i* )( s + i + 64 ) );
+		__m256i e = _mm256_loadu_si256( ( const __m256i* )( s + i + 96 ) );
+		_mm256_store_si256( ( __m256i* )( d + i + 0 ), a );
+		_mm256_store_si256( ( __m256i* )( d + i + 32 ), b );
+		_mm256_store_si256( ( __m256i* )( d + i + 64 ), c );
+		_mm256_store_si256( ( __m256i* )( d + i + 96 ), e );
+	}
+	
+	memcpy( d + i, s + i, count - i );
+}
+
+/*
+================
+idSIMD_AVX2::Memset
+================
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::Memset( void* dst, const int val, const int count )
+{
+	if( count < 256 )
+	{
+		memset( dst, val, count );
+		return;
+	}
+	
+	byte* d = ( byte* )dst;
+	
+	int head = ( int )( ( 32 - ( ( uintptr_t )d & 31 ) ) & 31 );
+	memset( d, val, head );
+	
+	const __m256i v = _mm256_set1_epi8( ( char )val );
+	
+	int i = head;
+	for( ; i + 128 <= count; i += 128 )
+	{
+		_mm256_store_si256( ( __m256i* )( d + i + 0 ), v );
+		_mm256_store_si256( ( __m256i* )( d + i + 32 ), v );
+		_mm256_store_si256( ( __m256i* )( d + i + 64 ), v );
+		_mm256_store_si256( ( __m256i* )( d + i + 96 ), v );
+	}
+	
+	memset( d + i, val, count - i );
+}
+
+/*
+============
+idSIMD_AVX2::BlendJoints
+
+Same math as the SSE version, the joints n and n + 4 of a block share a register in the low and high lane
+============
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::BlendJoints( idJointQuat* joints, const idJointQuat* blendJoints, const float lerp, const int* index, const int numJoints )
+{
+	if( lerp <= 0.0f )
+	{
+		return;
+	}
+	else if( lerp >= 1.0f )
+	{
+		for( int i = 0; i < numJoints; i++ )
+		{
+			int j = index[i];
+			joints[j] = blendJoints[j];
+		}
+		return;
+	}
+	
+	const __m256 vlerp = _mm256_set1_ps( lerp );
+	
+	const __m256 vector_float_one		= _mm256_set1_ps( 1.0f );
+	const __m256 vector_float_sign_bit	= _mm256_castsi256_ps( _mm256_set1_epi32( 0x80000000 ) );
+	const __m256 vector_float_rsqrt_c0	= _mm256_set1_ps( -3.0f );
+	const __m256 vector_float_rsqrt_c1	= _mm256_set1_ps( -0.5f );
+	const __m256 vector_float_tiny		= _mm256_set1_ps( 1e-10f );
+	const __m256 vector_float_half_pi	= _mm256_set1_ps( M_PI * 0.5f );
+	
+	const __m256 vector_float_sin_c0	= _mm256_set1_ps( -2.39e-08f );
+	const __m256 vector_float_sin_c1	= _mm256_set1_ps( 2.7526e-06f );
+	const __m256 vector_float_sin_c2	= _mm256_set1_ps( -1.98409e-04f );
+	const __m256 vector_float_sin_c3	= _mm256_set1_ps( 8.3333315e-03f );
+	const __m256 vector_float_sin_c4	= _mm256_set1_ps( -1.666666664e-01f );
+	
+	const __m256 vector_float_atan_c0	= _mm256_set1_ps( 0.0028662257f );
+	const __m256 vector_float_atan_c1	= _mm256_set1_ps( -0.0161657367f );
+	const __m256 vector_float_atan_c2	= _mm256_set1_ps( 0.0429096138f );
+	const __m256 vector_float_atan_c3	= _mm256_set1_ps( -0.0752896400f );
+	const __m256 vector_float_atan_c4	= _mm256_set1_ps( 0.1065626393f );
+	const __m256 vector_float_atan_c5	= _mm256_set1_ps( -0.1420889944f );
+	const __m256 vector_float_atan_c6	= _mm256_set1_ps( 0.1999355085f );
+	const __m256 vector_float_atan_c7	= _mm256_set1_ps( -0.3333314528f );
+	
+	int i = 0;
+	for( ; i + 8 <= numJoints; i += 8 )
+	{
+		const int n0 = index[i + 0];
+		const int n1 = index[i + 1];
+		const int n2 = index[i + 2];
+		const int n3 = index[i + 3];
+		const int n4 = index[i + 4];
+		const int n5 = index[i + 5];
+		const int n6 = index[i + 6];
+		const int n7 = index[i + 7];
+		
+		__m256 jqa = _mm256_load2_ps( joints[n0].q.ToFloatPtr(), joints[n4].q.ToFloatPtr() );
+		__m256 jqb = _mm256_load2_ps( joints[n1].q.ToFloatPtr(), joints[n5].q.ToFloatPtr() );
+		__m256 jqc = _mm256_load2_ps( joints[n2].q.ToFloatPtr(), joints[n6].q.ToFloatPtr() );
+		__m256 jqd = _mm256_load2_ps( joints[n3].q.ToFloatPtr(), joints[n7].q.ToFloatPtr() );
+		
+		__m256 jta = _mm256_load2_ps( joints[n0].t.ToFloatPtr(), joints[n4].t.ToFloatPtr() );
+		__m256 jtb = _mm256_load2_ps( joints[n1].t.ToFloatPtr(), joints[n5].t.ToFloatPtr() );
+		__m256 jtc = _mm256_load2_ps( joints[n2].t.ToFloatPtr(), joints[n6].t.ToFloatPtr() );
+		__m256 jtd = _mm256_load2_ps( joints[n3].t.ToFloatPtr(), joints[n7].t.ToFloatPtr() );
+		
+		__m256 bqa = _mm256_load2_ps( blendJoints[n0].q.ToFloatPtr(), blendJoints[n4].q.ToFloatPtr() );
+		__m256 bqb = _mm256_load2_ps( blendJoints[n1].q.ToFloatPtr(), blendJoints[n5].q.ToFloatPtr() );
+		__m256 bqc = _mm256_load2_ps( blendJoints[n2].q.ToFloatPtr(), blendJoints[n6].q.ToFloatPtr() );
+		__m256 bqd = _mm256_load2_ps( blendJoints[n3].q.ToFloatPtr(), blendJoints[n7].q.ToFloatPtr() );
+		
+		__m256 bta = _mm256_load2_ps( blendJoints[n0].t.ToFloatPtr(), blendJoints[n4].t.ToFloatPtr() );
+		__m256 btb = _mm256_load2_ps( blendJoints[n1].t.ToFloatPtr(), blendJoints[n5].t.ToFloatPtr() );
+		__m256 btc = _mm256_load2_ps( blendJoints[n2].t.ToFloatPtr(), blendJoints[n6].t.ToFloatPtr() );
+		__m256 btd = _mm256_load2_ps( blendJoints[n3].t.ToFloatPtr(), blendJoints[n7].t.ToFloatPtr() );
+		
+		jta = _mm256_madd_ps( vlerp, _mm256_sub_ps( bta, jta ), jta );
+		jtb = _mm256_madd_ps( vlerp, _mm256_sub_ps( btb, jtb ), jtb );
+		jtc = _mm256_madd_ps( vlerp, _mm256_sub_ps( btc, jtc ), jtc );
+		jtd = _mm256_madd_ps( vlerp, _mm256_sub_ps( btd, jtd ), jtd );
+		
+		_mm256_store2_ps( joints[n0].t.ToFloatPtr(), joints[n4].t.ToFloatPtr(), jta );
+		_mm256_store2_ps( joints[n1].t.ToFloatPtr(), joints[n5].t.ToFloatPtr(), jtb );
+		_mm256_store2_ps( joints[n2].t.ToFloatPtr(), joints[n6].t.ToFloatPtr(), jtc );
+		_mm256_store2_ps( joints[n3].t.ToFloatPtr(), joints[n7].t.ToFloatPtr(), jtd );
+		
+		// the unpacks work per lane, so this transposes two 4x4 blocks at once
+		__m256 jqr = _mm256_unpacklo_ps( jqa, jqc );
+		__m256 jqs = _mm256_unpackhi_ps( jqa, jqc );
+		__m256 jqt = _mm256_unpacklo_ps( jqb, jqd );
+		__m256 jqu = _mm256_unpackhi_ps( jqb, jqd );
+		
+		__m256 bqr = _mm256_unpacklo_ps( bqa, bqc );
+		__m256 bqs = _mm256_unpackhi_ps( bqa, bqc );
+		__m256 bqt = _mm256_unpacklo_ps( bqb, bqd );
+		__m256 bqu = _mm256_unpackhi_ps( bqb, bqd );
+		
+		__m256 jqx = _mm256_unpacklo_ps( jqr, jqt );
+		__m256 jqy = _mm256_unpackhi_ps( jqr, jqt );
+		__m256 jqz = _mm256_unpacklo_ps( jqs, jqu );
+		__m256 jqw = _mm256_unpackhi_ps( jqs, jqu );
+		
+		__m256 bqx = _mm256_unpacklo_ps( bqr, bqt );
+		__m256 bqy = _mm256_unpackhi_ps( bqr, bqt );
+		__m256 bqz = _mm256_unpacklo_ps( bqs, bqu );
+		__m256 bqw = _mm256_unpackhi_ps( bqs, bqu );
+		
+		__m256 cosome = _mm256_add_ps( _mm256_mul_ps( jqx, bqx ), _mm256_mul_ps( jqy, bqy ) );
+		__m256 cosomf = _mm256_add_ps( _mm256_mul_ps( jqz, bqz ), _mm256_mul_ps( jqw, bqw ) );
+		__m256 cosomg = _mm256_add_ps( cosome, cosomf );
+		
+		__m256 sign = _mm256_and_ps( cosomg, vector_float_sign_bit );
+		__m256 cosom = _mm256_xor_ps( cosomg, sign );
+		__m256 ss = _mm256_nmsub_ps( cosom, cosom, vector_float_one );
+		
+		ss = _mm256_max_ps( ss, vector_float_tiny );
+		
+		__m256 rs = _mm256_rsqrt_ps( ss );
+		__m256 sq = _mm256_mul_ps( rs, rs );
+		__m256 sh = _mm256_mul_ps( rs, vector_float_rsqrt_c1 );
+		__m256 sx = _mm256_madd_ps( ss, sq, vector_float_rsqrt_c0 );
+		__m256 sinom = _mm256_mul_ps( sh, sx );							// sinom = sqrt( ss );
+		
+		ss = _mm256_mul_ps( ss, sinom );
+		
+		__m256 min = _mm256_min_ps( ss, cosom );
+		__m256 max = _mm256_max_ps( ss, cosom );
+		__m256 mask = _mm256_cmp_ps( min, cosom, _CMP_EQ_OQ );
+		__m256 masksign = _mm256_and_ps( mask, vector_float_sign_bit );
+		__m256 maskPI = _mm256_and_ps( mask, vector_float_half_pi );
+		
+		__m256 rcpa = _mm256_rcp_ps( max );
+		__m256 rcpb = _mm256_mul_ps( max, rcpa );
+		__m256 rcpd = _mm256_add_ps( rcpa, rcpa );
+		__m256 rcp = _mm256_nmsub_ps( rcpb, rcpa, rcpd );				// 1 / y or 1 / x
+		__m256 ata = _mm256_mul_ps( min, rcp );							// x / y or y / x
+		
+		__m256 atb = _mm256_xor_ps( ata, masksign );					// -x / y or y / x
+		__m256 atc = _mm256_mul_ps( atb, atb );
+		__m256 atd = _mm256_madd_ps( atc, vector_float_atan_c0, vector_float_atan_c1 );
+		
+		atd = _mm256_madd_ps( atd, atc, vector_float_atan_c2 );
+		atd = _mm256_madd_ps( atd, atc, vector_float_atan_c3 );
+		atd = _mm256_madd_ps( atd, atc, vector_float_atan_c4 );
+		atd = _mm256_madd_ps( atd, atc, vector_float_atan_c5 );
+		atd = _mm256_madd_ps( atd, atc, vector_float_atan_c6 );
+		atd = _mm256_madd_ps( atd, atc, vector_float_atan_c7 );
+		atd = _mm256_madd_ps( atd, atc, vector_float_one );
+		
+		__m256 omega_a = _mm256_madd_ps( atd, atb, maskPI );
+		__m256 omega_b = _mm256_mul_ps( vlerp, omega_a );
+		omega_a = _mm256_sub_ps( omega_a, omega_b );
+		
+		__m256 sinsa = _mm256_mul_ps( omega_a, omega_a );
+		__m256 sinsb = _mm256_mul_ps( omega_b, omega_b );
+		__m256 sina = _mm256_madd_ps( sinsa, vector_float_sin_c0, vector_float_sin_c1 );
+		__m256 sinb = _mm256_madd_ps( sinsb, vector_float_sin_c0, vector_float_sin_c1 );
+		sina = _mm256_madd_ps( sina, sinsa, vector_float_sin_c2 );
+		sinb = _mm256_madd_ps( sinb, sinsb, vector_float_sin_c2 );
+		sina = _mm256_madd_ps( sina, sinsa, vector_float_sin_c3 );
+		sinb = _mm256_madd_ps( sinb, sinsb, vector_float_sin_c3 );
+		sina = _mm256_madd_ps( sina, sinsa, vector_float_sin_c4 );
+		sinb = _mm256_madd_ps( sinb, sinsb, vector_float_sin_c4 );
+		sina = _mm256_madd_ps( sina, sinsa, vector_float_one );
+		sinb = _mm256_madd_ps( sinb, sinsb, vector_float_one );
+		sina = _mm256_mul_ps( sina, omega_a );
+		sinb = _mm256_mul_ps( sinb, omega_b );
+		__m256 scalea = _mm256_mul_ps( sina, sinom );
+		__m256 scaleb = _mm256_mul_ps( sinb, sinom );
+		
+		scaleb = _mm256_xor_ps( scaleb, sign );
+		
+		jqx = _mm256_madd_ps( bqx, scaleb, _mm256_mul_ps( jqx, scalea ) );
+		jqy = _mm256_madd_ps( bqy, scaleb, _mm256_mul_ps( jqy, scalea ) );
+		jqz = _mm256_madd_ps( bqz, scaleb, _mm256_mul_ps( jqz, scalea ) );
+		jqw = _mm256_madd_ps( bqw, scaleb, _mm256_mul_ps( jqw, scalea ) );
+		
+		__m256 tp0 = _mm256_unpacklo_ps( jqx, jqz );
+		__m256 tp1 = _mm256_unpackhi_ps( jqx, jqz );
+		__m256 tp2 = _mm256_unpacklo_ps( jqy, jqw );
+		__m256 tp3 = _mm256_unpackhi_ps( jqy, jqw );
+		
+		__m256 p0 = _mm256_unpacklo_ps( tp0, tp2 );
+		__m256 p1 = _mm256_unpackhi_ps( tp0, tp2 );
+		__m256 p2 = _mm256_unpacklo_ps( tp1, tp3 );
+		__m256 p3 = _mm256_unpackhi_ps( tp1, tp3 );
+		
+		_mm256_store2_ps( joints[n0].q.ToFloatPtr(), joints[n4].q.ToFloatPtr(), p0 );
+		_mm256_store2_ps( joints[n1].q.ToFloatPtr(), joints[n5].q.ToFloatPtr(), p1 );
+		_mm256_store2_ps( joints[n2].q.ToFloatPtr(), joints[n6].q.ToFloatPtr(), p2 );
+		_mm256_store2_ps( joints[n3].q.ToFloatPtr(), joints[n7].q.ToFloatPtr(), p3 );
+	}
+	
+	// the SSE code blends the last few joints
+	if( i < numJoints )
+	{
+		idSIMD_SSE::BlendJoints( joints, blendJoints, lerp, index + i, numJoints - i );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::BlendJointsFast
+============
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::BlendJointsFast( idJointQuat* joints, const idJointQuat* blendJoints, const float lerp, const int* index, const int numJoints )
+{
+	assert_16_byte_aligned( joints );
+	assert_16_byte_aligned( blendJoints );
+	assert_16_byte_aligned( JOINTQUAT_Q_OFFSET );
+	assert_16_byte_aligned( JOINTQUAT_T_OFFSET );
+	assert_sizeof_16_byte_multiple( idJointQuat );
+	
+	if( lerp <= 0.0f )
+	{
+		return;
+	}
+	else if( lerp >= 1.0f )
+	{
+		for( int i = 0; i < numJoints; i++ )
+		{
+			int j = index[i];
+			joints[j] = blendJoints[j];
+		}
+		return;
+	}
+	
+	const __m256 vector_float_sign_bit	= _mm256_castsi256_ps( _mm256_set1_epi32( 0x80000000 ) );
+	const __m256 vector_float_rsqrt_c0	= _mm256_set1_ps( -3.0f );
+	const __m256 vector_float_rsqrt_c1	= _mm256_set1_ps( -0.5f );
+	
+	const float scaledLerp = lerp / ( 1.0f - lerp );
+	const __m256 vlerp = _mm256_set1_ps( lerp );
+	const __m256 vscaledLerp = _mm256_set1_ps( scaledLerp );
+	
+	int i = 0;
+	for( ; i + 8 <= numJoints; i += 8 )
+	{
+		const int n0 = index[i + 0];
+		const int n1 = index[i + 1];
+		const int n2 = index[i + 2];
+		const int n3 = index[i + 3];
+		const int n4 = index[i + 4];
+		const int n5 = index[i + 5];
+		const int n6 = index[i + 6];
+		const int n7 = index[i + 7];
+		
+		__m256 jqa = _mm256_load2_ps( joints[n0].q.ToFloatPtr(), joints[n4].q.ToFloatPtr() );
+		__m256 jqb = _mm256_load2_ps( joints[n1].q.ToFloatPtr(), joints[n5].q.ToFloatPtr() );
+		__m256 jqc = _mm256_load2_ps( joints[n2].q.ToFloatPtr(), joints[n6].q.ToFloatPtr() );
+		__m256 jqd = _mm256_load2_ps( joints[n3].q.ToFloatPtr(), joints[n7].q.ToFloatPtr() );
+		
+		__m256 jta = _mm256_load2_ps( joints[n0].t.ToFloatPtr(), joints[n4].t.ToFloatPtr() );
+		__m256 jtb = _mm256_load2_ps( joints[n1].t.ToFloatPtr(), joints[n5].t.ToFloatPtr() );
+		__m256 jtc = _mm256_load2_ps( joints[n2].t.ToFloatPtr(), joints[n6].t.ToFloatPtr() );
+		__m256 jtd = _mm256_load2_ps( joints[n3].t.ToFloatPtr(), joints[n7].t.ToFloatPtr() );
+		
+		__m256 bqa = _mm256_load2_ps( blendJoints[n0].q.ToFloatPtr(), blendJoints[n4].q.ToFloatPtr() );
+		__m256 bqb = _mm256_load2_ps( blendJoints[n1].q.ToFloatPtr(), blendJoints[n5].q.ToFloatPtr() );
+		__m256 bqc = _mm256_load2_ps( blendJoints[n2].q.ToFloatPtr(), blendJoints[n6].q.ToFloatPtr() );
+		__m256 bqd = _mm256_load2_ps( blendJoints[n3].q.ToFloatPtr(), blendJoints[n7].q.ToFloatPtr() );
+		
+		__m256 bta = _mm256_load2_ps( blendJoints[n0].t.ToFloatPtr(), blendJoints[n4].t.ToFloatPtr() );
+		__m256 btb = _mm256_load2_ps( blendJoints[n1].t.ToFloatPtr(), blendJoints[n5].t.ToFloatPtr() );
+		__m256 btc = _mm256_load2_ps( blendJoints[n2].t.ToFloatPtr(), blendJoints[n6].t.ToFloatPtr() );
+		__m256 btd = _mm256_load2_ps( blendJoints[n3].t.ToFloatPtr(), blendJoints[n7].t.ToFloatPtr() );
+		
+		jta = _mm256_madd_ps( vlerp, _mm256_sub_ps( bta, jta ), jta );
+		jtb = _mm256_madd_ps( vlerp, _mm256_sub_ps( btb, jtb ), jtb );
+		jtc = _mm256_madd_ps( vlerp, _mm256_sub_ps( btc, jtc ), jtc );
+		jtd = _mm256_madd_ps( vlerp, _mm256_sub_ps( btd, jtd ), jtd );
+		
+		_mm256_store2_ps( joints[n0].t.ToFloatPtr(), joints[n4].t.ToFloatPtr(), jta );
+		_mm256_store2_ps( joints[n1].t.ToFloatPtr(), joints[n5].t.ToFloatPtr(), jtb );
+		_mm256_store2_ps( joints[n2].t.ToFloatPtr(), joints[n6].t.ToFloatPtr(), jtc );
+		_mm256_store2_ps( joints[n3].t.ToFloatPtr(), joints[n7].t.ToFloatPtr(), jtd );
+		
+		__m256 jqr = _mm256_unpacklo_ps( jqa, jqc );
+		__m256 jqs = _mm256_unpackhi_ps( jqa, jqc );
+		__m256 jqt = _mm256_unpacklo_ps( jqb, jqd );
+		__m256 jqu = _mm256_unpackhi_ps( jqb, jqd );
+		
+		__m256 bqr = _mm256_unpacklo_ps( bqa, bqc );
+		__m256 bqs = _mm256_unpackhi_ps( bqa, bqc );
+		__m256 bqt = _mm256_unpacklo_ps( bqb, bqd );
+		__m256 bqu = _mm256_unpackhi_ps( bqb, bqd );
+		
+		__m256 jqx = _mm256_unpacklo_ps( jqr, jqt );
+		__m256 jqy = _mm256_unpackhi_ps( jqr, jqt );
+		__m256 jqz = _mm256_unpacklo_ps( jqs, jqu );
+		__m256 jqw = _mm256_unpackhi_ps( jqs, jqu );
+		
+		__m256 bqx = _mm256_unpacklo_ps( bqr, bqt );
+		__m256 bqy = _mm256_unpackhi_ps( bqr, bqt );
+		__m256 bqz = _mm256_unpacklo_ps( bqs, bqu );
+		__m256 bqw = _mm256_unpackhi_ps( bqs, bqu );
+		
+		__m256 cosome = _mm256_add_ps( _mm256_mul_ps( jqx, bqx ), _mm256_mul_ps( jqy, bqy ) );
+		__m256 cosomf = _mm256_add_ps( _mm256_mul_ps( jqz, bqz ), _mm256_mul_ps( jqw, bqw ) );
+		__m256 cosom = _mm256_add_ps( cosome, cosomf );
+		
+		__m256 sign = _mm256_and_ps( cosom, vector_float_sign_bit );
+		
+		__m256 scale = _mm256_xor_ps( vscaledLerp, sign );
+		
+		jqx = _mm256_madd_ps( scale, bqx, jqx );
+		jqy = _mm256_madd_ps( scale, bqy, jqy );
+		jqz = _mm256_madd_ps( scale, bqz, jqz );
+		jqw = _mm256_madd_ps( scale, bqw, jqw );
+		
+		__m256 de = _mm256_add_ps( _mm256_mul_ps( jqx, jqx ), _mm256_mul_ps( jqy, jqy ) );
+		__m256 df = _mm256_add_ps( _mm256_mul_ps( jqz, jqz ), _mm256_mul_ps( jqw, jqw ) );
+		__m256 d = _mm256_add_ps( de, df );
+		
+		__m256 rs = _mm256_rsqrt_ps( d );
+		__m256 sq = _mm256_mul_ps( rs, rs );
+		__m256 sh = _mm256_mul_ps( rs, vector_float_rsqrt_c1 );
+		__m256 sx = _mm256_madd_ps( d, sq, vector_float_rsqrt_c0 );
+		__m256 s = _mm256_mul_ps( sh, sx );
+		
+		jqx = _mm256_mul_ps( jqx, s );
+		jqy = _mm256_mul_ps( jqy, s );
+		jqz = _mm256_mul_ps( jqz, s );
+		jqw = _mm256_mul_ps( jqw, s );
+		
+		__m256 tp0 = _mm256_unpacklo_ps( jqx, jqz );
+		__m256 tp1 = _mm256_unpackhi_ps( jqx, jqz );
+		__m256 tp2 = _mm256_unpacklo_ps( jqy, jqw );
+		__m256 tp3 = _mm256_unpackhi_ps( jqy, jqw );
+		
+		__m256 p0 = _mm256_unpacklo_ps( tp0, tp2 );
+		__m256 p1 = _mm256_unpackhi_ps( tp0, tp2 );
+		__m256 p2 = _mm256_unpacklo_ps( tp1, tp3 );
+		__m256 p3 = _mm256_unpackhi_ps( tp1, tp3 );
+		
+		_mm256_store2_ps( joints[n0].q.ToFloatPtr(), joints[n4].q.ToFloatPtr(), p0 );
+		_mm256_store2_ps( joints[n1].q.ToFloatPtr(), joints[n5].q.ToFloatPtr(), p1 );
+		_mm256_store2_ps( joints[n2].q.ToFloatPtr(), joints[n6].q.ToFloatPtr(), p2 );
+		_mm256_store2_ps( joints[n3].q.ToFloatPtr(), joints[n7].q.ToFloatPtr(), p3 );
+	}
+	
+	if( i < numJoints )
+	{
+		idSIMD_SSE::BlendJointsFast( joints, blendJoints, lerp, index + i, numJoints - i );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::ConvertJointQuatsToJointMats
+
+Same math as the SSE version with two joints per register, all shuffles stay within a lane
+============
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::ConvertJointQuatsToJointMats( idJointMat* jointMats, const idJointQuat* jointQuats, const int numJoints )
+{
+	assert( sizeof( idJointQuat ) == JOINTQUAT_SIZE );
+	assert( sizeof( idJointMat ) == JOINTMAT_SIZE );
+	
+	const float* jointQuatPtr = ( float* )jointQuats;
+	float* jointMatPtr = ( float* )jointMats;
+	
+	const __m256 vector_float_first_sign_bit		= _mm256_castsi256_ps( _mm256_setr_epi32( 0x80000000, 0, 0, 0, 0x80000000, 0, 0, 0 ) );
+	const __m256 vector_float_last_three_sign_bits	= _mm256_castsi256_ps( _mm256_setr_epi32( 0, 0x80000000, 0x80000000, 0x80000000, 0, 0x80000000, 0x80000000, 0x80000000 ) );
+	const __m256 vector_float_first_pos_half		= _mm256_setr_ps(   0.5f,   0.0f,   0.0f,   0.0f,   0.5f,   0.0f,   0.0f,   0.0f );	// +.5 0 0 0
+	const __m256 vector_float_first_neg_half		= _mm256_setr_ps(  -0.5f,   0.0f,   0.0f,   0.0f,  -0.5f,   0.0f,   0.0f,   0.0f );	// -.5 0 0 0
+	const __m256 vector_float_quat2mat_mad1			= _mm256_setr_ps(  -1.0f,  -1.0f,  +1.0f,  -1.0f,  -1.0f,  -1.0f,  +1.0f,  -1.0f );	//  - - + -
+	const __m256 vector_float_quat2mat_mad2			= _mm256_setr_ps(  -1.0f,  +1.0f,  -1.0f,  -1.0f,  -1.0f,  +1.0f,  -1.0f,  -1.0f );	//  - + - -
+	const __m256 vector_float_quat2mat_mad3			= _mm256_setr_ps(  +1.0f,  -1.0f,  -1.0f,  +1.0f,  +1.0f,  -1.0f,  -1.0f,  +1.0f );	//  + - - +
+	
+	int i = 0;
+	for( ; i + 2 <= numJoints; i += 2 )
+	{
+		__m256 q = _mm256_load2_ps( &jointQuatPtr[i * 8 + 0 * 8 + 0], &jointQuatPtr[i * 8 + 1 * 8 + 0] );
+		__m256 t = _mm256_load2_ps( &jointQuatPtr[i * 8 + 0 * 8 + 4], &jointQuatPtr[i * 8 + 1 * 8 + 4] );
+		
+		__m256 d = _mm256_add_ps( q, q );
+		
+		__m256 sa = _mm256_permute_ps( q, _MM_SHUFFLE( 1, 0, 0, 1 ) );							//   y,   x,   x,   y
+		__m256 sb = _mm256_permute_ps( d, _MM_SHUFFLE( 2, 2, 1, 1 ) );							//  y2,  y2,  z2,  z2
+		__m256 sc = _mm256_permute_ps( q, _MM_SHUFFLE( 3, 3, 3, 2 ) );							//   z,   w,   w,   w
+		__m256 sd = _mm256_permute_ps( d, _MM_SHUFFLE( 0, 1, 2, 2 ) );							//  z2,  z2,  y2,  x2
+		
+		sa = _mm256_xor_ps( sa, vector_float_first_sign_bit );
+		sc = _mm256_xor_ps( sc, vector_float_last_three_sign_bits );							// flip stupid inverse quaternions
+		
+		__m256 ma = _mm256_add_ps( _mm256_mul_ps( sa, sb ), vector_float_first_pos_half );		//  .5 - yy2,  xy2,  xz2,  yz2		//  .5 0 0 0
+		__m256 mb = _mm256_add_ps( _mm256_mul_ps( sc, sd ), vector_float_first_neg_half );		// -.5 + zz2,  wz2,  wy2,  wx2		// -.5 0 0 0
+		__m256 mc = _mm256_sub_ps( vector_float_first_pos_half, _mm256_mul_ps( q, d ) );		//  .5 - xx2, -yy2, -zz2, -ww2		//  .5 0 0 0
+		
+		__m256 mf = _mm256_shuffle_ps( ma, mc, _MM_SHUFFLE( 0, 0, 1, 1 ) );					//       xy2,  xy2, .5 - xx2, .5 - xx2	// 01, 01, 10, 10
+		__m256 md = _mm256_shuffle_ps( mf, ma, _MM_SHUFFLE( 3, 2, 0, 2 ) );					//  .5 - xx2,  xy2,  xz2,  yz2			// 10, 01, 02, 03
+		__m256 me = _mm256_shuffle_ps( ma, mb, _MM_SHUFFLE( 3, 2, 1, 0 ) );					//  .5 - yy2,  xy2,  wy2,  wx2			// 00, 01, 12, 13
+		
+		__m256 ra = _mm256_add_ps( _mm256_mul_ps( mb, vector_float_quat2mat_mad1 ), ma );		// 1 - yy2 - zz2, xy2 - wz2, xz2 + wy2,					// - - + -
+		__m256 rb = _mm256_add_ps( _mm256_mul_ps( mb, vector_float_quat2mat_mad2 ), md );		// 1 - xx2 - zz2, xy2 + wz2,          , yz2 - wx2		// - + - -
+		__m256 rc = _mm256_add_ps( _mm256_mul_ps( me, vector_float_quat2mat_mad3 ), md );		// 1 - xx2 - yy2,          , xz2 - wy2, yz2 + wx2		// + - - +
+		
+		__m256 ta = _mm256_shuffle_ps( ra, t, _MM_SHUFFLE( 0, 0, 2, 2 ) );
+		__m256 tb = _mm256_shuffle_ps( rb, t, _MM_SHUFFLE( 1, 1, 3, 3 ) );
+		__m256 tc = _mm256_shuffle_ps( rc, t, _MM_SHUFFLE( 2, 2, 0, 0 ) );
+		
+		ra = _mm256_shuffle_ps( ra, ta, _MM_SHUFFLE( 2, 0, 1, 0 ) );							// 00 01 02 10
+		rb = _mm256_shuffle_ps( rb, tb, _MM_SHUFFLE( 2, 0, 0, 1 ) );							// 01 00 03 11
+		rc = _mm256_shuffle_ps( rc, tc, _MM_SHUFFLE( 2, 0, 3, 2 ) );							// 02 03 00 12
+		
+		_mm256_store2_ps( &jointMatPtr[i * 12 + 0 * 12 + 0], &jointMatPtr[i * 12 + 1 * 12 + 0], ra );
+		_mm256_store2_ps( &jointMatPtr[i * 12 + 0 * 12 + 4], &jointMatPtr[i * 12 + 1 * 12 + 4], rb );
+		_mm256_store2_ps( &jointMatPtr[i * 12 + 0 * 12 + 8], &jointMatPtr[i * 12 + 1 * 12 + 8], rc );
+	}
+	
+	if( i < numJoints )
+	{
+		idSIMD_SSE::ConvertJointQuatsToJointMats( jointMats + i, jointQuats + i, numJoints - i );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::TransformJoints
+
+The first two rows of the parent share a register, each lane is multiplied by the broadcast child rows
+============
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::TransformJoints( idJointMat* jointMats, const int* parents, const int firstJoint, const int lastJoint )
+{
+	const __m256 vector_float_mask_keep_last	= _mm256_castsi256_ps( _mm256_setr_epi32( 0, 0, 0, 0xFFFFFFFF, 0, 0, 0, 0xFFFFFFFF ) );
+	
+	const float* __restrict firstMatrix = jointMats->ToFloatPtr() + ( firstJoint + firstJoint + firstJoint - 3 ) * 4;
+	
+	__m256 pmab = _mm256_load2_ps( firstMatrix + 0, firstMatrix + 4 );
+	__m128 pmc = _mm_load_ps( firstMatrix + 8 );
+	
+	for( int joint = firstJoint; joint <= lastJoint; joint++ )
+	{
+		const int parent = parents[joint];
+		const float* __restrict parentMatrix = jointMats->ToFloatPtr() + ( parent + parent + parent ) * 4;
+		float* __restrict childMatrix = jointMats->ToFloatPtr() + ( joint + joint + joint ) * 4;
+		
+		if( parent != joint - 1 )
+		{
+			pmab = _mm256_load2_ps( parentMatrix + 0, parentMatrix + 4 );
+			pmc = _mm_load_ps( parentMatrix + 8 );
+		}
+		
+		__m256 cma = _mm256_broadcast_ps( ( const __m128* )( childMatrix + 0 ) );
+		__m256 cmb = _mm256_broadcast_ps( ( const __m128* )( childMatrix + 4 ) );
+		__m256 cmc = _mm256_broadcast_ps( ( const __m128* )( childMatrix + 8 ) );
+		
+		__m128 ta = _mm_splat_ps( pmc, 0 );
+		__m128 tb = _mm_splat_ps( pmc, 1 );
+		__m128 tc = _mm_splat_ps( pmc, 2 );
+		
+		__m256 tab = _mm256_permute_ps( pmab, _MM_SHUFFLE( 0, 0, 0, 0 ) );
+		__m256 tde = _mm256_permute_ps( pmab, _MM_SHUFFLE( 1, 1, 1, 1 ) );
+		__m256 tgh = _mm256_permute_ps( pmab, _MM_SHUFFLE( 2, 2, 2, 2 ) );
+		
+		pmab = _mm256_madd_ps( tab, cma, _mm256_and_ps( pmab, vector_float_mask_keep_last ) );
+		pmc = _mm_madd_ps( ta, _mm256_castps256_ps128( cma ), _mm_and_ps( pmc, _mm256_castps256_ps128( vector_float_mask_keep_last ) ) );
+		
+		pmab = _mm256_madd_ps( tde, cmb, pmab );
+		pmc = _mm_madd_ps( tb, _mm256_castps256_ps128( cmb ), pmc );
+		
+		pmab = _mm256_madd_ps( tgh, cmc, pmab );
+		pmc = _mm_madd_ps( tc, _mm256_castps256_ps128( cmc ), pmc );
+		
+		_mm256_store2_ps( childMatrix + 0, childMatrix + 4, pmab );
+		_mm_store_ps( childMatrix + 8, pmc );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::DequantizeComponents
+============
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::DequantizeComponents( float* dst, const unsigned short* src, const float* scale, const float* bias, const int count )
+{
+	int i = 0;
+	for( ; i + 16 <= count; i += 16 )
+	{
+		__m256i s = _mm256_loadu_si256( ( const __m256i* )( src + i ) );
+		
+		__m256 a = _mm256_cvtepi32_ps( _mm256_cvtepu16_epi32( _mm256_castsi256_si128( s ) ) );
+		__m256 b = _mm256_cvtepi32_ps( _mm256_cvtepu16_epi32( _mm256_extracti128_si256( s, 1 ) ) );
+		
+		a = _mm256_madd_ps( a, _mm256_loadu_ps( scale + i + 0 ), _mm256_loadu_ps( bias + i + 0 ) );
+		b = _mm256_madd_ps( b, _mm256_loadu_ps( scale + i + 8 ), _mm256_loadu_ps( bias + i + 8 ) );
+		
+		_mm256_storeu_ps( dst + i + 0, a );
+		_mm256_storeu_ps( dst + i + 8, b );
+	}
+	
+	if( i < count )
+	{
+		idSIMD_SSE::DequantizeComponents( dst + i, src + i, scale + i, bias + i, count - i );
+	}
+}
+
+/*
+============
+idSIMD_AVX2::DequantizeComponents
+============
+*/
+AVX2_FUNCTION void VPCALL idSIMD_AVX2::DequantizeComponents( float* dst, const byte* src, const float* scale, const float* bias, const int count )
+{
+	int i = 0;
+	for( ; i + 16 <= count; i += 16 )
+	{
+		__m128i s = _mm_loadu_si128( ( const __m128i* )( src + i ) );
+		
+		__m256 a = _mm256_cvtepi32_ps( _mm256_cvtepu8_epi32( s ) );
+		__m256 b = _mm256_cvtepi32_ps( _mm256_cvtepu8_epi32( _mm_srli_si128( s, 8 ) ) );
+		
+		a = _mm256_madd_ps( a, _mm256_loadu_ps( scale + i + 0 ), _mm256_loadu_ps( bias + i + 0 ) );
+		b = _mm256_madd_ps( b, _mm256_loadu_ps( scale + i + 8 ), _mm256_loadu_ps( bias + i + 8 ) );
+		
+		_mm256_storeu_ps( dst + i + 0, a );
+		_mm256_storeu_ps( dst + i + 8, b );
+	}
+	
+	if( i < count )
+	{
+		idSIMD_SSE::DequantizeComponents( dst + i, src + i, scale + i, bias + i, count - i );
+	}
+}
+
+#endif
@@ -234,3 +234,29 @@ void VPCALL idSIMD_Generic::UntransformJoints( idJointMat* jointMats, const int*
 		jointMats[i] /= jointMats[parents[i]];
 	}
 }
+
+/*
+============
+idSIMD_Generic::DequantizeComponents
+============
+*/
+void VPCALL idSIMD_Generic::DequantizeComponents( float* dst, const unsigned short* src, const float* scale, const float* bias, const int count )
+{
+	for( int i = 0; i < count; i++ )
+	{
+		dst[i] = bias[i] + scale[i] * src[i];
+	}
+}
+
+/*
+============
+idSIMD_Generic::DequantizeComponents
+============
+*/
+void VPCALL idSIMD_Generic::DequantizeComponents( float* dst, const byte* src, const float* scale, const float* bias, const int count )
+{
+	for( int i = 0; i < count; i++ )
+	{
+		dst[i] = bias[i] + scale[i] * src[i];
+	}
+}
@@ -974,5 +974,65 @@ void VPCALL idSIMD_SSE::UntransformJoints( idJointMat* jointMats, const int* par
 	}
 }
 
+/*
+============
+idSIMD_SSE::DequantizeComponents
+============
+*/
+void VPCALL idSIMD_SSE::DequantizeComponents( float* dst, const unsigned short* src, const float* scale, const float* bias, const int count )
+{
+	const __m128i zero = _mm_setzero_si128();
+	
+	int i = 0;
+	for( ; i + 8 <= count; i += 8 )
+	{
+		__m128i s = _mm_loadu_si128( ( const __m128i* )( src + i ) );
+		
+		__m128 a = _mm_cvtepi32_ps( _mm_unpacklo_epi16( s, zero ) );
+		__m128 b = _mm_cvtepi32_ps( _mm_unpackhi_epi16( s, zero ) );
+		
+		a = _mm_madd_ps( a, _mm_loadu_ps( scale + i + 0 ), _mm_loadu_ps( bias + i + 0 ) );
+		b = _mm_madd_ps( b, _mm_loadu_ps( scale + i + 4 ), _mm_loadu_ps( bias + i + 4 ) );
+		
+		_mm_storeu_ps( dst + i + 0, a );
+		_mm_storeu_ps( dst + i + 4, b );
+	}
+	
+	for( ; i < count; i++ )
+	{
+		dst[i] = bias[i] + scale[i] * src[i];
+	}
+}
+
+/*
+============
+idSIMD_SSE::DequantizeComponents
+============
+*/
+void VPCALL idSIMD_SSE::DequantizeComponents( float* dst, const byte* src, const float* scale, const float* bias, const int count )
+{
+	const __m128i zero = _mm_setzero_si128();
+	
+	int i = 0;
+	for( ; i + 8 <= count; i += 8 )
+	{
+		__m128i s = _mm_unpacklo_epi8( _mm_loadl_epi64( ( const __m128i* )( src + i ) ), zero );
+		
+		__m128 a = _mm_cvtepi32_ps( _mm_unpacklo_epi16( s, zero ) );
+		__m128 b = _mm_cvtepi32_ps( _mm_unpackhi_epi16( s, zero ) );
+		
+		a = _mm_madd_ps( a, _mm_loadu_ps( scale + i + 0 ), _mm_loadu_ps( bias + i + 0 ) );
+		b = _mm_madd_ps( b, _mm_loadu_ps( scale + i + 4 ), _mm_loadu_ps( bias + i + 4 ) );
+		
+		_mm_storeu_ps( dst + i + 0, a );
+		_mm_storeu_ps( dst + i + 4, b );
+	}
+	
+	for( ; i < count; i++ )
+	{
+		dst[i] = bias[i] + scale[i] * src[i];
+	}
+}
+
 #endif // #if defined(USE_INTRINSICS)
 
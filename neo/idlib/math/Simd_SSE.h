@@ -51,6 +51,8 @@ public:
 	virtual void VPCALL ConvertJointMatsToJointQuats( idJointQuat* jointQuats, const idJointMat* jointMats, const int numJoints );
 	virtual void VPCALL TransformJoints( idJointMat* jointMats, const int* parents, const int firstJoint, const int lastJoint );
 	virtual void VPCALL UntransformJoints( idJointMat* jointMats, const int* parents, const int firstJoint, const int lastJoint );
+	virtual void VPCALL DequantizeComponents( float* dst, const unsigned short* src, const float* scale, const float* bias, const int count );
+	virtual void VPCALL DequantizeComponents( float* dst, const byte* src, const float* scale, const float* bias, const int count );
 };
 
 #endif
@@ -529,6 +529,16 @@ interlockedInt_t Sys_InterlockedIncrement( interlockedInt_t& value )
 	return __sync_add_and_fetch( &value, 1 );
 }
 
+/*
+========================
+Sys_InterlockedIncrement64
+========================
+*/
+int64 Sys_InterlockedIncrement64( int64& value )
+{
+	return __sync_add_and_fetch( &value, 1 );
+}
+
 /*
 ========================
 Sys_InterlockedDecrement
@@ -221,6 +221,7 @@ void				Sys_MutexUnlock( mutexHandle_t& handle );
 
 interlockedInt_t	Sys_InterlockedIncrement( interlockedInt_t& value );
 interlockedInt_t	Sys_InterlockedDecrement( interlockedInt_t& value );
+int64				Sys_InterlockedIncrement64( int64& value );
 
 interlockedInt_t	Sys_InterlockedAdd( interlockedInt_t& value, interlockedInt_t i );
 interlockedInt_t	Sys_InterlockedSub( interlockedInt_t& value, interlockedInt_t i );
@@ -322,6 +322,20 @@ interlockedInt_t Sys_InterlockedIncrement( interlockedInt_t& value )
 #endif
 }
 
+/*
+========================
+Sys_InterlockedIncrement64
+========================
+*/
+int64 Sys_InterlockedIncrement64( int64& value )
+{
+#if defined(__GNUC__)
+	return __sync_add_and_fetch( &value, 1 );
+#else
+	return InterlockedIncrement64( & value );
+#endif
+}
+
 /*
 ========================
 Sys_InterlockedDecrement
@@ -41,6 +41,149 @@ If you have questions concerning this license or the applicable additional terms
 #include "Color/ColorSpace.h"
 
 idCVar image_highQualityCompression( "image_highQualityCompression", "0", CVAR_BOOL, "Use high quality (slow) compression" );
+idCVar image_parallelCompression( "image_parallelCompression", "1", CVAR_BOOL, "split the DXT compression of large images into block rows that are encoded in parallel jobs" );
+
+// smaller levels are not worth the job overhead and stay in a single job
+static const int MIN_DXT_BLOCKS_PER_JOB = 1024;
+
+struct dxtEncodeJob_t
+{
+	const byte*		src;			// RGBA source, padded to whole 4x4 blocks
+	byte*			dest;
+	int				width;
+	int				height;			// only the rows encoded by this job
+	textureFormat_t	format;
+	textureColor_t	colorFormat;
+	bool			highQuality;
+};
+
+/*
+========================
+DXT_EncodeJob
+
+The encoders work on one row of 4x4 blocks at a time, so any range of block
+rows can be encoded independently of the rest of the image.
+========================
+*/
+static void DXT_EncodeJob( dxtEncodeJob_t* job )
+{
+	idDxtEncoder dxt;
+	if( job->format == FMT_DXT1 )
+	{
+		if( job->highQuality )
+		{
+			dxt.CompressImageDXT1HQ( job->src, job->dest, job->width, job->height );
+		}
+		else
+		{
+			dxt.CompressImageDXT1Fast( job->src, job->dest, job->width, job->height );
+		}
+	}
+	else if( job->colorFormat == CFM_NORMAL_DXT5 )
+	{
+		if( job->highQuality )
+		{
+			dxt.CompressNormalMapDXT5HQ( job->src, job->dest, job->width, job->height );
+		}
+		else
+		{
+			dxt.CompressNormalMapDXT5Fast( job->src, job->dest, job->width, job->height );
+		}
+	}
+	else if( job->colorFormat == CFM_YCOCG_DXT5 )
+	{
+		if( job->highQuality )
+		{
+			dxt.CompressYCoCgDXT5HQ( job->src, job->dest, job->width, job->height );
+		}
+		else
+		{
+			dxt.CompressYCoCgDXT5Fast( job->src, job->dest, job->width, job->height );
+		}
+	}
+	else
+	{
+		if( job->highQuality )
+		{
+			dxt.CompressImageDXT5HQ( job->src, job->dest, job->width, job->height );
+		}
+		else
+		{
+			dxt.CompressImageDXT5Fast( job->src, job->dest, job->width, job->height );
+		}
+	}
+}
+
+REGISTER_PARALLEL_JOB( DXT_EncodeJob, "DXT_EncodeJob" );
+
+/*
+========================
+AddDXTEncodeJobs
+
+Splits a DXT level into ranges of block rows. The source must stay valid
+until RunDXTEncodeJobs has been called.
+========================
+*/
+static void AddDXTEncodeJobs( idList< dxtEncodeJob_t >& jobs, const byte* src, byte* dest, int width, int height, textureFormat_t format, textureColor_t colorFormat, bool highQuality )
+{
+	const int blockBytes = ( format == FMT_DXT1 ) ? 8 : 16;
+	const int blocksWide = Max( 1, width >> 2 );
+	const int blocksHigh = Max( 1, height >> 2 );
+	const int rowsPerJob = Max( 1, MIN_DXT_BLOCKS_PER_JOB / blocksWide );
+	
+	if( height < 4 || rowsPerJob >= blocksHigh )
+	{
+		dxtEncodeJob_t& job = jobs.Alloc();
+		job.src = src;
+		job.dest = dest;
+		job.width = width;
+		job.height = height;
+		job.format = format;
+		job.colorFormat = colorFormat;
+		job.highQuality = highQuality;
+		return;
+	}
+	
+	for( int row = 0; row < blocksHigh; row += rowsPerJob )
+	{
+		dxtEncodeJob_t& job = jobs.Alloc();
+		job.src = src + row * 4 * width * 4;
+		job.dest = dest + row * blocksWide * blockBytes;
+		job.width = width;
+		job.height = Min( rowsPerJob, blocksHigh - row ) * 4;
+		job.format = format;
+		job.colorFormat = colorFormat;
+		job.highQuality = highQuality;
+	}
+}
+
+/*
+========================
+RunDXTEncodeJobs
+========================
+*/
+static void RunDXTEncodeJobs( idList< dxtEncodeJob_t >& jobs, bool parallel )
+{
+	if( parallel && jobs.Num() > 1 )
+	{
+		idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, jobs.Num(), 0, NULL );
+		for( int i = 0; i < jobs.Num(); i++ )
+		{
+			jobList->AddJob( ( jobRun_t )DXT_EncodeJob, &jobs[i] );
+		}
+		jobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+		jobList->Wait();
+		parallelJobManager->FreeJobList( jobList );
+	}
+	else
+	{
+		for( int i = 0; i < jobs.Num(); i++ )
+		{
+			DXT_EncodeJob( &jobs[i] );
+		}
+	}
+	jobs.Clear();
+}
 
 /*
 ========================
@@ -56,6 +199,10 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte* pic_con
 	fileData.height = height;
 	fileData.numLevels = numLevels;
 	
+	const bool highQuality = image_highQualityCompression.GetBool();
+	idList< dxtEncodeJob_t > encodeJobs;
+	idList< byte* > encodeSources;
+	
 	byte* pic = ( byte* )Mem_Alloc( width * height * 4, TAG_TEMP );
 	memcpy( pic, pic_const, width * height * 4 );
 	
@@ -67,7 +214,7 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte* pic_con
 	else if( colorFormat == CFM_NORMAL_DXT5 )
 	{
 		// Blah, HQ swizzles automatically, Fast doesn't
-		if( !image_highQualityCompression.GetBool() )
+		if( !highQuality )
 		{
 			for( int i = 0; i < width * height; i++ )
 			{
@@ -126,57 +273,22 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte* pic_con
 		img.height = scaledHeight;
 		
 		// compress data or convert floats as necessary
+		// the DXT levels are only queued here and encoded once the whole mip chain exists
 		if( textureFormat == FMT_DXT1 )
 		{
-			idDxtEncoder dxt;
 			img.Alloc( dxtWidth * dxtHeight / 2 );
-			if( image_highQualityCompression.GetBool() )
-			{
-				dxt.CompressImageDXT1HQ( dxtPic, img.data, dxtWidth, dxtHeight );
-			}
-			else
-			{
-				dxt.CompressImageDXT1Fast( dxtPic, img.data, dxtWidth, dxtHeight );
-			}
+			AddDXTEncodeJobs( encodeJobs, dxtPic, img.data, dxtWidth, dxtHeight, textureFormat, colorFormat, highQuality );
+			encodeSources.Append( dxtPic );
 		}
 		else if( textureFormat == FMT_DXT5 )
 		{
-			idDxtEncoder dxt;
 			img.Alloc( dxtWidth * dxtHeight );
-			if( colorFormat == CFM_NORMAL_DXT5 )
-			{
-				if( image_highQualityCompression.GetBool() )
-				{
-					dxt.CompressNormalMapDXT5HQ( dxtPic, img.data, dxtWidth, dxtHeight );
-				}
-				else
-				{
-					dxt.CompressNormalMapDXT5Fast( dxtPic, img.data, dxtWidth, dxtHeight );
-				}
-			}
-			else if( colorFormat == CFM_YCOCG_DXT5 )
-			{
-				if( image_highQualityCompression.GetBool() )
-				{
-					dxt.CompressYCoCgDXT5HQ( dxtPic, img.data, dxtWidth, dxtHeight );
-				}
-				else
-				{
-					dxt.CompressYCoCgDXT5Fast( dxtPic, img.data, dxtWidth, dxtHeight );
-				}
-			}
-			else
+			if( colorFormat != CFM_NORMAL_DXT5 && colorFormat != CFM_YCOCG_DXT5 )
 			{
 				fileData.colorFormat = colorFormat = CFM_DEFAULT;
-				if( image_highQualityCompression.GetBool() )
-				{
-					dxt.CompressImageDXT5HQ( dxtPic, img.data, dxtWidth, dxtHeight );
-				}
-				else
-				{
-					dxt.CompressImageDXT5Fast( dxtPic, img.data, dxtWidth, dxtHeight );
-				}
 			}
+			AddDXTEncodeJobs( encodeJobs, dxtPic, img.data, dxtWidth, dxtHeight, textureFormat, colorFormat, highQuality );
+			encodeSources.Append( dxtPic );
 		}
 		else if( textureFormat == FMT_LUM8 || textureFormat == FMT_INT8 )
 		{
@@ -226,13 +338,6 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte* pic_con
 			}
 		}
 		
-		// if we had to pad to quads, free the padded version
-		if( pic != dxtPic )
-		{
-			Mem_Free( dxtPic );
-			dxtPic = NULL;
-		}
-		
 		// downsample for the next level
 		byte* shrunk = NULL;
 		if( gammaMips )
@@ -243,7 +348,12 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte* pic_con
 		{
 			shrunk = R_MipMap( pic, scaledWidth, scaledHeight );
 		}
-		Mem_Free( pic );
+		
+		// a level that is still waiting for its encode jobs is freed afterwards
+		if( encodeSources.Num() == 0 || encodeSources[ encodeSources.Num() - 1 ] != pic )
+		{
+			Mem_Free( pic );
+		}
 		pic = shrunk;
 		
 		scaledWidth = Max( 1, scaledWidth >> 1 );
@@ -251,6 +361,12 @@ void idBinaryImage::Load2DFromMemory( int width, int height, const byte* pic_con
 	}
 	
 	Mem_Free( pic );
+	
+	RunDXTEncodeJobs( encodeJobs, parallelEncode && image_parallelCompression.GetBool() );
+	for( int i = 0; i < encodeSources.Num(); i++ )
+	{
+		Mem_Free( encodeSources[i] );
+	}
 }
 
 /*
@@ -297,6 +413,9 @@ void idBinaryImage::LoadCubeFromMemory( int width, const byte* pics[6], int numL
 	
 	images.SetNum( fileData.numLevels * 6 );
 	
+	idList< dxtEncodeJob_t > encodeJobs;
+	idList< byte* > encodeSources;
+	
 	for( int side = 0; side < 6; side++ )
 	{
 		const byte* orig = pics[side];
@@ -327,17 +446,30 @@ void idBinaryImage::LoadCubeFromMemory( int width, const byte* pics[6], int numL
 			img.destZ = side;
 			img.width = padSize;
 			img.height = padSize;
-			if( textureFormat == FMT_DXT1 )
+			if( textureFormat == FMT_DXT1 || textureFormat == FMT_DXT5 )
 			{
-				img.Alloc( padSize * padSize / 2 );
-				idDxtEncoder dxt;
-				dxt.CompressImageDXT1Fast( padSrc, img.data, padSize, padSize );
-			}
-			else if( textureFormat == FMT_DXT5 )
-			{
-				img.Alloc( padSize * padSize );
-				idDxtEncoder dxt;
-				dxt.CompressImageDXT5Fast( padSrc, img.data, padSize, padSize );
+				img.Alloc( ( textureFormat == FMT_DXT1 ) ? padSize * padSize / 2 : padSize * padSize );
+				if( padSrc == padBlock )
+				{
+					// the pad block is reused by the next level, so encode it right away
+					idDxtEncoder dxt;
+					if( textureFormat == FMT_DXT1 )
+					{
+						dxt.CompressImageDXT1Fast( padSrc, img.data, padSize, padSize );
+					}
+					else
+					{
+						dxt.CompressImageDXT5Fast( padSrc, img.data, padSize, padSize );
+					}
+				}
+				else
+				{
+					AddDXTEncodeJobs( encodeJobs, padSrc, img.data, padSize, padSize, textureFormat, CFM_DEFAULT, false );
+					if( pic != orig )
+					{
+						encodeSources.Append( ( byte* )pic );
+					}
+				}
 			}
 			else
 			{
@@ -356,7 +488,7 @@ void idBinaryImage::LoadCubeFromMemory( int width, const byte* pics[6], int numL
 			{
 				shrunk = R_MipMap( pic, scaledWidth, scaledWidth );
 			}
-			if( pic != orig )
+			if( pic != orig && ( encodeSources.Num() == 0 || encodeSources[ encodeSources.Num() - 1 ] != pic ) )
 			{
 				Mem_Free( ( void* )pic );
 				pic = NULL;
@@ -372,6 +504,12 @@ void idBinaryImage::LoadCubeFromMemory( int width, const byte* pics[6], int numL
 			pic = NULL;
 		}
 	}
+	
+	RunDXTEncodeJobs( encodeJobs, parallelEncode && image_parallelCompression.GetBool() );
+	for( int i = 0; i < encodeSources.Num(); i++ )
+	{
+		Mem_Free( encodeSources[i] );
+	}
 }
 
 /*
@@ -41,7 +41,7 @@ generation.
 class idBinaryImage
 {
 public:
-	idBinaryImage( const char* name ) : imgName( name ) { }
+	idBinaryImage( const char* name ) : imgName( name ), parallelEncode( false ) { }
 	
 	const char* 		GetName() const
 	{
@@ -52,6 +52,13 @@ public:
 		imgName = _name;
 	}
 	
+	// large DXT levels are split into block rows that are encoded in parallel jobs,
+	// only enable this on the thread that owns the job lists
+	void				SetParallelEncode( bool parallel )
+	{
+		parallelEncode = parallel;
+	}
+	
 	void				Load2DFromMemory( int width, int height, const byte* pic_const, int numLevels, textureFormat_t& textureFormat, textureColor_t& colorFormat, bool gammaMips );
 	void				LoadCubeFromMemory( int width, const byte* pics[6], int numLevels, textureFormat_t& textureFormat, bool gammaMips );
 	
@@ -79,6 +86,7 @@ public:
 private:
 	idStr				imgName;			// game path, including extension (except for cube maps), may be an image program
 	bimageFile_t		fileData;
+	bool				parallelEncode;
 	
 	class idBinaryImageData : public bimageImage_t
 	{
@@ -287,6 +287,11 @@ private:
 	void				InsetYCoCgBBox_SSE2( byte* minColor, byte* maxColor ) const;
 	void				SelectYCoCgDiagonal_SSE2( const byte* colorBlock, byte* minColor, byte* maxColor ) const;
 	
+	// the exhaustive searches score eight pairs of end points at once, chosen at run time when the CPU supports AVX2
+	int					GetMinMaxAlphaHQ_AVX2( const byte* colorBlock, const int alphaOffset, byte* minColor, byte* maxColor ) const;
+	int					GetMinMaxColorsHQ_AVX2( const byte* colorBlock, byte* minColor, byte* maxColor, bool noBlack ) const;
+	int					GetMinMaxNormalYHQ_AVX2( const byte* colorBlock, byte* minColor, byte* maxColor, bool noBlack, int scale ) const;
+	
 	
 	
 	void				EmitNormalYIndices( const byte* normalBlock, const int offset, const byte minNormalY, const byte maxNormalY );
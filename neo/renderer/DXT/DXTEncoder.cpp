@@ -495,6 +495,13 @@ paramO:	maxColor		- 4 byte max color found
 */
 int idDxtEncoder::GetMinMaxAlphaHQ( const byte* colorBlock, const int alphaOffset, byte* minColor, byte* maxColor ) const
 {
+#if defined(USE_INTRINSICS)
+	if( SIMDProcessor != NULL && ( SIMDProcessor->cpuid & CPUID_AVX2 ) )
+	{
+		return GetMinMaxAlphaHQ_AVX2( colorBlock, alphaOffset, minColor, maxColor );
+	}
+#endif
+	
 	int i, j;
 	byte alphaMin, alphaMax;
 	int error, bestError = MAX_TYPE( int );
@@ -682,6 +689,13 @@ paramO:	maxColor	- 4 byte max color found
 */
 int idDxtEncoder::GetMinMaxColorsHQ( const byte* colorBlock, byte* minColor, byte* maxColor, bool noBlack ) const
 {
+#if defined(USE_INTRINSICS)
+	if( SIMDProcessor != NULL && ( SIMDProcessor->cpuid & CPUID_AVX2 ) )
+	{
+		return GetMinMaxColorsHQ_AVX2( colorBlock, minColor, maxColor, noBlack );
+	}
+#endif
+	
 	int i;
 	int i0, i1, i2, j0, j1, j2;
 	unsigned short minColor565, maxColor565, bestMinColor565, bestMaxColor565;
@@ -1006,6 +1020,13 @@ paramO:	maxColor	- 4 byte Max color found
 */
 int idDxtEncoder::GetMinMaxNormalYHQ( const byte* colorBlock, byte* minColor, byte* maxColor, bool noBlack, int scale ) const
 {
+#if defined(USE_INTRINSICS)
+	if( SIMDProcessor != NULL && ( SIMDProcessor->cpuid & CPUID_AVX2 ) )
+	{
+		return GetMinMaxNormalYHQ_AVX2( colorBlock, minColor, maxColor, noBlack, scale );
+	}
+#endif
+	
 	unsigned short bestMinColor565, bestMaxColor565;
 	byte bboxMin[3], bboxMax[3];
 	int error, bestError = MAX_TYPE( int );
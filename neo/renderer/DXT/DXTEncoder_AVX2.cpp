@@ -0,0 +1,636 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+/*
+================================================================================================
+Contains the AVX2 versions of the high quality DxtEncoder searches.
+
+The exhaustive searches are unchanged, but instead of scoring one pair of end points at a
+time, eight candidates are collected and scored at once with one candidate per 32-bit lane.
+The candidates are then compared in the original search order, so the selected end points
+and the returned error are exactly the same as the ones of the generic code.
+================================================================================================
+*/
+#pragma hdrstop
+#include "DXTCodec_local.h"
+#include "DXTCodec.h"
+
+#if defined(USE_INTRINSICS)
+
+#include <immintrin.h>
+
+// only these functions may use 256-bit instructions, everything else is still built for SSE2
+#if defined(_MSC_VER)
+#define AVX2_FUNCTION
+#else
+#define AVX2_FUNCTION		__attribute__(( target( "avx2" ) ))
+#endif
+
+#define HQ_CANDIDATES		8
+
+// ( x * magic ) >> 16 is an exact division for the largest sums used by the palettes: 3 * 255, 5 * 255 and 7 * 255
+#define DIV_BY_3_MAGIC		21846
+#define DIV_BY_5_MAGIC		13108
+#define DIV_BY_7_MAGIC		9363
+
+/*
+========================
+hqCandidates_t
+
+End point candidates in search order. The lanes of a partial batch repeat the first
+candidate so they never need to be masked out.
+========================
+*/
+struct hqCandidates_t
+{
+	int		endPoint0[HQ_CANDIDATES];		// first end point as used for decoding
+	int		endPoint1[HQ_CANDIDATES];
+	int		storeMin[HQ_CANDIDATES];		// values reported to the caller when the candidate wins
+	int		storeMax[HQ_CANDIDATES];
+	int		num;
+	
+	hqCandidates_t() : num( 0 ) { }
+	
+	bool	Add( int e0, int e1, int sMin, int sMax )
+	{
+		endPoint0[num] = e0;
+		endPoint1[num] = e1;
+		storeMin[num] = sMin;
+		storeMax[num] = sMax;
+		return ++num == HQ_CANDIDATES;
+	}
+	
+	void	Pad()
+	{
+		for( int i = num; i < HQ_CANDIDATES; i++ )
+		{
+			endPoint0[i] = endPoint0[0];
+			endPoint1[i] = endPoint1[0];
+		}
+	}
+	
+	// picks the first candidate with a lower error than the best one so far
+	void	Select( const int* errors, int& bestError, int& bestMin, int& bestMax )
+	{
+		for( int i = 0; i < num; i++ )
+		{
+			if( errors[i] < bestError )
+			{
+				bestError = errors[i];
+				bestMin = storeMin[i];
+				bestMax = storeMax[i];
+			}
+		}
+		num = 0;
+	}
+};
+
+/*
+========================
+AllWorse_AVX2
+
+True when no lane can beat the best error anymore.
+========================
+*/
+AVX2_FUNCTION static ID_INLINE bool AllWorse_AVX2( const __m256i error, const __m256i bestError )
+{
+	return _mm256_movemask_epi8( _mm256_cmpgt_epi32( bestError, error ) ) == 0;
+}
+
+/*
+========================
+Div_AVX2
+========================
+*/
+AVX2_FUNCTION static ID_INLINE __m256i Div_AVX2( const __m256i x, const int magic )
+{
+	// the upper halves of the 32-bit lanes are zero
+	return _mm256_mulhi_epu16( x, _mm256_set1_epi32( magic ) );
+}
+
+/*
+========================
+Lerp_AVX2
+
+( s0 * a + s1 * b ) / divisor
+========================
+*/
+AVX2_FUNCTION static ID_INLINE __m256i Lerp_AVX2( const __m256i a, const __m256i b, const int s0, const int s1, const int magic )
+{
+	const __m256i sum = _mm256_add_epi32( _mm256_mullo_epi16( a, _mm256_set1_epi32( s0 ) ), _mm256_mullo_epi16( b, _mm256_set1_epi32( s1 ) ) );
+	return Div_AVX2( sum, magic );
+}
+
+/*
+========================
+Square_AVX2
+
+Squares values in the range [0, 255].
+========================
+*/
+AVX2_FUNCTION static ID_INLINE __m256i Square_AVX2( const __m256i x )
+{
+	return _mm256_madd_epi16( x, x );
+}
+
+/*
+========================
+Red565_AVX2, Green565_AVX2, Blue565_AVX2
+
+Same expansion as idDxtEncoder::ColorFrom565.
+========================
+*/
+AVX2_FUNCTION static ID_INLINE __m256i Red565_AVX2( const __m256i c )
+{
+	return _mm256_or_si256( _mm256_and_si256( _mm256_srli_epi32( c, 8 ), _mm256_set1_epi32( 0xF8 ) ), _mm256_and_si256( _mm256_srli_epi32( c, 13 ), _mm256_set1_epi32( 0x07 ) ) );
+}
+
+AVX2_FUNCTION static ID_INLINE __m256i Green565_AVX2( const __m256i c )
+{
+	return _mm256_or_si256( _mm256_and_si256( _mm256_srli_epi32( c, 3 ), _mm256_set1_epi32( 0xFC ) ), _mm256_and_si256( _mm256_srli_epi32( c, 9 ), _mm256_set1_epi32( 0x03 ) ) );
+}
+
+AVX2_FUNCTION static ID_INLINE __m256i Blue565_AVX2( const __m256i c )
+{
+	return _mm256_or_si256( _mm256_and_si256( _mm256_slli_epi32( c, 3 ), _mm256_set1_epi32( 0xF8 ) ), _mm256_and_si256( _mm256_srli_epi32( c, 2 ), _mm256_set1_epi32( 0x07 ) ) );
+}
+
+/*
+========================
+ColorPalette_AVX2
+
+The two interpolated colors of a DXT1 block, black for the three color mode.
+========================
+*/
+AVX2_FUNCTION static ID_INLINE void ColorPalette_AVX2( const __m256i fourColors, const __m256i c0, const __m256i c1, __m256i& c2, __m256i& c3 )
+{
+	const __m256i third0 = Lerp_AVX2( c0, c1, 2, 1, DIV_BY_3_MAGIC );
+	const __m256i third1 = Lerp_AVX2( c0, c1, 1, 2, DIV_BY_3_MAGIC );
+	const __m256i half = _mm256_srli_epi32( _mm256_add_epi32( c0, c1 ), 1 );
+	c2 = _mm256_blendv_epi8( half, third0, fourColors );
+	c3 = _mm256_and_si256( third1, fourColors );
+}
+
+/*
+========================
+ColorsError_AVX2
+
+GetSquareColorsError for eight candidates.
+========================
+*/
+AVX2_FUNCTION static void ColorsError_AVX2( const __m256i pixels[16][3], const hqCandidates_t& candidates, const int bestError, int* errors )
+{
+	const __m256i color0 = _mm256_loadu_si256( ( const __m256i* )candidates.endPoint0 );
+	const __m256i color1 = _mm256_loadu_si256( ( const __m256i* )candidates.endPoint1 );
+	const __m256i fourColors = _mm256_cmpgt_epi32( color0, color1 );
+	
+	__m256i palette[4][3];
+	palette[0][0] = Red565_AVX2( color0 );
+	palette[0][1] = Green565_AVX2( color0 );
+	palette[0][2] = Blue565_AVX2( color0 );
+	palette[1][0] = Red565_AVX2( color1 );
+	palette[1][1] = Green565_AVX2( color1 );
+	palette[1][2] = Blue565_AVX2( color1 );
+	for( int c = 0; c < 3; c++ )
+	{
+		ColorPalette_AVX2( fourColors, palette[0][c], palette[1][c], palette[2][c], palette[3][c] );
+	}
+	
+	const __m256i best = _mm256_set1_epi32( bestError );
+	__m256i error = _mm256_setzero_si256();
+	for( int i = 0; i < 16; i++ )
+	{
+		__m256i minDist = _mm256_set1_epi32( -1 );
+		for( int j = 0; j < 4; j++ )
+		{
+			__m256i dist = Square_AVX2( _mm256_abs_epi32( _mm256_sub_epi32( pixels[i][0], palette[j][0] ) ) );
+			dist = _mm256_add_epi32( dist, Square_AVX2( _mm256_abs_epi32( _mm256_sub_epi32( pixels[i][1], palette[j][1] ) ) ) );
+			dist = _mm256_add_epi32( dist, Square_AVX2( _mm256_abs_epi32( _mm256_sub_epi32( pixels[i][2], palette[j][2] ) ) ) );
+			minDist = _mm256_min_epu32( minDist, dist );
+		}
+		error = _mm256_add_epi32( error, minDist );
+		
+		// stop once every candidate is already worse, these can never be selected
+		if( ( i & 3 ) == 3 && AllWorse_AVX2( error, best ) )
+		{
+			break;
+		}
+	}
+	_mm256_storeu_si256( ( __m256i* )errors, error );
+}
+
+/*
+========================
+idDxtEncoder::GetMinMaxColorsHQ_AVX2
+========================
+*/
+AVX2_FUNCTION int idDxtEncoder::GetMinMaxColorsHQ_AVX2( const byte* colorBlock, byte* minColor, byte* maxColor, bool noBlack ) const
+{
+	int i;
+	int i0, i1, i2, j0, j1, j2;
+	byte bboxMin[3], bboxMax[3], minAxisDist[3];
+	int bestError = MAX_TYPE( int );
+	
+	__m256i pixels[16][3];
+	
+	bboxMin[0] = bboxMin[1] = bboxMin[2] = 255;
+	bboxMax[0] = bboxMax[1] = bboxMax[2] = 0;
+	
+	// get color bbox
+	for( i = 0; i < 16; i++ )
+	{
+		for( int c = 0; c < 3; c++ )
+		{
+			bboxMin[c] = Min( bboxMin[c], colorBlock[i * 4 + c] );
+			bboxMax[c] = Max( bboxMax[c], colorBlock[i * 4 + c] );
+			pixels[i][c] = _mm256_set1_epi32( colorBlock[i * 4 + c] );
+		}
+	}
+	
+	// decrease range for 565 encoding
+	bboxMin[0] >>= 3;
+	bboxMin[1] >>= 2;
+	bboxMin[2] >>= 3;
+	bboxMax[0] >>= 3;
+	bboxMax[1] >>= 2;
+	bboxMax[2] >>= 3;
+	
+	// get the minimum distance the end points of the line must be apart along each axis
+	for( i = 0; i < 3; i++ )
+	{
+		minAxisDist[i] = ( bboxMax[i] - bboxMin[i] );
+		if( minAxisDist[i] >= 16 )
+		{
+			minAxisDist[i] = minAxisDist[i] * 3 / 4;
+		}
+		else if( minAxisDist[i] >= 8 )
+		{
+			minAxisDist[i] = minAxisDist[i] * 2 / 4;
+		}
+		else if( minAxisDist[i] >= 4 )
+		{
+			minAxisDist[i] = minAxisDist[i] * 1 / 4;
+		}
+		else
+		{
+			minAxisDist[i] = 0;
+		}
+	}
+	
+	// expand the bounding box
+	const int C565_BBOX_EXPAND = 1;
+	
+	bboxMin[0] = ( bboxMin[0] <= C565_BBOX_EXPAND ) ? 0 : bboxMin[0] - C565_BBOX_EXPAND;
+	bboxMin[1] = ( bboxMin[1] <= C565_BBOX_EXPAND ) ? 0 : bboxMin[1] - C565_BBOX_EXPAND;
+	bboxMin[2] = ( bboxMin[2] <= C565_BBOX_EXPAND ) ? 0 : bboxMin[2] - C565_BBOX_EXPAND;
+	bboxMax[0] = ( bboxMax[0] >= ( 255 >> 3 ) - C565_BBOX_EXPAND ) ? ( 255 >> 3 ) : bboxMax[0] + C565_BBOX_EXPAND;
+	bboxMax[1] = ( bboxMax[1] >= ( 255 >> 2 ) - C565_BBOX_EXPAND ) ? ( 255 >> 2 ) : bboxMax[1] + C565_BBOX_EXPAND;
+	bboxMax[2] = ( bboxMax[2] >= ( 255 >> 3 ) - C565_BBOX_EXPAND ) ? ( 255 >> 3 ) : bboxMax[2] + C565_BBOX_EXPAND;
+	
+	int bestMinColor565 = 0;
+	int bestMaxColor565 = 0;
+	
+	hqCandidates_t candidates;
+	int errors[HQ_CANDIDATES];
+	
+	for( i0 = bboxMin[0]; i0 <= bboxMax[0]; i0++ )
+	{
+		for( j0 = bboxMax[0]; j0 >= bboxMin[0]; j0-- )
+		{
+			if( abs( i0 - j0 ) < minAxisDist[0] )
+			{
+				continue;
+			}
+			
+			for( i1 = bboxMin[1]; i1 <= bboxMax[1]; i1++ )
+			{
+				for( j1 = bboxMax[1]; j1 >= bboxMin[1]; j1-- )
+				{
+					if( abs( i1 - j1 ) < minAxisDist[1] )
+					{
+						continue;
+					}
+					
+					for( i2 = bboxMin[2]; i2 <= bboxMax[2]; i2++ )
+					{
+						for( j2 = bboxMax[2]; j2 >= bboxMin[2]; j2-- )
+						{
+							if( abs( i2 - j2 ) < minAxisDist[2] )
+							{
+								continue;
+							}
+							
+							int minColor565 = ( i0 << 11 ) | ( i1 << 5 ) | ( i2 << 0 );
+							int maxColor565 = ( j0 << 11 ) | ( j1 << 5 ) | ( j2 << 0 );
+							
+							if( !noBlack )
+							{
+								if( candidates.Add( maxColor565, minColor565, minColor565, maxColor565 ) )
+								{
+									ColorsError_AVX2( pixels, candidates, bestError, errors );
+									candidates.Select( errors, bestError, bestMinColor565, bestMaxColor565 );
+								}
+							}
+							else
+							{
+								if( minColor565 <= maxColor565 )
+								{
+									SwapValues( minColor565, maxColor565 );
+								}
+							}
+							
+							if( candidates.Add( minColor565, maxColor565, minColor565, maxColor565 ) )
+							{
+								ColorsError_AVX2( pixels, candidates, bestError, errors );
+								candidates.Select( errors, bestError, bestMinColor565, bestMaxColor565 );
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	
+	if( candidates.num > 0 )
+	{
+		candidates.Pad();
+		ColorsError_AVX2( pixels, candidates, bestError, errors );
+		candidates.Select( errors, bestError, bestMinColor565, bestMaxColor565 );
+	}
+	
+	ColorFrom565( ( unsigned short )bestMinColor565, minColor );
+	ColorFrom565( ( unsigned short )bestMaxColor565, maxColor );
+	
+	return bestError;
+}
+
+/*
+========================
+AlphaError_AVX2
+
+GetSquareAlphaError for eight candidates.
+========================
+*/
+AVX2_FUNCTION static void AlphaError_AVX2( const __m256i pixels[16], const hqCandidates_t& candidates, const int bestError, int* errors )
+{
+	const __m256i alpha0 = _mm256_loadu_si256( ( const __m256i* )candidates.endPoint0 );
+	const __m256i alpha1 = _mm256_loadu_si256( ( const __m256i* )candidates.endPoint1 );
+	const __m256i eightAlphas = _mm256_cmpgt_epi32( alpha0, alpha1 );
+	
+	__m256i palette[8];
+	palette[0] = alpha0;
+	palette[1] = alpha1;
+	for( int k = 2; k < 6; k++ )
+	{
+		const __m256i seventh = Lerp_AVX2( alpha0, alpha1, 8 - k, k - 1, DIV_BY_7_MAGIC );
+		const __m256i fifth = Lerp_AVX2( alpha0, alpha1, 6 - k, k - 1, DIV_BY_5_MAGIC );
+		palette[k] = _mm256_blendv_epi8( fifth, seventh, eightAlphas );
+	}
+	palette[6] = _mm256_and_si256( Lerp_AVX2( alpha0, alpha1, 2, 5, DIV_BY_7_MAGIC ), eightAlphas );
+	palette[7] = _mm256_blendv_epi8( _mm256_set1_epi32( 255 ), Lerp_AVX2( alpha0, alpha1, 1, 6, DIV_BY_7_MAGIC ), eightAlphas );
+	
+	const __m256i best = _mm256_set1_epi32( bestError );
+	__m256i error = _mm256_setzero_si256();
+	for( int i = 0; i < 16; i++ )
+	{
+		// the closest palette entry also has the smallest square distance
+		__m256i minDist = _mm256_abs_epi32( _mm256_sub_epi32( pixels[i], palette[0] ) );
+		for( int j = 1; j < 8; j++ )
+		{
+			minDist = _mm256_min_epi32( minDist, _mm256_abs_epi32( _mm256_sub_epi32( pixels[i], palette[j] ) ) );
+		}
+		error = _mm256_add_epi32( error, Square_AVX2( minDist ) );
+		
+		if( ( i & 3 ) == 3 && AllWorse_AVX2( error, best ) )
+		{
+			break;
+		}
+	}
+	_mm256_storeu_si256( ( __m256i* )errors, error );
+}
+
+/*
+========================
+idDxtEncoder::GetMinMaxAlphaHQ_AVX2
+========================
+*/
+AVX2_FUNCTION int idDxtEncoder::GetMinMaxAlphaHQ_AVX2( const byte* colorBlock, const int alphaOffset, byte* minColor, byte* maxColor ) const
+{
+	int i, j;
+	byte alphaMin, alphaMax;
+	int bestError = MAX_TYPE( int );
+	
+	__m256i pixels[16];
+	
+	alphaMin = 255;
+	alphaMax = 0;
+	
+	// get alpha min / max
+	for( i = 0; i < 16; i++ )
+	{
+		alphaMin = Min( alphaMin, colorBlock[i * 4 + alphaOffset] );
+		alphaMax = Max( alphaMax, colorBlock[i * 4 + alphaOffset] );
+		pixels[i] = _mm256_set1_epi32( colorBlock[i * 4 + alphaOffset] );
+	}
+	
+	const int ALPHA_EXPAND = 32;
+	
+	alphaMin = ( alphaMin <= ALPHA_EXPAND ) ? 0 : alphaMin - ALPHA_EXPAND;
+	alphaMax = ( alphaMax >= 255 - ALPHA_EXPAND ) ? 255 : alphaMax + ALPHA_EXPAND;
+	
+	int bestMin = minColor[alphaOffset];
+	int bestMax = maxColor[alphaOffset];
+	
+	hqCandidates_t candidates;
+	int errors[HQ_CANDIDATES];
+	
+	for( i = alphaMin; i <= alphaMax; i++ )
+	{
+		for( j = alphaMax; j >= i; j-- )
+		{
+			// the first palette entry is the max alpha passed to GetSquareAlphaError
+			if( candidates.Add( j, i, i, j ) )
+			{
+				AlphaError_AVX2( pixels, candidates, bestError, errors );
+				candidates.Select( errors, bestError, bestMin, bestMax );
+			}
+			if( candidates.Add( i, j, i, j ) )
+			{
+				AlphaError_AVX2( pixels, candidates, bestError, errors );
+				candidates.Select( errors, bestError, bestMin, bestMax );
+			}
+		}
+	}
+	
+	if( candidates.num > 0 )
+	{
+		candidates.Pad();
+		AlphaError_AVX2( pixels, candidates, bestError, errors );
+		candidates.Select( errors, bestError, bestMin, bestMax );
+	}
+	
+	minColor[alphaOffset] = ( byte )bestMin;
+	maxColor[alphaOffset] = ( byte )bestMax;
+	
+	return bestError;
+}
+
+/*
+========================
+NormalYError_AVX2
+
+GetSquareNormalYError for eight candidates.
+========================
+*/
+AVX2_FUNCTION static void NormalYError_AVX2( const __m256 pixels[16], const float scale, const hqCandidates_t& candidates, const int bestError, int* errors )
+{
+	const __m256i color0 = _mm256_loadu_si256( ( const __m256i* )candidates.endPoint0 );
+	const __m256i color1 = _mm256_loadu_si256( ( const __m256i* )candidates.endPoint1 );
+	const __m256i fourColors = _mm256_cmpgt_epi32( color0, color1 );
+	
+	__m256i green[4];
+	green[0] = Green565_AVX2( color0 );
+	green[1] = Green565_AVX2( color1 );
+	ColorPalette_AVX2( fourColors, green[0], green[1], green[2], green[3] );
+	
+	const __m256 s = _mm256_set1_ps( scale );
+	__m256 palette[4];
+	for( int j = 0; j < 4; j++ )
+	{
+		palette[j] = _mm256_div_ps( _mm256_cvtepi32_ps( green[j] ), s );
+	}
+	
+	const __m256i best = _mm256_set1_epi32( bestError );
+	__m256i error = _mm256_setzero_si256();
+	for( int i = 0; i < 16; i++ )
+	{
+		__m256i minDist = _mm256_set1_epi32( -1 );
+		for( int j = 0; j < 4; j++ )
+		{
+			const __m256 d = _mm256_sub_ps( pixels[i], palette[j] );
+			minDist = _mm256_min_epu32( minDist, _mm256_cvttps_epi32( _mm256_mul_ps( d, d ) ) );
+		}
+		error = _mm256_add_epi32( error, minDist );
+		
+		if( ( i & 3 ) == 3 && AllWorse_AVX2( error, best ) )
+		{
+			break;
+		}
+	}
+	_mm256_storeu_si256( ( __m256i* )errors, error );
+}
+
+/*
+========================
+idDxtEncoder::GetMinMaxNormalYHQ_AVX2
+========================
+*/
+AVX2_FUNCTION int idDxtEncoder::GetMinMaxNormalYHQ_AVX2( const byte* colorBlock, byte* minColor, byte* maxColor, bool noBlack, int scale ) const
+{
+	byte bboxMin[3], bboxMax[3];
+	int bestError = MAX_TYPE( int );
+	
+	__m256 pixels[16];
+	
+	bboxMin[1] = 255;
+	bboxMax[1] = 0;
+	
+	// get color bbox
+	for( int i = 0; i < 16; i++ )
+	{
+		bboxMin[1] = Min( bboxMin[1], colorBlock[i * 4 + 1] );
+		bboxMax[1] = Max( bboxMax[1], colorBlock[i * 4 + 1] );
+		pixels[i] = _mm256_set1_ps( ( float ) colorBlock[i * 4 + 1] / scale );
+	}
+	
+	// decrease range for 565 encoding
+	bboxMin[1] >>= 2;
+	bboxMax[1] >>= 2;
+	
+	// expand the bounding box
+	const int C565_BBOX_EXPAND = 1;
+	
+	bboxMin[1] = ( bboxMin[1] <= C565_BBOX_EXPAND ) ? 0 : bboxMin[1] - C565_BBOX_EXPAND;
+	bboxMax[1] = ( bboxMax[1] >= ( 255 >> 2 ) - C565_BBOX_EXPAND ) ? ( 255 >> 2 ) : bboxMax[1] + C565_BBOX_EXPAND;
+	
+	int bestMinColor565 = 0;
+	int bestMaxColor565 = 0;
+	
+	hqCandidates_t candidates;
+	int errors[HQ_CANDIDATES];
+	
+	for( int i1 = bboxMin[1]; i1 <= bboxMax[1]; i1++ )
+	{
+		for( int j1 = bboxMax[1]; j1 >= bboxMin[1]; j1-- )
+		{
+			int minColor565 = i1 << 5;
+			int maxColor565 = j1 << 5;
+			
+			if( !noBlack )
+			{
+				if( candidates.Add( maxColor565, minColor565, minColor565, maxColor565 ) )
+				{
+					NormalYError_AVX2( pixels, ( float )scale, candidates, bestError, errors );
+					candidates.Select( errors, bestError, bestMinColor565, bestMaxColor565 );
+				}
+			}
+			else
+			{
+				if( minColor565 <= maxColor565 )
+				{
+					SwapValues( minColor565, maxColor565 );
+				}
+			}
+			
+			if( candidates.Add( minColor565, maxColor565, minColor565, maxColor565 ) )
+			{
+				NormalYError_AVX2( pixels, ( float )scale, candidates, bestError, errors );
+				candidates.Select( errors, bestError, bestMinColor565, bestMaxColor565 );
+			}
+		}
+	}
+	
+	if( candidates.num > 0 )
+	{
+		candidates.Pad();
+		NormalYError_AVX2( pixels, ( float )scale, candidates, bestError, errors );
+		candidates.Select( errors, bestError, bestMinColor565, bestMaxColor565 );
+	}
+	
+	ColorFrom565( ( unsigned short )bestMinColor565, minColor );
+	ColorFrom565( ( unsigned short )bestMaxColor565, maxColor );
+	
+	int bias = colorBlock[0 * 4 + 0];
+	int size = colorBlock[0 * 4 + 2];
+	
+	minColor[0] = maxColor[0] = ( byte )bias;
+	minColor[2] = maxColor[2] = ( byte )size;
+	
+	return bestError;
+}
+
+#endif // #if defined(USE_INTRINSICS)
@@ -336,6 +336,9 @@ public:
 	void				StartBuild();
 	void				FinishBuild( bool removeDups = false );
 	
+	// generates the binary images of all materials, skipping the ones that are up to date
+	void				BuildGeneratedImages( bool force );
+	
 	void				PrintMemInfo( MemInfo_t* mi );
 	
 	// built-in images
@@ -39,6 +39,8 @@ idImageManager* globalImages = &imageManager;
 
 idCVar preLoad_Images( "preLoad_Images", "1", CVAR_SYSTEM | CVAR_BOOL, "preload images during beginlevelload" );
 
+extern idCVar image_highQualityCompression;
+
 /*
 ===============
 R_ReloadImages_f
@@ -742,6 +744,350 @@ void R_CombineCubeImages_f( const idCmdArgs& args )
 	common->SetRefreshOnPrint( false );
 }
 
+/*
+===============
+R_BuildImages_f
+
+buildImages <force>
+===============
+*/
+void R_BuildImages_f( const idCmdArgs& args )
+{
+	bool force = false;
+	
+	if( args.Argc() == 2 )
+	{
+		if( !idStr::Icmp( args.Argv( 1 ), "force" ) )
+		{
+			force = true;
+		}
+		else
+		{
+			common->Printf( "USAGE: buildImages <force>\n" );
+			return;
+		}
+	}
+	
+	globalImages->BuildGeneratedImages( force );
+}
+
+/*
+================================================================================================
+
+	buildImages
+
+	Generates the bimage of every image referenced by a material without needing a
+	rendering context. Sources are read on the main thread in batches, small images
+	are then compressed one per job and large images are split into block rows that
+	are encoded in parallel. A manifest next to the generated images remembers the
+	source time stamp and the options each bimage was built with.
+
+================================================================================================
+*/
+
+static const char*	IMAGE_BUILD_MANIFEST = "generated/images/_buildImages.dict";
+static const int	IMAGE_BUILD_BATCH_BYTES = 256 * 1024 * 1024;
+static const int	IMAGE_BUILD_PARALLEL_ENCODE_PIXELS = 512 * 512;
+
+struct imageBuildJob_t
+{
+	idBinaryImage*	binaryImage;
+	byte*			pics[6];			// 2D images only use the first one
+	int				width;
+	int				height;
+	int				numLevels;
+	textureFormat_t	format;
+	textureColor_t	colorFormat;
+	bool			cube;
+	bool			gammaMips;
+	ID_TIME_T		sourceFileTime;
+	idStr			stamp;				// manifest entry for the generated file
+	int				sourceBytes;
+};
+
+/*
+========================
+R_BuildImageJob
+========================
+*/
+static void R_BuildImageJob( imageBuildJob_t* job )
+{
+	if( job->cube )
+	{
+		job->binaryImage->LoadCubeFromMemory( job->width, ( const byte** )job->pics, job->numLevels, job->format, job->gammaMips );
+	}
+	else
+	{
+		job->binaryImage->Load2DFromMemory( job->width, job->height, job->pics[0], job->numLevels, job->format, job->colorFormat, job->gammaMips );
+	}
+}
+
+REGISTER_PARALLEL_JOB( R_BuildImageJob, "R_BuildImageJob" );
+
+/*
+========================
+R_ImageBuildStamp
+
+Everything besides the source pixels that changes the contents of a bimage.
+========================
+*/
+static idStr R_ImageBuildStamp( const idImageOpts& opts, textureFilter_t filter, ID_TIME_T sourceFileTime )
+{
+	const int parms[] =
+	{
+		BIMAGE_VERSION,
+		opts.textureType,
+		opts.format,
+		opts.colorFormat,
+		opts.gammaMips,
+		( filter == TF_LINEAR || filter == TF_NEAREST ),
+		image_highQualityCompression.GetBool()
+	};
+	return va( "%lld %08x", ( long long )sourceFileTime, MD5_BlockChecksum( parms, sizeof( parms ) ) );
+}
+
+/*
+========================
+R_BuildImageBatch
+========================
+*/
+static void R_BuildImageBatch( idList< imageBuildJob_t* >& batch, idDict& manifest )
+{
+	idList< imageBuildJob_t* > largeImages;
+	idParallelJobList* jobList = NULL;
+	
+	for( int i = 0; i < batch.Num(); i++ )
+	{
+		imageBuildJob_t* job = batch[i];
+		if( job->width * job->height >= IMAGE_BUILD_PARALLEL_ENCODE_PIXELS )
+		{
+			largeImages.Append( job );
+			continue;
+		}
+		if( jobList == NULL )
+		{
+			jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, batch.Num(), 0, NULL );
+		}
+		jobList->AddJob( ( jobRun_t )R_BuildImageJob, job );
+	}
+	
+	if( jobList != NULL )
+	{
+		jobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+	}
+	
+	// large images keep the job threads busy on their own
+	for( int i = 0; i < largeImages.Num(); i++ )
+	{
+		largeImages[i]->binaryImage->SetParallelEncode( true );
+		R_BuildImageJob( largeImages[i] );
+	}
+	
+	if( jobList != NULL )
+	{
+		jobList->Wait();
+		parallelJobManager->FreeJobList( jobList );
+	}
+	
+	// the file system is only used from the main thread
+	for( int i = 0; i < batch.Num(); i++ )
+	{
+		imageBuildJob_t* job = batch[i];
+		if( job->binaryImage->WriteGeneratedFile( job->sourceFileTime ) != FILE_NOT_FOUND_TIMESTAMP )
+		{
+			idStr binaryFileName;
+			idBinaryImage::GetGeneratedFileName( binaryFileName, job->binaryImage->GetName() );
+			manifest.Set( binaryFileName, job->stamp );
+		}
+		for( int side = 0; side < 6; side++ )
+		{
+			if( job->pics[side] != NULL )
+			{
+				Mem_Free( job->pics[side] );
+			}
+		}
+		delete job->binaryImage;
+		delete job;
+	}
+	batch.Clear();
+}
+
+/*
+===============
+idImageManager::BuildGeneratedImages
+===============
+*/
+void idImageManager::BuildGeneratedImages( bool force )
+{
+	if( fileSystem->InProductionMode() )
+	{
+		common->Warning( "buildImages: not available in production mode" );
+		return;
+	}
+	
+	int start = Sys_Milliseconds();
+	
+	// register the images of every material without loading them
+	idList< bool > referenced;
+	referenced.SetNum( images.Num() );
+	for( int i = 0; i < images.Num(); i++ )
+	{
+		referenced[i] = images[i]->levelLoadReferenced;
+	}
+	const int numOldImages = images.Num();
+	const bool oldInsideLevelLoad = insideLevelLoad;
+	const bool oldPreloadingMapImages = preloadingMapImages;
+	insideLevelLoad = true;
+	preloadingMapImages = false;
+	
+	for( int i = 0; i < declManager->GetNumDecls( DECL_MATERIAL ); i++ )
+	{
+		declManager->DeclByIndex( DECL_MATERIAL, i, true );
+	}
+	
+	insideLevelLoad = oldInsideLevelLoad;
+	preloadingMapImages = oldPreloadingMapImages;
+	for( int i = 0; i < images.Num(); i++ )
+	{
+		images[i]->levelLoadReferenced = ( i < numOldImages ) ? referenced[i] : false;
+	}
+	
+	idDict manifest;
+	{
+		idFileLocal file( fileSystem->OpenFileRead( IMAGE_BUILD_MANIFEST ) );
+		if( file != NULL )
+		{
+			manifest.ReadFromFileHandle( file );
+		}
+	}
+	
+	int numBuilt = 0;
+	int numUpToDate = 0;
+	int numFailed = 0;
+	int64 sourceBytes = 0;
+	int batchBytes = 0;
+	idList< imageBuildJob_t* > batch;
+	
+	for( int i = 0; i < images.Num(); i++ )
+	{
+		const idImage* image = images[i];
+		if( image->generatorFunction != NULL || image->cubeFiles == CF_2D_ARRAY )
+		{
+			continue;
+		}
+		
+		// derive the options on a copy so images that are already loaded are left alone
+		idImage derived( image->GetName() );
+		derived.cubeFiles = image->cubeFiles;
+		derived.usage = image->usage;
+		derived.filter = image->filter;
+		derived.repeat = image->repeat;
+		
+		ID_TIME_T sourceFileTime = FILE_NOT_FOUND_TIMESTAMP;
+		if( derived.cubeFiles != CF_2D )
+		{
+			derived.opts.textureType = TT_CUBIC;
+			R_LoadCubeImages( derived.GetName(), derived.cubeFiles, NULL, NULL, &sourceFileTime );
+		}
+		else
+		{
+			derived.opts.textureType = TT_2D;
+			R_LoadImageProgram( derived.GetName(), NULL, NULL, NULL, &sourceFileTime, &derived.usage );
+		}
+		if( sourceFileTime == FILE_NOT_FOUND_TIMESTAMP )
+		{
+			// only shipped as a generated image
+			continue;
+		}
+		derived.DeriveOpts();
+		
+		idStr generatedName = derived.GetName();
+		idImage::GetGeneratedName( generatedName, derived.usage, derived.cubeFiles );
+		idStr binaryFileName;
+		idBinaryImage::GetGeneratedFileName( binaryFileName, generatedName );
+		
+		idStr stamp = R_ImageBuildStamp( derived.opts, derived.filter, sourceFileTime );
+		if( !force && stamp == manifest.GetString( binaryFileName ) && fileSystem->ReadFile( binaryFileName, NULL, NULL ) > 0 )
+		{
+			numUpToDate++;
+			continue;
+		}
+		
+		imageBuildJob_t* job = new( TAG_IMAGE ) imageBuildJob_t;
+		memset( job->pics, 0, sizeof( job->pics ) );
+		
+		if( derived.cubeFiles != CF_2D )
+		{
+			int size = 0;
+			if( !R_LoadCubeImages( derived.GetName(), derived.cubeFiles, job->pics, &size, &sourceFileTime ) || size == 0 )
+			{
+				idLib::Warning( "Couldn't load cube image: %s", derived.GetName() );
+				numFailed++;
+				delete job;
+				continue;
+			}
+			job->width = job->height = size;
+			job->sourceBytes = size * size * 4 * 6;
+		}
+		else
+		{
+			R_LoadImageProgram( derived.GetName(), &job->pics[0], &job->width, &job->height, &sourceFileTime, &derived.usage );
+			if( job->pics[0] == NULL )
+			{
+				idLib::Warning( "Couldn't load image: %s : %s", derived.GetName(), generatedName.c_str() );
+				numFailed++;
+				delete job;
+				continue;
+			}
+			job->sourceBytes = job->width * job->height * 4;
+		}
+		
+		derived.opts.width = job->width;
+		derived.opts.height = job->height;
+		derived.opts.numLevels = 0;
+		derived.DeriveOpts();
+		
+		job->binaryImage = new( TAG_IMAGE ) idBinaryImage( generatedName );
+		job->numLevels = derived.opts.numLevels;
+		job->format = derived.opts.format;
+		job->colorFormat = derived.opts.colorFormat;
+		job->cube = ( derived.cubeFiles != CF_2D );
+		job->gammaMips = derived.opts.gammaMips;
+		job->sourceFileTime = sourceFileTime;
+		job->stamp = stamp;
+		
+		batch.Append( job );
+		batchBytes += job->sourceBytes;
+		sourceBytes += job->sourceBytes;
+		numBuilt++;
+		
+		if( batchBytes >= IMAGE_BUILD_BATCH_BYTES )
+		{
+			R_BuildImageBatch( batch, manifest );
+			batchBytes = 0;
+		}
+	}
+	R_BuildImageBatch( batch, manifest );
+	
+	if( numBuilt > 0 )
+	{
+		idFileLocal file( fileSystem->OpenFileWrite( IMAGE_BUILD_MANIFEST, "fs_basepath" ) );
+		if( file == NULL )
+		{
+			idLib::Warning( "buildImages: could not write '%s'", IMAGE_BUILD_MANIFEST );
+		}
+		else
+		{
+			manifest.WriteToFileHandle( file );
+		}
+	}
+	
+	const float seconds = Max( Sys_Milliseconds() - start, 1 ) * 0.001f;
+	const float megs = sourceBytes / ( 1024.0f * 1024.0f );
+	common->Printf( "%5i images built, %i up to date, %i failed\n", numBuilt, numUpToDate, numFailed );
+	common->Printf( "%5.1f MB of source images in %5.1f seconds, %5.1f MB/s\n", megs, seconds, megs / seconds );
+}
+
 /*
 ===============
 UnbindAll
@@ -785,6 +1131,7 @@ void idImageManager::Init()
 	cmdSystem->AddCommand( "reloadImages", R_ReloadImages_f, CMD_FL_RENDERER, "reloads images" );
 	cmdSystem->AddCommand( "listImages", R_ListImages_f, CMD_FL_RENDERER, "lists images" );
 	cmdSystem->AddCommand( "combineCubeImages", R_CombineCubeImages_f, CMD_FL_RENDERER, "combines six images for roq compression" );
+	cmdSystem->AddCommand( "buildImages", R_BuildImages_f, CMD_FL_RENDERER, "generates the bimage files of all material images in parallel" );
 	
 	// should forceLoadImages be here?
 }
@@ -752,31 +752,40 @@ Called by idRenderWorldLocal::GenerateAllInteractions
 */
 void idInteraction::CreateStaticInteraction()
 {
-	// note that it is a static interaction
-	staticInteraction = true;
-	const idRenderModel* model = entityDef->parms.hModel;
+	staticInteractionTris_t tris;
+	CreateStaticInteractionTris( entityDef, lightDef, tris );
+	SetStaticInteractionTris( tris );
+}
+
+/*
+======================
+idInteraction::CreateStaticInteractionTris
+
+Only reads the entity and light, so this is safe to call from the job threads.
+======================
+*/
+void idInteraction::CreateStaticInteractionTris( const idRenderEntityLocal* edef, const idRenderLightLocal* ldef, staticInteractionTris_t& tris )
+{
+	tris.numSurfaces = 0;
+	tris.surfaces.Clear();
+	
+	const idRenderModel* model = edef->parms.hModel;
 	if( model == NULL || model->NumSurfaces() <= 0 || model->IsDynamicModel() != DM_STATIC )
 	{
-		MakeEmpty();
 		return;
 	}
 	
-	const idBounds bounds = model->Bounds( &entityDef->parms );
+	const idBounds bounds = model->Bounds( &edef->parms );
 	
 	// if it doesn't contact the light frustum, none of the surfaces will
-	if( R_CullModelBoundsToLight( lightDef, bounds, entityDef->modelRenderMatrix ) )
+	if( R_CullModelBoundsToLight( ldef, bounds, edef->modelRenderMatrix ) )
 	{
-		MakeEmpty();
 		return;
 	}
 	
-	//
-	// create slots for each of the model's surfaces
-	//
-	numSurfaces = model->NumSurfaces();
-	surfaces = ( surfaceInteraction_t* )R_ClearedStaticAlloc( sizeof( *surfaces ) * numSurfaces );
+	tris.numSurfaces = model->NumSurfaces();
 	
-	bool interactionGenerated = false;
+	const bool hasShadows = !edef->parms.noShadow && ldef->LightCastsShadows();
 	
 	// check each surface in the model
 	for( int c = 0 ; c < model->NumSurfaces() ; c++ )
@@ -792,76 +801,458 @@ void idInteraction::CreateStaticInteraction()
 		// Note that this will be wrong if customSkin/customShader are
 		// changed after map load time without invalidating the interaction!
 		const idMaterial* const shader = R_RemapShaderBySkin( surf->shader,
-										 entityDef->parms.customSkin, entityDef->parms.customShader );
+										 edef->parms.customSkin, edef->parms.customShader );
 		if( shader == NULL )
 		{
 			continue;
 		}
 		
 		// try to cull each surface
-		if( R_CullModelBoundsToLight( lightDef, tri->bounds, entityDef->modelRenderMatrix ) )
+		if( R_CullModelBoundsToLight( ldef, tri->bounds, edef->modelRenderMatrix ) )
 		{
 			continue;
 		}
 		
-		surfaceInteraction_t* sint = &surfaces[c];
+		staticSurfaceTris_t sTris = {};
+		sTris.surfaceNum = c;
 		
 		// generate a set of indexes for the lit surfaces, culling away triangles that are
 		// not at least partially inside the light
 		if( shader->ReceivesLighting() )
 		{
-			srfTriangles_t* lightTris = R_CreateInteractionLightTris( entityDef, tri, lightDef, shader );
+			srfTriangles_t* lightTris = R_CreateInteractionLightTris( edef, tri, ldef, shader );
 			if( lightTris != NULL )
 			{
-				// make a static index cache
-				sint->numLightTrisIndexes = lightTris->numIndexes;
-				sint->lightTrisIndexCache = vertexCache.AllocStaticIndex( lightTris->indexes, ALIGN( lightTris->numIndexes * sizeof( lightTris->indexes[0] ), INDEX_CACHE_ALIGN ) );
-				
-				interactionGenerated = true;
-				R_FreeStaticTriSurf( lightTris );
+				sTris.lightTris = lightTris;
+				sTris.numLightIndexes = lightTris->numIndexes;
+				sTris.lightIndexes = lightTris->indexes;
 			}
 		}
 		
 		// if the interaction has shadows and this surface casts a shadow
-		if( HasShadows() && shader->SurfaceCastsShadow() && tri->silEdges != NULL )
+		if( hasShadows && shader->SurfaceCastsShadow() && tri->silEdges != NULL )
 		{
 		
 			// if the light has an optimized shadow volume, don't create shadows for any models that are part of the base areas
-			if( lightDef->parms.prelightModel == NULL || !model->IsStaticWorldModel() || r_skipPrelightShadows.GetBool() )
+			if( ldef->parms.prelightModel == NULL || !model->IsStaticWorldModel() || r_skipPrelightShadows.GetBool() )
 			{
-				srfTriangles_t* shadowTris = R_CreateInteractionShadowVolume( entityDef, tri, lightDef );
+				srfTriangles_t* shadowTris = R_CreateInteractionShadowVolume( edef, tri, ldef );
 				if( shadowTris != NULL )
 				{
-					// make a static index cache
-					sint->shadowIndexCache = vertexCache.AllocStaticIndex( shadowTris->indexes, ALIGN( shadowTris->numIndexes * sizeof( shadowTris->indexes[0] ), INDEX_CACHE_ALIGN ) );
-					sint->numShadowIndexes = shadowTris->numIndexes;
-#if defined( KEEP_INTERACTION_CPU_DATA )
-					sint->shadowIndexes = shadowTris->indexes;
-					shadowTris->indexes = NULL;
-#endif
+					sTris.shadowTris = shadowTris;
+					sTris.numShadowIndexes = shadowTris->numIndexes;
+					sTris.shadowIndexes = shadowTris->indexes;
 					if( shader->Coverage() != MC_OPAQUE )
 					{
 						// if any surface is a shadow-casting perforated or translucent surface, or the
 						// base surface is suppressed in the view (world weapon shadows) we can't use
 						// the external shadow optimizations because we can see through some of the faces
-						sint->numShadowIndexesNoCaps = shadowTris->numIndexes;
+						sTris.numShadowIndexesNoCaps = shadowTris->numIndexes;
 					}
 					else
 					{
-						sint->numShadowIndexesNoCaps = shadowTris->numShadowIndexesNoCaps;
+						sTris.numShadowIndexesNoCaps = shadowTris->numShadowIndexesNoCaps;
 					}
-					R_FreeStaticTriSurf( shadowTris );
 				}
-				interactionGenerated = true;
+				sTris.castsShadow = true;
+			}
+		}
+		
+		if( sTris.lightIndexes != NULL || sTris.castsShadow )
+		{
+			tris.surfaces.Append( sTris );
+		}
+	}
+}
+
+/*
+======================
+idInteraction::SetStaticInteractionTris
+
+Moves the tris into the static index cache and frees them.
+======================
+*/
+void idInteraction::SetStaticInteractionTris( staticInteractionTris_t& tris )
+{
+	// note that it is a static interaction
+	staticInteraction = true;
+	
+	if( tris.numSurfaces == 0 )
+	{
+		MakeEmpty();
+		return;
+	}
+	
+	//
+	// create slots for each of the model's surfaces
+	//
+	numSurfaces = tris.numSurfaces;
+	surfaces = ( surfaceInteraction_t* )R_ClearedStaticAlloc( sizeof( *surfaces ) * numSurfaces );
+	
+	for( int i = 0; i < tris.surfaces.Num(); i++ )
+	{
+		staticSurfaceTris_t& sTris = tris.surfaces[i];
+		surfaceInteraction_t* sint = &surfaces[sTris.surfaceNum];
+		
+		if( sTris.lightIndexes != NULL )
+		{
+			// make a static index cache
+			sint->numLightTrisIndexes = sTris.numLightIndexes;
+			sint->lightTrisIndexCache = vertexCache.AllocStaticIndex( sTris.lightIndexes, ALIGN( sTris.numLightIndexes * sizeof( triIndex_t ), INDEX_CACHE_ALIGN ) );
+		}
+		
+		if( sTris.shadowIndexes != NULL )
+		{
+			// make a static index cache
+			sint->shadowIndexCache = vertexCache.AllocStaticIndex( sTris.shadowIndexes, ALIGN( sTris.numShadowIndexes * sizeof( triIndex_t ), INDEX_CACHE_ALIGN ) );
+			sint->numShadowIndexes = sTris.numShadowIndexes;
+			sint->numShadowIndexesNoCaps = sTris.numShadowIndexesNoCaps;
+#if defined( KEEP_INTERACTION_CPU_DATA )
+			if( sTris.shadowTris != NULL )
+			{
+				sint->shadowIndexes = sTris.shadowTris->indexes;
+				sTris.shadowTris->indexes = NULL;
 			}
+			else
+			{
+				// the indexes are in the static interaction cache
+				sint->shadowIndexes = ( triIndex_t* )Mem_Alloc16( ALIGN( sTris.numShadowIndexes * sizeof( triIndex_t ), INDEX_CACHE_ALIGN ), TAG_TRI_INDEXES );
+				memcpy( sint->shadowIndexes, sTris.shadowIndexes, sTris.numShadowIndexes * sizeof( triIndex_t ) );
+			}
+#endif
 		}
+		
+		R_FreeStaticTriSurf( sTris.lightTris );
+		R_FreeStaticTriSurf( sTris.shadowTris );
 	}
 	
 	// if none of the surfaces generated anything, don't even bother checking?
-	if( !interactionGenerated )
+	if( tris.surfaces.Num() == 0 )
 	{
 		MakeEmpty();
 	}
+	
+	tris.surfaces.Clear();
+}
+
+/*
+===========================================================================
+
+idStaticInteractionCache
+
+===========================================================================
+*/
+
+static const int STATIC_INTERACTION_CACHE_IDENT		= ( ( 'I' << 24 ) | ( 'N' << 16 ) | ( 'I' << 8 ) | 'B' );
+static const int STATIC_INTERACTION_CACHE_VERSION	= 1;
+
+// index runs are padded so the aligned static index cache copies stay inside the file
+static const int STATIC_INTERACTION_CACHE_INDEX_ALIGN	= INDEX_CACHE_ALIGN / sizeof( triIndex_t );
+
+struct staticInteractionCacheHeader_t
+{
+	int						ident;
+	int						version;
+	unsigned int			mapCRC;
+	unsigned int			settings;
+	int						numPairs;
+	int						numSurfaces;
+	int						numIndexes;
+	int						pad;
+};
+
+/*
+======================
+idStaticInteractionCache::idStaticInteractionCache
+======================
+*/
+idStaticInteractionCache::idStaticInteractionCache()
+{
+	data = NULL;
+	dataLength = 0;
+	dataMapped = false;
+	numPairs = 0;
+	numSurfaces = 0;
+	numIndexes = 0;
+	pairs = NULL;
+	surfaces = NULL;
+	indexes = NULL;
+	
+	writePairs.SetGranularity( 1024 );
+	writeSurfaces.SetGranularity( 1024 );
+}
+
+/*
+======================
+idStaticInteractionCache::~idStaticInteractionCache
+======================
+*/
+idStaticInteractionCache::~idStaticInteractionCache()
+{
+	Free();
+}
+
+/*
+======================
+idStaticInteractionCache::Free
+======================
+*/
+void idStaticInteractionCache::Free()
+{
+	if( dataMapped )
+	{
+		Sys_UnmapFile( data, dataLength );
+	}
+	else
+	{
+		Mem_Free( data );
+	}
+	data = NULL;
+	dataLength = 0;
+	dataMapped = false;
+	numPairs = 0;
+	numSurfaces = 0;
+	numIndexes = 0;
+	pairs = NULL;
+	surfaces = NULL;
+	indexes = NULL;
+	pairHash.Clear();
+	
+	writePairs.Clear();
+	writeSurfaces.Clear();
+	writeIndexes.Clear();
+}
+
+/*
+======================
+idStaticInteractionCache::Load
+======================
+*/
+bool idStaticInteractionCache::Load( const char* fileName, unsigned int mapCRC, unsigned int settings )
+{
+	int mappedLength;
+	
+	Free();
+	
+	idFile* f = fileSystem->OpenFileRead( fileName );
+	if( f == NULL )
+	{
+		return false;
+	}
+	
+	// map the file when it is a plain file on disk, otherwise read it
+	dataLength = f->Length();
+	data = ( byte* )Sys_MapFile( f->GetFullPath(), mappedLength );
+	if( data != NULL && mappedLength == dataLength )
+	{
+		dataMapped = true;
+	}
+	else
+	{
+		Sys_UnmapFile( data, mappedLength );
+		data = ( byte* )Mem_Alloc( dataLength, TAG_RENDER_INTERACTION );
+		if( f->Read( data, dataLength ) != dataLength )
+		{
+			common->Warning( "couldn't read static interaction cache '%s'", fileName );
+			delete f;
+			Free();
+			return false;
+		}
+	}
+	delete f;
+	
+	const staticInteractionCacheHeader_t* header = ( const staticInteractionCacheHeader_t* )data;
+	if( dataLength < ( int )sizeof( staticInteractionCacheHeader_t ) ||
+			header->ident != STATIC_INTERACTION_CACHE_IDENT || header->version != STATIC_INTERACTION_CACHE_VERSION )
+	{
+		common->Warning( "static interaction cache '%s' has the wrong version", fileName );
+		Free();
+		return false;
+	}
+	if( header->mapCRC != mapCRC || header->settings != settings )
+	{
+		// the map or the light settings changed, the interactions will be created again
+		Free();
+		return false;
+	}
+	
+	const int pairsOffset = sizeof( staticInteractionCacheHeader_t );
+	const int surfacesOffset = pairsOffset + header->numPairs * sizeof( staticInteractionCachePair_t );
+	const int indexesOffset = ALIGN( surfacesOffset + header->numSurfaces * sizeof( staticInteractionCacheSurface_t ), INDEX_CACHE_ALIGN );
+	if( header->numPairs < 0 || header->numPairs > dataLength / ( int )sizeof( staticInteractionCachePair_t ) ||
+			header->numSurfaces < 0 || header->numSurfaces > dataLength / ( int )sizeof( staticInteractionCacheSurface_t ) ||
+			header->numIndexes < 0 || header->numIndexes > dataLength / ( int )sizeof( triIndex_t ) ||
+			indexesOffset + header->numIndexes * ( int )sizeof( triIndex_t ) != dataLength )
+	{
+		common->Warning( "static interaction cache '%s' is truncated", fileName );
+		Free();
+		return false;
+	}
+	
+	numPairs = header->numPairs;
+	numSurfaces = header->numSurfaces;
+	numIndexes = header->numIndexes;
+	pairs = ( const staticInteractionCachePair_t* )( data + pairsOffset );
+	surfaces = ( const staticInteractionCacheSurface_t* )( data + surfacesOffset );
+	indexes = ( const triIndex_t* )( data + indexesOffset );
+	
+	pairHash.Clear( 4096, numPairs );
+	for( int i = 0; i < numPairs; i++ )
+	{
+		pairHash.Add( pairHash.GenerateKey( pairs[i].lightIndex, pairs[i].entityIndex ), i );
+	}
+	
+	return true;
+}
+
+/*
+======================
+idStaticInteractionCache::Find
+======================
+*/
+bool idStaticInteractionCache::Find( int lightIndex, int entityIndex, unsigned int key, staticInteractionTris_t& tris ) const
+{
+	tris.numSurfaces = 0;
+	tris.surfaces.Clear();
+	
+	for( int i = pairHash.First( pairHash.GenerateKey( lightIndex, entityIndex ) ); i != -1; i = pairHash.Next( i ) )
+	{
+		const staticInteractionCachePair_t& pair = pairs[i];
+		if( pair.lightIndex != lightIndex || pair.entityIndex != entityIndex )
+		{
+			continue;
+		}
+		if( pair.key != key || pair.firstSurface < 0 || pair.numCachedSurfaces < 0 || pair.firstSurface + pair.numCachedSurfaces > numSurfaces )
+		{
+			return false;
+		}
+		
+		tris.surfaces.SetNum( pair.numCachedSurfaces );
+		for( int j = 0; j < pair.numCachedSurfaces; j++ )
+		{
+			const staticInteractionCacheSurface_t& cached = surfaces[pair.firstSurface + j];
+			if( cached.surfaceNum < 0 || cached.surfaceNum >= pair.numSurfaces ||
+					cached.numLightIndexes < 0 || cached.firstLightIndex < 0 || cached.firstLightIndex + ALIGN( cached.numLightIndexes, STATIC_INTERACTION_CACHE_INDEX_ALIGN ) > numIndexes ||
+					cached.firstShadowIndex < 0 || cached.firstShadowIndex + ALIGN( cached.numShadowIndexes, STATIC_INTERACTION_CACHE_INDEX_ALIGN ) > numIndexes ||
+					cached.numShadowIndexesNoCaps < 0 || cached.numShadowIndexesNoCaps > cached.numShadowIndexes )
+			{
+				tris.surfaces.Clear();
+				return false;
+			}
+			
+			staticSurfaceTris_t& sTris = tris.surfaces[j];
+			memset( &sTris, 0, sizeof( sTris ) );
+			sTris.surfaceNum = cached.surfaceNum;
+			sTris.castsShadow = ( cached.castsShadow != 0 );
+			if( cached.numLightIndexes > 0 )
+			{
+				sTris.numLightIndexes = cached.numLightIndexes;
+				sTris.lightIndexes = indexes + cached.firstLightIndex;
+			}
+			if( cached.numShadowIndexes > 0 )
+			{
+				sTris.numShadowIndexes = cached.numShadowIndexes;
+				sTris.numShadowIndexesNoCaps = cached.numShadowIndexesNoCaps;
+				sTris.shadowIndexes = indexes + cached.firstShadowIndex;
+			}
+		}
+		tris.numSurfaces = pair.numSurfaces;
+		return true;
+	}
+	return false;
+}
+
+/*
+======================
+idStaticInteractionCache::AddIndexes
+======================
+*/
+int idStaticInteractionCache::AddIndexes( const triIndex_t* src, int num )
+{
+	const int first = writeIndexes.Num();
+	const int padded = ALIGN( num, STATIC_INTERACTION_CACHE_INDEX_ALIGN );
+	if( first + padded > writeIndexes.NumAllocated() )
+	{
+		// grow geometrically, the indexes of a big map run into the millions
+		writeIndexes.Resize( Max( first + padded, writeIndexes.NumAllocated() * 2 ) );
+	}
+	writeIndexes.SetNum( first + padded );
+	memcpy( writeIndexes.Ptr() + first, src, num * sizeof( triIndex_t ) );
+	memset( writeIndexes.Ptr() + first + num, 0, ( padded - num ) * sizeof( triIndex_t ) );
+	return first;
+}
+
+/*
+======================
+idStaticInteractionCache::Add
+======================
+*/
+void idStaticInteractionCache::Add( int lightIndex, int entityIndex, unsigned int key, const staticInteractionTris_t& tris )
+{
+	staticInteractionCachePair_t& pair = writePairs.Alloc();
+	pair.lightIndex = lightIndex;
+	pair.entityIndex = entityIndex;
+	pair.key = key;
+	pair.numSurfaces = tris.numSurfaces;
+	pair.firstSurface = writeSurfaces.Num();
+	pair.numCachedSurfaces = tris.surfaces.Num();
+	
+	for( int i = 0; i < tris.surfaces.Num(); i++ )
+	{
+		const staticSurfaceTris_t& sTris = tris.surfaces[i];
+		
+		staticInteractionCacheSurface_t& cached = writeSurfaces.Alloc();
+		memset( &cached, 0, sizeof( cached ) );
+		cached.surfaceNum = sTris.surfaceNum;
+		cached.castsShadow = sTris.castsShadow;
+		if( sTris.lightIndexes != NULL )
+		{
+			cached.numLightIndexes = sTris.numLightIndexes;
+			cached.firstLightIndex = AddIndexes( sTris.lightIndexes, sTris.numLightIndexes );
+		}
+		if( sTris.shadowIndexes != NULL )
+		{
+			cached.numShadowIndexes = sTris.numShadowIndexes;
+			cached.numShadowIndexesNoCaps = sTris.numShadowIndexesNoCaps;
+			cached.firstShadowIndex = AddIndexes( sTris.shadowIndexes, sTris.numShadowIndexes );
+		}
+	}
+}
+
+/*
+======================
+idStaticInteractionCache::Write
+======================
+*/
+bool idStaticInteractionCache::Write( const char* fileName, unsigned int mapCRC, unsigned int settings )
+{
+	idFile* f = fileSystem->OpenFileWrite( fileName, "fs_basepath" );
+	if( f == NULL )
+	{
+		common->Warning( "couldn't open %s for writing", fileName );
+		return false;
+	}
+	
+	staticInteractionCacheHeader_t header;
+	memset( &header, 0, sizeof( header ) );
+	header.ident = STATIC_INTERACTION_CACHE_IDENT;
+	header.version = STATIC_INTERACTION_CACHE_VERSION;
+	header.mapCRC = mapCRC;
+	header.settings = settings;
+	header.numPairs = writePairs.Num();
+	header.numSurfaces = writeSurfaces.Num();
+	header.numIndexes = writeIndexes.Num();
+	f->Write( &header, sizeof( header ) );
+	f->Write( writePairs.Ptr(), writePairs.Num() * sizeof( staticInteractionCachePair_t ) );
+	f->Write( writeSurfaces.Ptr(), writeSurfaces.Num() * sizeof( staticInteractionCacheSurface_t ) );
+	
+	const int length = sizeof( header ) + writePairs.Num() * sizeof( staticInteractionCachePair_t ) + writeSurfaces.Num() * sizeof( staticInteractionCacheSurface_t );
+	const byte pad[INDEX_CACHE_ALIGN] = { 0 };
+	f->Write( pad, ALIGN( length, INDEX_CACHE_ALIGN ) - length );
+	f->Write( writeIndexes.Ptr(), writeIndexes.Num() * sizeof( triIndex_t ) );
+	
+	delete f;
+	return true;
 }
 
 /*
@@ -82,6 +82,112 @@ struct surfaceInteraction_t
 };
 
 
+// The geometry of one surface of a static interaction, before it is put in the
+// static index cache. The indexes either belong to the light and shadow tris that
+// were just created, or point into the static interaction cache.
+struct staticSurfaceTris_t
+{
+	int						surfaceNum;
+	bool					castsShadow;			// counts as generated even without shadow indexes
+	
+	int						numLightIndexes;
+	const triIndex_t* 		lightIndexes;
+	
+	int						numShadowIndexes;
+	int						numShadowIndexesNoCaps;
+	const triIndex_t* 		shadowIndexes;
+	
+	srfTriangles_t* 		lightTris;				// freed once the indexes are in the index cache
+	srfTriangles_t* 		shadowTris;
+};
+
+// Static interaction geometry is created without touching the interaction links,
+// the interaction table or the vertex cache, so GenerateAllInteractions can create
+// the geometry of several lights on the job threads.
+struct staticInteractionTris_t
+{
+	int								numSurfaces;	// 0 if the entity and light don't touch
+	idList<staticSurfaceTris_t>		surfaces;
+};
+
+/*
+===============================================================================
+
+	Static interaction cache
+
+The static interactions of a map are written to generated/<map>.binteractions,
+next to the .bproc file. At the next load the file is memory mapped, and every
+light / entity pair whose key still matches takes its tris from the file instead
+of creating them. The whole file is ignored when the map geometry or the cvars
+that change the interactions are different.
+
+===============================================================================
+*/
+
+struct staticInteractionCachePair_t
+{
+	int						lightIndex;
+	int						entityIndex;
+	unsigned int			key;					// light and entity parameters
+	int						numSurfaces;
+	int						firstSurface;
+	int						numCachedSurfaces;
+};
+
+struct staticInteractionCacheSurface_t
+{
+	int						surfaceNum;
+	int						castsShadow;
+	int						numLightIndexes;
+	int						firstLightIndex;
+	int						numShadowIndexes;
+	int						numShadowIndexesNoCaps;
+	int						firstShadowIndex;
+	int						pad;
+};
+
+class idStaticInteractionCache
+{
+public:
+	idStaticInteractionCache();
+	~idStaticInteractionCache();
+	
+	// the map CRC covers the map geometry, the settings the cvars the interactions depend on
+	bool					Load( const char* fileName, unsigned int mapCRC, unsigned int settings );
+	void					Free();
+	
+	int						NumPairs() const
+	{
+		return numPairs;
+	}
+	
+	// sets the tris to point into the cache if the pair is cached with the same key
+	bool					Find( int lightIndex, int entityIndex, unsigned int key, staticInteractionTris_t& tris ) const;
+	
+	// copies the tris of a pair for the next Write
+	void					Add( int lightIndex, int entityIndex, unsigned int key, const staticInteractionTris_t& tris );
+	bool					Write( const char* fileName, unsigned int mapCRC, unsigned int settings );
+	
+private:
+	byte* 					data;
+	int						dataLength;
+	bool					dataMapped;
+	
+	int						numPairs;
+	int						numSurfaces;
+	int						numIndexes;
+	const staticInteractionCachePair_t* 	pairs;
+	const staticInteractionCacheSurface_t* 	surfaces;
+	const triIndex_t* 		indexes;
+	idHashIndex				pairHash;
+	
+	idList<staticInteractionCachePair_t>	writePairs;
+	idList<staticInteractionCacheSurface_t>	writeSurfaces;
+	idList<triIndex_t>		writeIndexes;
+	
+	int						AddIndexes( const triIndex_t* src, int num );
+};
+
 class idRenderEntityLocal;
 class idRenderLightLocal;
 
@@ -146,6 +252,12 @@ public:
 	// called by GenerateAllInteractions
 	void					CreateStaticInteraction();
 	
+	// CreateStaticInteraction in two steps. The tris only read the entity and light
+	// and can be created on any thread, they are set on the interaction in the
+	// main thread, in the same order as CreateStaticInteraction would have been called.
+	static void				CreateStaticInteractionTris( const idRenderEntityLocal* edef, const idRenderLightLocal* ldef, staticInteractionTris_t& tris );
+	void					SetStaticInteractionTris( staticInteractionTris_t& tris );
+	
 private:
 	// unlink from entity and light lists
 	void					Unlink();
@@ -87,7 +87,7 @@ static void R_PerformanceCounters()
 	}
 	if( r_showMemory.GetBool() )
 	{
-		common->Printf( "frameData: %i (%i)\n", frameData->frameMemoryAllocated.GetValue(), frameData->highWaterAllocated );
+		common->Printf( "frameData: %i (%i) chained: %i\n", R_FrameMemoryAllocated( frameData ), frameData->highWaterAllocated, frameData->chunkMemoryAllocated );
 	}
 	
 	memset( &tr.pc, 0, sizeof( tr.pc ) );
@@ -124,6 +124,9 @@ void idRenderSystemLocal::RenderCommandBuffers( const emptyCommand_t* const cmdH
 	
 	// r_skipRender is usually more usefull, because it will still
 	// draw 2D graphics
+	
+	// the dedicated server only runs the front end, there is nothing to draw to
+#if !defined(ID_DEDICATED)
 	if( !r_skipBackEnd.GetBool() )
 	{
 #if !defined(USE_GLES2) && !defined(USE_GLES3)
@@ -144,6 +147,7 @@ void idRenderSystemLocal::RenderCommandBuffers( const emptyCommand_t* const cmdH
 			RB_ExecuteBackEndCommands( cmdHead );
 		}
 	}
+#endif
 	
 	// pass in null for now - we may need to do some map specific hackery in the future
 	resolutionScale.InitForMap( NULL );
@@ -736,6 +740,7 @@ void idRenderSystemLocal::SwapCommandBuffers_FinishRendering(
 	
 	
 	// After coming back from an autoswap, we won't have anything to render
+#if !defined(ID_DEDICATED)
 	if( frameData->cmdHead->next != NULL )
 	{
 		// wait for our fence to hit, which means the swap has actually happened
@@ -743,6 +748,7 @@ void idRenderSystemLocal::SwapCommandBuffers_FinishRendering(
 		void GL_BlockingSwapBuffers();
 		GL_BlockingSwapBuffers();
 	}
+#endif
 	
 	// read back the start and end timer queries from the previous frame
 	if( glConfig.timerQueryAvailable )
@@ -789,6 +795,35 @@ void idRenderSystemLocal::SwapCommandBuffers_FinishRendering(
 	
 }
 
+/*
+=====================
+idRenderSystemLocal::GetFrontEndTimes
+=====================
+*/
+void idRenderSystemLocal::GetFrontEndTimes(
+	uint64* frontEndMicroSec,
+	uint64* addLightsMicroSec,
+	uint64* addModelsMicroSec,
+	uint64* shadowVolumeMicroSec )
+{
+	if( frontEndMicroSec != NULL )
+	{
+		*frontEndMicroSec = pc.frontEndMicroSec;
+	}
+	if( addLightsMicroSec != NULL )
+	{
+		*addLightsMicroSec = pc.addLightsMicroSec;
+	}
+	if( addModelsMicroSec != NULL )
+	{
+		*addModelsMicroSec = pc.addModelsMicroSec;
+	}
+	if( shadowVolumeMicroSec != NULL )
+	{
+		*shadowVolumeMicroSec = pc.shadowVolumeMicroSec;
+	}
+}
+
 /*
 =====================
 idRenderSystemLocal::SwapCommandBuffers_FinishCommandBuffers
@@ -330,6 +330,11 @@ public:
 	virtual void			SwapCommandBuffers_FinishRendering( uint64* frontEndMicroSec, uint64* backEndMicroSec, uint64* shadowMicroSec, uint64* gpuMicroSec ) = 0;
 	virtual const emptyCommand_t* 	SwapCommandBuffers_FinishCommandBuffers() = 0;
 	
+	// Returns the front end time spent so far in the current frame, in total and
+	// split into its stages. The counters are cleared by SwapCommandBuffers(), so
+	// this has to be called before it, as the headless timeDemo does.
+	virtual void			GetFrontEndTimes( uint64* frontEndMicroSec, uint64* addLightsMicroSec, uint64* addModelsMicroSec, uint64* shadowVolumeMicroSec ) = 0;
+	
 	// issues GPU commands to render a built up list of command buffers returned
 	// by SwapCommandBuffers().  No references should be made to the current frameData,
 	// so new scenes and GUIs can be built up in parallel with the rendering.
@@ -1806,6 +1806,303 @@ void idRenderWorldLocal::AddLightRefToArea( idRenderLightLocal* light, portalAre
 	area->lightRefs.areaNext = lref;
 }
 
+idCVar r_useParallelStaticInteractions( "r_useParallelStaticInteractions", "1", CVAR_RENDERER | CVAR_BOOL, "create the static interactions of several lights in parallel with jobs at map load" );
+idCVar r_useStaticInteractionCache( "r_useStaticInteractionCache", "1", CVAR_RENDERER | CVAR_BOOL, "load the static interactions from generated/<map>.binteractions and write it when it is out of date" );
+
+// the tris of a batch are all kept until the batch is linked
+static const int MAX_STATIC_INTERACTION_BATCH_LIGHTS	= 64;
+static const int MAX_STATIC_INTERACTION_BATCH_PAIRS		= 4096;
+
+struct staticInteractionPair_t
+{
+	idRenderEntityLocal* 		edef;
+	unsigned int				key;
+	bool						cached;
+};
+
+// a pair whose tris were found in the cache, they are only copied when the file is rewritten
+struct staticInteractionCachedPair_t
+{
+	int							lightIndex;
+	int							entityIndex;
+	unsigned int				key;
+};
+
+struct staticInteractionJob_t
+{
+	idRenderLightLocal* 		ldef;
+	int							lightIndex;
+	int							firstPair;
+	int							numPairs;
+	staticInteractionPair_t* 	pairs;
+	staticInteractionTris_t* 	tris;
+};
+
+/*
+===================
+R_StaticInteractionLightKey
+
+Covers everything of the light the static interaction tris depend on.
+===================
+*/
+static unsigned int R_StaticInteractionLightKey( const idRenderLightLocal* ldef )
+{
+	const renderLight_t& parms = ldef->parms;
+	unsigned int crc;
+	
+	CRC32_InitChecksum( crc );
+	CRC32_UpdateChecksum( crc, &parms.axis, sizeof( parms.axis ) );
+	CRC32_UpdateChecksum( crc, &parms.origin, sizeof( parms.origin ) );
+	CRC32_UpdateChecksum( crc, &parms.lightRadius, sizeof( parms.lightRadius ) );
+	CRC32_UpdateChecksum( crc, &parms.lightCenter, sizeof( parms.lightCenter ) );
+	CRC32_UpdateChecksum( crc, &parms.target, sizeof( parms.target ) );
+	CRC32_UpdateChecksum( crc, &parms.right, sizeof( parms.right ) );
+	CRC32_UpdateChecksum( crc, &parms.up, sizeof( parms.up ) );
+	CRC32_UpdateChecksum( crc, &parms.start, sizeof( parms.start ) );
+	CRC32_UpdateChecksum( crc, &parms.end, sizeof( parms.end ) );
+	
+	const byte flags[4] = { parms.forceShadows, parms.noShadows, parms.pointLight, parms.parallel };
+	CRC32_UpdateChecksum( crc, flags, sizeof( flags ) );
+	
+	const char* shaderName = ldef->lightShader->GetName();
+	CRC32_UpdateChecksum( crc, shaderName, idStr::Length( shaderName ) + 1 );
+	if( parms.prelightModel != NULL )
+	{
+		const char* prelightName = parms.prelightModel->Name();
+		CRC32_UpdateChecksum( crc, prelightName, idStr::Length( prelightName ) + 1 );
+	}
+	
+	CRC32_FinishChecksum( crc );
+	return crc;
+}
+
+/*
+===================
+R_StaticInteractionModelChecksum
+
+Adds the geometry and materials of a model to a checksum.
+===================
+*/
+static void R_StaticInteractionModelChecksum( unsigned int& crc, const idRenderModel* model )
+{
+	for( int i = 0; i < model->NumSurfaces(); i++ )
+	{
+		const modelSurface_t* surf = model->Surface( i );
+		if( surf->shader != NULL )
+		{
+			const char* shaderName = surf->shader->GetName();
+			CRC32_UpdateChecksum( crc, shaderName, idStr::Length( shaderName ) + 1 );
+		}
+		
+		const srfTriangles_t* tri = surf->geometry;
+		if( tri == NULL )
+		{
+			continue;
+		}
+		CRC32_UpdateChecksum( crc, &tri->numVerts, sizeof( tri->numVerts ) );
+		CRC32_UpdateChecksum( crc, &tri->numIndexes, sizeof( tri->numIndexes ) );
+		if( tri->verts != NULL )
+		{
+			CRC32_UpdateChecksum( crc, tri->verts, tri->numVerts * sizeof( tri->verts[0] ) );
+		}
+		if( tri->indexes != NULL )
+		{
+			CRC32_UpdateChecksum( crc, tri->indexes, tri->numIndexes * sizeof( tri->indexes[0] ) );
+		}
+	}
+}
+
+/*
+===================
+R_StaticInteractionEntityKey
+
+Covers everything of the entity the static interaction tris depend on. The
+geometry of the world area models is already covered by the map checksum.
+===================
+*/
+static unsigned int R_StaticInteractionEntityKey( const idRenderEntityLocal* edef )
+{
+	const renderEntity_t& parms = edef->parms;
+	unsigned int crc;
+	
+	CRC32_InitChecksum( crc );
+	CRC32_UpdateChecksum( crc, &parms.origin, sizeof( parms.origin ) );
+	CRC32_UpdateChecksum( crc, &parms.axis, sizeof( parms.axis ) );
+	
+	const byte flags[2] = { parms.noShadow, parms.noSelfShadow };
+	CRC32_UpdateChecksum( crc, flags, sizeof( flags ) );
+	
+	if( parms.customShader != NULL )
+	{
+		const char* shaderName = parms.customShader->GetName();
+		CRC32_UpdateChecksum( crc, shaderName, idStr::Length( shaderName ) + 1 );
+	}
+	if( parms.customSkin != NULL )
+	{
+		const char* skinName = parms.customSkin->GetName();
+		CRC32_UpdateChecksum( crc, skinName, idStr::Length( skinName ) + 1 );
+	}
+	
+	const idRenderModel* model = parms.hModel;
+	if( model != NULL )
+	{
+		const char* modelName = model->Name();
+		CRC32_UpdateChecksum( crc, modelName, idStr::Length( modelName ) + 1 );
+		
+		const int numSurfaces = model->NumSurfaces();
+		CRC32_UpdateChecksum( crc, &numSurfaces, sizeof( numSurfaces ) );
+		
+		if( !model->IsStaticWorldModel() && model->IsDynamicModel() == DM_STATIC )
+		{
+			R_StaticInteractionModelChecksum( crc, model );
+		}
+	}
+	
+	CRC32_FinishChecksum( crc );
+	return crc;
+}
+
+/*
+===================
+R_StaticInteractionPairKey
+===================
+*/
+static unsigned int R_StaticInteractionPairKey( unsigned int lightKey, unsigned int entityKey )
+{
+	const unsigned int keys[2] = { lightKey, entityKey };
+	return CRC32_BlockChecksum( keys, sizeof( keys ) );
+}
+
+/*
+===================
+R_StaticInteractionSettings
+
+The cvars the static interaction tris depend on.
+===================
+*/
+static unsigned int R_StaticInteractionSettings()
+{
+	unsigned int settings = sizeof( triIndex_t ) << 8;
+	if( r_lightAllBackFaces.GetBool() )
+	{
+		settings |= BIT( 0 );
+	}
+	if( r_skipPrelightShadows.GetBool() )
+	{
+		settings |= BIT( 1 );
+	}
+	return settings;
+}
+
+/*
+===================
+R_CreateStaticInteractionsJob
+
+Creates the static interaction tris of all entities touching a light.
+===================
+*/
+static void R_CreateStaticInteractionsJob( staticInteractionJob_t* job )
+{
+	for( int i = 0; i < job->numPairs; i++ )
+	{
+		if( job->pairs[i].cached )
+		{
+			continue;
+		}
+		idInteraction::CreateStaticInteractionTris( job->pairs[i].edef, job->ldef, job->tris[i] );
+	}
+}
+
+REGISTER_PARALLEL_JOB( R_CreateStaticInteractionsJob, "R_CreateStaticInteractionsJob" );
+
+/*
+===================
+R_CreateStaticInteractionBatch
+
+Takes the tris of the pairs found in the cache from the file and creates the tris
+of the others, in parallel if there is a job list. Then allocates and links the
+interactions in the order the serial loop would have, so the interaction lists and
+the static index cache come out the same. Only the created tris are copied to the
+new cache, the cached pairs are just recorded.
+===================
+*/
+static void R_CreateStaticInteractionBatch( idList<staticInteractionJob_t>& jobs, idList<staticInteractionPair_t>& pairs,
+		idList<staticInteractionTris_t>& tris, idParallelJobList* jobList, const idStaticInteractionCache* cache,
+		idStaticInteractionCache* newCache, idList<staticInteractionCachedPair_t>& cachedPairs )
+{
+	tris.SetNum( pairs.Num() );
+	
+	for( int i = 0; i < jobs.Num(); i++ )
+	{
+		staticInteractionJob_t& job = jobs[i];
+		job.pairs = pairs.Ptr() + job.firstPair;
+		job.tris = tris.Ptr() + job.firstPair;
+		
+		int numMissing = job.numPairs;
+		if( cache != NULL )
+		{
+			for( int j = 0; j < job.numPairs; j++ )
+			{
+				staticInteractionPair_t& pair = job.pairs[j];
+				pair.cached = cache->Find( job.lightIndex, pair.edef->index, pair.key, job.tris[j] );
+				if( pair.cached )
+				{
+					staticInteractionCachedPair_t& cached = cachedPairs.Alloc();
+					cached.lightIndex = job.lightIndex;
+					cached.entityIndex = pair.edef->index;
+					cached.key = pair.key;
+					numMissing--;
+				}
+			}
+		}
+		
+		if( numMissing == 0 )
+		{
+			continue;
+		}
+		if( jobList != NULL )
+		{
+			jobList->AddJob( ( jobRun_t )R_CreateStaticInteractionsJob, &job );
+		}
+		else
+		{
+			R_CreateStaticInteractionsJob( &job );
+		}
+	}
+	
+	if( jobList != NULL )
+	{
+		jobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+		jobList->Wait();
+	}
+	
+	for( int i = 0; i < jobs.Num(); i++ )
+	{
+		const staticInteractionJob_t& job = jobs[i];
+		for( int j = 0; j < job.numPairs; j++ )
+		{
+			const staticInteractionPair_t& pair = job.pairs[j];
+			
+			if( newCache != NULL && !pair.cached )
+			{
+				newCache->Add( job.lightIndex, pair.edef->index, pair.key, job.tris[j] );
+			}
+			
+			// make an interaction for this light / entity pair
+			// and add a pointer to it in the table
+			idInteraction* inter = idInteraction::AllocAndLink( pair.edef, job.ldef );
+			
+			// the interaction may create geometry
+			inter->SetStaticInteractionTris( job.tris[j] );
+		}
+		
+		session->Pump();
+	}
+	
+	jobs.SetNum( 0 );
+	pairs.SetNum( 0 );
+}
+
 /*
 ===================
 idRenderWorldLocal::GenerateAllInteractions
@@ -1836,6 +2133,67 @@ void idRenderWorldLocal::GenerateAllInteractions()
 	int	size =  interactionTableWidth * interactionTableHeight * sizeof( *interactionTable );
 	interactionTable = ( idInteraction** )R_ClearedStaticAlloc( size );
 	
+	idParallelJobList* jobList = NULL;
+	if( r_useParallelStaticInteractions.GetBool() )
+	{
+		jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_MEDIUM, MAX_STATIC_INTERACTION_BATCH_LIGHTS, 0, NULL );
+	}
+	
+	// the cache file is read and written as a whole, the pairs that were
+	// found in it are written back with the newly created ones if anything changed
+	idStaticInteractionCache cache;
+	idStaticInteractionCache newCache;
+	idStrStatic< MAX_OSPATH > cacheFileName;
+	unsigned int mapCRC = 0;
+	unsigned int settings = 0;
+	bool cacheLoaded = false;
+	if( r_useStaticInteractionCache.GetBool() && mapName.Length() > 0 )
+	{
+		cacheFileName = mapName;
+		cacheFileName.Insert( "generated/", 0 );
+		cacheFileName.SetFileExtension( "binteractions" );
+		
+		CRC32_InitChecksum( mapCRC );
+		CRC32_UpdateChecksum( mapCRC, mapName.c_str(), mapName.Length() );
+		for( int i = 0; i < localModels.Num(); i++ )
+		{
+			R_StaticInteractionModelChecksum( mapCRC, localModels[i] );
+		}
+		CRC32_FinishChecksum( mapCRC );
+		
+		settings = R_StaticInteractionSettings();
+		cacheLoaded = cache.Load( cacheFileName, mapCRC, settings );
+	}
+	const bool useCache = ( cacheFileName.Length() > 0 );
+	idList<staticInteractionCachedPair_t> cachedPairs;
+	cachedPairs.SetGranularity( 1024 );
+	
+	idList<staticInteractionJob_t> jobs;
+	idList<staticInteractionPair_t> pairs;
+	idList<staticInteractionTris_t> tris;
+	
+	// the entity keys are only made for the entities that touch a light
+	idList<unsigned int> entityKeys;
+	idList<bool> entityKeyValid;
+	if( useCache )
+	{
+		entityKeys.SetNum( entityDefs.Num() );
+		entityKeyValid.SetNum( entityDefs.Num() );
+		for( int i = 0; i < entityKeyValid.Num(); i++ )
+		{
+			entityKeyValid[i] = false;
+		}
+	}
+	
+	// the last light an entity was collected for, an entity touching a light
+	// through several areas only gets one interaction
+	idList<int> entityLight;
+	entityLight.SetNum( entityDefs.Num() );
+	for( int i = 0; i < entityLight.Num(); i++ )
+	{
+		entityLight[i] = -1;
+	}
+	
 	// itterate through all lights
 	int	count = 0;
 	for( int i = 0; i < this->lightDefs.Num(); i++ )
@@ -1846,6 +2204,13 @@ void idRenderWorldLocal::GenerateAllInteractions()
 			continue;
 		}
 		
+		staticInteractionJob_t& job = jobs.Alloc();
+		job.ldef = ldef;
+		job.lightIndex = i;
+		job.firstPair = pairs.Num();
+		
+		const unsigned int lightKey = useCache ? R_StaticInteractionLightKey( ldef ) : 0;
+		
 		// check all areas the light touches
 		for( areaReference_t* lref = ldef->references; lref; lref = lref->ownerNext )
 		{
@@ -1856,6 +2221,12 @@ void idRenderWorldLocal::GenerateAllInteractions()
 			{
 				idRenderEntityLocal* 	edef = eref->entity;
 				
+				if( entityLight[edef->index] == i )
+				{
+					continue;
+				}
+				entityLight[edef->index] = i;
+				
 				// scan the doubly linked lists, which may have several dozen entries
 				idInteraction*	inter;
 				
@@ -1876,17 +2247,56 @@ void idRenderWorldLocal::GenerateAllInteractions()
 					continue;
 				}
 				
-				// make an interaction for this light / entity pair
-				// and add a pointer to it in the table
-				inter = idInteraction::AllocAndLink( edef, ldef );
+				staticInteractionPair_t& pair = pairs.Alloc();
+				pair.edef = edef;
+				pair.key = 0;
+				pair.cached = false;
+				if( useCache )
+				{
+					if( !entityKeyValid[edef->index] )
+					{
+						entityKeys[edef->index] = R_StaticInteractionEntityKey( edef );
+						entityKeyValid[edef->index] = true;
+					}
+					pair.key = R_StaticInteractionPairKey( lightKey, entityKeys[edef->index] );
+				}
 				count++;
-				
-				// the interaction may create geometry
-				inter->CreateStaticInteraction();
 			}
 		}
 		
-		session->Pump();
+		job.numPairs = pairs.Num() - job.firstPair;
+		
+		if( jobs.Num() >= MAX_STATIC_INTERACTION_BATCH_LIGHTS || pairs.Num() >= MAX_STATIC_INTERACTION_BATCH_PAIRS )
+		{
+			R_CreateStaticInteractionBatch( jobs, pairs, tris, jobList, cacheLoaded ? &cache : NULL, useCache ? &newCache : NULL, cachedPairs );
+		}
+	}
+	
+	R_CreateStaticInteractionBatch( jobs, pairs, tris, jobList, cacheLoaded ? &cache : NULL, useCache ? &newCache : NULL, cachedPairs );
+	
+	if( jobList != NULL )
+	{
+		parallelJobManager->FreeJobList( jobList );
+	}
+	
+	if( useCache )
+	{
+		// only rewrite the file when something changed
+		const int numCached = cachedPairs.Num();
+		if( numCached != count || cache.NumPairs() != count )
+		{
+			staticInteractionTris_t cachedTris;
+			for( int i = 0; i < numCached; i++ )
+			{
+				const staticInteractionCachedPair_t& cached = cachedPairs[i];
+				if( cache.Find( cached.lightIndex, cached.entityIndex, cached.key, cachedTris ) )
+				{
+					newCache.Add( cached.lightIndex, cached.entityIndex, cached.key, cachedTris );
+				}
+			}
+			newCache.Write( cacheFileName, mapCRC, settings );
+		}
+		common->Printf( "%i of %i static interactions from %s\n", numCached, count, cacheFileName.c_str() );
 	}
 	
 	int end = Sys_Milliseconds();
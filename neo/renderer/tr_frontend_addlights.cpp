@@ -133,7 +133,7 @@ static void R_AddSingleLight( viewLight_t* vLight )
 	}
 	
 	// evaluate the light shader registers
-	float* lightRegs = ( float* )R_FrameAlloc( lightShader->GetNumRegisters() * sizeof( float ), FRAME_ALLOC_SHADER_REGISTER );
+	float* lightRegs = ( float* )R_UnclearedFrameAlloc( lightShader->GetNumRegisters() * sizeof( float ), FRAME_ALLOC_SHADER_REGISTER );
 	lightShader->EvaluateRegisters( lightRegs, light->parms.shaderParms, viewDef->renderView.shaderParms,
 									tr.viewDef->renderView.time[0] * 0.001f, light->parms.referenceSound );
 									
@@ -589,6 +589,8 @@ void R_AddLights()
 {
 	SCOPED_PROFILE_EVENT( "R_AddLights" );
 	
+	const int addLightsStart = Sys_Microseconds();
+	
 	//-------------------------------------------------
 	// check each light individually, possibly in parallel
 	//-------------------------------------------------
@@ -644,6 +646,8 @@ void R_AddLights()
 		}
 	}
 	
+	tr.pc.addLightsMicroSec += Sys_Microseconds() - addLightsStart;
+	
 	//-------------------------------------------------
 	// Add jobs to setup pre-light shadow volumes.
 	//-------------------------------------------------
@@ -674,6 +678,7 @@ void R_AddLights()
 		
 		int end = Sys_Microseconds();
 		backEnd.pc.shadowMicroSec += end - start;
+		tr.pc.shadowVolumeMicroSec += end - start;
 	}
 }
 
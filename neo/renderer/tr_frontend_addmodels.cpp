@@ -316,7 +316,7 @@ void R_SetupDrawSurfShader( drawSurf_t* drawSurf, const idMaterial* shader, cons
 		}
 		
 		// allocte frame memory for the shader register values
-		float* regs = ( float* )R_FrameAlloc( shader->GetNumRegisters() * sizeof( float ), FRAME_ALLOC_SHADER_REGISTER );
+		float* regs = ( float* )R_UnclearedFrameAlloc( shader->GetNumRegisters() * sizeof( float ), FRAME_ALLOC_SHADER_REGISTER );
 		drawSurf->shaderRegisters = regs;
 		
 		// process the shader expressions for conditionals / color / texcoords
@@ -1217,7 +1217,7 @@ void R_LinkDrawSurfToView( drawSurf_t* drawSurf, viewDef_t* viewDef )
 			count = viewDef->maxDrawSurfs * sizeof( viewDef->drawSurfs[0] );
 			viewDef->maxDrawSurfs *= 2;
 		}
-		viewDef->drawSurfs = ( drawSurf_t** )R_FrameAlloc( viewDef->maxDrawSurfs * sizeof( viewDef->drawSurfs[0] ), FRAME_ALLOC_DRAW_SURFACE_POINTER );
+		viewDef->drawSurfs = ( drawSurf_t** )R_UnclearedFrameAlloc( viewDef->maxDrawSurfs * sizeof( viewDef->drawSurfs[0] ), FRAME_ALLOC_DRAW_SURFACE_POINTER );
 		memcpy( viewDef->drawSurfs, old, count );
 	}
 	
@@ -1238,6 +1238,8 @@ void R_AddModels()
 {
 	SCOPED_PROFILE_EVENT( "R_AddModels" );
 	
+	const int addModelsStart = Sys_Microseconds();
+	
 	tr.viewDef->viewEntitys = R_SortViewEntities( tr.viewDef->viewEntitys );
 	
 	//-------------------------------------------------
@@ -1266,6 +1268,9 @@ void R_AddModels()
 	// Kick off jobs to setup static and dynamic shadow volumes.
 	//-------------------------------------------------
 	
+	const int shadowVolumeStart = Sys_Microseconds();
+	tr.pc.addModelsMicroSec += shadowVolumeStart - addModelsStart;
+	
 	if( r_useParallelAddShadows.GetInteger() == 1 )
 	{
 		for( viewEntity_t* vEntity = tr.viewDef->viewEntitys; vEntity != NULL; vEntity = vEntity->next )
@@ -1307,6 +1312,9 @@ void R_AddModels()
 		backEnd.pc.shadowMicroSec += end - start;
 	}
 	
+	// with r_useParallelAddShadows this is mostly waiting on the shadow volume jobs
+	tr.pc.shadowVolumeMicroSec += Sys_Microseconds() - shadowVolumeStart;
+	
 	//-------------------------------------------------
 	// Move the draw surfs to the view.
 	//-------------------------------------------------
@@ -43,17 +43,55 @@ FRAME MEMORY ALLOCATION
 static const unsigned int NUM_FRAME_DATA = 2;
 static const unsigned int FRAME_ALLOC_ALIGNMENT = 128;
 static const unsigned int MAX_FRAME_MEMORY = 64 * 1024 * 1024;	// larger so that we can noclip on PC for dev purposes
+static const unsigned int FRAME_MEMORY_CHUNK_SIZE = 4 * 1024 * 1024;
 
 idFrameData		smpFrameData[NUM_FRAME_DATA];
 idFrameData* 	frameData;
 unsigned int	smpFrame;
 
-//#define TRACK_FRAME_ALLOCS
+static const char* frameAllocTypeNames[FRAME_ALLOC_MAX] =
+{
+	"viewDef",
+	"viewEntity",
+	"viewLight",
+	"surfaceTriangles",
+	"drawSurface",
+	"interactionState",
+	"shadowOnlyEntity",
+	"shadowVolumeParms",
+	"shaderRegister",
+	"drawSurfacePointer",
+	"drawCommand",
+	"unknown"
+};
 
-#if defined( TRACK_FRAME_ALLOCS )
-idSysInterlockedInteger frameAllocTypeCount[FRAME_ALLOC_MAX];
-int frameHighWaterTypeCount[FRAME_ALLOC_MAX];
-#endif
+/*
+====================
+R_FrameMemoryAllocated
+
+Bytes handed out from the main block and any chained chunks.
+====================
+*/
+int R_FrameMemoryAllocated( const idFrameData* data )
+{
+	return Min( data->frameMemoryAllocated.GetValue(), data->frameMemorySize ) + data->chunkMemoryAllocated;
+}
+
+/*
+====================
+R_FreeFrameMemoryChunks
+====================
+*/
+static void R_FreeFrameMemoryChunks( idFrameData* data )
+{
+	while( data->chunks != NULL )
+	{
+		frameMemoryChunk_t* next = data->chunks->next;
+		Mem_Free16( data->chunks );
+		data->chunks = next;
+	}
+	data->chunkMemoryAllocated = 0;
+}
 
 /*
 ====================
@@ -62,23 +100,35 @@ R_ToggleSmpFrame
 */
 void R_ToggleSmpFrame()
 {
-	// update the highwater mark
-	if( frameData->frameMemoryAllocated.GetValue() > frameData->highWaterAllocated )
+	// update the highwater marks
+	const int allocated = R_FrameMemoryAllocated( frameData );
+	if( allocated > frameData->highWaterAllocated )
 	{
-		frameData->highWaterAllocated = frameData->frameMemoryAllocated.GetValue();
-#if defined( TRACK_FRAME_ALLOCS )
+		frameData->highWaterAllocated = allocated;
 		frameData->highWaterUsed = frameData->frameMemoryUsed.GetValue();
-		for( int i = 0; i < FRAME_ALLOC_MAX; i++ )
-		{
-			frameHighWaterTypeCount[i] = frameAllocTypeCount[i].GetValue();
-		}
-#endif
+	}
+	for( int i = 0; i < FRAME_ALLOC_MAX; i++ )
+	{
+		frameData->highWaterTypeUsed[i] = Max( frameData->highWaterTypeUsed[i], frameData->typeMemoryUsed[i].GetValue() );
 	}
 	
 	// switch to the next frame
 	smpFrame++;
 	frameData = &smpFrameData[smpFrame % NUM_FRAME_DATA];
 	
+	// the back end is done with this frame, so if it had to chain chunks the last
+	// time around, grow the main block to cover them and go back to a single bump
+	if( frameData->chunks != NULL )
+	{
+		const int newSize = frameData->frameMemorySize + ( ( frameData->chunkMemoryAllocated + FRAME_MEMORY_CHUNK_SIZE - 1 ) & ~( FRAME_MEMORY_CHUNK_SIZE - 1 ) );
+		idLib::Printf( "R_ToggleSmpFrame: growing frame memory from %i to %i kB\n", frameData->frameMemorySize >> 10, newSize >> 10 );
+		
+		R_FreeFrameMemoryChunks( frameData );
+		Mem_Free16( frameData->frameMemory );
+		frameData->frameMemory = ( byte* )Mem_Alloc16( newSize, TAG_RENDER );
+		frameData->frameMemorySize = newSize;
+	}
+	
 	// reset the memory allocation
 	
 	// RB: 64 bit fixes, changed unsigned int to uintptr_t
@@ -88,12 +138,10 @@ void R_ToggleSmpFrame()
 	frameData->frameMemoryAllocated.SetValue( bytesNeededForAlignment );
 	frameData->frameMemoryUsed.SetValue( 0 );
 	
-#if defined( TRACK_FRAME_ALLOCS )
 	for( int i = 0; i < FRAME_ALLOC_MAX; i++ )
 	{
-		frameAllocTypeCount[i].SetValue( 0 );
+		frameData->typeMemoryUsed[i].SetValue( 0 );
 	}
-#endif
 	
 	// clear the command chain and make a RC_NOP command the only thing on the list
 	frameData->cmdHead = frameData->cmdTail = ( emptyCommand_t* )R_FrameAlloc( sizeof( *frameData->cmdHead ), FRAME_ALLOC_DRAW_COMMAND );
@@ -111,8 +159,10 @@ void R_ShutdownFrameData()
 	frameData = NULL;
 	for( int i = 0; i < NUM_FRAME_DATA; i++ )
 	{
+		R_FreeFrameMemoryChunks( &smpFrameData[i] );
 		Mem_Free16( smpFrameData[i].frameMemory );
 		smpFrameData[i].frameMemory = NULL;
+		smpFrameData[i].frameMemorySize = 0;
 	}
 }
 
@@ -128,6 +178,7 @@ void R_InitFrameData()
 	for( int i = 0; i < NUM_FRAME_DATA; i++ )
 	{
 		smpFrameData[i].frameMemory = ( byte* ) Mem_Alloc16( MAX_FRAME_MEMORY, TAG_RENDER );
+		smpFrameData[i].frameMemorySize = MAX_FRAME_MEMORY;
 	}
 	
 	// must be set before calling R_ToggleSmpFrame()
@@ -138,7 +189,41 @@ void R_InitFrameData()
 
 /*
 ================
-R_FrameAlloc
+R_ChunkFrameAlloc
+
+Called when the main block is exhausted.  This is serialized, but
+only happens on frames heavier than anything seen before, because
+the main block is grown to cover the chunks when the frame is reused.
+================
+*/
+static byte* R_ChunkFrameAlloc( int bytes )
+{
+	idScopedCriticalSection lock( frameData->chunkLock );
+	
+	frameMemoryChunk_t* chunk = frameData->chunks;
+	if( chunk == NULL || chunk->allocated + bytes > chunk->size )
+	{
+		// the header is padded out so the chunk memory keeps the frame alignment
+		const int headerSize = sizeof( frameMemoryChunk_t ) + FRAME_ALLOC_ALIGNMENT;
+		const int chunkSize = Max( ( int )FRAME_MEMORY_CHUNK_SIZE, bytes + headerSize );
+		
+		chunk = ( frameMemoryChunk_t* )Mem_Alloc16( chunkSize, TAG_RENDER );
+		chunk->next = frameData->chunks;
+		chunk->size = chunkSize;
+		chunk->allocated = headerSize - ( ( ( uintptr_t )chunk + headerSize ) & ( FRAME_ALLOC_ALIGNMENT - 1 ) );
+		frameData->chunks = chunk;
+	}
+	
+	byte* ptr = ( byte* )chunk + chunk->allocated;
+	chunk->allocated += bytes;
+	frameData->chunkMemoryAllocated += bytes;
+	
+	return ptr;
+}
+
+/*
+================
+R_UnclearedFrameAlloc
 
 This data will be automatically freed when the
 current frame's back end completes.
@@ -149,28 +234,40 @@ back end shouldn't need to allocate memory.
 All temporary data, like dynamic tesselations
 and local spaces are allocated here.
 
-All memory is cache-line-cleared for the best performance.
+The memory is not cleared, so this is only for callers
+that overwrite everything they read back.
 ================
 */
-void* R_FrameAlloc( int bytes, frameAllocType_t type )
+void* R_UnclearedFrameAlloc( int bytes, frameAllocType_t type )
 {
-#if defined( TRACK_FRAME_ALLOCS )
 	frameData->frameMemoryUsed.Add( bytes );
-	frameAllocTypeCount[type].Add( bytes );
-#endif
+	frameData->typeMemoryUsed[type].Add( bytes );
 	
 	bytes = ( bytes + FRAME_ALLOC_ALIGNMENT - 1 ) & ~( FRAME_ALLOC_ALIGNMENT - 1 );
 	
 	// thread safe add
 	int	end = frameData->frameMemoryAllocated.Add( bytes );
-	if( end > MAX_FRAME_MEMORY )
+	if( end > frameData->frameMemorySize )
 	{
-		idLib::Error( "R_FrameAlloc ran out of memory. bytes = %d, end = %d, highWaterAllocated = %d\n", bytes, end, frameData->highWaterAllocated );
+		return R_ChunkFrameAlloc( bytes );
 	}
 	
-	byte* ptr = frameData->frameMemory + end - bytes;
+	return frameData->frameMemory + end - bytes;
+}
+
+/*
+================
+R_FrameAlloc
+
+All memory is cache-line-cleared for the best performance.
+================
+*/
+void* R_FrameAlloc( int bytes, frameAllocType_t type )
+{
+	byte* ptr = ( byte* )R_UnclearedFrameAlloc( bytes, type );
 	
 	// cache line clear the memory
+	bytes = ( bytes + FRAME_ALLOC_ALIGNMENT - 1 ) & ~( FRAME_ALLOC_ALIGNMENT - 1 );
 	for( int offset = 0; offset < bytes; offset += CACHE_LINE_SIZE )
 	{
 		ZeroCacheLine( ptr, offset );
@@ -190,6 +287,36 @@ void* R_ClearedFrameAlloc( int bytes, frameAllocType_t type )
 	return R_FrameAlloc( bytes, type );
 }
 
+/*
+==================
+R_ListFrameAllocs_f
+==================
+*/
+CONSOLE_COMMAND( listFrameAllocs, "lists frame memory use by allocation type", NULL )
+{
+	if( frameData == NULL )
+	{
+		return;
+	}
+	
+	idLib::Printf( "%-20s %10s %10s\n", "type", "used", "highWater" );
+	for( int i = 0; i < FRAME_ALLOC_MAX; i++ )
+	{
+		int highWater = 0;
+		for( int j = 0; j < NUM_FRAME_DATA; j++ )
+		{
+			highWater = Max( highWater, smpFrameData[j].highWaterTypeUsed[i] );
+		}
+		idLib::Printf( "%-20s %9ik %9ik\n", frameAllocTypeNames[i], frameData->typeMemoryUsed[i].GetValue() >> 10, highWater >> 10 );
+	}
+	for( int j = 0; j < NUM_FRAME_DATA; j++ )
+	{
+		idLib::Printf( "frame %i: %ik in a %ik block, %ik chained, highWater %ik allocated %ik used\n", j,
+					   R_FrameMemoryAllocated( &smpFrameData[j] ) >> 10, smpFrameData[j].frameMemorySize >> 10,
+					   smpFrameData[j].chunkMemoryAllocated >> 10, smpFrameData[j].highWaterAllocated >> 10, smpFrameData[j].highWaterUsed >> 10 );
+	}
+}
+
 /*
 ==========================================================================================
 
@@ -586,6 +586,15 @@ enum frameAllocType_t
 	FRAME_ALLOC_MAX
 };
 
+// extra memory chained on to an idFrameData when a heavy frame
+// runs past the end of frameMemory
+struct frameMemoryChunk_t
+{
+	frameMemoryChunk_t* 	next;
+	int						size;		// total bytes, including this header
+	int						allocated;	// offset of the next free byte from the chunk start
+};
+
 // all of the information needed by the back end must be
 // contained in a idFrameData.  This entire structure is
 // duplicated so the front and back end can run in parallel
@@ -596,9 +605,19 @@ public:
 	idSysInterlockedInteger	frameMemoryAllocated;
 	idSysInterlockedInteger	frameMemoryUsed;
 	byte* 					frameMemory;
+	int						frameMemorySize;
+	
+	// overflow chunks are only touched under chunkLock, the next time this
+	// frame is reused frameMemory is grown to cover them and they are released
+	idSysMutex				chunkLock;
+	frameMemoryChunk_t* 	chunks;
+	int						chunkMemoryAllocated;
+	
+	idSysInterlockedInteger	typeMemoryUsed[FRAME_ALLOC_MAX];
 	
 	int						highWaterAllocated;	// max used on any frame
 	int						highWaterUsed;
+	int						highWaterTypeUsed[FRAME_ALLOC_MAX];
 	
 	// the currently building command list commands can be inserted
 	// at the front if needed, as required for dynamically generated textures
@@ -655,6 +674,9 @@ struct performanceCounters_t
 	int		c_lightReferences;
 	int		c_guiSurfs;
 	int		frontEndMicroSec;	// sum of time in all RE_RenderScene's in a frame
+	int		addLightsMicroSec;	// R_AddLights, without the pre-light shadow volumes
+	int		addModelsMicroSec;	// R_AddModels, without the shadow volumes
+	int		shadowVolumeMicroSec;	// creating or waiting on the front end shadow volume jobs
 };
 
 
@@ -816,6 +838,8 @@ public:
 	virtual void			SwapCommandBuffers_FinishRendering( uint64* frontEndMicroSec, uint64* backEndMicroSec, uint64* shadowMicroSec, uint64* gpuMicroSec );
 	virtual const emptyCommand_t* 	SwapCommandBuffers_FinishCommandBuffers();
 	
+	virtual void			GetFrontEndTimes( uint64* frontEndMicroSec, uint64* addLightsMicroSec, uint64* addModelsMicroSec, uint64* shadowVolumeMicroSec );
+	
 	virtual void			RenderCommandBuffers( const emptyCommand_t* commandBuffers );
 	virtual void			TakeScreenshot( int width, int height, const char* fileName, int downSample, renderView_t* ref, int exten );
 	virtual void			CropRenderSize( int width, int height );
@@ -1238,6 +1262,8 @@ void R_ShutdownFrameData();
 void R_ToggleSmpFrame();
 void* R_FrameAlloc( int bytes, frameAllocType_t type = FRAME_ALLOC_UNKNOWN );
 void* R_ClearedFrameAlloc( int bytes, frameAllocType_t type = FRAME_ALLOC_UNKNOWN );
+void* R_UnclearedFrameAlloc( int bytes, frameAllocType_t type = FRAME_ALLOC_UNKNOWN );
+int R_FrameMemoryAllocated( const idFrameData* data );
 
 void* R_StaticAlloc( int bytes, const memTag_t tag = TAG_RENDER_STATIC );		// just malloc with error checking
 void* R_ClearedStaticAlloc( int bytes );	// with memset
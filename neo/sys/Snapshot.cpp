@@ -241,12 +241,12 @@ idSnapShot::PeekDeltaSequence
 */
 void idSnapShot::PeekDeltaSequence( const char* deltaMem, int deltaSize, int& sequence, int& baseSequence )
 {
-	lzwCompressionData_t	lzwData;
-	idLZWCompressor			lzwCompressor( &lzwData );
+	int header[2] = { 0, 0 };
 	
-	lzwCompressor.Start( ( uint8* )deltaMem, deltaSize );
-	lzwCompressor.ReadAgnostic( sequence );
-	lzwCompressor.ReadAgnostic( baseSequence );
+	idSnapDeltaCodec::PeekHeader( ( const uint8* )deltaMem, deltaSize, header, sizeof( header ) );
+	
+	sequence		= header[0];
+	baseSequence	= header[1];
 }
 
 /*
@@ -261,26 +261,33 @@ bool idSnapShot::ReadDeltaForJob( const char* deltaMem, int deltaSize, int visIn
 	net_verboseSnapshotReport.SetBool( false );
 	
 	lzwCompressionData_t		lzwData;
-	idZeroRunLengthCompressor	rleCompressor;
-	idLZWCompressor				lzwCompressor( &lzwData );
+	idSnapDeltaCodecLZW			lzwCodec( &lzwData );
+	idSnapDeltaCodecFast		fastCodec( NULL );
 	int bytesRead = 0; // how many uncompressed bytes we read in. Used to figure out compression ratio
 	
-	lzwCompressor.Start( ( uint8* )deltaMem, deltaSize );
+	const snapDeltaCodec_t codecType = idSnapDeltaCodec::PeekType( ( const uint8* )deltaMem, deltaSize );
+	idSnapDeltaCodec& codec = ( codecType == SNAP_CODEC_FAST ) ? static_cast<idSnapDeltaCodec&>( fastCodec ) : lzwCodec;
+	
+	if( !codec.StartRead( ( const uint8* )deltaMem, deltaSize ) )
+	{
+		idLib::Warning( "ReadDeltaForJob: invalid %s snapshot delta", idSnapDeltaCodec::GetName( codecType ) );
+		return false;
+	}
 	
 	// Skip past sequence and baseSequence
 	int sequence		= 0;
 	int baseSequence	= 0;
 	
-	lzwCompressor.ReadAgnostic( sequence );
-	lzwCompressor.ReadAgnostic( baseSequence );
-	lzwCompressor.ReadAgnostic( time );
+	codec.ReadAgnostic( sequence );
+	codec.ReadAgnostic( baseSequence );
+	codec.ReadAgnostic( time );
 	bytesRead += sizeof( int ) * 3;
 	
 	int objectNum = 0;
 	uint16 delta = 0;
 	
 	
-	while( lzwCompressor.ReadAgnostic( delta, true ) == sizeof( delta ) )
+	while( codec.ReadAgnostic( delta, true ) == sizeof( delta ) )
 	{
 		bytesRead += sizeof( delta );
 		
@@ -299,7 +306,7 @@ bool idSnapShot::ReadDeltaForJob( const char* deltaMem, int deltaSize, int visIn
 		objectState_t& state = FindOrCreateObjectByID( objectNum );
 		
 		objectSize_t newsize = 0;
-		lzwCompressor.ReadAgnostic( newsize );
+		codec.ReadAgnostic( newsize );
 		bytesRead += sizeof( newsize );
 		
 		if( newsize == SIZE_STALE )
@@ -330,7 +337,7 @@ bool idSnapShot::ReadDeltaForJob( const char* deltaMem, int deltaSize, int visIn
 			state.visMask |= ( 1 << visIndex );
 			state.stale = false;
 			// the latest state is packed in, get the new size and continue reading the new state
-			lzwCompressor.ReadAgnostic( newsize );
+			codec.ReadAgnostic( newsize );
 			bytesRead += sizeof( newsize );
 		}
 		
@@ -377,7 +384,7 @@ bool idSnapShot::ReadDeltaForJob( const char* deltaMem, int deltaSize, int visIn
 					{
 						state.Print( "SPAWN STATE" );
 						debug = true;
-						PrintAlign( "DELTA STATE" );
+						PrintAlign( va( "DELTA STATE (%s)", idSnapDeltaCodec::GetName( codecType ) ) );
 					}
 				}
 				else if( net_ssTemplateDebug.GetBool() )
@@ -392,34 +399,24 @@ bool idSnapShot::ReadDeltaForJob( const char* deltaMem, int deltaSize, int visIn
 			
 			// the buffer shrank or stayed the same
 			objectBuffer_t newbuffer( newsize );
-			rleCompressor.Start( NULL, &lzwCompressor, newsize );
 			objectSize_t compareSize = Min( state.buffer.Size(), newsize );
-			for( objectSize_t i = 0; i < compareSize; i++ )
-			{
-				byte b = rleCompressor.ReadByte();
-				newbuffer[i] = state.buffer[i] + b;
-				
-				if( debug && InDebugRange( i ) )
-				{
-					idLib::Printf( "%02X", b );
-				}
-			}
-			// Catch leftover
-			if( newsize > compareSize )
+			int compressedSize = codec.ReadObject( newbuffer.Ptr(), newsize, ( compareSize > 0 ) ? state.buffer.Ptr() : NULL, compareSize );
+			
+			if( debug )
 			{
-				rleCompressor.ReadBytes( newbuffer.Ptr() + compareSize, newsize - compareSize );
-				
-				if( debug )
+				for( objectSize_t i = 0; i < newsize; i++ )
 				{
-					for( objectSize_t i = compareSize; i < newsize; i++ )
+					if( InDebugRange( i ) )
 					{
-						if( InDebugRange( i ) )
+						// print the delta the way the codec in the delta header encodes it
+						byte b = newbuffer[i];
+						if( i < compareSize )
 						{
-							idLib::Printf( "%02X", newbuffer[i] );
+							b = ( codecType == SNAP_CODEC_FAST ) ? ( byte )( newbuffer[i] ^ state.buffer[i] ) : ( byte )( newbuffer[i] - state.buffer[i] );
 						}
+						idLib::Printf( "%02X", b );
 					}
 				}
-				
 			}
 			state.buffer = newbuffer;
 			state.changedCount = sequence;
@@ -432,7 +429,7 @@ bool idSnapShot::ReadDeltaForJob( const char* deltaMem, int deltaSize, int visIn
 			
 			if( report )
 			{
-				idLib::Printf( "    Obj %d Compressed: Size %d \n", objectNum, rleCompressor.CompressedSize() );
+				idLib::Printf( "    Obj %d Compressed: Size %d \n", objectNum, compressedSize );
 			}
 		}
 #ifdef SNAPSHOT_CHECKSUMS
@@ -440,7 +437,7 @@ bool idSnapShot::ReadDeltaForJob( const char* deltaMem, int deltaSize, int visIn
 		if( state.buffer.Size() > 0 )
 		{
 			uint32 checksum = 0;
-			lzwCompressor.ReadAgnostic( checksum );
+			codec.ReadAgnostic( checksum );
 			bytesRead += sizeof( checksum );
 			if( !verify( checksum == SnapObjChecksum( state.buffer.Ptr(), state.buffer.Size() ) ) )
 			{
@@ -496,6 +493,7 @@ void idSnapShot::SubmitObjectJob(	const submitDeltaJobsInfo_t& 	submitDeltaJobsI
 	// Setup obj parms
 	assert( submitDeltaJobsInfo.visIndex < 256 );
 	curObjParm->visIndex	= submitDeltaJobsInfo.visIndex;
+	curObjParm->codec		= ( uint8 )submitDeltaJobsInfo.lzwInOutData->codec;
 	curObjParm->destHeader	= curHeader;
 	curObjParm->dest		= curObjDest;
 	
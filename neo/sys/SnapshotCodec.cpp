@@ -0,0 +1,1325 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#pragma hdrstop
+#include "precompiled.h"
+
+#include "SnapshotCodec.h"
+
+idCVar net_snapCodec( "net_snapCodec", "1", CVAR_INTEGER, "snapshot delta codec the host writes for peers that support it: 0 = lzw, 1 = fast (xor delta, zero runs, lz77)", 0, SNAP_CODEC_MAX - 1 );
+
+/*
+========================
+CountEqualBytes
+Number of leading bytes that match in a and b, a NULL b compares against zero
+========================
+*/
+static int CountEqualBytes( const uint8* a, const uint8* b, int count )
+{
+	int n = 0;
+	
+#if defined(USE_INTRINSICS)
+	const __m128i zero = _mm_setzero_si128();
+	for( ; n + 16 <= count; n += 16 )
+	{
+		const __m128i va = _mm_loadu_si128( ( const __m128i* )( a + n ) );
+		const __m128i vb = ( b != NULL ) ? _mm_loadu_si128( ( const __m128i* )( b + n ) ) : zero;
+		if( _mm_movemask_epi8( _mm_cmpeq_epi8( va, vb ) ) != 0xFFFF )
+		{
+			break;
+		}
+	}
+#endif
+	
+	if( b != NULL )
+	{
+		while( n < count && a[n] == b[n] )
+		{
+			n++;
+		}
+	}
+	else
+	{
+		while( n < count && a[n] == 0 )
+		{
+			n++;
+		}
+	}
+	return n;
+}
+
+/*
+========================
+XorBytes
+========================
+*/
+static void XorBytes( uint8* dest, const uint8* a, const uint8* b, int count )
+{
+	int n = 0;
+	
+#if defined(USE_INTRINSICS)
+	for( ; n + 16 <= count; n += 16 )
+	{
+		const __m128i va = _mm_loadu_si128( ( const __m128i* )( a + n ) );
+		const __m128i vb = _mm_loadu_si128( ( const __m128i* )( b + n ) );
+		_mm_storeu_si128( ( __m128i* )( dest + n ), _mm_xor_si128( va, vb ) );
+	}
+#endif
+	
+	for( ; n < count; n++ )
+	{
+		dest[n] = a[n] ^ b[n];
+	}
+}
+
+/*
+========================
+DeltaByte
+The xor delta of newData against the first compareSize bytes of oldData, bytes past that are sent as is
+========================
+*/
+static ID_INLINE uint8 DeltaByte( const uint8* newData, const uint8* oldData, int compareSize, int i )
+{
+	return ( i < compareSize ) ? ( newData[i] ^ oldData[i] ) : newData[i];
+}
+
+/*
+========================
+ZeroDeltaLength
+========================
+*/
+static int ZeroDeltaLength( const uint8* newData, const uint8* oldData, int compareSize, int start, int size )
+{
+	int n = 0;
+	if( start < compareSize )
+	{
+		n = CountEqualBytes( newData + start, oldData + start, compareSize - start );
+		if( start + n < compareSize )
+		{
+			return n;
+		}
+	}
+	const int rest = start + n;
+	return n + CountEqualBytes( newData + rest, NULL, size - rest );
+}
+
+/*
+========================
+ZeroRunEncode
+Writes the delta as runs. A run byte below 0x80 is followed by run + 1 literal bytes,
+otherwise it stands for ( run & 0x7F ) + 1 zeroes. Returns -1 if it doesn't fit in maxSize.
+========================
+*/
+static int ZeroRunEncode( uint8* dest, int maxSize, const uint8* newData, const uint8* oldData, int compareSize, int size )
+{
+	const int maxRun = idSnapDeltaCodecFast::MAX_RUN;
+	
+	int compressed = 0;
+	int i = 0;
+	while( i < size )
+	{
+		int zeroes = ZeroDeltaLength( newData, oldData, compareSize, i, size );
+		
+		if( zeroes >= 2 || i + zeroes == size )
+		{
+			i += zeroes;
+			while( zeroes > 0 )
+			{
+				const int run = Min( zeroes, maxRun );
+				if( compressed + 1 > maxSize )
+				{
+					return -1;
+				}
+				dest[compressed++] = ( uint8 )( 0x80 | ( run - 1 ) );
+				zeroes -= run;
+			}
+			continue;
+		}
+		
+		// Literals up to the next pair of zeroes, a single zero is cheaper to send as a literal
+		int end = i + 1;
+		while( end < size && end - i < maxRun )
+		{
+			if( DeltaByte( newData, oldData, compareSize, end ) == 0 && end + 1 < size && DeltaByte( newData, oldData, compareSize, end + 1 ) == 0 )
+			{
+				break;
+			}
+			end++;
+		}
+		
+		const int run = end - i;
+		if( compressed + 1 + run > maxSize )
+		{
+			return -1;
+		}
+		dest[compressed++] = ( uint8 )( run - 1 );
+		
+		const int xorEnd = Min( end, compareSize );
+		if( i < xorEnd )
+		{
+			XorBytes( dest + compressed, newData + i, oldData + i, xorEnd - i );
+		}
+		const int copyStart = Max( i, compareSize );
+		if( copyStart < end )
+		{
+			memcpy( dest + compressed + copyStart - i, newData + copyStart, end - copyStart );
+		}
+		
+		compressed += run;
+		i = end;
+	}
+	
+	return compressed;
+}
+
+/*
+========================
+ZeroRunDecode
+Returns the number of src bytes used, or -1 if the runs are malformed
+========================
+*/
+static int ZeroRunDecode( uint8* dest, int size, const uint8* src, int srcSize )
+{
+	int read = 0;
+	int written = 0;
+	while( written < size )
+	{
+		if( read >= srcSize )
+		{
+			return -1;
+		}
+		
+		const int code = src[read++];
+		const int run = ( code & 0x7F ) + 1;
+		
+		if( run > size - written )
+		{
+			return -1;
+		}
+		
+		if( code & 0x80 )
+		{
+			memset( dest + written, 0, run );
+		}
+		else
+		{
+			if( run > srcSize - read )
+			{
+				return -1;
+			}
+			memcpy( dest + written, src + read, run );
+			read += run;
+		}
+		written += run;
+	}
+	return read;
+}
+
+/*
+========================
+LZ stage helpers
+
+A sequence is a token byte holding the literal count in the high nibble and the match length - MIN_MATCH in
+the low nibble, a nibble of 15 continues in following bytes that are added until one is below 255. The literals
+follow the literal count, then the 16 bit match offset, then the match length. The last sequence of a stream
+has no match.
+========================
+*/
+static ID_INLINE uint32 ReadSequence( const uint8* p )
+{
+	uint32 v;
+	memcpy( &v, p, sizeof( v ) );
+	return v;
+}
+
+static ID_INLINE int HashSequence( uint32 v )
+{
+	return ( int )( ( v * 2654435761U ) >> ( 32 - snapFastCodecData_t::HASH_BITS ) );
+}
+
+static ID_INLINE int LengthBytes( int length )
+{
+	return ( length < 15 ) ? 0 : ( length - 15 ) / 255 + 1;
+}
+
+static ID_INLINE int LiteralCost( int numLiterals )
+{
+	return ( numLiterals > 0 ) ? 1 + LengthBytes( numLiterals ) + numLiterals : 0;
+}
+
+static ID_INLINE int SequenceCost( int numLiterals, int matchLength )
+{
+	return 1 + LengthBytes( numLiterals ) + numLiterals + 2 + LengthBytes( matchLength - idSnapDeltaCodecFast::MIN_MATCH );
+}
+
+static uint8* WriteLength( uint8* out, int length )
+{
+	for( length -= 15; length >= 255; length -= 255 )
+	{
+		*out++ = 255;
+	}
+	*out++ = ( uint8 )length;
+	return out;
+}
+
+static bool ReadLength( const uint8*& in, const uint8* end, int& length )
+{
+	int b;
+	do
+	{
+		if( in >= end || length > snapFastCodecData_t::MAX_RAW_BYTES )
+		{
+			return false;
+		}
+		b = *in++;
+		length += b;
+	}
+	while( b == 255 );
+	
+	return true;
+}
+
+/*
+========================
+LZDecode
+Decodes until the input runs out, returns the number of bytes written or -1 if the stream is malformed.
+With truncate set, decoding stops once limit bytes are written instead of failing.
+========================
+*/
+static int LZDecode( const uint8* in, const uint8* end, uint8* out, int limit, bool truncate )
+{
+	const int minMatch = idSnapDeltaCodecFast::MIN_MATCH;
+	
+	int written = 0;
+	while( in < end && written < limit )
+	{
+		const int token = *in++;
+		
+		int numLiterals = token >> 4;
+		if( numLiterals == 15 && !ReadLength( in, end, numLiterals ) )
+		{
+			return -1;
+		}
+		if( numLiterals > end - in )
+		{
+			return -1;
+		}
+		if( numLiterals > limit - written )
+		{
+			if( !truncate )
+			{
+				return -1;
+			}
+			numLiterals = limit - written;
+		}
+		memcpy( out + written, in, numLiterals );
+		in += numLiterals;
+		written += numLiterals;
+		
+		if( in >= end || written == limit )
+		{
+			break;		// Last sequence has no match
+		}
+		
+		if( end - in < 2 )
+		{
+			return -1;
+		}
+		const int offset = in[0] | ( in[1] << 8 );
+		in += 2;
+		
+		int matchLength = token & 15;
+		if( matchLength == 15 && !ReadLength( in, end, matchLength ) )
+		{
+			return -1;
+		}
+		matchLength += minMatch;
+		
+		if( offset == 0 || offset > written )
+		{
+			return -1;
+		}
+		if( matchLength > limit - written )
+		{
+			if( !truncate )
+			{
+				return -1;
+			}
+			matchLength = limit - written;
+		}
+		
+		const uint8* match = out + written - offset;
+		if( offset >= matchLength )
+		{
+			memcpy( out + written, match, matchLength );
+		}
+		else
+		{
+			// Overlapping match, repeats the last offset bytes
+			for( int i = 0; i < matchLength; i++ )
+			{
+				out[written + i] = match[i];
+			}
+		}
+		written += matchLength;
+	}
+	
+	if( !truncate && in < end )
+	{
+		return -1;		// More input than the header said there was output
+	}
+	return written;
+}
+
+/*
+================================================================================================
+
+	idSnapDeltaCodec
+
+================================================================================================
+*/
+
+/*
+========================
+idSnapDeltaCodec::EncodeObject
+========================
+*/
+int idSnapDeltaCodec::EncodeObject( snapDeltaCodec_t codec, uint8* dest, int maxSize, const uint8* newData, int newSize, const uint8* oldData, int oldSize )
+{
+	if( codec == SNAP_CODEC_FAST )
+	{
+		return idSnapDeltaCodecFast::EncodeObjectDelta( dest, maxSize, newData, newSize, oldData, oldSize );
+	}
+	return idSnapDeltaCodecLZW::EncodeObjectDelta( dest, maxSize, newData, newSize, oldData, oldSize );
+}
+
+/*
+========================
+idSnapDeltaCodec::PeekType
+========================
+*/
+snapDeltaCodec_t idSnapDeltaCodec::PeekType( const uint8* data, int size )
+{
+	if( size < 1 || data[0] >= SNAP_CODEC_MAX )
+	{
+		return SNAP_CODEC_MAX;
+	}
+	return ( snapDeltaCodec_t )data[0];
+}
+
+/*
+========================
+idSnapDeltaCodec::PeekHeader
+Reads the first length bytes of a delta without decoding all of it
+========================
+*/
+bool idSnapDeltaCodec::PeekHeader( const uint8* data, int size, void* dest, int length )
+{
+	const snapDeltaCodec_t codec = PeekType( data, size );
+	
+	if( codec == SNAP_CODEC_FAST )
+	{
+		if( size < idSnapDeltaCodecFast::HEADER_SIZE )
+		{
+			return false;
+		}
+		return LZDecode( data + idSnapDeltaCodecFast::HEADER_SIZE, data + size, ( uint8* )dest, length, true ) == length;
+	}
+	
+	if( codec == SNAP_CODEC_LZW )
+	{
+		lzwCompressionData_t	lzwData;
+		idLZWCompressor			lzwCompressor( &lzwData );
+		
+		lzwCompressor.Start( const_cast<uint8*>( data ) + 1, size - 1 );
+		return lzwCompressor.Read( dest, length, true ) == length;
+	}
+	
+	return false;
+}
+
+/*
+========================
+idSnapDeltaCodec::GetName
+========================
+*/
+const char* idSnapDeltaCodec::GetName( snapDeltaCodec_t codec )
+{
+	switch( codec )
+	{
+		case SNAP_CODEC_LZW:
+			return "lzw";
+		case SNAP_CODEC_FAST:
+			return "fast";
+		default:
+			return "unknown";
+	}
+}
+
+/*
+========================
+idSnapDeltaCodec::Negotiate
+========================
+*/
+snapDeltaCodec_t idSnapDeltaCodec::Negotiate( int peerCodecs )
+{
+	const int preferred = net_snapCodec.GetInteger();
+	if( preferred >= 0 && preferred < SNAP_CODEC_MAX && ( peerCodecs & ( 1 << preferred ) ) != 0 )
+	{
+		return ( snapDeltaCodec_t )preferred;
+	}
+	// Every peer can read lzw
+	return SNAP_CODEC_LZW;
+}
+
+/*
+================================================================================================
+
+	idSnapDeltaCodecLZW
+
+================================================================================================
+*/
+
+/*
+========================
+idSnapDeltaCodecLZW::EncodeObjectDelta
+========================
+*/
+int idSnapDeltaCodecLZW::EncodeObjectDelta( uint8* dest, int maxSize, const uint8* newData, int newSize, const uint8* oldData, int oldSize )
+{
+	const int compareSize = ( oldData != NULL ) ? Min( newSize, oldSize ) : 0;
+	const int leftOver = newSize - compareSize;
+	
+	idZeroRunLengthCompressor rleCompressor;
+	rleCompressor.Start( dest, NULL, maxSize );
+	for( int b = 0; b < compareSize; b++ )
+	{
+		byte delta = newData[b] - oldData[b];
+		rleCompressor.WriteByte( ( 0xFF + 1 + delta ) & 0xFF );
+	}
+	if( leftOver > 0 )
+	{
+		rleCompressor.WriteBytes( const_cast<uint8*>( newData ) + compareSize, leftOver );
+	}
+	
+	const int csize = rleCompressor.End();
+	
+	if( csize == -1 )
+	{
+		// Not enough space, don't compress, have lzw job do zrle compression instead
+		for( int b = 0; b < compareSize; b++ )
+		{
+			*dest++ = ( ( 0xFF + 1 + ( newData[b] - oldData[b] ) ) & 0xFF );
+		}
+		if( leftOver > 0 )
+		{
+			memcpy( dest, newData + compareSize, leftOver );
+		}
+	}
+	
+	return csize;
+}
+
+/*
+========================
+idSnapDeltaCodecLZW::StartWrite
+========================
+*/
+void idSnapDeltaCodecLZW::StartWrite( uint8* data_, int maxSize, bool append )
+{
+	data = data_;
+	data[0] = SNAP_CODEC_LZW;
+	lzwCompressor.Start( data + 1, maxSize - 1, append );
+}
+
+/*
+========================
+idSnapDeltaCodecLZW::Write
+========================
+*/
+void idSnapDeltaCodecLZW::Write( const void* src, int length )
+{
+	lzwCompressor.Write( src, length );
+}
+
+/*
+========================
+idSnapDeltaCodecLZW::WriteRawDelta
+========================
+*/
+void idSnapDeltaCodecLZW::WriteRawDelta( const uint8* delta, int size )
+{
+	idZeroRunLengthCompressor rleCompressor;
+	rleCompressor.Start( NULL, &lzwCompressor, 0xFFFF );
+	rleCompressor.WriteBytes( const_cast<uint8*>( delta ), size );
+	rleCompressor.End();
+}
+
+/*
+========================
+idSnapDeltaCodecLZW::Save
+========================
+*/
+void idSnapDeltaCodecLZW::Save()
+{
+	lzwCompressor.Save();
+}
+
+/*
+========================
+idSnapDeltaCodecLZW::Restore
+========================
+*/
+void idSnapDeltaCodecLZW::Restore()
+{
+	lzwCompressor.Restore();
+}
+
+/*
+========================
+idSnapDeltaCodecLZW::IsOverflowed
+========================
+*/
+bool idSnapDeltaCodecLZW::IsOverflowed()
+{
+	return lzwCompressor.IsOverflowed();
+}
+
+/*
+========================
+idSnapDeltaCodecLZW::Length
+========================
+*/
+int idSnapDeltaCodecLZW::Length()
+{
+	return lzwCompressor.Length() + 1;
+}
+
+/*
+========================
+idSnapDeltaCodecLZW::End
+========================
+*/
+int idSnapDeltaCodecLZW::End()
+{
+	const int length = lzwCompressor.End();
+	return ( length == -1 ) ? -1 : length + 1;
+}
+
+/*
+========================
+idSnapDeltaCodecLZW::StartRead
+========================
+*/
+bool idSnapDeltaCodecLZW::StartRead( const uint8* src, int size )
+{
+	if( PeekType( src, size ) != SNAP_CODEC_LZW )
+	{
+		return false;
+	}
+	lzwCompressor.Start( const_cast<uint8*>( src ) + 1, size - 1 );
+	return true;
+}
+
+/*
+========================
+idSnapDeltaCodecLZW::Read
+========================
+*/
+int idSnapDeltaCodecLZW::Read( void* dest, int length, bool ignoreOverflow )
+{
+	return lzwCompressor.Read( dest, length, ignoreOverflow );
+}
+
+/*
+========================
+idSnapDeltaCodecLZW::ReadObject
+========================
+*/
+int idSnapDeltaCodecLZW::ReadObject( uint8* dest, int size, const uint8* base, int baseSize )
+{
+	const int compareSize = ( base != NULL ) ? Min( baseSize, size ) : 0;
+	
+	idZeroRunLengthCompressor rleCompressor;
+	rleCompressor.Start( NULL, &lzwCompressor, size );
+	for( int i = 0; i < compareSize; i++ )
+	{
+		dest[i] = base[i] + rleCompressor.ReadByte();
+	}
+	// Catch leftover
+	if( size > compareSize )
+	{
+		rleCompressor.ReadBytes( dest + compareSize, size - compareSize );
+	}
+	return rleCompressor.CompressedSize();
+}
+
+/*
+================================================================================================
+
+	idSnapDeltaCodecFast
+
+================================================================================================
+*/
+
+/*
+========================
+idSnapDeltaCodecFast::EncodeObjectDelta
+========================
+*/
+int idSnapDeltaCodecFast::EncodeObjectDelta( uint8* dest, int maxSize, const uint8* newData, int newSize, const uint8* oldData, int oldSize )
+{
+	const int compareSize = ( oldData != NULL ) ? Min( newSize, oldSize ) : 0;
+	
+	const int csize = ZeroRunEncode( dest, maxSize, newData, oldData, compareSize, newSize );
+	
+	if( csize == -1 )
+	{
+		// Not enough space, store the raw delta and have the lzw job run length code it
+		XorBytes( dest, newData, oldData, compareSize );
+		memcpy( dest + compareSize, newData + compareSize, newSize - compareSize );
+	}
+	
+	return csize;
+}
+
+/*
+========================
+idSnapDeltaCodecFast::StartWrite
+========================
+*/
+void idSnapDeltaCodecFast::StartWrite( uint8* data_, int maxSize_, bool append )
+{
+	assert( state != NULL );
+	
+	data	= data_;
+	maxSize	= maxSize_;
+	
+	if( append )
+	{
+		return;		// Continue where the last job left off
+	}
+	
+	memset( state->hash, 0xFF, sizeof( state->hash ) );
+	
+	state->rawLength	= 0;
+	state->literalStart	= 0;
+	state->matchPos		= 0;
+	state->bytesWritten	= HEADER_SIZE;
+	state->overflowed	= ( maxSize < HEADER_SIZE );
+	
+	state->savedRawLength		= state->rawLength;
+	state->savedLiteralStart	= state->literalStart;
+	state->savedMatchPos		= state->matchPos;
+	state->savedBytesWritten	= state->bytesWritten;
+	
+	if( !state->overflowed )
+	{
+		data[0] = SNAP_CODEC_FAST;
+	}
+}
+
+/*
+========================
+idSnapDeltaCodecFast::CheckOverflow
+At any point the stream has to be able to End with the unmatched bytes sent as literals
+========================
+*/
+void idSnapDeltaCodecFast::CheckOverflow()
+{
+	if( state->bytesWritten + LiteralCost( state->rawLength - state->literalStart ) <= maxSize )
+	{
+		return;
+	}
+	
+	Compress();
+	
+	if( state->bytesWritten + LiteralCost( state->rawLength - state->literalStart ) > maxSize )
+	{
+		state->overflowed = true;
+	}
+}
+
+/*
+========================
+idSnapDeltaCodecFast::Write
+========================
+*/
+void idSnapDeltaCodecFast::Write( const void* src, int length )
+{
+	if( state->overflowed )
+	{
+		return;
+	}
+	
+	if( length > snapFastCodecData_t::MAX_RAW_BYTES - state->rawLength )
+	{
+		state->overflowed = true;
+		return;
+	}
+	
+	memcpy( state->raw + state->rawLength, src, length );
+	state->rawLength += length;
+	
+	CheckOverflow();
+}
+
+/*
+========================
+idSnapDeltaCodecFast::WriteRawDelta
+========================
+*/
+void idSnapDeltaCodecFast::WriteRawDelta( const uint8* delta, int size )
+{
+	if( state->overflowed )
+	{
+		return;
+	}
+	
+	const int csize = ZeroRunEncode( state->raw + state->rawLength, snapFastCodecData_t::MAX_RAW_BYTES - state->rawLength, delta, NULL, 0, size );
+	
+	if( csize == -1 )
+	{
+		state->overflowed = true;
+		return;
+	}
+	
+	state->rawLength += csize;
+	
+	CheckOverflow();
+}
+
+/*
+========================
+idSnapDeltaCodecFast::Compress
+Greedy lz77 over the raw bytes that haven't been looked at yet
+========================
+*/
+void idSnapDeltaCodecFast::Compress()
+{
+	const uint8* raw		= state->raw;
+	const int rawLength		= state->rawLength;
+	const int lastMatch		= rawLength - MIN_MATCH;
+	
+	int pos = state->matchPos;
+	
+	while( pos <= lastMatch )
+	{
+		const uint32 sequence = ReadSequence( raw + pos );
+		const int hashIndex = HashSequence( sequence );
+		const int candidate = state->hash[hashIndex];
+		state->hash[hashIndex] = ( uint16 )pos;
+		
+		// Stale entries from a restored stream are caught by comparing the bytes
+		if( candidate >= pos || ReadSequence( raw + candidate ) != sequence )
+		{
+			pos++;
+			continue;
+		}
+		
+		const int matchLength = MIN_MATCH + CountEqualBytes( raw + pos + MIN_MATCH, raw + candidate + MIN_MATCH, rawLength - pos - MIN_MATCH );
+		const int numLiterals = pos - state->literalStart;
+		
+		// Only take the match if the rest of the stream still fits as literals, so End can't fail
+		if( state->bytesWritten + SequenceCost( numLiterals, matchLength ) + LiteralCost( rawLength - pos - matchLength ) > maxSize )
+		{
+			break;
+		}
+		
+		EmitSequence( numLiterals, pos - candidate, matchLength );
+		
+		pos += matchLength;
+		state->literalStart = pos;
+	}
+	
+	state->matchPos = pos;
+}
+
+/*
+========================
+idSnapDeltaCodecFast::EmitSequence
+========================
+*/
+void idSnapDeltaCodecFast::EmitSequence( int numLiterals, int offset, int matchLength )
+{
+	assert( offset > 0 && offset <= 0xFFFF );
+	
+	uint8* start = data + state->bytesWritten;
+	uint8* out = start;
+	
+	const int matchCode = matchLength - MIN_MATCH;
+	
+	*out++ = ( uint8 )( ( Min( numLiterals, 15 ) << 4 ) | Min( matchCode, 15 ) );
+	if( numLiterals >= 15 )
+	{
+		out = WriteLength( out, numLiterals );
+	}
+	
+	memcpy( out, state->raw + state->literalStart, numLiterals );
+	out += numLiterals;
+	
+	*out++ = ( uint8 )( offset & 0xFF );
+	*out++ = ( uint8 )( offset >> 8 );
+	if( matchCode >= 15 )
+	{
+		out = WriteLength( out, matchCode );
+	}
+	
+	state->bytesWritten += ( int )( out - start );
+}
+
+/*
+========================
+idSnapDeltaCodecFast::Save
+========================
+*/
+void idSnapDeltaCodecFast::Save()
+{
+	Compress();
+	
+	assert( !state->overflowed );
+	
+	state->savedRawLength		= state->rawLength;
+	state->savedLiteralStart	= state->literalStart;
+	state->savedMatchPos		= state->matchPos;
+	state->savedBytesWritten	= state->bytesWritten;
+}
+
+/*
+========================
+idSnapDeltaCodecFast::Restore
+========================
+*/
+void idSnapDeltaCodecFast::Restore()
+{
+	state->rawLength	= state->savedRawLength;
+	state->literalStart	= state->savedLiteralStart;
+	state->matchPos		= state->savedMatchPos;
+	state->bytesWritten	= state->savedBytesWritten;
+	state->overflowed	= false;
+}
+
+/*
+========================
+idSnapDeltaCodecFast::IsOverflowed
+========================
+*/
+bool idSnapDeltaCodecFast::IsOverflowed()
+{
+	return state->overflowed;
+}
+
+/*
+========================
+idSnapDeltaCodecFast::Length
+Size of the stream if it was ended now
+========================
+*/
+int idSnapDeltaCodecFast::Length()
+{
+	if( !state->overflowed )
+	{
+		Compress();
+	}
+	return state->bytesWritten + LiteralCost( state->rawLength - state->literalStart );
+}
+
+/*
+========================
+idSnapDeltaCodecFast::End
+========================
+*/
+int idSnapDeltaCodecFast::End()
+{
+	if( state->overflowed )
+	{
+		return -1;
+	}
+	
+	Compress();
+	
+	// Trailing literals without a match
+	const int numLiterals = state->rawLength - state->literalStart;
+	if( numLiterals > 0 )
+	{
+		assert( state->bytesWritten + LiteralCost( numLiterals ) <= maxSize );
+		
+		uint8* out = data + state->bytesWritten;
+		*out++ = ( uint8 )( Min( numLiterals, 15 ) << 4 );
+		if( numLiterals >= 15 )
+		{
+			out = WriteLength( out, numLiterals );
+		}
+		memcpy( out, state->raw + state->literalStart, numLiterals );
+		
+		state->bytesWritten += LiteralCost( numLiterals );
+		state->literalStart = state->rawLength;
+	}
+	state->matchPos = state->rawLength;
+	
+	data[1] = ( uint8 )( state->rawLength & 0xFF );
+	data[2] = ( uint8 )( state->rawLength >> 8 );
+	
+	return state->bytesWritten;
+}
+
+/*
+========================
+idSnapDeltaCodecFast::Decompress
+========================
+*/
+bool idSnapDeltaCodecFast::Decompress( const uint8* src, int size )
+{
+	const int rawLength = src[1] | ( src[2] << 8 );
+	decoded.SetNum( rawLength );
+	
+	return LZDecode( src + HEADER_SIZE, src + size, decoded.Ptr(), rawLength, false ) == rawLength;
+}
+
+/*
+========================
+idSnapDeltaCodecFast::StartRead
+========================
+*/
+bool idSnapDeltaCodecFast::StartRead( const uint8* src, int size )
+{
+	readCount = 0;
+	
+	if( PeekType( src, size ) != SNAP_CODEC_FAST || size < HEADER_SIZE || !Decompress( src, size ) )
+	{
+		decoded.SetNum( 0 );
+		return false;
+	}
+	return true;
+}
+
+/*
+========================
+idSnapDeltaCodecFast::Read
+========================
+*/
+int idSnapDeltaCodecFast::Read( void* dest, int length, bool ignoreOverflow )
+{
+	const int count = Min( length, decoded.Num() - readCount );
+	
+	memcpy( dest, decoded.Ptr() + readCount, count );
+	readCount += count;
+	
+	if( count < length && !ignoreOverflow )
+	{
+		assert( !"idSnapDeltaCodecFast::Read overflowed!" );
+	}
+	return count;
+}
+
+/*
+========================
+idSnapDeltaCodecFast::ReadObject
+========================
+*/
+int idSnapDeltaCodecFast::ReadObject( uint8* dest, int size, const uint8* base, int baseSize )
+{
+	const int csize = ZeroRunDecode( dest, size, decoded.Ptr() + readCount, decoded.Num() - readCount );
+	
+	if( csize == -1 )
+	{
+		assert( !"idSnapDeltaCodecFast::ReadObject malformed delta!" );
+		memset( dest, 0, size );
+		readCount = decoded.Num();		// Stop reading, the delta is treated as partial
+		return 0;
+	}
+	
+	readCount += csize;
+	
+	if( base != NULL )
+	{
+		XorBytes( dest, dest, base, Min( size, baseSize ) );
+	}
+	return csize;
+}
+
+/*
+================================================================================================
+
+	Snapshot capture and codec benchmark
+
+================================================================================================
+*/
+
+static const int SNAP_CAPTURE_IDENT		= ( 'S' << 24 ) | ( 'N' << 16 ) | ( 'A' << 8 ) | 'P';
+static const int SNAP_CAPTURE_VERSION	= 1;
+
+static idFile* snapCaptureFile = NULL;
+
+/*
+========================
+RecordSnapshotCapture
+Called by the host for every snapshot it sends, clientMask has bit visIndex set for each peer it goes to
+========================
+*/
+void RecordSnapshotCapture( const idSnapShot& ss, uint32 clientMask )
+{
+	if( snapCaptureFile == NULL || clientMask == 0 )
+	{
+		return;
+	}
+	
+	snapCaptureFile->WriteBig( ss.GetTime() );
+	snapCaptureFile->WriteBig( clientMask );
+	snapCaptureFile->WriteBig( ss.NumObjects() );
+	
+	for( int i = 0; i < ss.NumObjects(); i++ )
+	{
+		idBitMsg msg;
+		const int objectNum = ss.GetObjectMsgByIndex( i, msg );
+		const idSnapShot::objectState_t* state = ss.FindObjectByID( objectNum );
+		
+		snapCaptureFile->WriteBig( ( uint16 )objectNum );
+		snapCaptureFile->WriteBig( state->visMask );
+		snapCaptureFile->WriteBig( msg.GetSize() );
+		snapCaptureFile->Write( msg.GetReadData(), msg.GetSize() );
+	}
+}
+
+CONSOLE_COMMAND( recordSnapshots, "records the snapshots the host sends to a file for benchmarkSnapCodecs", 0 )
+{
+	if( snapCaptureFile != NULL )
+	{
+		idLib::Printf( "stopped recording snapshots to %s\n", snapCaptureFile->GetName() );
+		fileSystem->CloseFile( snapCaptureFile );
+		snapCaptureFile = NULL;
+		return;
+	}
+	
+	const char* fileName = ( args.Argc() > 1 ) ? args.Argv( 1 ) : "snapshots.snapcap";
+	
+	snapCaptureFile = fileSystem->OpenFileWrite( fileName );
+	if( snapCaptureFile == NULL )
+	{
+		idLib::Printf( "couldn't open %s\n", fileName );
+		return;
+	}
+	
+	snapCaptureFile->WriteBig( SNAP_CAPTURE_IDENT );
+	snapCaptureFile->WriteBig( SNAP_CAPTURE_VERSION );
+	
+	idLib::Printf( "recording snapshots to %s\n", fileName );
+}
+
+/*
+========================
+CountMismatchedObjects
+Objects visible to visIndex that didn't come through the delta intact
+========================
+*/
+static int CountMismatchedObjects( const idSnapShot& sent, const idSnapShot& received, int visIndex )
+{
+	int mismatched = 0;
+	for( int i = 0; i < sent.NumObjects(); i++ )
+	{
+		idBitMsg msg;
+		const int objectNum = sent.GetObjectMsgByIndex( i, msg );
+		const idSnapShot::objectState_t* state = sent.FindObjectByID( objectNum );
+		
+		if( ( state->visMask & ( 1 << visIndex ) ) == 0 )
+		{
+			continue;
+		}
+		
+		idSnapShot::objectState_t* receivedState = received.FindObjectByID( objectNum );
+		if( receivedState == NULL || receivedState->buffer.Size() != msg.GetSize() || memcmp( receivedState->buffer.Ptr(), msg.GetReadData(), msg.GetSize() ) != 0 )
+		{
+			mismatched++;
+		}
+	}
+	return mismatched;
+}
+
+CONSOLE_COMMAND( benchmarkSnapCodecs, "replays a recordSnapshots file through every snapshot delta codec", 0 )
+{
+	if( args.Argc() < 2 )
+	{
+		idLib::Printf( "usage: benchmarkSnapCodecs <file>\n" );
+		return;
+	}
+	
+	idFile* file = fileSystem->OpenFileRead( args.Argv( 1 ) );
+	if( file == NULL )
+	{
+		idLib::Printf( "couldn't open %s\n", args.Argv( 1 ) );
+		return;
+	}
+	
+	int ident = 0;
+	int version = 0;
+	file->ReadBig( ident );
+	file->ReadBig( version );
+	if( ident != SNAP_CAPTURE_IDENT || version != SNAP_CAPTURE_VERSION )
+	{
+		idLib::Printf( "%s is not a snapshot capture\n", args.Argv( 1 ) );
+		fileSystem->CloseFile( file );
+		return;
+	}
+	
+	idList< idSnapShot* > snaps;
+	idList< uint32 > clientMasks;
+	idList< byte > objectData;
+	uint32 allClients = 0;
+	
+	while( file->Tell() < file->Length() )
+	{
+		int time = 0;
+		uint32 clientMask = 0;
+		int numObjects = 0;
+		file->ReadBig( time );
+		file->ReadBig( clientMask );
+		file->ReadBig( numObjects );
+		
+		idSnapShot* ss = new( TAG_NETWORKING ) idSnapShot;
+		ss->SetTime( time );
+		
+		for( int i = 0; i < numObjects; i++ )
+		{
+			uint16 objectNum = 0;
+			uint32 visMask = 0;
+			int size = 0;
+			file->ReadBig( objectNum );
+			file->ReadBig( visMask );
+			file->ReadBig( size );
+			
+			objectData.SetNum( size );
+			file->Read( objectData.Ptr(), size );
+			ss->S_AddObject( objectNum, visMask, objectData.Ptr(), size );
+		}
+		
+		snaps.Append( ss );
+		clientMasks.Append( clientMask );
+		allClients |= clientMask;
+	}
+	fileSystem->CloseFile( file );
+	
+	static const int OBJ_MEMORY = 1024 * 128;
+	
+	uint8* objMemory = ( uint8* )Mem_Alloc( OBJ_MEMORY, TAG_NETWORKING );
+	lzwCompressionData_t* lzwData = ( lzwCompressionData_t* )Mem_Alloc( sizeof( lzwCompressionData_t ), TAG_NETWORKING );
+	snapFastCodecData_t* fastData = ( snapFastCodecData_t* )Mem_Alloc( sizeof( snapFastCodecData_t ), TAG_NETWORKING );
+	
+	byte delta[ idPacketProcessor::MAX_MSG_SIZE ];
+	
+	idLib::Printf( "%d snapshots\n", snaps.Num() );
+	
+	for( int c = 0; c < SNAP_CODEC_MAX; c++ )
+	{
+		const snapDeltaCodec_t codec = ( snapDeltaCodec_t )c;
+		
+		int numClients = 0;
+		int numDeltas = 0;
+		int numObjects = 0;
+		int mismatched = 0;
+		int64 totalBytes = 0;
+		uint64 encodeTime = 0;
+		uint64 decodeTime = 0;
+		
+		for( int visIndex = 1; visIndex < 32; visIndex++ )
+		{
+			if( ( allClients & ( 1 << visIndex ) ) == 0 )
+			{
+				continue;
+			}
+			numClients++;
+			
+			idSnapshotProcessor* host = new( TAG_NETWORKING ) idSnapshotProcessor;
+			idSnapshotProcessor* client = new( TAG_NETWORKING ) idSnapshotProcessor;
+			host->SetDeltaCodec( codec );
+			
+			idSnapShot received;
+			
+			for( int f = 0; f < snaps.Num(); f++ )
+			{
+				if( ( clientMasks[f] & ( 1 << visIndex ) ) == 0 )
+				{
+					continue;
+				}
+				
+				host->TrySetPendingSnapshot( *snaps[f] );
+				
+				const uint64 encodeStart = Sys_Microseconds();
+				host->SubmitPendingSnap( visIndex, objMemory, OBJ_MEMORY, lzwData, fastData );
+				int size = host->GetPendingSnapDelta( delta, sizeof( delta ) );
+				encodeTime += Sys_Microseconds() - encodeStart;
+				
+				numObjects += host->GetPendingSnap()->NumObjects();
+				
+				if( size == 0 )
+				{
+					continue;
+				}
+				size = abs( size );
+				
+				totalBytes += size;
+				numDeltas++;
+				
+				int sequence = 0;
+				int baseSequence = 0;
+				bool fullSnap = false;
+				
+				const uint64 decodeStart = Sys_Microseconds();
+				const bool receivedDelta = client->ReceiveSnapshotDelta( delta, size, 0, sequence, baseSequence, received, fullSnap );
+				decodeTime += Sys_Microseconds() - decodeStart;
+				
+				if( !receivedDelta )
+				{
+					continue;
+				}
+				
+				if( fullSnap )
+				{
+					mismatched += CountMismatchedObjects( *host->GetPendingSnap(), received, visIndex );
+				}
+				
+				// The client acks every delta straight away
+				host->ApplySnapshotDelta( visIndex, sequence );
+			}
+			
+			delete host;
+			delete client;
+		}
+		
+		idLib::Printf( "%s: %d clients, %d deltas, %.1f bytes per delta, %.1f KB per client, encode %.3f usec per object, decode %.3f usec per object, %d mismatched objects\n",
+					   idSnapDeltaCodec::GetName( codec ), numClients, numDeltas,
+					   numDeltas > 0 ? ( float )totalBytes / numDeltas : 0.0f,
+					   numClients > 0 ? ( float )totalBytes / ( 1024.0f * numClients ) : 0.0f,
+					   numObjects > 0 ? ( float )encodeTime / numObjects : 0.0f,
+					   numObjects > 0 ? ( float )decodeTime / numObjects : 0.0f,
+					   mismatched );
+	}
+	
+	Mem_Free( objMemory );
+	Mem_Free( lzwData );
+	Mem_Free( fastData );
+	snaps.DeleteContents( true );
+}
@@ -0,0 +1,208 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+#ifndef __SNAPSHOT_CODEC_H__
+#define __SNAPSHOT_CODEC_H__
+
+/*
+Snapshot deltas are produced in two stages: the object jobs delta each object against its base state,
+and the lzw job packs the results into the final delta packet. A codec implements both stages and the
+matching reader. The first byte of every delta packet names the codec that wrote it, so deltas can
+always be read back. The host picks the codec it writes for each peer from the set the peer advertised
+when it connected.
+*/
+
+enum snapDeltaCodec_t
+{
+	SNAP_CODEC_LZW,			// Byte subtract delta, zero rle, lzw
+	SNAP_CODEC_FAST,		// Xor delta, zero runs, lz77 byte stage
+	SNAP_CODEC_MAX
+};
+
+static const int SNAP_CODEC_SUPPORTED = ( 1 << SNAP_CODEC_MAX ) - 1;		// Codecs this build can read
+
+// Fast codec state that needs to persist across lzw jobs (the fast counterpart of lzwCompressionData_t)
+struct snapFastCodecData_t
+{
+	static const int	MAX_RAW_BYTES	= 0xFFFF;			// Uncompressed stream size must fit the 16 bit header field
+	static const int	HASH_BITS		= 12;
+	static const int	HASH_SIZE		= 1 << HASH_BITS;
+	
+	uint8				raw[MAX_RAW_BYTES + 1];				// Uncompressed stream
+	uint16				hash[HASH_SIZE];					// Last raw position each 4 byte sequence was seen at
+	
+	int					rawLength;							// Bytes in raw
+	int					literalStart;						// First raw byte not yet covered by an emitted sequence
+	int					matchPos;							// Next raw position to look for a match at
+	int					bytesWritten;						// Compressed bytes written
+	bool				overflowed;
+	
+	// saving/restoring when overflow
+	int					savedRawLength;
+	int					savedLiteralStart;
+	int					savedMatchPos;
+	int					savedBytesWritten;
+};
+
+/*
+========================
+idSnapDeltaCodec
+========================
+*/
+class idSnapDeltaCodec
+{
+public:
+	virtual						~idSnapDeltaCodec() {}
+	
+	virtual snapDeltaCodec_t	GetType() const = 0;
+	
+	// Writing, used by the lzw job
+	virtual void				StartWrite( uint8* data, int maxSize, bool append ) = 0;
+	virtual void				Write( const void* data, int length ) = 0;
+	// Writes a delta that EncodeObject couldn't fit in the object memory
+	virtual void				WriteRawDelta( const uint8* delta, int size ) = 0;
+	virtual void				Save() = 0;
+	virtual void				Restore() = 0;		// Must call End directly after restoring
+	virtual bool				IsOverflowed() = 0;
+	virtual int					Length() = 0;
+	virtual int					End() = 0;
+	
+	// Reading
+	virtual bool				StartRead( const uint8* data, int size ) = 0;
+	virtual int					Read( void* data, int length, bool ignoreOverflow = false ) = 0;
+	// Reads an object delta and applies it to base (NULL if there is none), returns the encoded size
+	virtual int					ReadObject( uint8* dest, int size, const uint8* base, int baseSize ) = 0;
+	
+	template<class type> ID_INLINE void WriteAgnostic( const type& c )
+	{
+		Write( &c, sizeof( c ) );
+	}
+	
+	template<class type> ID_INLINE size_t ReadAgnostic( type& c, bool ignoreOverflow = false )
+	{
+		return Read( &c, sizeof( c ), ignoreOverflow );
+	}
+	
+	// Object stage, run from SnapshotObjectJob. Deltas newData against oldData (NULL for a new object) into dest.
+	// Returns the encoded size, or -1 if it didn't fit in maxSize, in which case dest holds the raw delta.
+	static int					EncodeObject( snapDeltaCodec_t codec, uint8* dest, int maxSize, const uint8* newData, int newSize, const uint8* oldData, int oldSize );
+	
+	static snapDeltaCodec_t		PeekType( const uint8* data, int size );
+	static bool					PeekHeader( const uint8* data, int size, void* dest, int length );
+	static const char* 			GetName( snapDeltaCodec_t codec );
+	// Picks the codec to write for a peer that can read peerCodecs (a mask of 1 << snapDeltaCodec_t)
+	static snapDeltaCodec_t		Negotiate( int peerCodecs );
+};
+
+/*
+========================
+idSnapDeltaCodecLZW
+The original snapshot codec, each delta byte is the difference between the new and old byte
+========================
+*/
+class idSnapDeltaCodecLZW : public idSnapDeltaCodec
+{
+public:
+	idSnapDeltaCodecLZW( lzwCompressionData_t* lzwData ) : lzwCompressor( lzwData ), data( NULL ) {}
+	
+	virtual snapDeltaCodec_t	GetType() const
+	{
+		return SNAP_CODEC_LZW;
+	}
+	
+	virtual void				StartWrite( uint8* data, int maxSize, bool append );
+	virtual void				Write( const void* data, int length );
+	virtual void				WriteRawDelta( const uint8* delta, int size );
+	virtual void				Save();
+	virtual void				Restore();
+	virtual bool				IsOverflowed();
+	virtual int					Length();
+	virtual int					End();
+	
+	virtual bool				StartRead( const uint8* data, int size );
+	virtual int					Read( void* data, int length, bool ignoreOverflow = false );
+	virtual int					ReadObject( uint8* dest, int size, const uint8* base, int baseSize );
+	
+	static int					EncodeObjectDelta( uint8* dest, int maxSize, const uint8* newData, int newSize, const uint8* oldData, int oldSize );
+	
+private:
+	idLZWCompressor				lzwCompressor;
+	uint8* 						data;
+};
+
+/*
+========================
+idSnapDeltaCodecFast
+Xor delta, zero run coded per object, then the whole stream goes through a byte aligned lz77 stage.
+Cheap to encode and decode, and the per object work vectorizes.
+========================
+*/
+class idSnapDeltaCodecFast : public idSnapDeltaCodec
+{
+public:
+	static const int			HEADER_SIZE		= 3;		// Codec byte, 16 bit uncompressed stream size
+	static const int			MIN_MATCH		= 4;
+	static const int			MAX_RUN			= 128;		// Longest zero or literal run a single run byte holds
+	
+	idSnapDeltaCodecFast( snapFastCodecData_t* fastData ) : state( fastData ), data( NULL ), maxSize( 0 ), readCount( 0 ) {}
+	
+	virtual snapDeltaCodec_t	GetType() const
+	{
+		return SNAP_CODEC_FAST;
+	}
+	
+	virtual void				StartWrite( uint8* data, int maxSize, bool append );
+	virtual void				Write( const void* data, int length );
+	virtual void				WriteRawDelta( const uint8* delta, int size );
+	virtual void				Save();
+	virtual void				Restore();
+	virtual bool				IsOverflowed();
+	virtual int					Length();
+	virtual int					End();
+	
+	virtual bool				StartRead( const uint8* data, int size );
+	virtual int					Read( void* data, int length, bool ignoreOverflow = false );
+	virtual int					ReadObject( uint8* dest, int size, const uint8* base, int baseSize );
+	
+	static int					EncodeObjectDelta( uint8* dest, int maxSize, const uint8* newData, int newSize, const uint8* oldData, int oldSize );
+	
+private:
+	void						CheckOverflow();
+	void						Compress();
+	void						EmitSequence( int numLiterals, int offset, int matchLength );
+	bool						Decompress( const uint8* src, int size );
+	
+	snapFastCodecData_t* 		state;
+	uint8* 						data;
+	int							maxSize;
+	
+	// For reading
+	idList< uint8, TAG_NETWORKING >	decoded;
+	int							readCount;
+};
+
+#endif // __SNAPSHOT_CODEC_H__
@@ -49,6 +49,8 @@ idSnapshotProcessor::idSnapshotProcessor()
 	assert_16_byte_aligned( jobMemory->headers.Ptr() );
 	assert_16_byte_aligned( jobMemory->lzwParms.Ptr() );
 	
+	deltaCodec = SNAP_CODEC_LZW;
+	
 	Reset( true );
 }
 
@@ -89,6 +91,7 @@ void idSnapshotProcessor::Reset( bool cstor )
 	partialBaseSequence = -1;
 	
 	memset( &jobMemory->lzwInOutData, 0, sizeof( jobMemory->lzwInOutData ) );
+	memset( &submitInfo, 0, sizeof( submitInfo ) );
 }
 
 /*
@@ -139,11 +142,23 @@ static int g_maxlwMem = 100;
 idSnapshotProcessor::SubmitPendingSnap
 ========================
 */
-void idSnapshotProcessor::SubmitPendingSnap( int visIndex, uint8* objMemory, int objMemorySize, lzwCompressionData_t* lzwData )
+void idSnapshotProcessor::SubmitPendingSnap( int visIndex, uint8* objMemory, int objMemorySize, lzwCompressionData_t* lzwData, snapFastCodecData_t* fastData )
+{
+	PreparePendingSnap( visIndex, objMemory, objMemorySize, lzwData, fastData );
+	WritePendingSnap();
+}
+
+/*
+========================
+idSnapshotProcessor::PreparePendingSnap
+========================
+*/
+void idSnapshotProcessor::PreparePendingSnap( int visIndex, uint8* objMemory, int objMemorySize, lzwCompressionData_t* lzwData, snapFastCodecData_t* fastData )
 {
 
 	assert_16_byte_aligned( objMemory );
 	assert_16_byte_aligned( lzwData );
+	assert( deltaCodec != SNAP_CODEC_FAST || fastData != NULL );
 	
 	assert( hasPendingSnap );
 	assert( jobMemory->lzwInOutData.numlzwDeltas == 0 );
@@ -167,8 +182,8 @@ void idSnapshotProcessor::SubmitPendingSnap( int visIndex, uint8* objMemory, int
 	jobMemory->lzwInOutData.snapSequence	= snapSequence;
 	jobMemory->lzwInOutData.lastObjId		= 0;
 	jobMemory->lzwInOutData.lzwData			= lzwData;
-	
-	idSnapShot::submitDeltaJobsInfo_t submitInfo;
+	jobMemory->lzwInOutData.fastData		= fastData;
+	jobMemory->lzwInOutData.codec			= deltaCodec;
 	
 	submitInfo.objParms			= jobMemory->objParms.Ptr();
 	submitInfo.maxObjParms		= jobMemory->objParms.Num();
@@ -192,6 +207,17 @@ void idSnapshotProcessor::SubmitPendingSnap( int visIndex, uint8* objMemory, int
 	submitInfo.baseSequence		= baseSequence;
 	
 	submitInfo.lzwInOutData		= &jobMemory->lzwInOutData;
+}
+
+/*
+========================
+idSnapshotProcessor::WritePendingSnap
+========================
+*/
+void idSnapshotProcessor::WritePendingSnap()
+{
+	assert( hasPendingSnap );
+	assert( submitInfo.lzwInOutData == &jobMemory->lzwInOutData );
 	
 	pendingSnap.SubmitWriteDeltaToJobs( submitInfo );
 }
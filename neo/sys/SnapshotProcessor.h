@@ -53,7 +53,12 @@ public:
 	bool ApplyDeltaToSnapshot( idSnapShot& snap, const char* deltaMem, int deltaSize, int visIndex );
 	// Attempts to write the currently pending snap to the supplied buffer, which can then be sent as an unreliable msg.
 	// SubmitPendingSnap will submit the pending snap to a job, so that it can be retrieved later for sending.
-	void SubmitPendingSnap( int visIndex, uint8* objMemory, int objMemorySize, lzwCompressionData_t* lzwData );
+	void SubmitPendingSnap( int visIndex, uint8* objMemory, int objMemorySize, lzwCompressionData_t* lzwData, snapFastCodecData_t* fastData );
+	// SubmitPendingSnap split in two, so the deltas of several peers can be written in parallel.
+	// PreparePendingSnap must be called on the main thread, since it takes references to the shared object buffers.
+	// WritePendingSnap only reads those buffers, and writes to this processor's job memory and the supplied scratch memory.
+	void PreparePendingSnap( int visIndex, uint8* objMemory, int objMemorySize, lzwCompressionData_t* lzwData, snapFastCodecData_t* fastData );
+	void WritePendingSnap();
 	// GetPendingSnapDelta
 	int GetPendingSnapDelta( byte* outBuffer, int maxLength );
 	// If PendingSnapReadyToSend is true, then GetPendingSnapDelta will return something to send
@@ -115,6 +120,16 @@ public:
 	
 	bool IsBusyConfirmingPartialSnap();
 	
+	// Codec the deltas for this peer are written with (the reading side picks it up from the delta itself)
+	void SetDeltaCodec( snapDeltaCodec_t codec )
+	{
+		deltaCodec = codec;
+	}
+	snapDeltaCodec_t GetDeltaCodec() const
+	{
+		return deltaCodec;
+	}
+	
 	void AddSnapObjTemplate( int objID, idBitMsg& msg );
 	
 	static const int MAX_SNAPSHOT_QUEUE		= 64;
@@ -167,11 +182,14 @@ private:
 	jobMemory_t* 	jobMemory;
 	
 	idSnapShot		submittedState;
+	idSnapShot::submitDeltaJobsInfo_t	submitInfo;		// Filled out by PreparePendingSnap for WritePendingSnap
 	
 	idSnapShot		templateStates;			// holds default snapshot states for some newly spawned object
 	idSnapShot		submittedTemplateStates;
 	
 	int				partialBaseSequence;
+	
+	snapDeltaCodec_t	deltaCodec;
 };
 
 #endif /* !__SNAP_PROCESSOR_H__ */
@@ -73,13 +73,14 @@ ID_INLINE bool ObjectsSame( objJobState_t& newState, objJobState_t& oldState )
 ========================
 SnapshotObjectJob
 This job processes objects by delta comparing them, and then zrle encoding them to the dest stream
-The dest stream is then eventually read by the lzw job, and then lzw compressed into the final delta packet
-ready to be sent to peers.
+with the codec picked for the peer. The dest stream is then eventually read by the lzw job, and then
+compressed into the final delta packet ready to be sent to peers.
 ========================
 */
 void SnapshotObjectJob( objParms_t* parms )
 {
 	int				visIndex	= parms->visIndex;
+	snapDeltaCodec_t codec		= ( snapDeltaCodec_t )parms->codec;
 	objJobState_t& 	newState	= parms->newState;
 	objJobState_t& 	oldState	= parms->oldState;
 	objHeader_t* 	header		= parms->destHeader;
@@ -101,8 +102,6 @@ void SnapshotObjectJob( objParms_t* parms )
 	header->checksum = 0;
 #endif
 	
-	idZeroRunLengthCompressor rleCompressor;
-	
 	bool visChange		= false; // visibility changes will be signified with a 0xffff state size
 	bool visSendState	= false; // the state is sent when an entity is no longer stale
 	
@@ -168,15 +167,9 @@ void SnapshotObjectJob( objParms_t* parms )
 		// New object, write out full state
 		assert( newState.valid );
 		// delta against an empty snap
-		rleCompressor.Start( dataStart, NULL, OBJ_DEST_SIZE_ALIGN16( newState.size ) );
-		rleCompressor.WriteBytes( newState.data, newState.size );
-		header->csize = rleCompressor.End();
+		// (if there isn't enough space, the raw delta is left in dest and the lzw job does the zrle compression instead)
+		header->csize = idSnapDeltaCodec::EncodeObject( codec, dataStart, OBJ_DEST_SIZE_ALIGN16( newState.size ), newState.data, newState.size, NULL, 0 );
 		header->flags |= OBJ_NEW;
-		if( header->csize == -1 )
-		{
-			// Not enough space, don't compress, have lzw job do zrle compression instead
-			memcpy( dataStart, newState.data, newState.size );
-		}
 	}
 	else
 	{
@@ -192,38 +185,7 @@ void SnapshotObjectJob( objParms_t* parms )
 		
 		if( !visChange || visSendState )
 		{
-			int compareSize = Min( newState.size, oldState.size );
-			rleCompressor.Start( dataStart, NULL, OBJ_DEST_SIZE_ALIGN16( newState.size ) );
-			for( int b = 0; b < compareSize; b++ )
-			{
-				byte delta = newState.data[b] - oldState.data[b];
-				rleCompressor.WriteByte( ( 0xFF + 1 + delta ) & 0xFF );
-			}
-			// Get leftover
-			int leftOver = newState.size - compareSize;
-			
-			if( leftOver > 0 )
-			{
-				rleCompressor.WriteBytes( newState.data + compareSize, leftOver );
-			}
-			
-			header->csize = rleCompressor.End();
-			
-			if( header->csize == -1 )
-			{
-				// Not enough space, don't compress, have lzw job do zrle compression instead
-				for( int b = 0; b < compareSize; b++ )
-				{
-					*dataStart++ = ( ( 0xFF + 1 + ( newState.data[b] - oldState.data[b] ) ) & 0xFF );
-				}
-				// Get leftover
-				int leftOver = newState.size - compareSize;
-				
-				if( leftOver > 0 )
-				{
-					memcpy( dataStart, newState.data + compareSize, leftOver );
-				}
-			}
+			header->csize = idSnapDeltaCodec::EncodeObject( codec, dataStart, OBJ_DEST_SIZE_ALIGN16( newState.size ), newState.data, newState.size, oldState.data, oldState.size );
 		}
 	}
 	
@@ -243,16 +205,16 @@ void SnapshotObjectJob( objParms_t* parms )
 FinishLZWStream
 ========================
 */
-static void FinishLZWStream( lzwParm_t* parm, idLZWCompressor* lzwCompressor )
+static void FinishLZWStream( lzwParm_t* parm, idSnapDeltaCodec* codec )
 {
-	if( lzwCompressor->IsOverflowed() )
+	if( codec->IsOverflowed() )
 	{
-		lzwCompressor->Restore();
+		codec->Restore();
 	}
 	
 	lzwDelta_t& pendingDelta = parm->ioData->lzwDeltas[parm->ioData->numlzwDeltas];
 	
-	if( lzwCompressor->End() == -1 )
+	if( codec->End() == -1 )
 	{
 		// If we couldn't end the stream, notify the main thread
 		pendingDelta.offset			= -1;
@@ -263,7 +225,7 @@ static void FinishLZWStream( lzwParm_t* parm, idLZWCompressor* lzwCompressor )
 		return;
 	}
 	
-	int size = lzwCompressor->Length();
+	int size = codec->Length();
 	
 	pendingDelta.offset			= parm->ioData->lzwBytes;		// Remember offset into buffer
 	pendingDelta.size			= size;							// Remember size
@@ -278,20 +240,20 @@ static void FinishLZWStream( lzwParm_t* parm, idLZWCompressor* lzwCompressor )
 NewLZWStream
 ========================
 */
-static void NewLZWStream( lzwParm_t* parm, idLZWCompressor* lzwCompressor )
+static void NewLZWStream( lzwParm_t* parm, idSnapDeltaCodec* codec )
 {
 
 	// Reset compressor
 	int maxSize = parm->ioData->maxlzwMem - parm->ioData->lzwBytes;
-	lzwCompressor->Start( &parm->ioData->lzwMem[parm->ioData->lzwBytes], maxSize );
+	codec->StartWrite( &parm->ioData->lzwMem[parm->ioData->lzwBytes], maxSize, false );
 	
 	parm->ioData->lastObjId = 0;
 	
 	parm->ioData->snapSequence++;
 	
-	lzwCompressor->WriteAgnostic( parm->ioData->snapSequence );
-	lzwCompressor->WriteAgnostic( parm->baseSequence );
-	lzwCompressor->WriteAgnostic( parm->curTime );
+	codec->WriteAgnostic( parm->ioData->snapSequence );
+	codec->WriteAgnostic( parm->baseSequence );
+	codec->WriteAgnostic( parm->curTime );
 }
 
 /*
@@ -299,11 +261,11 @@ static void NewLZWStream( lzwParm_t* parm, idLZWCompressor* lzwCompressor )
 ContinueLZWStream
 ========================
 */
-static void ContinueLZWStream( lzwParm_t* parm, idLZWCompressor* lzwCompressor )
+static void ContinueLZWStream( lzwParm_t* parm, idSnapDeltaCodec* codec )
 {
 	// Continue compressor where we left off
 	int maxSize = parm->ioData->maxlzwMem - parm->ioData->lzwBytes;
-	lzwCompressor->Start( &parm->ioData->lzwMem[parm->ioData->lzwBytes], maxSize, true );
+	codec->StartWrite( &parm->ioData->lzwMem[parm->ioData->lzwBytes], maxSize, true );
 }
 
 /*
@@ -334,21 +296,24 @@ void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
 	
 #ifdef __GNUC__
 	// DG: remove ALIGN16 for GCC/clang, as they can't use it here and clang gets an error
-	idLZWCompressor lzwCompressor( parm->ioData->lzwData );
+	idSnapDeltaCodecLZW lzwCodec( parm->ioData->lzwData );
 	// DG end
 #else
-	ALIGN16( idLZWCompressor lzwCompressor( parm->ioData->lzwData ) );
+	ALIGN16( idSnapDeltaCodecLZW lzwCodec( parm->ioData->lzwData ) );
 #endif
+	idSnapDeltaCodecFast fastCodec( parm->ioData->fastData );
+	
+	idSnapDeltaCodec& codec = ( parm->ioData->codec == SNAP_CODEC_FAST ) ? static_cast<idSnapDeltaCodec&>( fastCodec ) : lzwCodec;
 	
 	if( parm->fragmented )
 	{
 		// This packet was partially written out, we need to continue writing, using previous lzw dictionary values
-		ContinueLZWStream( parm, &lzwCompressor );
+		ContinueLZWStream( parm, &codec );
 	}
 	else
 	{
 		// We can start a new lzw dictionary
-		NewLZWStream( parm, &lzwCompressor );
+		NewLZWStream( parm, &codec );
 	}
 	
 	
@@ -359,16 +324,16 @@ void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
 	
 		// This will eventually be gracefully caught in SnapshotProcessor.cpp.
 		// It's nice to know right when it happens though, so you can inspect the situation.
-		assert( !lzwCompressor.IsOverflowed() || numChangedObjProcessed > 1 );
+		assert( !codec.IsOverflowed() || numChangedObjProcessed > 1 );
 		
 		// First, see if we need to finish the current lzw stream
-		if( lzwCompressor.IsOverflowed() || lzwCompressor.Length() >= parm->ioData->optimalLength )
+		if( codec.IsOverflowed() || codec.Length() >= parm->ioData->optimalLength )
 		{
-			FinishLZWStream( parm, &lzwCompressor );
+			FinishLZWStream( parm, &codec );
 			// indicate how much needs to be DMA'ed back out
 			parm->ioData->lzwDmaOut = parm->ioData->lzwBytes;
 #ifdef ALLOW_MULTIPLE_DELTAS
-			NewLZWStream( parm, &lzwCompressor );
+			NewLZWStream( parm, &codec );
 #else
 			// Currently, we don't use fragmented deltas.
 			// We only send the first one and rely on a full snap being sent to get the whole snap across
@@ -381,7 +346,7 @@ void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
 		if( numChangedObjProcessed > 0 )
 		{
 			// We should be at a good spot in the stream if we've written at least one obj without overflowing, so save it
-			lzwCompressor.Save();
+			codec.Save();
 		}
 		
 		// Get header
@@ -396,7 +361,7 @@ void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
 		numChangedObjProcessed++;
 		
 		// Write obj id as delta into stream
-		lzwCompressor.WriteAgnostic<uint16>( ( uint16 )( header->objID - parm->ioData->lastObjId ) );
+		codec.WriteAgnostic<uint16>( ( uint16 )( header->objID - parm->ioData->lastObjId ) );
 		parm->ioData->lastObjId = ( uint16 )header->objID;
 		
 		// Check special stale/notstale flags
@@ -404,7 +369,7 @@ void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
 		{
 			// Write stale/notstale flag
 			objectSize_t value = ( header->flags & OBJ_VIS_STALE ) ? SIZE_STALE : SIZE_NOT_STALE;
-			lzwCompressor.WriteAgnostic<objectSize_t>( value );
+			codec.WriteAgnostic<objectSize_t>( value );
 		}
 		
 		if( header->flags & OBJ_VIS_STALE )
@@ -415,12 +380,12 @@ void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
 		if( header->flags & OBJ_DELETED )
 		{
 			// Object was deleted
-			lzwCompressor.WriteAgnostic<objectSize_t>( 0 );
+			codec.WriteAgnostic<objectSize_t>( 0 );
 			continue;
 		}
 		
 		// Write size
-		lzwCompressor.WriteAgnostic<objectSize_t>( ( objectSize_t )header->size );
+		codec.WriteAgnostic<objectSize_t>( ( objectSize_t )header->size );
 		
 		// Get compressed data area
 		uint8* compressedData = header->data;
@@ -428,34 +393,31 @@ void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
 		if( header->csize == -1 )
 		{
 			// Wasn't zrle compressed, zrle now while lzw'ing
-			idZeroRunLengthCompressor rleCompressor;
-			rleCompressor.Start( NULL, &lzwCompressor, 0xFFFF );
-			rleCompressor.WriteBytes( compressedData, header->size );
-			rleCompressor.End();
+			codec.WriteRawDelta( compressedData, header->size );
 		}
 		else
 		{
 			// Write out zero-rle compressed data
-			lzwCompressor.Write( compressedData, header->csize );
+			codec.Write( compressedData, header->csize );
 		}
 		
 #ifdef SNAPSHOT_CHECKSUMS
 		// Write checksum
-		lzwCompressor.WriteAgnostic( header->checksum );
+		codec.WriteAgnostic( header->checksum );
 #endif
 		// This will eventually be gracefully caught in SnapshotProcessor.cpp.
 		// It's nice to know right when it happens though, so you can inspect the situation.
-		assert( !lzwCompressor.IsOverflowed() || numChangedObjProcessed > 1 );
+		assert( !codec.IsOverflowed() || numChangedObjProcessed > 1 );
 	}
 	
 	if( !parm->saveDictionary )
 	{
 		// Write out terminator
 		uint16 objectDelta = 0xFFFF - parm->ioData->lastObjId;
-		lzwCompressor.WriteAgnostic( objectDelta );
+		codec.WriteAgnostic( objectDelta );
 		
 		// Last stream
-		FinishLZWStream( parm, &lzwCompressor );
+		FinishLZWStream( parm, &codec );
 		
 		// indicate how much needs to be DMA'ed back out
 		parm->ioData->lzwDmaOut = parm->ioData->lzwBytes;
@@ -467,7 +429,7 @@ void LZWJobInternal( lzwParm_t* parm, unsigned int dmaTag )
 		// the compressor did some work, wrote data to lzwMem, but since we didn't call FinishLZWStream to end the compression,
 		// we need to figure how much needs to be DMA'ed back out
 		assert( parm->ioData->lzwBytes == 0 ); // I don't think we ever hit this with lzwBytes != 0, but adding it just in case
-		parm->ioData->lzwDmaOut = parm->ioData->lzwBytes + lzwCompressor.Length();
+		parm->ioData->lzwDmaOut = parm->ioData->lzwBytes + codec.Length();
 	}
 	
 	assert( parm->ioData->lzwBytes < parm->ioData->maxlzwMem );
@@ -29,6 +29,7 @@ If you have questions concerning this license or the applicable additional terms
 #define __SNAPSHOT_JOBS_H__
 
 #include "LightweightCompression.h"
+#include "SnapshotCodec.h"
 
 //#define SNAPSHOT_CHECKSUMS
 
@@ -76,6 +77,7 @@ struct ALIGNTYPE16 objParms_t
 {
 	// Input
 	uint8				visIndex;
+	uint8				codec;					// snapDeltaCodec_t used to encode the object
 	
 	objJobState_t		newState;
 	objJobState_t		oldState;
@@ -109,6 +111,8 @@ struct ALIGNTYPE16 lzwInOutData_t
 	int						snapSequence;
 	uint16					lastObjId;				// Last obj id written out
 	lzwCompressionData_t* 	lzwData;
+	snapFastCodecData_t* 	fastData;
+	snapDeltaCodec_t		codec;					// Codec the delta packets are written with
 };
 
 // Input to the job that takes the results of the delta'd zrle obj's, and turns them into lzw delta packets
@@ -67,6 +67,10 @@ Note that other POSIX systems may need some small changes, e.g. in Sys_InitNetwo
 #if defined(__APPLE__) || defined(__FreeBSD__)
 #include <ifaddrs.h>
 #endif
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/eventfd.h>
+#endif
 
 #endif // _WIN32
 
@@ -125,6 +129,7 @@ idCVar net_socksUsername( "net_socksUsername", "", CVAR_ARCHIVE, "" );
 idCVar net_socksPassword( "net_socksPassword", "", CVAR_ARCHIVE, "" );
 
 idCVar net_ip( "net_ip", "localhost", CVAR_NOCHEAT, "local IP address" );
+idCVar net_udpThread( "net_udpThread", "0", CVAR_BOOL | CVAR_NOCHEAT, "service UDP sockets from a network thread that batches the I/O with recvmmsg/sendmmsg (Linux only, applied when a socket is opened)" );
 
 static struct sockaddr_in	socksRelayAddr;
 
@@ -1279,6 +1284,609 @@ const char* Sys_GetLocalIP( int i )
 	return netint[i].addr;
 }
 
+/*
+================================================================================================
+
+	idUDPThread
+
+	Linux only. Owns all the I/O of one socket: incoming datagrams are drained in batches
+	with recvmmsg() into a ring that idUDP::GetPacket pops from, and the packets queued by
+	idUDP::SendPacket are handed to the kernel with sendmmsg() when idUDP::Flush wakes the
+	thread up. The main thread is the only consumer of the receive ring and the only producer
+	of the send ring, so neither needs a lock.
+
+================================================================================================
+*/
+
+#if defined(__linux__)
+
+static const int UDP_THREAD_MAX_PACKET_SIZE	= 1536;		// larger than anything the session layer sends
+static const int UDP_THREAD_RING_SIZE		= 256;		// packets per ring, must be a power of two
+static const int UDP_THREAD_BATCH_SIZE		= 64;		// packets per recvmmsg / sendmmsg call
+static const int UDP_THREAD_POLL_TIMEOUT	= 10;		// ms, also bounds the delay of packets nobody flushed
+
+struct udpThreadPacket_t
+{
+	netadr_t	adr;
+	int			size;			// -1 if the packet was truncated and has to be dropped
+	byte		data[ UDP_THREAD_MAX_PACKET_SIZE ];
+};
+
+/*
+================================================
+idUDPPacketRing
+
+Lock free ring with exactly one producer and one consumer thread. The producer fills the
+slots from WriteSlot and publishes them with CommitWrite, the consumer reads the slots from
+ReadSlot and hands them back with CommitRead.
+================================================
+*/
+class idUDPPacketRing
+{
+public:
+	idUDPPacketRing() : writeIndex( 0 ), readIndex( 0 ) {}
+	
+	int					NumReady() const
+	{
+		const int num = ( int )( writeIndex - readIndex );
+		SYS_MEMORYBARRIER;
+		return num;
+	}
+	int					NumFree() const
+	{
+		return UDP_THREAD_RING_SIZE - NumReady();
+	}
+	
+	udpThreadPacket_t* 	WriteSlot( int i )
+	{
+		return &packets[( writeIndex + i ) & ( UDP_THREAD_RING_SIZE - 1 ) ];
+	}
+	void				CommitWrite( int num )
+	{
+		SYS_MEMORYBARRIER;
+		writeIndex += num;
+	}
+	
+	udpThreadPacket_t* 	ReadSlot( int i )
+	{
+		return &packets[( readIndex + i ) & ( UDP_THREAD_RING_SIZE - 1 ) ];
+	}
+	void				CommitRead( int num )
+	{
+		SYS_MEMORYBARRIER;
+		readIndex += num;
+	}
+	
+private:
+	udpThreadPacket_t	packets[ UDP_THREAD_RING_SIZE ];
+	volatile uint32		writeIndex;
+	byte				pad[ 128 ];		// keep the two indices on separate cache lines
+	volatile uint32		readIndex;
+};
+
+/*
+================================================
+idUDPThread
+================================================
+*/
+class idUDPThread : public idSysThread
+{
+public:
+	idUDPThread( int netSocket );
+	virtual			~idUDPThread();
+	
+	bool			Init();
+	void			Shutdown();
+	
+	// main thread side
+	bool			GetPacket( netadr_t& from, void* data, int& size, int maxSize );
+	bool			WaitForPacket( int timeout );
+	bool			QueuePacket( const netadr_t& to, const void* data, int size );
+	void			Wake();
+	bool			HasQueuedPackets() const
+	{
+		return sendRing.NumReady() > 0;
+	}
+	
+protected:
+	virtual int		Run();
+	
+private:
+	void			ReceivePackets();
+	void			SendPackets();
+	
+	int							netSocket;
+	int							wakeEvent;			// eventfd that interrupts poll()
+	idSysInterlockedInteger		wakePending;		// set while a wake up is on its way
+	idSysInterlockedInteger		receiveStalled;		// set when the receive ring filled up
+	idSysSignal					packetsReceived;
+	
+	idUDPPacketRing				recvRing;			// filled by the thread, drained by GetPacket
+	idUDPPacketRing				sendRing;			// filled by QueuePacket, drained by the thread
+};
+
+/*
+========================
+idUDPThread::idUDPThread
+========================
+*/
+idUDPThread::idUDPThread( int netSocket_ ) :
+	netSocket( netSocket_ ),
+	wakeEvent( -1 )
+{
+}
+
+/*
+========================
+idUDPThread::~idUDPThread
+========================
+*/
+idUDPThread::~idUDPThread()
+{
+	Shutdown();
+}
+
+/*
+========================
+idUDPThread::Init
+========================
+*/
+bool idUDPThread::Init()
+{
+	wakeEvent = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+	if( wakeEvent < 0 )
+	{
+		idLib::Printf( "WARNING: idUDPThread: eventfd: %s\n", NET_ErrorString() );
+		return false;
+	}
+	
+	return StartThread( "UDP I/O", CORE_ANY, THREAD_ABOVE_NORMAL );
+}
+
+/*
+========================
+idUDPThread::Shutdown
+========================
+*/
+void idUDPThread::Shutdown()
+{
+	if( IsRunning() )
+	{
+		StopThread( false );
+		Wake();
+		WaitForThread();
+	}
+	
+	if( wakeEvent >= 0 )
+	{
+		close( wakeEvent );
+		wakeEvent = -1;
+	}
+}
+
+/*
+========================
+idUDPThread::Wake
+========================
+*/
+void idUDPThread::Wake()
+{
+	// only the first wake up after the thread went back to sleep costs a syscall
+	if( wakePending.CompareExchange( 0, 1 ) == 0 )
+	{
+		const uint64 one = 1;
+		if( write( wakeEvent, &one, sizeof( one ) ) < 0 )
+		{
+			// the counter can only overflow if the thread is gone, poll() times out anyway
+		}
+	}
+}
+
+/*
+========================
+idUDPThread::GetPacket
+========================
+*/
+bool idUDPThread::GetPacket( netadr_t& from, void* data, int& size, int maxSize )
+{
+	bool result = false;
+	
+	while( !result && recvRing.NumReady() > 0 )
+	{
+		const udpThreadPacket_t* packet = recvRing.ReadSlot( 0 );
+		
+		if( packet->size > maxSize )
+		{
+			idLib::Printf( "Net_GetUDPPacket: oversize packet from %s\n", Sys_NetAdrToString( packet->adr ) );
+		}
+		else if( packet->size >= 0 )
+		{
+			from = packet->adr;
+			size = packet->size;
+			memcpy( data, packet->data, packet->size );
+			result = true;
+		}
+		
+		recvRing.CommitRead( 1 );
+	}
+	
+	// the thread stops watching the socket while the ring is full
+	if( receiveStalled.GetValue() != 0 && receiveStalled.CompareExchange( 1, 0 ) == 1 )
+	{
+		Wake();
+	}
+	
+	return result;
+}
+
+/*
+========================
+idUDPThread::WaitForPacket
+========================
+*/
+bool idUDPThread::WaitForPacket( int timeout )
+{
+	if( timeout < 0 )
+	{
+		return true;
+	}
+	
+	const int endTime = Sys_Milliseconds() + timeout;
+	
+	while( recvRing.NumReady() == 0 )
+	{
+		const int remaining = endTime - Sys_Milliseconds();
+		if( remaining <= 0 )
+		{
+			return false;
+		}
+		
+		// the signal can still be raised for packets GetPacket already returned
+		packetsReceived.Wait( remaining );
+	}
+	
+	return true;
+}
+
+/*
+========================
+idUDPThread::QueuePacket
+
+Returns false if the packet has to be sent directly
+========================
+*/
+bool idUDPThread::QueuePacket( const netadr_t& to, const void* data, int size )
+{
+	if( size > UDP_THREAD_MAX_PACKET_SIZE )
+	{
+		return false;
+	}
+	
+	if( sendRing.NumFree() == 0 )
+	{
+		// UDP gives no ordering guarantees, so overtaking the queue is fine
+		Wake();
+		return false;
+	}
+	
+	udpThreadPacket_t* packet = sendRing.WriteSlot( 0 );
+	packet->adr = to;
+	packet->size = size;
+	memcpy( packet->data, data, size );
+	sendRing.CommitWrite( 1 );
+	
+	if( sendRing.NumReady() >= UDP_THREAD_RING_SIZE / 2 )
+	{
+		Wake();
+	}
+	
+	return true;
+}
+
+/*
+========================
+idUDPThread::Run
+========================
+*/
+int idUDPThread::Run()
+{
+	pollfd fds[2];
+	fds[0].fd = netSocket;
+	fds[1].fd = wakeEvent;
+	fds[1].events = POLLIN;
+	
+	while( !IsTerminating() )
+	{
+		// while the ring is full the kernel keeps buffering, GetPacket wakes us up again
+		fds[0].events = ( recvRing.NumFree() > 0 ) ? POLLIN : 0;
+		fds[0].revents = 0;
+		fds[1].revents = 0;
+		
+		if( poll( fds, 2, UDP_THREAD_POLL_TIMEOUT ) < 0 )
+		{
+			if( errno != EINTR )
+			{
+				idLib::Printf( "idUDPThread: poll: %s\n", NET_ErrorString() );
+			}
+			continue;
+		}
+		
+		if( fds[1].revents & POLLIN )
+		{
+			uint64 count;
+			if( read( wakeEvent, &count, sizeof( count ) ) < 0 )
+			{
+				// EAGAIN, somebody else already drained the counter
+			}
+			wakePending.CompareExchange( 1, 0 );
+		}
+		
+		SendPackets();
+		
+		if( fds[0].revents & ( POLLIN | POLLERR ) )
+		{
+			ReceivePackets();
+		}
+	}
+	
+	SendPackets();
+	
+	return 0;
+}
+
+/*
+========================
+idUDPThread::ReceivePackets
+========================
+*/
+void idUDPThread::ReceivePackets()
+{
+	mmsghdr		msgs[ UDP_THREAD_BATCH_SIZE ];
+	iovec		iovecs[ UDP_THREAD_BATCH_SIZE ];
+	sockaddr_in	addrs[ UDP_THREAD_BATCH_SIZE ];
+	
+	for( ; ; )
+	{
+		const int batch = Min( recvRing.NumFree(), UDP_THREAD_BATCH_SIZE );
+		if( batch == 0 )
+		{
+			receiveStalled.SetValue( 1 );
+			return;
+		}
+		
+		memset( msgs, 0, batch * sizeof( msgs[0] ) );
+		for( int i = 0; i < batch; i++ )
+		{
+			udpThreadPacket_t* packet = recvRing.WriteSlot( i );
+			iovecs[i].iov_base = packet->data;
+			iovecs[i].iov_len = sizeof( packet->data );
+			msgs[i].msg_hdr.msg_name = &addrs[i];
+			msgs[i].msg_hdr.msg_namelen = sizeof( addrs[i] );
+			msgs[i].msg_hdr.msg_iov = &iovecs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+		
+		const int ret = recvmmsg( netSocket, msgs, batch, MSG_DONTWAIT, NULL );
+		if( ret <= 0 )
+		{
+			if( ret < 0 )
+			{
+				const int err = Net_GetLastError();
+				if( err != D3_NET_EWOULDBLOCK && err != D3_NET_ECONNRESET && err != EINTR )
+				{
+					idLib::Printf( "Net_GetUDPPacket: %s\n", NET_ErrorString() );
+				}
+			}
+			return;
+		}
+		
+		for( int i = 0; i < ret; i++ )
+		{
+			udpThreadPacket_t* packet = recvRing.WriteSlot( i );
+			Net_SockadrToNetadr( &addrs[i], &packet->adr );
+			packet->size = ( msgs[i].msg_hdr.msg_flags & MSG_TRUNC ) ? -1 : ( int )msgs[i].msg_len;
+		}
+		recvRing.CommitWrite( ret );
+		packetsReceived.Raise();
+		
+		if( ret < batch )
+		{
+			return;		// socket drained
+		}
+	}
+}
+
+/*
+========================
+idUDPThread::SendPackets
+========================
+*/
+void idUDPThread::SendPackets()
+{
+	mmsghdr		msgs[ UDP_THREAD_BATCH_SIZE ];
+	iovec		iovecs[ UDP_THREAD_BATCH_SIZE ];
+	sockaddr_in	addrs[ UDP_THREAD_BATCH_SIZE ];
+	
+	for( ; ; )
+	{
+		const int batch = Min( sendRing.NumReady(), UDP_THREAD_BATCH_SIZE );
+		if( batch == 0 )
+		{
+			return;
+		}
+		
+		memset( msgs, 0, batch * sizeof( msgs[0] ) );
+		for( int i = 0; i < batch; i++ )
+		{
+			udpThreadPacket_t* packet = sendRing.ReadSlot( i );
+			Net_NetadrToSockadr( &packet->adr, &addrs[i] );
+			iovecs[i].iov_base = packet->data;
+			iovecs[i].iov_len = packet->size;
+			msgs[i].msg_hdr.msg_name = &addrs[i];
+			msgs[i].msg_hdr.msg_namelen = sizeof( addrs[i] );
+			msgs[i].msg_hdr.msg_iov = &iovecs[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+		
+		int sent = 0;
+		while( sent < batch )
+		{
+			const int ret = sendmmsg( netSocket, msgs + sent, batch - sent, 0 );
+			if( ret >= 0 )
+			{
+				sent += ret;
+				continue;
+			}
+			
+			const int err = Net_GetLastError();
+			if( err == EINTR )
+			{
+				continue;
+			}
+			
+			// sendmmsg stops at the first packet that fails, drop that one like Net_SendUDPPacket would
+			// some PPP links do not allow broadcasts and return an error
+			if( !( err == D3_NET_EADDRNOTAVAIL && sendRing.ReadSlot( sent )->adr.type == NA_BROADCAST ) )
+			{
+				idLib::Printf( "UDP sendmmsg error - packet dropped: %s\n", NET_ErrorString() );
+			}
+			sent++;
+		}
+		
+		sendRing.CommitRead( batch );
+	}
+}
+
+#endif // __linux__
+
+/*
+================================================================================================
+
+	UDP loopback benchmark
+
+================================================================================================
+*/
+
+/*
+========================
+Net_RunUDPBenchmark
+
+Sends numPackets through the loopback interface in bursts, like a server sending one
+snapshot to each client, and measures how long each packet takes to reach the reader.
+========================
+*/
+static void Net_RunUDPBenchmark( bool useIOThread, int numPackets, int packetSize )
+{
+	const int BURST_SIZE = 32;
+	const int MAX_IN_FLIGHT = 64;		// stay below what the default socket buffers can absorb
+	
+	idUDP sender;
+	idUDP receiver;
+	
+	if( !sender.InitForPort( PORT_ANY ) || !receiver.InitForPort( PORT_ANY ) )
+	{
+		idLib::Printf( "net_udpBenchmark: couldn't open the sockets\n" );
+		return;
+	}
+	
+	if( useIOThread )
+	{
+		if( !sender.StartIOThread() || !receiver.StartIOThread() )
+		{
+			idLib::Printf( "net_udpBenchmark: no network I/O thread on this platform\n" );
+			return;
+		}
+	}
+	else
+	{
+		sender.StopIOThread();
+		receiver.StopIOThread();
+	}
+	
+	netadr_t to;
+	memset( &to, 0, sizeof( to ) );
+	to.type = NA_LOOPBACK;
+	to.ip[0] = 127;
+	to.ip[3] = 1;
+	to.port = receiver.GetPort();
+	
+	byte sendBuffer[ 2048 ];
+	byte recvBuffer[ 2048 ];
+	memset( sendBuffer, 0, sizeof( sendBuffer ) );
+	
+	idList< int > latencies;
+	latencies.Resize( numPackets );
+	
+	int sent = 0;
+	int lost = 0;
+	
+	const uint64 startTime = Sys_Microseconds();
+	
+	while( sent < numPackets || sent - latencies.Num() - lost > 0 )
+	{
+		if( sent < numPackets && sent - latencies.Num() - lost <= MAX_IN_FLIGHT - BURST_SIZE )
+		{
+			for( int i = 0; i < BURST_SIZE && sent < numPackets; i++, sent++ )
+			{
+				const uint64 sendTime = Sys_Microseconds();
+				memcpy( sendBuffer, &sendTime, sizeof( sendTime ) );
+				sender.SendPacket( to, sendBuffer, packetSize );
+			}
+			sender.Flush();
+		}
+		
+		netadr_t from;
+		int size = 0;
+		if( !receiver.GetPacketBlocking( from, recvBuffer, size, sizeof( recvBuffer ), 250 ) )
+		{
+			// nothing for a quarter of a second, whatever is still in flight is gone
+			lost = sent - latencies.Num();
+			continue;
+		}
+		
+		do
+		{
+			uint64 sendTime;
+			memcpy( &sendTime, recvBuffer, sizeof( sendTime ) );
+			latencies.Append( ( int )( Sys_Microseconds() - sendTime ) );
+		}
+		while( receiver.GetPacket( from, recvBuffer, size, sizeof( recvBuffer ) ) );
+	}
+	
+	const double seconds = ( Sys_Microseconds() - startTime ) / 1000000.0;
+	
+	lost = Max( sent - latencies.Num(), 0 );
+	
+	if( latencies.Num() == 0 )
+	{
+		idLib::Printf( "net_udpBenchmark: no packets arrived\n" );
+		return;
+	}
+	
+	latencies.SortWithTemplate( idSort_QuickDefault< int >() );
+	
+	const int num = latencies.Num();
+	idLib::Printf( "%-22s %8.0f packets/s %7.1f MB/s   latency p50 %5d us  p90 %5d us  p99 %5d us  max %6d us   %d lost\n",
+				   useIOThread ? "recvmmsg/sendmmsg:" : "recvfrom/sendto:",
+				   num / seconds, num * packetSize / ( seconds * 1024.0 * 1024.0 ),
+				   latencies[ num / 2 ], latencies[ num * 9 / 10 ], latencies[ num * 99 / 100 ], latencies[ num - 1 ], lost );
+}
+
+/*
+========================
+net_udpBenchmark
+========================
+*/
+CONSOLE_COMMAND( net_udpBenchmark, "measures loopback UDP throughput and latency, usage: net_udpBenchmark [packets] [packet size]", 0 )
+{
+	const int numPackets = ( args.Argc() > 1 ) ? Max( atoi( args.Argv( 1 ) ), 1 ) : 100000;
+	const int packetSize = ( args.Argc() > 2 ) ? idMath::ClampInt( ( int )sizeof( uint64 ), 1400, atoi( args.Argv( 2 ) ) ) : 1200;
+	
+	idLib::Printf( "%d packets of %d bytes over loopback\n", numPackets, packetSize );
+	Net_RunUDPBenchmark( false, numPackets, packetSize );
+	Net_RunUDPBenchmark( true, numPackets, packetSize );
+}
+
 /*
 ================================================================================================
 
@@ -1301,6 +1909,7 @@ idUDP::idUDP()
 	bytesRead = 0;
 	packetsWritten = 0;
 	bytesWritten = 0;
+	ioThread = NULL;
 }
 
 /*
@@ -1331,6 +1940,11 @@ bool idUDP::InitForPort( int portNumber )
 		return false;
 	}
 	
+	if( net_udpThread.GetBool() )
+	{
+		StartIOThread();
+	}
+	
 	return true;
 }
 
@@ -1341,6 +1955,8 @@ idUDP::Close
 */
 void idUDP::Close()
 {
+	StopIOThread();
+	
 	if( netSocket )
 	{
 		closesocket( netSocket );
@@ -1356,6 +1972,21 @@ idUDP::GetPacket
 */
 bool idUDP::GetPacket( netadr_t& from, void* data, int& size, int maxSize )
 {
+#if defined(__linux__)
+	if( ioThread != NULL )
+	{
+		if( !ioThread->GetPacket( from, data, size, maxSize ) )
+		{
+			return false;
+		}
+		
+		packetsRead++;
+		bytesRead += size;
+		
+		return true;
+	}
+#endif
+	
 	// DG: this fake while(1) loop pissed me off so I replaced it.. no functional change.
 	if( ! Net_GetUDPPacket( netSocket, from, ( char* )data, size, maxSize ) )
 	{
@@ -1376,7 +2007,19 @@ idUDP::GetPacketBlocking
 */
 bool idUDP::GetPacketBlocking( netadr_t& from, void* data, int& size, int maxSize, int timeout )
 {
-
+#if defined(__linux__)
+	if( ioThread != NULL )
+	{
+		// the thread owns the socket, wait for it to fill the ring instead
+		if( !ioThread->WaitForPacket( timeout ) )
+		{
+			return false;
+		}
+		
+		return GetPacket( from, data, size, maxSize );
+	}
+#endif
+	
 	if( !Net_WaitForData( netSocket, timeout ) )
 	{
 		return false;
@@ -1411,6 +2054,81 @@ void idUDP::SendPacket( const netadr_t to, const void* data, int size )
 		return;
 	}
 	
+#if defined(__linux__)
+	if( ioThread != NULL && ioThread->QueuePacket( to, data, size ) )
+	{
+		return;
+	}
+#endif
+	
 	Net_SendUDPPacket( netSocket, size, data, to );
 }
 
+/*
+========================
+idUDP::StartIOThread
+========================
+*/
+bool idUDP::StartIOThread()
+{
+#if defined(__linux__)
+	if( ioThread != NULL )
+	{
+		return true;
+	}
+	
+	// the SOCKS relay wraps every packet, keep that on the direct path
+	if( !IsOpen() || usingSocks )
+	{
+		return false;
+	}
+	
+	idUDPThread* thread = new( TAG_NETWORKING ) idUDPThread( netSocket );
+	if( !thread->Init() )
+	{
+		delete thread;
+		return false;
+	}
+	ioThread = thread;
+	
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*
+========================
+idUDP::StopIOThread
+
+Packets the thread already received but nobody read are dropped
+========================
+*/
+void idUDP::StopIOThread()
+{
+#if defined(__linux__)
+	if( ioThread != NULL )
+	{
+		// Shutdown sends whatever is still queued
+		ioThread->Shutdown();
+		delete ioThread;
+		ioThread = NULL;
+	}
+#endif
+}
+
+/*
+========================
+idUDP::Flush
+========================
+*/
+void idUDP::Flush()
+{
+#if defined(__linux__)
+	if( ioThread != NULL && ioThread->HasQueuedPackets() )
+	{
+		ioThread->Wake();
+	}
+#endif
+}
+
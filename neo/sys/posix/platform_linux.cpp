@@ -80,7 +80,7 @@ Sys_GetProcessorId
 */
 cpuid_t Sys_GetProcessorId()
 {
-	return CPUID_GENERIC;
+	return Sys_GetCPUId();
 }
 
 /*
@@ -807,6 +807,71 @@ ID_TIME_T Sys_FileTimeStamp( idFileHandle fp )
 	return st.st_mtime;
 }
 
+/*
+================
+Sys_MapFile
+================
+*/
+void* Sys_MapFile( const char* osPath, int& length )
+{
+	length = 0;
+	
+	int fd = open( osPath, O_RDONLY );
+	if( fd == -1 )
+	{
+		return NULL;
+	}
+	
+	struct stat st;
+	if( fstat( fd, &st ) == -1 || st.st_size <= 0 || st.st_size > INT_MAX )
+	{
+		close( fd );
+		return NULL;
+	}
+	
+	// private and writable so a loader that patches its buffer in place
+	// only dirties its own copy of the page
+	void* data = mmap( NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+	close( fd );
+	if( data == MAP_FAILED )
+	{
+		return NULL;
+	}
+	
+	// reads jump all over the file, readahead is requested per file instead
+	madvise( data, st.st_size, MADV_RANDOM );
+	
+	length = st.st_size;
+	return data;
+}
+
+/*
+================
+Sys_UnmapFile
+================
+*/
+void Sys_UnmapFile( void* data, int length )
+{
+	if( data != NULL )
+	{
+		munmap( data, length );
+	}
+}
+
+/*
+================
+Sys_PrefetchMappedRange
+================
+*/
+void Sys_PrefetchMappedRange( void* data, int offset, int length )
+{
+	static const uintptr_t pageMask = sysconf( _SC_PAGESIZE ) - 1;
+	
+	const uintptr_t start = ( ( uintptr_t )data + offset ) & ~pageMask;
+	const uintptr_t end = ( uintptr_t )data + offset + length;
+	madvise( ( void* )start, end - start, MADV_WILLNEED );
+}
+
 void Sys_Sleep( int msec )
 {
 #if 0 // DG: I don't really care, this spams the console (and on windows this case isn't handled either)
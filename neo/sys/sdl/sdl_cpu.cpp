@@ -37,7 +37,25 @@ If you have questions concerning this license or the applicable additional terms
 #undef vsnprintf
 // DG end
 
+#if defined(ID_DEDICATED)
+// the dedicated server doesn't link SDL, so ask the compiler runtime for the CPU features
+#define SDL_VERSION_ATLEAST( X, Y, Z ) 1
+#if defined(__i386__) || defined(__x86_64__)
+#define SDL_HasMMX()	__builtin_cpu_supports( "mmx" )
+#define SDL_HasSSE()	__builtin_cpu_supports( "sse" )
+#define SDL_HasSSE2()	__builtin_cpu_supports( "sse2" )
+#define SDL_HasAVX2()	__builtin_cpu_supports( "avx2" )
+#else
+#define SDL_HasMMX()	false
+#define SDL_HasSSE()	false
+#define SDL_HasSSE2()	false
+#define SDL_HasAVX2()	false
+#endif
+#define SDL_Has3DNow()	false
+#else
 #include <SDL_cpuinfo.h>
+#include <SDL_version.h>
+#endif
 
 
 #pragma warning(disable:4740)	// warning C4740: flow in or out of inline asm code suppresses global optimization
@@ -177,6 +195,72 @@ void Sys_CPUCount( int& numLogicalCPUCores, int& numPhysicalCPUCores, int& numCP
 }
 #endif
 
+idCVar sys_cpustring( "sys_cpustring", "detect", CVAR_SYSTEM | CVAR_INIT, "\"detect\" or the CPU features to force, e.g. \"generic mmx sse sse2 avx2\"" );
+
+/*
+================
+Sys_ParseCPUString
+
+Same tokens as sys_cpustring on Windows
+================
+*/
+static cpuid_t Sys_ParseCPUString( const char* cpuString )
+{
+	idLexer src( cpuString, idStr::Length( cpuString ), "sys_cpustring" );
+	idToken token;
+	
+	int id = CPUID_NONE;
+	while( src.ReadToken( &token ) )
+	{
+		if( token.Icmp( "generic" ) == 0 )
+		{
+			id |= CPUID_GENERIC;
+		}
+		else if( token.Icmp( "intel" ) == 0 )
+		{
+			id |= CPUID_INTEL;
+		}
+		else if( token.Icmp( "amd" ) == 0 )
+		{
+			id |= CPUID_AMD;
+		}
+		else if( token.Icmp( "mmx" ) == 0 )
+		{
+			id |= CPUID_MMX;
+		}
+		else if( token.Icmp( "3dnow" ) == 0 )
+		{
+			id |= CPUID_3DNOW;
+		}
+		else if( token.Icmp( "sse" ) == 0 )
+		{
+			id |= CPUID_SSE;
+		}
+		else if( token.Icmp( "sse2" ) == 0 )
+		{
+			id |= CPUID_SSE2;
+		}
+		else if( token.Icmp( "sse3" ) == 0 )
+		{
+			id |= CPUID_SSE3;
+		}
+		else if( token.Icmp( "avx2" ) == 0 )
+		{
+			id |= CPUID_AVX2;
+		}
+		else if( token.Icmp( "htt" ) == 0 )
+		{
+			id |= CPUID_HTT;
+		}
+	}
+	if( id == CPUID_NONE )
+	{
+		common->Printf( "WARNING: unknown sys_cpustring '%s'\n", cpuString );
+		id = CPUID_GENERIC;
+	}
+	return ( cpuid_t )id;
+}
+
 /*
 ================
 Sys_GetCPUId
@@ -186,6 +270,12 @@ cpuid_t Sys_GetCPUId()
 {
 	int flags;
 	
+	// anything but "detect" forces the CPU features
+	if( idStr::Icmp( sys_cpustring.GetString(), "detect" ) != 0 )
+	{
+		return Sys_ParseCPUString( sys_cpustring.GetString() );
+	}
+	
 	// check for an AMD
 	flags = CPUID_GENERIC;
 	
@@ -221,6 +311,14 @@ cpuid_t Sys_GetCPUId()
 	}
 #endif
 	
+	// check for Advanced Vector Extensions 2, SDL also checks that the OS saves the registers
+#if SDL_VERSION_ATLEAST(2,0,4)
+	if( SDL_HasAVX2() )
+	{
+		flags |= CPUID_AVX2;
+	}
+#endif
+	
 	/*
 	// check for Hyper-Threading Technology
 	if( HasHTT() )
@@ -0,0 +1,549 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+/*
+================================================================================================
+Null OpenGL driver for the dedicated server.
+
+The dedicated server links the bundled GLEW against this file instead of libGL, so the
+renderer front end, the image and material managers and the vertex cache all initialize
+as usual without a display. Every entry point is a no-op, except for the few the engine
+reads results back from: object names, shader and program status, the driver strings and
+limits, and buffer objects, which are backed by system memory so the vertex cache can map
+them and the front end can keep filling them.
+================================================================================================
+*/
+#pragma hdrstop
+#include "../../idlib/precompiled.h"
+
+static const char* NULLGL_EXTENSIONS =
+	"GL_ARB_multitexture "
+	"GL_ARB_texture_compression "
+	"GL_EXT_texture_compression_s3tc "
+	"GL_ARB_vertex_buffer_object "
+	"GL_ARB_map_buffer_range "
+	"GL_ARB_vertex_array_object "
+	"GL_ARB_draw_elements_base_vertex "
+	"GL_ARB_fragment_program "
+	"GL_ARB_uniform_buffer_object "
+	"GL_ARB_framebuffer_object "
+	"GL_ARB_texture_multisample "
+	"GL_ARB_sync "
+	"GL_EXT_framebuffer_object "
+	"GL_EXT_framebuffer_blit";
+
+typedef void ( *nullGLProc_t )( void );
+
+static idSysInterlockedInteger	nullGLNames;
+
+/*
+================================================
+nullGLBuffer_t is the system memory store of a buffer object.
+================================================
+*/
+struct nullGLBuffer_t
+{
+	byte* 			data;
+	GLsizeiptr		size;
+};
+
+static idSysMutex				nullGLBufferMutex;
+static idList< nullGLBuffer_t >	nullGLBuffers;
+static GLuint					nullGLBoundBuffers[4];
+
+/*
+========================
+NullGL_GenNames
+========================
+*/
+static void NullGL_GenNames( GLsizei n, GLuint* names )
+{
+	for( int i = 0; i < n; i++ )
+	{
+		names[i] = nullGLNames.Increment();
+	}
+}
+
+/*
+========================
+NullGL_BufferBinding
+========================
+*/
+static GLuint& NullGL_BufferBinding( GLenum target )
+{
+	switch( target )
+	{
+		case GL_ARRAY_BUFFER:
+			return nullGLBoundBuffers[0];
+		case GL_ELEMENT_ARRAY_BUFFER:
+			return nullGLBoundBuffers[1];
+		case GL_UNIFORM_BUFFER:
+			return nullGLBoundBuffers[2];
+		default:
+			return nullGLBoundBuffers[3];
+	}
+}
+
+/*
+========================
+NullGL_BoundBuffer
+
+Must be called with nullGLBufferMutex locked.
+========================
+*/
+static nullGLBuffer_t* NullGL_BoundBuffer( GLenum target )
+{
+	const GLuint name = NullGL_BufferBinding( target );
+	if( name == 0 || ( int )name >= nullGLBuffers.Num() )
+	{
+		return NULL;
+	}
+	return &nullGLBuffers[name];
+}
+
+/*
+===============================================================================
+
+	OpenGL 1.1 entry points, exported directly like libGL does
+
+===============================================================================
+*/
+
+void glAlphaFunc( GLenum func, GLclampf ref ) {}
+void glArrayElement( GLint i ) {}
+void glBegin( GLenum mode ) {}
+void glBindTexture( GLenum target, GLuint texture ) {}
+void glBlendFunc( GLenum sfactor, GLenum dfactor ) {}
+void glClear( GLbitfield mask ) {}
+void glClearColor( GLclampf red, GLclampf green, GLclampf blue, GLclampf alpha ) {}
+void glClearDepth( GLclampd depth ) {}
+void glClearStencil( GLint s ) {}
+void glColor3f( GLfloat red, GLfloat green, GLfloat blue ) {}
+void glColor3fv( const GLfloat* v ) {}
+void glColor4f( GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha ) {}
+void glColor4fv( const GLfloat* v ) {}
+void glColor4ubv( const GLubyte* v ) {}
+void glColorMask( GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha ) {}
+void glCopyTexImage2D( GLenum target, GLint level, GLenum internalFormat, GLint x, GLint y, GLsizei width, GLsizei height, GLint border ) {}
+void glCullFace( GLenum mode ) {}
+void glDeleteTextures( GLsizei n, const GLuint* textures ) {}
+void glDepthFunc( GLenum func ) {}
+void glDepthMask( GLboolean flag ) {}
+void glDisable( GLenum cap ) {}
+void glDrawBuffer( GLenum mode ) {}
+void glDrawElements( GLenum mode, GLsizei count, GLenum type, const GLvoid* indices ) {}
+void glDrawPixels( GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels ) {}
+void glEnable( GLenum cap ) {}
+void glEnd( void ) {}
+void glFinish( void ) {}
+void glFlush( void ) {}
+void glLineWidth( GLfloat width ) {}
+void glLoadIdentity( void ) {}
+void glLoadMatrixf( const GLfloat* m ) {}
+void glMatrixMode( GLenum mode ) {}
+void glOrtho( GLdouble left, GLdouble right, GLdouble bottom, GLdouble top, GLdouble zNear, GLdouble zFar ) {}
+void glPixelStorei( GLenum pname, GLint param ) {}
+void glPolygonMode( GLenum face, GLenum mode ) {}
+void glPolygonOffset( GLfloat factor, GLfloat units ) {}
+void glPopAttrib( void ) {}
+void glPopMatrix( void ) {}
+void glPushAttrib( GLbitfield mask ) {}
+void glPushMatrix( void ) {}
+void glRasterPos2f( GLfloat x, GLfloat y ) {}
+void glReadBuffer( GLenum mode ) {}
+void glScissor( GLint x, GLint y, GLsizei width, GLsizei height ) {}
+void glShadeModel( GLenum mode ) {}
+void glStencilFunc( GLenum func, GLint ref, GLuint mask ) {}
+void glStencilOp( GLenum fail, GLenum zfail, GLenum zpass ) {}
+void glTexImage2D( GLenum target, GLint level, GLint internalformat, GLsizei width, GLsizei height, GLint border, GLenum format, GLenum type, const GLvoid* pixels ) {}
+void glTexParameterf( GLenum target, GLenum pname, GLfloat param ) {}
+void glTexParameterfv( GLenum target, GLenum pname, const GLfloat* params ) {}
+void glTexParameteri( GLenum target, GLenum pname, GLint param ) {}
+void glTexSubImage2D( GLenum target, GLint level, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum format, GLenum type, const GLvoid* pixels ) {}
+void glVertex2f( GLfloat x, GLfloat y ) {}
+void glVertex3f( GLfloat x, GLfloat y, GLfloat z ) {}
+void glVertex3fv( const GLfloat* v ) {}
+void glVertexPointer( GLint size, GLenum type, GLsizei stride, const GLvoid* pointer ) {}
+void glViewport( GLint x, GLint y, GLsizei width, GLsizei height ) {}
+
+void glGenTextures( GLsizei n, GLuint* textures )
+{
+	NullGL_GenNames( n, textures );
+}
+
+GLenum glGetError( void )
+{
+	return GL_NO_ERROR;
+}
+
+const GLubyte* glGetString( GLenum name )
+{
+	switch( name )
+	{
+		case GL_VENDOR:
+			return ( const GLubyte* )"id Software";
+		case GL_RENDERER:
+			return ( const GLubyte* )"Null OpenGL";
+		case GL_VERSION:
+			return ( const GLubyte* )"3.3 Null";
+		case GL_SHADING_LANGUAGE_VERSION:
+			return ( const GLubyte* )"3.30";
+		case GL_EXTENSIONS:
+			return ( const GLubyte* )NULLGL_EXTENSIONS;
+		default:
+			return NULL;
+	}
+}
+
+void glGetIntegerv( GLenum pname, GLint* params )
+{
+	switch( pname )
+	{
+		case GL_MAX_TEXTURE_SIZE:
+		case GL_MAX_RENDERBUFFER_SIZE:
+			params[0] = 4096;
+			break;
+		case GL_MAX_TEXTURE_COORDS:
+		case GL_MAX_COLOR_ATTACHMENTS:
+			params[0] = 8;
+			break;
+		case GL_MAX_TEXTURE_IMAGE_UNITS:
+			params[0] = 16;
+			break;
+		case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+			params[0] = 256;
+			break;
+		default:
+			params[0] = 0;
+			break;
+	}
+}
+
+void glGetFloatv( GLenum pname, GLfloat* params )
+{
+	params[0] = ( pname == GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT ) ? 1.0f : 0.0f;
+}
+
+void glReadPixels( GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLvoid* pixels ) {}
+
+/*
+===============================================================================
+
+	Extension entry points, handed out by glXGetProcAddressARB
+
+===============================================================================
+*/
+
+static void GLAPIENTRY NullGL_GenObjects( GLsizei n, GLuint* names )
+{
+	NullGL_GenNames( n, names );
+}
+
+static GLuint GLAPIENTRY NullGL_CreateObject()
+{
+	return nullGLNames.Increment();
+}
+
+static void GLAPIENTRY NullGL_GenBuffers( GLsizei n, GLuint* buffers )
+{
+	idScopedCriticalSection lock( nullGLBufferMutex );
+
+	for( int i = 0; i < n; i++ )
+	{
+		// buffer zero is never handed out
+		if( nullGLBuffers.Num() == 0 )
+		{
+			nullGLBuffer_t& none = nullGLBuffers.Alloc();
+			none.data = NULL;
+			none.size = 0;
+		}
+
+		// reuse deleted buffers so the list doesn't grow with every re-created buffer
+		int name = 1;
+		for( ; name < nullGLBuffers.Num(); name++ )
+		{
+			if( nullGLBuffers[name].size < 0 )
+			{
+				break;
+			}
+		}
+		if( name == nullGLBuffers.Num() )
+		{
+			nullGLBuffers.Alloc();
+		}
+		nullGLBuffers[name].data = NULL;
+		nullGLBuffers[name].size = 0;
+		buffers[i] = name;
+	}
+}
+
+static void GLAPIENTRY NullGL_DeleteBuffers( GLsizei n, const GLuint* buffers )
+{
+	idScopedCriticalSection lock( nullGLBufferMutex );
+
+	for( int i = 0; i < n; i++ )
+	{
+		const GLuint name = buffers[i];
+		if( name == 0 || ( int )name >= nullGLBuffers.Num() )
+		{
+			continue;
+		}
+		Mem_Free( nullGLBuffers[name].data );
+		nullGLBuffers[name].data = NULL;
+		nullGLBuffers[name].size = -1;
+
+		for( int j = 0; j < 4; j++ )
+		{
+			if( nullGLBoundBuffers[j] == name )
+			{
+				nullGLBoundBuffers[j] = 0;
+			}
+		}
+	}
+}
+
+static void GLAPIENTRY NullGL_BindBuffer( GLenum target, GLuint buffer )
+{
+	idScopedCriticalSection lock( nullGLBufferMutex );
+
+	NullGL_BufferBinding( target ) = buffer;
+}
+
+static void GLAPIENTRY NullGL_BufferData( GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage )
+{
+	idScopedCriticalSection lock( nullGLBufferMutex );
+
+	nullGLBuffer_t* buffer = NullGL_BoundBuffer( target );
+	if( buffer == NULL )
+	{
+		return;
+	}
+	if( buffer->size != size )
+	{
+		Mem_Free( buffer->data );
+		buffer->data = ( size > 0 ) ? ( byte* )Mem_Alloc( size, TAG_RENDER ) : NULL;
+		buffer->size = size;
+	}
+	if( data != NULL && buffer->data != NULL )
+	{
+		memcpy( buffer->data, data, size );
+	}
+}
+
+static void GLAPIENTRY NullGL_BufferSubData( GLenum target, GLintptr offset, GLsizeiptr size, const GLvoid* data )
+{
+	idScopedCriticalSection lock( nullGLBufferMutex );
+
+	nullGLBuffer_t* buffer = NullGL_BoundBuffer( target );
+	if( buffer == NULL || buffer->data == NULL || offset < 0 || offset + size > buffer->size )
+	{
+		return;
+	}
+	memcpy( buffer->data + offset, data, size );
+}
+
+static GLvoid* GLAPIENTRY NullGL_MapBufferRange( GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access )
+{
+	idScopedCriticalSection lock( nullGLBufferMutex );
+
+	nullGLBuffer_t* buffer = NullGL_BoundBuffer( target );
+	if( buffer == NULL || buffer->data == NULL || offset < 0 || offset + length > buffer->size )
+	{
+		return NULL;
+	}
+	return buffer->data + offset;
+}
+
+static GLvoid* GLAPIENTRY NullGL_MapBuffer( GLenum target, GLenum access )
+{
+	idScopedCriticalSection lock( nullGLBufferMutex );
+
+	nullGLBuffer_t* buffer = NullGL_BoundBuffer( target );
+	return ( buffer != NULL ) ? buffer->data : NULL;
+}
+
+static GLboolean GLAPIENTRY NullGL_UnmapBuffer( GLenum target )
+{
+	return GL_TRUE;
+}
+
+static void GLAPIENTRY NullGL_GetShaderiv( GLuint shader, GLenum pname, GLint* param )
+{
+	// every shader compiles and every program links, without an info log
+	param[0] = ( pname == GL_COMPILE_STATUS || pname == GL_LINK_STATUS ) ? GL_TRUE : 0;
+}
+
+static void GLAPIENTRY NullGL_GetInfoLog( GLuint object, GLsizei bufSize, GLsizei* length, GLchar* infoLog )
+{
+	if( length != NULL )
+	{
+		*length = 0;
+	}
+	if( infoLog != NULL && bufSize > 0 )
+	{
+		infoLog[0] = '\0';
+	}
+}
+
+static void GLAPIENTRY NullGL_GetActiveUniform( GLuint program, GLuint index, GLsizei maxLength, GLsizei* length, GLint* size, GLenum* type, GLchar* name )
+{
+	NullGL_GetInfoLog( program, maxLength, length, name );
+	*size = 0;
+	*type = GL_FLOAT_VEC4;
+}
+
+static GLint GLAPIENTRY NullGL_GetUniformLocation( GLuint program, const GLchar* name )
+{
+	return 0;
+}
+
+static GLenum GLAPIENTRY NullGL_CheckFramebufferStatus( GLenum target )
+{
+	return GL_FRAMEBUFFER_COMPLETE;
+}
+
+static GLsync GLAPIENTRY NullGL_FenceSync( GLenum condition, GLbitfield flags )
+{
+	return ( GLsync )1;
+}
+
+static GLenum GLAPIENTRY NullGL_ClientWaitSync( GLsync sync, GLbitfield flags, GLuint64 timeout )
+{
+	return GL_ALREADY_SIGNALED;
+}
+
+static GLboolean GLAPIENTRY NullGL_IsSync( GLsync sync )
+{
+	return GL_TRUE;
+}
+
+static void GLAPIENTRY NullGL_GetQueryObjectui64v( GLuint id, GLenum pname, GLuint64EXT* params )
+{
+	params[0] = 0;
+}
+
+static void* GLAPIENTRY NullGL_GetCurrentDisplay()
+{
+	return NULL;
+}
+
+/*
+========================
+NullGL_Null
+
+Everything that has nothing to return. Returning zero also keeps any entry point that
+is missing from nullGLProcs well behaved.
+========================
+*/
+static GLintptr GLAPIENTRY NullGL_Null()
+{
+	return 0;
+}
+
+static const struct
+{
+	const char* 	name;
+	nullGLProc_t	proc;
+} nullGLProcs[] =
+{
+	{ "glGenBuffers",						( nullGLProc_t )NullGL_GenBuffers },
+	{ "glGenBuffersARB",					( nullGLProc_t )NullGL_GenBuffers },
+	{ "glDeleteBuffers",					( nullGLProc_t )NullGL_DeleteBuffers },
+	{ "glDeleteBuffersARB",					( nullGLProc_t )NullGL_DeleteBuffers },
+	{ "glBindBuffer",						( nullGLProc_t )NullGL_BindBuffer },
+	{ "glBindBufferARB",					( nullGLProc_t )NullGL_BindBuffer },
+	{ "glBufferData",						( nullGLProc_t )NullGL_BufferData },
+	{ "glBufferDataARB",					( nullGLProc_t )NullGL_BufferData },
+	{ "glBufferSubData",					( nullGLProc_t )NullGL_BufferSubData },
+	{ "glBufferSubDataARB",					( nullGLProc_t )NullGL_BufferSubData },
+	{ "glMapBuffer",						( nullGLProc_t )NullGL_MapBuffer },
+	{ "glMapBufferARB",						( nullGLProc_t )NullGL_MapBuffer },
+	{ "glMapBufferRange",					( nullGLProc_t )NullGL_MapBufferRange },
+	{ "glUnmapBuffer",						( nullGLProc_t )NullGL_UnmapBuffer },
+	{ "glUnmapBufferARB",					( nullGLProc_t )NullGL_UnmapBuffer },
+	{ "glGenFramebuffers",					( nullGLProc_t )NullGL_GenObjects },
+	{ "glGenFramebuffersEXT",				( nullGLProc_t )NullGL_GenObjects },
+	{ "glGenRenderbuffers",					( nullGLProc_t )NullGL_GenObjects },
+	{ "glGenRenderbuffersEXT",				( nullGLProc_t )NullGL_GenObjects },
+	{ "glGenQueries",						( nullGLProc_t )NullGL_GenObjects },
+	{ "glGenQueriesARB",					( nullGLProc_t )NullGL_GenObjects },
+	{ "glGenVertexArrays",					( nullGLProc_t )NullGL_GenObjects },
+	{ "glCreateShader",						( nullGLProc_t )NullGL_CreateObject },
+	{ "glCreateProgram",					( nullGLProc_t )NullGL_CreateObject },
+	{ "glGetShaderiv",						( nullGLProc_t )NullGL_GetShaderiv },
+	{ "glGetProgramiv",						( nullGLProc_t )NullGL_GetShaderiv },
+	{ "glGetShaderInfoLog",					( nullGLProc_t )NullGL_GetInfoLog },
+	{ "glGetProgramInfoLog",				( nullGLProc_t )NullGL_GetInfoLog },
+	{ "glGetActiveUniform",					( nullGLProc_t )NullGL_GetActiveUniform },
+	{ "glGetUniformLocation",				( nullGLProc_t )NullGL_GetUniformLocation },
+	{ "glGetUniformBlockIndex",				( nullGLProc_t )NullGL_GetUniformLocation },
+	{ "glCheckFramebufferStatus",			( nullGLProc_t )NullGL_CheckFramebufferStatus },
+	{ "glCheckFramebufferStatusEXT",		( nullGLProc_t )NullGL_CheckFramebufferStatus },
+	{ "glFenceSync",						( nullGLProc_t )NullGL_FenceSync },
+	{ "glClientWaitSync",					( nullGLProc_t )NullGL_ClientWaitSync },
+	{ "glIsSync",							( nullGLProc_t )NullGL_IsSync },
+	{ "glGetQueryObjectui64v",				( nullGLProc_t )NullGL_GetQueryObjectui64v },
+	{ "glGetQueryObjectui64vEXT",			( nullGLProc_t )NullGL_GetQueryObjectui64v },
+	{ "glXGetCurrentDisplay",				( nullGLProc_t )NullGL_GetCurrentDisplay },
+};
+
+/*
+===============================================================================
+
+	GLX entry points GLEW links against
+
+===============================================================================
+*/
+
+extern "C"
+{
+
+nullGLProc_t glXGetProcAddressARB( const GLubyte* procName )
+{
+	for( int i = 0; i < ( int )ARRAY_COUNT( nullGLProcs ); i++ )
+	{
+		if( idStr::Cmp( nullGLProcs[i].name, ( const char* )procName ) == 0 )
+		{
+			return nullGLProcs[i].proc;
+		}
+	}
+	return ( nullGLProc_t )NullGL_Null;
+}
+
+int glXQueryVersion( void* dpy, int* major, int* minor )
+{
+	*major = 1;
+	*minor = 4;
+	return 1;
+}
+
+const char* glXGetClientString( void* dpy, int name )
+{
+	return "";
+}
+
+}
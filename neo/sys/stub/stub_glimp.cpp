@@ -0,0 +1,161 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+/*
+================================================================================================
+Windowless GLimp for the dedicated server, replacing sdl_glimp.cpp.
+
+There is no window and no context, GLimp_Init only brings up GLEW on top of the null
+OpenGL driver in stub_gl.cpp.
+================================================================================================
+*/
+#pragma hdrstop
+#include "../../idlib/precompiled.h"
+
+#include "renderer/tr_local.h"
+#include "../sdl/sdl_local.h"
+
+idCVar in_nograb( "in_nograb", "0", CVAR_SYSTEM | CVAR_NOCHEAT, "prevents input grabbing" );
+idCVar r_waylandcompat( "r_waylandcompat", "0", CVAR_SYSTEM | CVAR_NOCHEAT | CVAR_ARCHIVE, "wayland compatible framebuffer" );
+idCVar r_useOpenGL32( "r_useOpenGL32", "1", CVAR_INTEGER, "0 = OpenGL 3.x, 1 = OpenGL 3.2 compatibility profile, 2 = OpenGL 3.2 core profile", 0, 2 );
+
+/*
+===================
+GLimp_PreInit
+===================
+*/
+void GLimp_PreInit()
+{
+}
+
+/*
+===================
+GLimp_Init
+===================
+*/
+bool GLimp_Init( glimpParms_t parms )
+{
+	common->Printf( "Initializing null OpenGL subsystem\n" );
+
+	GLenum glewResult = glewInit();
+	if( GLEW_OK != glewResult )
+	{
+		common->Printf( "^3GLimp_Init() - GLEW could not load the null OpenGL driver: %s", glewGetErrorString( glewResult ) );
+		return false;
+	}
+
+	glConfig.driverType = GLDRV_OPENGL3X;
+	glConfig.colorBits = 24;
+	glConfig.depthBits = 24;
+	glConfig.stencilBits = 8;
+	glConfig.isFullscreen = parms.fullScreen;
+	glConfig.isStereoPixelFormat = false;
+	glConfig.nativeScreenWidth = parms.width;
+	glConfig.nativeScreenHeight = parms.height;
+	glConfig.displayFrequency = 60;
+	glConfig.multisamples = 0;
+	glConfig.pixelAspect = 1.0f;
+
+	return true;
+}
+
+/*
+===================
+GLimp_SetScreenParms
+===================
+*/
+bool GLimp_SetScreenParms( glimpParms_t parms )
+{
+	glConfig.isFullscreen = parms.fullScreen;
+	glConfig.nativeScreenWidth = parms.width;
+	glConfig.nativeScreenHeight = parms.height;
+
+	return true;
+}
+
+/*
+===================
+GLimp_Shutdown
+===================
+*/
+void GLimp_Shutdown()
+{
+	common->Printf( "Shutting down null OpenGL subsystem\n" );
+}
+
+/*
+===================
+GLimp_SwapBuffers
+===================
+*/
+void GLimp_SwapBuffers()
+{
+}
+
+/*
+=================
+GLimp_SetGamma
+=================
+*/
+void GLimp_SetGamma( unsigned short red[256], unsigned short green[256], unsigned short blue[256] )
+{
+}
+
+/*
+===================
+GLimp_GrabInput
+===================
+*/
+void GLimp_GrabInput( int flags )
+{
+}
+
+/*
+====================
+DumpAllDisplayDevices
+====================
+*/
+void DumpAllDisplayDevices()
+{
+	common->Printf( "no display devices on the dedicated server\n" );
+}
+
+/*
+====================
+R_GetModeListForDisplay
+====================
+*/
+bool R_GetModeListForDisplay( const int requestedDisplayNum, idList<vidMode_t>& modeList )
+{
+	modeList.Clear();
+	if( requestedDisplayNum != 0 )
+	{
+		return false;
+	}
+	modeList.Append( vidMode_t() );	// 640x480 at 60 Hz
+	return true;
+}
@@ -0,0 +1,227 @@
+/*
+===========================================================================
+
+Doom 3 BFG Edition GPL Source Code
+Copyright (C) 1993-2012 id Software LLC, a ZeniMax Media company.
+
+This file is part of the Doom 3 BFG Edition GPL Source Code ("Doom 3 BFG Edition Source Code").
+
+Doom 3 BFG Edition Source Code is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+(at your option) any later version.
+
+Doom 3 BFG Edition Source Code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with Doom 3 BFG Edition Source Code.  If not, see <http://www.gnu.org/licenses/>.
+
+In addition, the Doom 3 BFG Edition Source Code is also subject to certain additional terms. You should have received a copy of these additional terms immediately following the terms and conditions of the GNU General Public License which accompanied the Doom 3 BFG Edition Source Code.  If not, please request a copy in writing from id Software at the address below.
+
+If you have questions concerning this license or the applicable additional terms, you may contact in writing id Software LLC, c/o ZeniMax Media Inc., Suite 120, Rockville, Maryland 20850 USA.
+
+===========================================================================
+*/
+/*
+================================================================================================
+Input for the dedicated server, replacing sdl_events.cpp.
+
+The only input is the terminal, whose lines are queued as console events.
+================================================================================================
+*/
+#pragma hdrstop
+#include "../../idlib/precompiled.h"
+
+#include "../posix/posix_public.h"
+
+static idList<sysEvent_t> consoleEvents;
+
+/*
+=================
+Sys_InitInput
+=================
+*/
+void Sys_InitInput()
+{
+	common->Printf( "Sys_InitInput: console input only\n" );
+}
+
+/*
+=================
+Sys_ShutdownInput
+=================
+*/
+void Sys_ShutdownInput()
+{
+	Sys_ClearEvents();
+}
+
+/*
+===========
+Sys_InitScanTable
+===========
+*/
+void Sys_InitScanTable()
+{
+}
+
+/*
+===============
+Sys_GetConsoleKey
+===============
+*/
+unsigned char Sys_GetConsoleKey( bool shifted )
+{
+	return shifted ? '~' : '`';
+}
+
+/*
+===============
+Sys_MapCharForKey
+===============
+*/
+unsigned char Sys_MapCharForKey( int key )
+{
+	return key & 0xff;
+}
+
+/*
+===============
+Sys_GrabMouseCursor
+===============
+*/
+void Sys_GrabMouseCursor( bool grabIt )
+{
+}
+
+/*
+================
+Sys_GetEvent
+================
+*/
+sysEvent_t Sys_GetEvent()
+{
+	// when this is returned, it's assumed that there are no more events!
+	static const sysEvent_t no_more_events = { SE_NONE, 0, 0, 0, NULL };
+
+	if( consoleEvents.Num() == 0 )
+	{
+		return no_more_events;
+	}
+
+	sysEvent_t res = consoleEvents[0];
+	consoleEvents.RemoveIndex( 0 );
+	return res;
+}
+
+/*
+================
+Sys_ClearEvents
+================
+*/
+void Sys_ClearEvents()
+{
+	for( int i = 0; i < consoleEvents.Num(); i++ )
+	{
+		Mem_Free( consoleEvents[i].evPtr );
+	}
+	consoleEvents.Clear();
+}
+
+/*
+================
+Sys_GenerateEvents
+================
+*/
+void Sys_GenerateEvents()
+{
+	char* s = Posix_ConsoleInput();
+
+	if( s )
+	{
+		const size_t len = strlen( s ) + 1;
+		char* b = ( char* )Mem_Alloc( len, TAG_EVENTS );
+		strcpy( b, s );
+
+		sysEvent_t& ev = consoleEvents.Alloc();
+		ev.evType = SE_CONSOLE;
+		ev.evValue = 0;
+		ev.evValue2 = 0;
+		ev.evPtrLength = len;
+		ev.evPtr = b;
+	}
+}
+
+/*
+================
+Sys_PollKeyboardInputEvents
+================
+*/
+int Sys_PollKeyboardInputEvents()
+{
+	return 0;
+}
+
+/*
+================
+Sys_ReturnKeyboardInputEvent
+================
+*/
+int Sys_ReturnKeyboardInputEvent( const int n, int& key, bool& state )
+{
+	return 0;
+}
+
+/*
+================
+Sys_EndKeyboardInputEvents
+================
+*/
+void Sys_EndKeyboardInputEvents()
+{
+}
+
+/*
+================
+Sys_PollMouseInputEvents
+================
+*/
+int Sys_PollMouseInputEvents( int mouseEvents[MAX_MOUSE_EVENTS][2] )
+{
+	return 0;
+}
+
+/*
+================
+Sys_GetKeyName
+================
+*/
+const char* Sys_GetKeyName( keyNum_t keynum )
+{
+	return NULL;
+}
+
+//=====================================================================================
+//	Joystick Input Handling
+//=====================================================================================
+
+void Sys_SetRumble( int device, int low, int hi )
+{
+}
+
+int Sys_PollJoystickInputEvents( int deviceNum )
+{
+	return 0;
+}
+
+int Sys_ReturnJoystickInputEvent( const int n, int& action, int& value )
+{
+	return 0;
+}
+
+void Sys_EndJoystickInputEvents()
+{
+}
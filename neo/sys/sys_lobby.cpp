@@ -68,7 +68,7 @@ idLobby::idLobby()
 	sessionCB				= NULL;
 	
 	localReadSS				= NULL;
-	objMemory				= NULL;
+	memset( snapJobMemory.Ptr(), 0, snapJobMemory.ByteSize() );
 	haveSubmittedSnaps		= false;
 	
 	state					= STATE_IDLE;
@@ -128,13 +128,6 @@ void idLobby::Initialize( lobbyType_t sessionType_, idSessionCallbacks* callback
 	
 	lobbyType = sessionType_;
 	sessionCB	= callbacks;
-	
-	if( lobbyType == GetActingGameStateLobbyType() )
-	{
-		// only needed in multiplayer mode
-		objMemory		= ( uint8* )Mem_Alloc( SNAP_OBJ_JOB_MEMORY, TAG_NETWORKING );
-		lzwData			= ( lzwCompressionData_t* )Mem_Alloc( sizeof( lzwCompressionData_t ), TAG_NETWORKING );
-	}
 }
 
 //===============================================================================
@@ -310,6 +303,9 @@ void idLobby::Shutdown( bool retainMigrationInfo, bool skipGoodbye )
 	
 	FreeAllUsers();
 	
+	// The peers are gone, release their snapshot job memory
+	FreeSnapJobMemory();
+	
 	host					= -1;
 	peerIndexOnHost			= -1;
 	isHost					= false;
@@ -1607,6 +1603,9 @@ void idLobby::SendConnectionRequest()
 	// We just used these users to fill up the msg above, we will get the real list from the server if we connect.
 	FreeAllUsers();
 	
+	// Let the host know which snapshot delta codecs we can decode
+	msg.WriteByte( SNAP_CODEC_SUPPORTED );
+	
 	NET_VERBOSE_PRINT( "NET: Sending hello to: %s (lobbyType: %s, session ID %i, attempt: %i)\n", hostAddress.ToString(), GetLobbyName(), peers[host].sessionID, connectionAttempts );
 	
 	SendConnectionLess( hostAddress, OOB_HELLO, msg.GetReadData(), msg.GetSize() );
@@ -2011,6 +2010,15 @@ int idLobby::HandleInitialPeerConnection( idBitMsg& msg, const lobbyAddress_t& p
 	// (which will then forward the list to all peers except peerNum)
 	AddUsersFromMsg( msg, peerNum );
 	
+	// The version check lets only peers through that send the codec mask
+	const int peerCodecs = msg.ReadByte();
+	
+	if( newPeer.snapProc != NULL )
+	{
+		newPeer.snapProc->SetDeltaCodec( idSnapDeltaCodec::Negotiate( peerCodecs ) );
+		NET_VERBOSE_PRINT( "NET: Peer %i using %s snapshot deltas\n", peerNum, idSnapDeltaCodec::GetName( newPeer.snapProc->GetDeltaCodec() ) );
+	}
+	
 	// Mark the peer as connected for this session type
 	SetPeerConnectionState( peerNum, CONNECTION_ESTABLISHED );
 	
@@ -740,6 +740,8 @@ public:		// Turning this on for now, for the sake of getting this up and running
 	bool								SendCompletedSnaps();
 	bool								SendResources( int p );
 	bool								SubmitPendingSnap( int p );
+	void								WriteSubmittedSnaps( const int* peerNums, int numPeers );
+	void								FreeSnapJobMemory();
 	void								SendCompletedPendingSnap( int p );
 	void								CheckPeerThrottle( int p );
 	void								ApplySnapshotDelta( int p, int snapshotNumber );
@@ -925,8 +927,15 @@ public:		// Turning this on for now, for the sake of getting this up and running
 	//------------------------
 	static const int SNAP_OBJ_JOB_MEMORY = 1024 * 128;			// 128k of obj memory
 	
-	lzwCompressionData_t* 				lzwData;				// Shared across all snapshot jobs
-	uint8* 								objMemory;				// Shared across all snapshot jobs
+	// Each peer gets its own scratch memory, so the deltas of all peers can be written at the same time
+	struct snapJobMemory_t
+	{
+		uint8* 							objMemory;
+		lzwCompressionData_t* 			lzwData;
+		snapFastCodecData_t* 			fastCodecData;
+	};
+	
+	idArray< snapJobMemory_t, MAX_PEERS >	snapJobMemory;		// Allocated the first time a snap is submitted for the peer
 	bool								haveSubmittedSnaps;		// True if we previously submitted snaps to jobs
 	idSnapShot* 						localReadSS;
 	
@@ -78,6 +78,7 @@ public:
 	bool InitPort( int portNumber, bool useBackend );
 	bool ReadRawPacket( lobbyAddress_t& from, void* data, int& size, int maxSize );
 	void SendRawPacket( const lobbyAddress_t& to, const void* data, int size );
+	void FlushRawPackets();
 	
 	bool IsOpen();
 	void Close();
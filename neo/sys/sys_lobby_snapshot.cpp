@@ -55,6 +55,8 @@ idCVar net_pingRecoveryThrottleTimeInSeconds( "net_pingRecoveryThrottleTimeInSec
 
 idCVar net_peer_timeout_loading( "net_peer_timeout_loading", "90000", CVAR_INTEGER, "time in MS to disconnect clients during loading - production only" );
 
+idCVar net_snapJobs( "net_snapJobs", "1", CVAR_BOOL, "Write the snapshot deltas of all peers in parallel on the job threads" );
+
 
 /*
 ========================
@@ -81,6 +83,9 @@ void idLobby::UpdateSnaps()
 		return;
 	}
 	
+	int submittedPeers[ MAX_PEERS ];
+	int numSubmittedPeers = 0;
+	
 	for( int p = 0; p < peers.Num(); p++ )
 	{
 		peer_t& peer = peers[p];
@@ -96,11 +101,14 @@ void idLobby::UpdateSnaps()
 			if( SubmitPendingSnap( p ) )
 			{
 				peer.needToSubmitPendingSnap = false;	// only clear this if we actually submitted the snap
+				submittedPeers[ numSubmittedPeers++ ] = p;
 			}
 			
 		}
 	}
 	
+	WriteSubmittedSnaps( submittedPeers, numSubmittedPeers );
+	
 #if 0
 	uint64 endTimeMicroSec = Sys_Microseconds();
 	
@@ -220,14 +228,92 @@ bool idLobby::SubmitPendingSnap( int p )
 	peer.lastSnapJobTime = time;
 	assert( !peer.snapProc->PendingSnapReadyToSend() );
 	
-	// Submit snapshot delta to jobs
-	peer.snapProc->SubmitPendingSnap( p + 1, objMemory, SNAP_OBJ_JOB_MEMORY, lzwData );
+	snapJobMemory_t& jobMemory = snapJobMemory[p];
+	
+	if( jobMemory.objMemory == NULL )
+	{
+		jobMemory.objMemory		= ( uint8* )Mem_Alloc( SNAP_OBJ_JOB_MEMORY, TAG_NETWORKING );
+		jobMemory.lzwData		= ( lzwCompressionData_t* )Mem_Alloc( sizeof( lzwCompressionData_t ), TAG_NETWORKING );
+		jobMemory.fastCodecData	= ( snapFastCodecData_t* )Mem_Alloc( sizeof( snapFastCodecData_t ), TAG_NETWORKING );
+	}
+	
+	// Set up the snapshot delta, it gets written in WriteSubmittedSnaps
+	peer.snapProc->PreparePendingSnap( p + 1, jobMemory.objMemory, SNAP_OBJ_JOB_MEMORY, jobMemory.lzwData, jobMemory.fastCodecData );
 	
 	NET_VERBOSESNAPSHOT_PRINT_LEVEL( 2, va( "  Submitted snapshot to jobList for peer %d. Since last jobsub: %d\n", p, timeFromLastSub ) );
 	
 	return true;
 }
 
+/*
+========================
+WriteSnapJob
+========================
+*/
+static void WriteSnapJob( idSnapshotProcessor* snapProc )
+{
+	snapProc->WritePendingSnap();
+}
+
+REGISTER_PARALLEL_JOB( WriteSnapJob, "WriteSnapJob" );
+
+/*
+========================
+idLobby::WriteSubmittedSnaps
+Writes the deltas of the snaps set up by SubmitPendingSnap.
+The object states are shared between the peers and nothing touches them until all deltas are written,
+so each peer can be handed to a different job thread.
+========================
+*/
+void idLobby::WriteSubmittedSnaps( const int* peerNums, int numPeers )
+{
+	assert( lobbyType == GetActingGameStateLobbyType() );
+	
+	SCOPED_PROFILE_EVENT( "WriteSubmittedSnaps" );
+	
+	if( numPeers <= 1 || !net_snapJobs.GetBool() )
+	{
+		for( int i = 0; i < numPeers; i++ )
+		{
+			peers[ peerNums[i] ].snapProc->WritePendingSnap();
+		}
+		return;
+	}
+	
+	idParallelJobList* jobList = parallelJobManager->AllocJobList( JOBLIST_UTILITY, JOBLIST_PRIORITY_HIGH, numPeers, 0, NULL );
+	
+	for( int i = 0; i < numPeers; i++ )
+	{
+		jobList->AddJob( ( jobRun_t )WriteSnapJob, peers[ peerNums[i] ].snapProc );
+	}
+	
+	jobList->Submit( NULL, JOBLIST_PARALLELISM_MAX_CORES );
+	jobList->Wait();
+	parallelJobManager->FreeJobList( jobList );
+}
+
+/*
+========================
+idLobby::FreeSnapJobMemory
+The snap jobs are done by the time WriteSubmittedSnaps returns, so this is safe whenever no snap is being written.
+========================
+*/
+void idLobby::FreeSnapJobMemory()
+{
+	for( int p = 0; p < snapJobMemory.Num(); p++ )
+	{
+		snapJobMemory_t& jobMemory = snapJobMemory[p];
+		
+		Mem_Free( jobMemory.objMemory );
+		Mem_Free( jobMemory.lzwData );
+		Mem_Free( jobMemory.fastCodecData );
+		
+		jobMemory.objMemory		= NULL;
+		jobMemory.lzwData		= NULL;
+		jobMemory.fastCodecData	= NULL;
+	}
+}
+
 /*
 ========================
 idLobby::SendCompletedPendingSnap
@@ -58,7 +58,8 @@ enum cpuid_t
 	CPUID_FTZ							= 0x04000,	// Flush-To-Zero mode (denormal results are flushed to zero)
 	CPUID_DAZ							= 0x08000,	// Denormals-Are-Zero mode (denormal source operands are set to zero)
 	CPUID_XENON							= 0x10000,	// Xbox 360
-	CPUID_CELL							= 0x20000	// PS3
+	CPUID_CELL							= 0x20000,	// PS3
+	CPUID_AVX2							= 0x40000	// Advanced Vector Extensions 2, including OS support for the 256-bit registers
 };
 
 enum fpuExceptions_t
@@ -722,6 +723,13 @@ typedef FILE* idFileHandle;
 
 
 ID_TIME_T		Sys_FileTimeStamp( idFileHandle fp );
+
+// maps a whole file copy-on-write so reads can be served without a copy,
+// returns NULL if the platform doesn't support it or the mapping fails
+void* 			Sys_MapFile( const char* osPath, int& length );
+void			Sys_UnmapFile( void* data, int length );
+// hint that a range of a mapping is about to be read
+void			Sys_PrefetchMappedRange( void* data, int offset, int length );
 // NOTE: do we need to guarantee the same output on all platforms?
 const char* 	Sys_TimeStampToStr( ID_TIME_T timeStamp );
 const char* 	Sys_SecToStr( int sec );
@@ -779,6 +787,8 @@ typedef struct
 
 #define	PORT_ANY			-1
 
+class idUDPThread;
+
 /*
 ================================================
 idUDP
@@ -815,6 +825,17 @@ public:
 								   
 	void		SendPacket( const netadr_t to, const void* data, int size );
 	
+	// On Linux the socket can be serviced by a network thread that batches the I/O with
+	// recvmmsg/sendmmsg. InitForPort starts it when net_udpThread is set. Packets sent
+	// while the thread runs are queued until Flush() or until the send queue fills up.
+	bool		StartIOThread();
+	void		StopIOThread();
+	bool		HasIOThread() const
+	{
+		return ioThread != NULL;
+	}
+	void		Flush();
+	
 	void		SetSilent( bool silent )
 	{
 		this->silent = silent;
@@ -839,6 +860,7 @@ private:
 	netadr_t	bound_to;		// interface and port
 	int			netSocket;		// OS specific socket
 	bool		silent;			// don't emit anything ( black hole )
+	idUDPThread* ioThread;		// NULL when the socket is read and written directly
 };
 
 
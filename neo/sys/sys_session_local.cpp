@@ -52,6 +52,7 @@ idCVar net_ignoreTitleStorage( "net_ignoreTitleStorage", "0", CVAR_BOOL, "Ignore
 idCVar net_maxLoadResourcesTimeInSeconds( "net_maxLoadResourcesTimeInSeconds", "0", CVAR_INTEGER, "How long, in seconds, clients have to load resources. Used for loose asset builds." );
 idCVar net_migrateHost( "net_migrateHost", "-1", CVAR_INTEGER, "Become host of session (0 = party, 1 = game) for testing purposes" );
 extern idCVar net_debugBaseStates;
+extern void RecordSnapshotCapture( const idSnapShot& ss, uint32 clientMask );
 
 idCVar net_testPartyMemberConnectFail( "net_testPartyMemberConnectFail", "-1", CVAR_INTEGER, "Force this party member index to fail to connect to games." );
 
@@ -83,11 +84,15 @@ const char* idSessionLocal::stateToString[ NUM_STATES ] =
 	ASSERT_ENUM_STRING( STATE_INGAME, 17 ),
 };
 
+// Bump when the wire format changes, so mismatched peers are turned away at connect
+// 2: snapshot deltas start with a codec byte, hello messages end with a codec mask
+static const int NET_PROTOCOL_VERSION = 2;
+
 struct netVersion_s
 {
 	netVersion_s()
 	{
-		sprintf( string, "%s.%d", ENGINE_VERSION, BUILD_NUMBER );
+		sprintf( string, "%s.%d.%d", ENGINE_VERSION, BUILD_NUMBER, NET_PROTOCOL_VERSION );
 	}
 	char	string[256];
 } netVersion;
@@ -2042,6 +2047,9 @@ void idSessionLocal::Pump()
 	GetGameLobby().PumpPackets();
 	GetGameStateLobby().PumpPackets();
 	
+	// hand everything queued this frame to the network thread in one go
+	FlushRawPackets();
+	
 	int currentTime = Sys_Milliseconds();
 	
 	const int SHOW_MIGRATING_INFO_IN_SECONDS = 3;	// Show for at least this long once we start showing it
@@ -2411,6 +2419,8 @@ idSessionLocal::SendSnapshot
 */
 void idSessionLocal::SendSnapshot( idSnapShot& ss )
 {
+	uint32 clientMask = 0;
+	
 	for( int p = 0; p < GetActingGameStateLobby().peers.Num(); p++ )
 	{
 		idLobby::peer_t& peer = GetActingGameStateLobby().peers[p];
@@ -2431,7 +2441,14 @@ void idSessionLocal::SendSnapshot( idSnapShot& ss )
 		}
 		
 		GetActingGameStateLobby().SendSnapshotToPeer( ss, p );
+		
+		clientMask |= ( 1 << ( p + 1 ) );
 	}
+	
+	FlushRawPackets();
+	
+	// Feed the snapshot capture (recordSnapshots) used to benchmark delta codecs offline
+	RecordSnapshotCapture( ss, clientMask );
 }
 
 /*
@@ -3058,6 +3075,16 @@ void idSessionLocal::SendRawPacket( const lobbyAddress_t& to, const void* data,
 	TickSendQueue();
 }
 
+/*
+========================
+idSessionLocal::FlushRawPackets
+========================
+*/
+void idSessionLocal::FlushRawPackets()
+{
+	GetPort().FlushRawPackets();
+}
+
 /*
 ========================
 idSessionLocal::ReadRawPacket
@@ -4446,6 +4473,16 @@ void idNetSessionPort::SendRawPacket( const lobbyAddress_t& to, const void* data
 	UDP.SendPacket( to.netAddr, data, size );
 }
 
+/*
+========================
+idNetSessionPort::FlushRawPackets
+========================
+*/
+void idNetSessionPort::FlushRawPackets()
+{
+	UDP.Flush();
+}
+
 /*
 ========================
 idNetSessionPort::IsOpen
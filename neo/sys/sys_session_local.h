@@ -801,6 +801,7 @@ protected:
 	bool	ReadRawPacketFromQueue( int time, lobbyAddress_t& from, void* data, int& size, bool& outDedicated, int maxSize );
 	
 	void	SendRawPacket( const lobbyAddress_t& to, const void* data, int size, bool dedicated );
+	void	FlushRawPackets();
 	bool	ReadRawPacket( lobbyAddress_t& from, void* data, int& size, bool& outDedicated, int maxSize );
 	
 	void	ConnectAndMoveToLobby( idLobby& lobby, const lobbyConnectInfo_t& connectInfo, bool fromInvite );
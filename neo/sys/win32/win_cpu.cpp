@@ -32,6 +32,9 @@ If you have questions concerning this license or the applicable additional terms
 
 #include "win_local.h"
 
+#include <intrin.h>
+#include <immintrin.h>
+
 #pragma warning(disable:4740)	// warning C4740: flow in or out of inline asm code suppresses global optimization
 #pragma warning(disable:4731)	// warning C4731: 'XXX' : frame pointer register 'ebx' modified by inline assembly code
 
@@ -591,6 +594,35 @@ static bool HasDAZ() {
 }
 #endif
 
+/*
+================
+HasAVX2
+================
+*/
+static bool HasAVX2() {
+	int regs[4];
+
+	__cpuid( regs, 0 );
+	if ( regs[_REG_EAX] < 7 ) {
+		return false;
+	}
+
+	// bit 27 of ECX denotes OSXSAVE, bit 28 of ECX denotes AVX
+	__cpuid( regs, 1 );
+	if ( ( regs[_REG_ECX] & ( 3 << 27 ) ) != ( 3 << 27 ) ) {
+		return false;
+	}
+
+	// the OS has to save the XMM and YMM registers on context switches
+	if ( ( _xgetbv( 0 ) & 6 ) != 6 ) {
+		return false;
+	}
+
+	// bit 5 of EBX denotes AVX2
+	__cpuidex( regs, 7, 0 );
+	return ( regs[_REG_EBX] & ( 1 << 5 ) ) != 0;
+}
+
 /*
 ================================================================================================
 
@@ -778,6 +810,11 @@ cpuid_t Sys_GetCPUId()
 	flags |= CPUID_SSE;
 	flags |= CPUID_SSE2;
 
+	// check for Advanced Vector Extensions 2
+	if ( HasAVX2() ) {
+		flags |= CPUID_AVX2;
+	}
+
 	return (cpuid_t)flags;
 #else
 	int flags;
@@ -834,6 +871,11 @@ cpuid_t Sys_GetCPUId()
 		flags |= CPUID_DAZ;
 	}
 
+	// check for Advanced Vector Extensions 2
+	if ( HasAVX2() ) {
+		flags |= CPUID_AVX2;
+	}
+
 	return (cpuid_t)flags;
 #endif
 }
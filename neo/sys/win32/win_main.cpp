@@ -477,6 +477,34 @@ bool Sys_Rmdir( const char *path ) {
 	return _rmdir( path ) == 0;
 }
 
+/*
+========================
+Sys_MapFile
+
+Resource reads go through the file handle on Windows
+========================
+*/
+void *Sys_MapFile( const char *osPath, int &length ) {
+	length = 0;
+	return NULL;
+}
+
+/*
+========================
+Sys_UnmapFile
+========================
+*/
+void Sys_UnmapFile( void *data, int length ) {
+}
+
+/*
+========================
+Sys_PrefetchMappedRange
+========================
+*/
+void Sys_PrefetchMappedRange( void *data, int offset, int length ) {
+}
+
 /*
 ========================
 Sys_IsFileWritable
@@ -1221,6 +1249,9 @@ void Sys_Init() {
 		if ( win32.cpuid & CPUID_SSE3 ) {
 			string += "SSE3 & ";
 		}
+		if ( win32.cpuid & CPUID_AVX2 ) {
+			string += "AVX2 & ";
+		}
 		if ( win32.cpuid & CPUID_HTT ) {
 			string += "HTT & ";
 		}
@@ -1250,6 +1281,8 @@ void Sys_Init() {
 				id |= CPUID_SSE2;
 			} else if ( token.Icmp( "sse3" ) == 0 ) {
 				id |= CPUID_SSE3;
+			} else if ( token.Icmp( "avx2" ) == 0 ) {
+				id |= CPUID_AVX2;
 			} else if ( token.Icmp( "htt" ) == 0 ) {
 				id |= CPUID_HTT;
 			}
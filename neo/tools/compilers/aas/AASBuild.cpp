@@ -880,6 +880,12 @@ bool idAASBuild::Build( const idStr& fileName, const idAASSettings* settings )
 	name.SetFileExtension( aasSettings->fileExtension );
 	file->Write( name, mapFile->GetGeometryCRC() );
 	
+	// precompute the portal travel times
+	if( aasSettings->writeRouteTable )
+	{
+		gameEdit->AAS_WriteRouteTable( name );
+	}
+	
 	// delete the map file
 	delete mapFile;
 	
@@ -937,6 +943,12 @@ bool idAASBuild::BuildReachability( const idStr& fileName, const idAASSettings*
 	// write the file
 	file->Write( name, mapFile->GetGeometryCRC() );
 	
+	// precompute the portal travel times
+	if( aasSettings->writeRouteTable )
+	{
+		gameEdit->AAS_WriteRouteTable( name );
+	}
+	
 	// delete the map file
 	delete mapFile;
 	
@@ -981,6 +993,11 @@ int ParseOptions( const idCmdArgs& args, idAASSettings& settings )
 			settings.noOptimize = true;
 			common->Printf( "noOptimize = true\n" );
 		}
+		else if( str.Icmp( "routeTable" ) == 0 )
+		{
+			settings.writeRouteTable = true;
+			common->Printf( "routeTable = true\n" );
+		}
 	}
 	return args.Argc() - 1;
 }
@@ -1003,7 +1020,8 @@ void RunAAS_f( const idCmdArgs& args )
 						"options:\n"
 						"  -usePatches        = use bezier patches for collision detection.\n"
 						"  -writeBrushMap     = write a brush map with the AAS geometry.\n"
-						"  -playerFlood       = use player spawn points as valid AAS positions.\n" );
+						"  -playerFlood       = use player spawn points as valid AAS positions.\n"
+						"  -routeTable        = precompute the portal travel times.\n" );
 		return;
 	}
 	
@@ -1170,3 +1188,62 @@ void RunReach_f( const idCmdArgs& args )
 	common->SetRefreshOnPrint( false );
 	common->PrintWarnings();
 }
+
+/*
+============
+RunAASRoutes_f
+============
+*/
+void RunAASRoutes_f( const idCmdArgs& args )
+{
+	idAASSettings settings;
+	idStr fileName;
+	
+	if( args.Argc() <= 1 )
+	{
+		common->Printf( "runAASRoutes <mapfile>\n" );
+		return;
+	}
+	
+	common->ClearWarnings( "precomputing AAS route tables" );
+	
+	common->SetRefreshOnPrint( true );
+	
+	// get the aas settings definitions
+	const idDict* dict = gameEdit->FindEntityDefDict( "aas_types", false );
+	if( !dict )
+	{
+		common->Error( "Unable to find entityDef for 'aas_types'" );
+	}
+	
+	const idKeyValue* kv = dict->MatchPrefix( "type" );
+	while( kv != NULL )
+	{
+		const idDict* settingsDict = gameEdit->FindEntityDefDict( kv->GetValue(), false );
+		if( !settingsDict )
+		{
+			common->Warning( "Unable to find '%s' in def/aas.def", kv->GetValue().c_str() );
+		}
+		else
+		{
+			settings.FromDict( kv->GetValue(), settingsDict );
+			fileName = args.Argv( 1 );
+			fileName.BackSlashesToSlashes();
+			if( fileName.Icmpn( "maps/", 4 ) != 0 )
+			{
+				fileName = "maps/" + fileName;
+			}
+			fileName.SetFileExtension( settings.fileExtension );
+			gameEdit->AAS_WriteRouteTable( fileName );
+		}
+		
+		kv = dict->MatchPrefix( "type", kv );
+		if( kv )
+		{
+			common->Printf( "=======================================================\n" );
+		}
+	}
+	
+	common->SetRefreshOnPrint( false );
+	common->PrintWarnings();
+}
@@ -44,5 +44,6 @@ void Dmap_f( const idCmdArgs& args );
 void RunAAS_f( const idCmdArgs& args );
 void RunAASDir_f( const idCmdArgs& args );
 void RunReach_f( const idCmdArgs& args );
+void RunAASRoutes_f( const idCmdArgs& args );
 
 #endif	/* !__COMPILER_PUBLIC_H__ */
@@ -599,6 +599,11 @@ void iVr::HMDInit( void )
 	hasHMD = false;
 	game->isVR = false;
 
+#if defined(ID_DEDICATED)
+	common->Printf( "Dedicated server.\n VR Disabled\n" );
+	return;
+#endif
+
 	if ( !OculusInit() && !OpenVRInit() )
 	{
 		common->Printf( "No HMD detected.\n VR Disabled\n" );